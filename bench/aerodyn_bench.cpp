@@ -0,0 +1,333 @@
+// Micro-benchmarks of the per-frame simulation hot paths.
+//
+// Covers the plant update on each rotor count, the raw checked RK4 step of
+// dynamic_models, the sensor simulator, complementary estimator and rotor
+// telemetry updates, the attitude-history capture, the sample-to-array
+// preparation behind every telemetry plot line, state snapshots and one
+// sample of swarm turbulence. Each
+// benchmark runs on a state in its steady regime (hovering plant, full
+// history windows), so the numbers describe a frame of a long-running
+// session.
+//
+// Usage: aerodyn_bench [--filter <substring>] [--repetitions <n>] [--min-batch-ms <ms>]
+//                      [--baseline <results.tsv>] [--threshold <percent>] [--list]
+//
+// Results go to stdout in the tab-separated format of bench_harness.h, one
+// line per benchmark in a fixed order:
+//
+//   aerodyn_bench > before.tsv
+//   ... change, rebuild ...
+//   aerodyn_bench --baseline before.tsv > after.tsv
+//
+// With --baseline the comparison table goes to stderr and the exit status is
+// 1 if any benchmark got significantly slower.
+
+#include "bench_harness.h"
+
+#include "core/attitude_history.h"
+#include "core/frame_arena.h"
+#include "core/simulation_state.h"
+#include "core/turbulence_field.h"
+#include "gui/widgets/plot_series.h"
+#include "modules/complementary_estimator.h"
+#include "modules/quadcopter_dynamics.h"
+#include "modules/rotor_telemetry.h"
+#include "modules/sensor_simulator.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr double kPlantDt = 0.0025;         ///< One fixed RK4 substep per update
+constexpr double kFrameDt = 1.0 / 60.0;
+
+/// State with the named airframe's plant initialized at its hover trim
+SimulationState hoveringState(SimulationState::Airframe airframe, std::unique_ptr<Module>& plant) {
+    SimulationState state;
+    plant = makeMultirotorDynamicsModule(airframe);
+    plant->initialize(state);
+    return state;
+}
+
+void benchPlant(bench::Runner& runner, SimulationState::Airframe airframe, const char* name) {
+    std::unique_ptr<Module> plant;
+    SimulationState state = hoveringState(airframe, plant);
+    runner.run(name, [&](std::size_t) {
+        plant->update(kPlantDt, state);
+        state.time_seconds += kPlantDt;
+        return state.physics.position[2];
+    });
+}
+
+void benchPlantAdaptive(bench::Runner& runner) {
+    std::unique_ptr<Module> plant;
+    SimulationState state = hoveringState(SimulationState::Airframe::QuadX, plant);
+    state.plant_integration.method = SimulationState::PlantIntegration::Method::DormandPrince45;
+    runner.run("plant.quad_x.update_dp45", [&](std::size_t) {
+        plant->update(kFrameDt, state);
+        state.time_seconds += kFrameDt;
+        return state.physics.position[2];
+    });
+}
+
+/// The raw library step on a hovering symmetric ring of rotor_count rotors
+void benchRk4Checked(bench::Runner& runner, int rotor_count, const char* name) {
+    dm_vehicle_config_t config{};
+    config.rotor_count = rotor_count;
+    config.mass = 1.2;
+    config.gravity = 9.81;
+    const double inertia[3] = {0.029, 0.029, 0.055};
+    for (int i = 0; i < 3; ++i) {
+        config.inertia[i][i] = inertia[i];
+        config.inertia_inv[i][i] = 1.0 / inertia[i];
+    }
+    const double thrust_coeff = 1.2e-6;
+    const double hover_omega = std::sqrt(config.mass * config.gravity / (rotor_count * thrust_coeff));
+    double omega[DM_MAX_ROTORS] = {0};
+    for (int i = 0; i < rotor_count; ++i) {
+        const double angle = (2.0 * i + 1.0) * 3.14159265358979323846 / rotor_count;
+        dm_rotor_config_t& rotor = config.rotors[i];
+        rotor.position_body[0] = 0.25 * std::cos(angle);
+        rotor.position_body[1] = 0.25 * std::sin(angle);
+        rotor.axis_body[2] = -1.0;
+        rotor.direction = i % 2 == 0 ? 1.0 : -1.0;
+        rotor.thrust_coeff = thrust_coeff;
+        rotor.torque_coeff = 2.5e-8;
+        omega[i] = hover_omega;
+    }
+
+    dm_vehicle_model_t model{};
+    model.config = &config;
+    model.state.quaternion[0] = 1.0;
+    model.state.angular_rate[2] = 0.2;
+    runner.run(name, [&](std::size_t) {
+        const dm_result_t result = dm_vehicle_step_rk4_checked(&model, omega, kPlantDt);
+        return model.state.quaternion[3] + static_cast<double>(result);
+    });
+}
+
+/// Sensors and estimator on a plant that was given a slow body-rate tumble
+SimulationState tumblingState() {
+    std::unique_ptr<Module> plant;
+    SimulationState state = hoveringState(SimulationState::Airframe::QuadX, plant);
+    state.angular_rate_rad_s = glm::dvec3(0.3, -0.2, 0.5);
+    for (int i = 0; i < 60; ++i) {
+        plant->update(kFrameDt, state);
+        state.time_seconds += kFrameDt;
+    }
+    return state;
+}
+
+void benchSensors(bench::Runner& runner) {
+    SimulationState state = tumblingState();
+    SensorSimulatorModule sensors;
+    sensors.initialize(state);
+    runner.run("sensor_simulator.update", [&](std::size_t) {
+        sensors.update(kFrameDt, state);
+        return state.sensor.accel_mps2.x;
+    });
+}
+
+void benchEstimator(bench::Runner& runner) {
+    SimulationState state = tumblingState();
+    SensorSimulatorModule sensors;
+    sensors.initialize(state);
+    sensors.update(kFrameDt, state);
+    ComplementaryEstimatorModule estimator;
+    estimator.initialize(state);
+    runner.run("complementary_estimator.update", [&](std::size_t) {
+        estimator.update(kFrameDt, state);
+        return state.estimator.quaternion[0];
+    });
+}
+
+/// Every call is one history sample: push plus prune of a full 60 s window per rotor
+void benchRotorTelemetry(bench::Runner& runner, SimulationState::Airframe airframe, const char* name) {
+    std::unique_ptr<Module> plant;
+    SimulationState state = hoveringState(airframe, plant);
+    std::unique_ptr<Module> telemetry = makeRotorTelemetryModule(airframe);
+    telemetry->initialize(state);
+    const double interval = state.rotor_history.sample_interval;
+    const auto fill = static_cast<std::size_t>(state.rotor_history.window_seconds / interval);
+    for (std::size_t i = 0; i < fill; ++i) {
+        state.time_seconds += interval;
+        telemetry->update(interval, state);
+    }
+    runner.run(name, [&](std::size_t) {
+        state.time_seconds += interval;
+        telemetry->update(interval, state);
+        return static_cast<double>(state.rotor_history.rotors[0].size());
+    });
+}
+
+/// Attitude history with its window full, so each capture pushes one sample and prunes one
+SimulationState fullAttitudeHistory() {
+    SimulationState state;
+    const double interval = state.attitude_history.sample_interval;
+    const auto fill = static_cast<std::size_t>(state.attitude_history.window_seconds / interval) + 16;
+    for (std::size_t i = 0; i < fill; ++i) {
+        state.time_seconds += interval;
+        captureAttitudeSample(state);
+    }
+    return state;
+}
+
+void benchAttitudeHistory(bench::Runner& runner) {
+    SimulationState state = fullAttitudeHistory();
+    const double interval = state.attitude_history.sample_interval;
+    runner.run("history.attitude.capture", [&](std::size_t) {
+        state.time_seconds += interval;
+        state.markPoseDirty();   // The plant moves the attitude every frame
+        captureAttitudeSample(state);
+        return static_cast<double>(state.attitude_history.samples.size());
+    });
+
+    // A frame between samples only checks the interval.
+    runner.run("history.attitude.skip", [&](std::size_t) {
+        state.time_seconds += 1e-3 * interval;
+        captureAttitudeSample(state);
+        return state.attitude_history.last_sample_time;
+    });
+}
+
+/// The copy ui::PlotLine makes before every ImPlot::PlotLine call, into a frame arena reset per line
+void benchPlotSeries(bench::Runner& runner) {
+    const SimulationState attitude = fullAttitudeHistory();
+    FrameArena arena;
+    runner.run("plot.series.attitude_roll", [&](std::size_t) {
+        arena.reset();
+        ArenaVector<double> x_data(arena), y_data(arena);
+        ui::ExtractSeries(attitude.attitude_history.samples,
+                          [](const SimulationState::AttitudeSample& s) { return s.roll * 57.2958; },
+                          x_data, y_data);
+        return y_data.back() + x_data.front();
+    });
+
+    std::unique_ptr<Module> plant;
+    SimulationState rotors = hoveringState(SimulationState::Airframe::QuadX, plant);
+    std::unique_ptr<Module> telemetry = makeRotorTelemetryModule(SimulationState::Airframe::QuadX);
+    telemetry->initialize(rotors);
+    const double interval = rotors.rotor_history.sample_interval;
+    for (int i = 0; i < static_cast<int>(rotors.rotor_history.window_seconds / interval); ++i) {
+        rotors.time_seconds += interval;
+        telemetry->update(interval, rotors);
+    }
+    runner.run("plot.series.rotor_rpm", [&](std::size_t) {
+        arena.reset();
+        ArenaVector<double> x_data(arena), y_data(arena);
+        ui::ExtractSeries(rotors.rotor_history.rotors[0],
+                          [](const SimulationState::RotorSample& s) { return static_cast<double>(s.rpm); },
+                          x_data, y_data);
+        return y_data.back() + x_data.front();
+    });
+}
+
+/// Snapshot/restore of the hot vehicle block against copying the whole state (histories full)
+void benchStateSnapshot(bench::Runner& runner) {
+    SimulationState state = fullAttitudeHistory();
+    runner.run("state.snapshot_restore", [&](std::size_t) {
+        const SimulationHotState hot = state.snapshot();
+        state.restore(hot);
+        return hot.time_seconds;
+    });
+    runner.run("state.copy_full", [&](std::size_t) {
+        const SimulationState copy = state;
+        return static_cast<double>(copy.attitude_history.samples.size());
+    });
+}
+
+/// One 100 Hz turbulence sample (noise block plus filter pass) for a whole swarm
+void benchTurbulence(bench::Runner& runner, TurbulenceSpectrum spectrum, std::size_t vehicles, const char* name) {
+    TurbulenceField field;
+    field.resize(vehicles, 1);
+    field.configure(spectrum, lowAltitudeTurbulence(7.7, 10.0), 5.0, 0.01);
+    runner.run(name, [&](std::size_t) {
+        field.step();
+        return field.output(TurbulenceField::kVertical)[vehicles - 1];
+    });
+}
+
+void runAll(bench::Runner& runner) {
+    benchPlant(runner, SimulationState::Airframe::QuadX, "plant.quad_x.update");
+    benchPlant(runner, SimulationState::Airframe::HexX, "plant.hex_x.update");
+    benchPlant(runner, SimulationState::Airframe::OctoX, "plant.octo_x.update");
+    benchPlantAdaptive(runner);
+    benchRk4Checked(runner, 4, "dm.step_rk4_checked.4");
+    benchRk4Checked(runner, 8, "dm.step_rk4_checked.8");
+    benchSensors(runner);
+    benchEstimator(runner);
+    benchRotorTelemetry(runner, SimulationState::Airframe::QuadX, "rotor_telemetry.quad_x.update");
+    benchRotorTelemetry(runner, SimulationState::Airframe::OctoX, "rotor_telemetry.octo_x.update");
+    benchAttitudeHistory(runner);
+    benchPlotSeries(runner);
+    benchStateSnapshot(runner);
+    benchTurbulence(runner, TurbulenceSpectrum::Dryden, 1000, "turbulence.dryden.1000");
+    benchTurbulence(runner, TurbulenceSpectrum::VonKarman, 1000, "turbulence.von_karman.1000");
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    bench::Options options;
+    std::string baseline_path;
+    double threshold_pct = 5.0;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && has_value) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--repetitions") == 0 && has_value) {
+            options.repetitions = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--min-batch-ms") == 0 && has_value) {
+            options.min_batch_ms = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--baseline") == 0 && has_value) {
+            baseline_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--threshold") == 0 && has_value) {
+            threshold_pct = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--filter <substring>] [--repetitions <n>] [--min-batch-ms <ms>]\n"
+                         "          [--baseline <results.tsv>] [--threshold <percent>] [--list]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<bench::Result> baseline;
+    if (!baseline_path.empty() && !bench::readResults(baseline_path, baseline)) {
+        std::fprintf(stderr, "%s is missing or not aerodyn_bench output\n", baseline_path.c_str());
+        return 2;
+    }
+
+    if (list) {
+        // Run each benchmark for a single tiny batch just to collect the names.
+        options.warmup_batches = 0;
+        options.repetitions = 1;
+        options.min_batch_ms = 0.0;
+    }
+    bench::Runner runner(options);
+    runAll(runner);
+    runner.publishSink();
+
+    if (list) {
+        for (const bench::Result& result : runner.results()) {
+            std::puts(result.name.c_str());
+        }
+        return 0;
+    }
+
+    bench::writeResults(stdout, runner.results());
+    if (!baseline.empty()) {
+        return bench::compareResults(baseline, runner.results(), threshold_pct, stderr) > 0 ? 1 : 0;
+    }
+    return 0;
+}
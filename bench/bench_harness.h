@@ -0,0 +1,202 @@
+// Timing harness shared by the micro-benchmarks.
+//
+// Each benchmark is calibrated to a batch of calls that lasts at least
+// min_batch_ms, warmed up for a few untimed batches, then timed over
+// `repetitions` batches. The per-call time is summarised by the median and
+// the median absolute deviation (MAD) across batches; both shrug off the
+// odd batch that was preempted or hit a page fault, which a mean does not.
+//
+// Results are written as tab-separated lines, one per benchmark in a fixed
+// order, so two runs can be diffed directly or compared with compareResults().
+
+#ifndef BENCH_BENCH_HARNESS_H
+#define BENCH_BENCH_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr const char* kFormatHeader = "# aerodyn_bench v1";
+constexpr double kMadToSigma = 1.4826;  ///< MAD of a normal distribution times this is its σ
+
+struct Options {
+    int warmup_batches = 3;         ///< Untimed batches after calibration
+    int repetitions = 25;           ///< Timed batches
+    double min_batch_ms = 2.0;      ///< Calibrate batches to at least this long
+    std::string filter;             ///< Run only benchmarks whose name contains this
+};
+
+struct Result {
+    std::string name;
+    double median_ns{0.0};          ///< Median time per call across batches
+    double mad_ns{0.0};             ///< Median absolute deviation of the same
+    double min_ns{0.0};             ///< Fastest batch, per call
+    std::size_t batch{0};           ///< Calls per batch
+    int repetitions{0};
+};
+
+inline double median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const std::size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    const double upper = values[mid];
+    if (values.size() % 2 != 0) {
+        return upper;
+    }
+    return 0.5 * (upper + *std::max_element(values.begin(), values.begin() + mid));
+}
+
+/// Where Runner::publishSink() stores the accumulated results
+inline volatile double published_sink = 0.0;
+
+class Runner {
+public:
+    explicit Runner(Options options) : options_(std::move(options)) {}
+
+    /**
+     * Time body(i) for i = 0, 1, 2, ... The returned double is accumulated
+     * into a sink that is published at the end, so the work cannot be
+     * optimised away; bodies should return something the call computed.
+     */
+    template <typename Body>
+    void run(const std::string& name, Body&& body) {
+        if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) {
+            return;
+        }
+
+        std::size_t counter = 0;
+        const double min_batch_ns = options_.min_batch_ms * 1e6;
+        std::size_t batch = 1;
+        while (batchNanoseconds(body, batch, counter) < min_batch_ns && batch < (std::size_t{1} << 30)) {
+            batch *= 2;
+        }
+        for (int i = 0; i < options_.warmup_batches; ++i) {
+            batchNanoseconds(body, batch, counter);
+        }
+
+        const int repetitions = std::max(1, options_.repetitions);
+        std::vector<double> per_call(static_cast<std::size_t>(repetitions));
+        for (double& sample : per_call) {
+            sample = batchNanoseconds(body, batch, counter) / static_cast<double>(batch);
+        }
+
+        Result result;
+        result.name = name;
+        result.median_ns = median(per_call);
+        std::vector<double> deviation(per_call.size());
+        for (std::size_t i = 0; i < per_call.size(); ++i) {
+            deviation[i] = std::abs(per_call[i] - result.median_ns);
+        }
+        result.mad_ns = median(deviation);
+        result.min_ns = *std::min_element(per_call.begin(), per_call.end());
+        result.batch = batch;
+        result.repetitions = repetitions;
+        results_.push_back(result);
+    }
+
+    const std::vector<Result>& results() const { return results_; }
+
+    /// Publish the accumulated sink (call once, after the last benchmark)
+    void publishSink() const { published_sink = sink_; }
+
+private:
+    template <typename Body>
+    double batchNanoseconds(Body& body, std::size_t batch, std::size_t& counter) {
+        double sink = 0.0;
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < batch; ++i) {
+            sink += body(counter++);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        sink_ += sink;
+        return elapsed.count();
+    }
+
+    Options options_;
+    std::vector<Result> results_;
+    double sink_{0.0};
+};
+
+inline void writeResults(std::FILE* out, const std::vector<Result>& results) {
+    std::fprintf(out, "%s\n# name\tmedian_ns\tmad_ns\tmin_ns\tbatch\trepetitions\n", kFormatHeader);
+    for (const Result& r : results) {
+        std::fprintf(out, "%s\t%.2f\t%.2f\t%.2f\t%zu\t%d\n", r.name.c_str(), r.median_ns, r.mad_ns, r.min_ns,
+                     r.batch, r.repetitions);
+    }
+}
+
+/// Read a file written by writeResults(); false if it is missing or not in that format
+inline bool readResults(const std::string& path, std::vector<Result>& results) {
+    std::ifstream file(path);
+    std::string line;
+    if (!std::getline(file, line) || line != kFormatHeader) {
+        return false;
+    }
+    results.clear();
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        Result r;
+        if (!std::getline(fields, r.name, '\t') ||
+            !(fields >> r.median_ns >> r.mad_ns >> r.min_ns >> r.batch >> r.repetitions)) {
+            return false;
+        }
+        results.push_back(r);
+    }
+    return true;
+}
+
+/**
+ * Report each benchmark present in both runs. A change counts only when it
+ * exceeds both threshold_pct of the baseline median and three standard
+ * deviations of the difference as estimated from the two MADs.
+ *
+ * @return Number of benchmarks that got slower
+ */
+inline int compareResults(const std::vector<Result>& baseline, const std::vector<Result>& current,
+                          double threshold_pct, std::FILE* out) {
+    int regressions = 0;
+    std::fprintf(out, "%-36s %12s %12s %9s\n", "benchmark", "baseline ns", "current ns", "change");
+    for (const Result& now : current) {
+        const auto before = std::find_if(baseline.begin(), baseline.end(),
+                                         [&](const Result& r) { return r.name == now.name; });
+        if (before == baseline.end()) {
+            std::fprintf(out, "%-36s %12s %12.2f %9s  new\n", now.name.c_str(), "-", now.median_ns, "");
+            continue;
+        }
+        const double delta = now.median_ns - before->median_ns;
+        const double noise = 3.0 * kMadToSigma * std::hypot(before->mad_ns, now.mad_ns);
+        const double significant = std::max(noise, 0.01 * threshold_pct * before->median_ns);
+        const char* verdict = "";
+        if (delta > significant) {
+            verdict = "  SLOWER";
+            ++regressions;
+        } else if (-delta > significant) {
+            verdict = "  faster";
+        }
+        const double percent = before->median_ns > 0.0 ? 100.0 * delta / before->median_ns : 0.0;
+        std::fprintf(out, "%-36s %12.2f %12.2f %+8.1f%%%s\n", now.name.c_str(), before->median_ns, now.median_ns,
+                     percent, verdict);
+    }
+    return regressions;
+}
+
+}  // namespace bench
+
+#endif // BENCH_BENCH_HARNESS_H
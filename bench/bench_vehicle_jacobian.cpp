@@ -0,0 +1,136 @@
+// Forward-mode AD versus central differences for the plant Jacobians.
+//
+// Reports the time per Jacobian of each method and the worst deviation of
+// the finite-difference result from the exact (AD) one over a sweep of step
+// sizes, for the quad and octo rotor counts.
+//
+// Usage: aerodyn_jacobian_bench [iterations]
+
+#include "modules/vehicle_jacobian.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <std::size_t RotorCount>
+dm_vehicle_config_t ringConfig()
+{
+    dm_vehicle_config_t config{};
+    config.rotor_count = static_cast<int>(RotorCount);
+    config.mass = 1.2;
+    config.gravity = 9.81;
+    const double inertia[3] = {0.029, 0.029, 0.055};
+    for (int i = 0; i < 3; ++i) {
+        config.inertia[i][i] = inertia[i];
+        config.inertia_inv[i][i] = 1.0 / inertia[i];
+    }
+    for (std::size_t i = 0; i < RotorCount; ++i) {
+        const double angle = (2.0 * static_cast<double>(i) + 1.0) * 3.14159265358979323846 /
+                             static_cast<double>(RotorCount);
+        dm_rotor_config_t& rotor = config.rotors[i];
+        rotor.position_body[0] = 0.25 * std::cos(angle);
+        rotor.position_body[1] = 0.25 * std::sin(angle);
+        rotor.axis_body[2] = -1.0;
+        rotor.direction = i % 2 == 0 ? 1.0 : -1.0;
+        rotor.thrust_coeff = 1.2e-6;
+        rotor.torque_coeff = 2.5e-8;
+    }
+    return config;
+}
+
+VehicleStateVector<double> operatingPoint()
+{
+    VehicleStateVector<double> x{};
+    x[kStateVelocity + 0] = 4.0;
+    x[kStateVelocity + 2] = -1.0;
+    const double q[4] = {0.96, 0.12, -0.18, 0.17};
+    const double norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (std::size_t i = 0; i < 4; ++i) {
+        x[kStateQuaternion + i] = q[i] / norm;
+    }
+    x[kStateAngularRate + 0] = 0.6;
+    x[kStateAngularRate + 1] = -0.3;
+    x[kStateAngularRate + 2] = 1.2;
+    return x;
+}
+
+/// Largest entry error relative to the largest entry of the same row
+template <std::size_t R, std::size_t C>
+double maxRelativeError(const SmallMatrix<R, C>& approx, const SmallMatrix<R, C>& exact)
+{
+    double worst = 0.0;
+    for (std::size_t i = 0; i < R; ++i) {
+        double scale = 0.0;
+        double error = 0.0;
+        for (std::size_t j = 0; j < C; ++j) {
+            scale = std::max(scale, std::abs(exact.m[i][j]));
+            error = std::max(error, std::abs(approx.m[i][j] - exact.m[i][j]));
+        }
+        if (scale > 0.0) {
+            worst = std::max(worst, error / scale);
+        }
+    }
+    return worst;
+}
+
+template <typename Function>
+double nanosecondsPerCall(Function&& function, int iterations, double& sink)
+{
+    const auto start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink += function(i);
+    }
+    const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+template <std::size_t RotorCount>
+void benchmark(int iterations)
+{
+    const dm_vehicle_config_t config = ringConfig<RotorCount>();
+    const VehicleStateVector<double> x = operatingPoint();
+    SmallVector<RotorCount> omega{};
+    for (std::size_t i = 0; i < RotorCount; ++i) {
+        omega[i] = 1000.0 + 25.0 * static_cast<double>(i);
+    }
+
+    // Perturb the input every call so nothing is hoisted out of the loop.
+    double sink = 0.0;
+    const double ad_ns = nanosecondsPerCall([&](int i) {
+        SmallVector<RotorCount> u = omega;
+        u[0] += 1e-3 * (i & 7);
+        return vehicleJacobian<RotorCount>(config, u, x).a.m[kStateVelocity][kStateQuaternion];
+    }, iterations, sink);
+    const double fd_ns = nanosecondsPerCall([&](int i) {
+        SmallVector<RotorCount> u = omega;
+        u[0] += 1e-3 * (i & 7);
+        return vehicleJacobianCentralDifference<RotorCount>(config, u, x).a.m[kStateVelocity][kStateQuaternion];
+    }, iterations, sink);
+
+    std::printf("%zu rotors: AD %.0f ns, central differences %.0f ns per Jacobian (%.2fx)  [checksum %.3g]\n",
+                RotorCount, ad_ns, fd_ns, fd_ns / ad_ns, sink);
+
+    const VehicleJacobian<RotorCount> exact = vehicleJacobian<RotorCount>(config, omega, x);
+    for (double step : {1e-3, 1e-5, 1e-7, 1e-9}) {
+        const VehicleJacobian<RotorCount> approx =
+            vehicleJacobianCentralDifference<RotorCount>(config, omega, x, AirRelativeDrag{}, step, step);
+        std::printf("    step %.0e: max relative error A %.2e, B %.2e\n", step,
+                    maxRelativeError(approx.a, exact.a), maxRelativeError(approx.b, exact.b));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200000;
+    benchmark<4>(iterations);
+    benchmark<8>(iterations);
+    return 0;
+}
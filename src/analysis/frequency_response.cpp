@@ -0,0 +1,178 @@
+#include "analysis/frequency_response.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include "analysis/parallel.h"
+#include "core/excitation.h"
+
+namespace {
+
+constexpr double kTwoPi = 2.0 * excitation::kPi;
+constexpr double kRadToDeg = 180.0 / excitation::kPi;
+
+/// Steps between renormalizations of the rotating phasors
+constexpr std::size_t kPhasorRenormalize = 1024;
+
+struct RunResult {
+    std::vector<double> frequency_hz;
+    std::vector<std::complex<double>> response;
+    double coherence{0.0};
+};
+
+/**
+ * @brief One headless run exciting every frequency in tones_hz (ascending) at once
+ */
+RunResult runTones(const HeadlessTarget& target, const FrequencyResponseSettings& settings,
+                   const std::vector<double>& tones_hz) {
+    const std::size_t tone_count = tones_hz.size();
+    const double cycles = static_cast<double>(std::max<std::size_t>(settings.measure_cycles, 1));
+    const double window_s = cycles / tones_hz.front();
+
+    // Snap every tone to a whole number of periods in the window (distinct bins).
+    RunResult result;
+    result.frequency_hz.resize(tone_count);
+    long previous_bin = 0;
+    for (std::size_t i = 0; i < tone_count; ++i) {
+        const long bin = std::max(previous_bin + 1, std::lround(tones_hz[i] * window_s));
+        result.frequency_hz[i] = static_cast<double>(bin) / window_s;
+        previous_bin = bin;
+    }
+
+    const double max_step = std::min(settings.max_step_s,
+                                     1.0 / (std::max(settings.samples_per_cycle, 2.0) * result.frequency_hz.back()));
+    const std::size_t measure_steps = static_cast<std::size_t>(std::ceil(window_s / max_step));
+    const double dt = window_s / static_cast<double>(measure_steps);
+    const double settle_s = std::max(settings.settle_cycles / tones_hz.front(), target.settle_s);
+    const std::size_t settle_steps = static_cast<std::size_t>(std::ceil(settle_s / dt));
+
+    // Rotating phasors: rotor = e^{jωt} at the step start; the input of a
+    // step is attributed to its midpoint, the output to its end.
+    const double tone_amplitude = settings.amplitude / std::sqrt(static_cast<double>(tone_count));
+    std::vector<std::complex<double>> rotor(tone_count, std::complex<double>(1.0, 0.0));
+    std::vector<std::complex<double>> step(tone_count);
+    std::vector<std::complex<double>> half_step(tone_count);
+    std::vector<std::complex<double>> drive(tone_count);
+    std::vector<std::complex<double>> input_sum(tone_count);
+    std::vector<std::complex<double>> output_sum(tone_count);
+    for (std::size_t i = 0; i < tone_count; ++i) {
+        const double omega = kTwoPi * result.frequency_hz[i];
+        step[i] = std::polar(1.0, omega * dt);
+        half_step[i] = std::polar(1.0, 0.5 * omega * dt);
+        const double phase = tone_count > 1 ? excitation::schroederPhase(i + 1, tone_count) : 0.0;
+        drive[i] = tone_amplitude * half_step[i] * std::polar(1.0, phase);
+    }
+
+    SimulationState state;
+    ModuleScheduler scheduler;
+    target.build(scheduler, state);
+
+    double output_sum_plain = 0.0;
+    double output_sum_sq = 0.0;
+    const std::size_t total_steps = settle_steps + measure_steps;
+    for (std::size_t n = 0; n < total_steps; ++n) {
+        double u = 0.0;
+        for (std::size_t i = 0; i < tone_count; ++i) {
+            u += (rotor[i] * drive[i]).imag();
+        }
+        target.inject(u, state);
+        scheduler.advance(dt, state);
+
+        if (n >= settle_steps) {
+            const double y = target.measure(state);
+            output_sum_plain += y;
+            output_sum_sq += y * y;
+            for (std::size_t i = 0; i < tone_count; ++i) {
+                input_sum[i] += u * std::conj(rotor[i] * half_step[i]);
+                output_sum[i] += y * std::conj(rotor[i] * step[i]);
+            }
+        }
+
+        for (std::size_t i = 0; i < tone_count; ++i) {
+            rotor[i] *= step[i];
+        }
+        if (n % kPhasorRenormalize == kPhasorRenormalize - 1) {
+            for (auto& r : rotor) {
+                r /= std::abs(r);
+            }
+        }
+    }
+
+    const double samples = static_cast<double>(measure_steps);
+    const double mean = output_sum_plain / samples;
+    const double variance = output_sum_sq / samples - mean * mean;
+    double tone_power = 0.0;
+    result.response.resize(tone_count);
+    for (std::size_t i = 0; i < tone_count; ++i) {
+        result.response[i] = output_sum[i] / input_sum[i];
+        tone_power += 2.0 * std::norm(output_sum[i] / samples);
+    }
+    result.coherence = variance > 0.0 ? std::min(tone_power / variance, 1.0) : 0.0;
+    return result;
+}
+
+}  // namespace
+
+std::vector<double> logFrequencyGrid(double min_hz, double max_hz, std::size_t points) {
+    std::vector<double> grid(points);
+    if (points == 0) {
+        return grid;
+    }
+    if (points == 1) {
+        grid[0] = min_hz;
+        return grid;
+    }
+    const double log_min = std::log(min_hz);
+    const double log_step = (std::log(max_hz) - log_min) / static_cast<double>(points - 1);
+    for (std::size_t i = 0; i < points; ++i) {
+        grid[i] = std::exp(log_min + log_step * static_cast<double>(i));
+    }
+    return grid;
+}
+
+std::vector<FrequencyResponsePoint> analyzeFrequencyResponse(const HeadlessTarget& target,
+                                                             const FrequencyResponseSettings& settings,
+                                                             std::atomic<std::size_t>* completed,
+                                                             const std::atomic<bool>* cancel) {
+    if (settings.points == 0 || settings.min_hz <= 0.0 || settings.max_hz < settings.min_hz) {
+        return {};
+    }
+    const std::vector<double> grid = logFrequencyGrid(settings.min_hz, settings.max_hz, settings.points);
+
+    // Run r excites grid points r, r + runs, r + 2·runs, ...
+    const std::size_t tones_per_run =
+        settings.excitation == FrequencyResponseSettings::Excitation::MultiSine
+            ? std::max<std::size_t>(settings.tones_per_run, 1)
+            : 1;
+    const std::size_t runs = (grid.size() + tones_per_run - 1) / tones_per_run;
+
+    std::vector<FrequencyResponsePoint> points(grid.size());
+    parallelFor(runs, settings.threads, [&](std::size_t run) {
+        std::vector<double> tones;
+        for (std::size_t index = run; index < grid.size(); index += runs) {
+            tones.push_back(grid[index]);
+        }
+        const RunResult result = runTones(target, settings, tones);
+        for (std::size_t i = 0; i < tones.size(); ++i) {
+            FrequencyResponsePoint& point = points[run + i * runs];
+            point.frequency_hz = result.frequency_hz[i];
+            point.gain = std::abs(result.response[i]);
+            point.phase_deg = std::arg(result.response[i]) * kRadToDeg;
+            point.coherence = result.coherence;
+        }
+        if (completed) {
+            completed->fetch_add(tones.size(), std::memory_order_relaxed);
+        }
+    }, cancel);
+    if (cancel && cancel->load()) {
+        return {};
+    }
+
+    // Unwrap the phase from the low end, where the wrapped value is taken as is.
+    for (std::size_t i = 1; i < points.size(); ++i) {
+        const double jump = points[i].phase_deg - points[i - 1].phase_deg;
+        points[i].phase_deg -= 360.0 * std::round(jump / 360.0);
+    }
+    return points;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file frequency_response.h
+ * @brief Headless frequency-response (Bode) analyzer over module pipelines
+ */
+
+#ifndef ANALYSIS_FREQUENCY_RESPONSE_H
+#define ANALYSIS_FREQUENCY_RESPONSE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "analysis/headless_target.h"
+
+/**
+ * @brief Sweep settings for analyzeFrequencyResponse()
+ *
+ * Stepped sine runs one headless simulation per frequency point. Multi-sine
+ * excites tones_per_run points at once with Schroeder phases; the points of
+ * one run are interleaved across the grid (run b gets points b, b + B,
+ * b + 2B, ...) so its tones are far apart and each lands on its own DFT bin.
+ */
+struct FrequencyResponseSettings {
+    enum class Excitation {
+        SteppedSine,  ///< One tone per run (most accurate, also for mildly nonlinear loops)
+        MultiSine     ///< tones_per_run tones per run (fewer, longer runs)
+    };
+    Excitation excitation{Excitation::SteppedSine};
+    double min_hz{0.05};              ///< Lowest frequency of the log grid (Hz)
+    double max_hz{20.0};              ///< Highest frequency of the log grid (Hz)
+    std::size_t points{200};          ///< Grid points
+    double amplitude{1.0};            ///< Peak input of a single tone (multi-sine: same total power)
+    double settle_cycles{3.0};        ///< Cycles of the lowest tone discarded before measuring
+    std::size_t measure_cycles{4};    ///< Whole cycles of the lowest tone correlated
+    std::size_t tones_per_run{8};     ///< Multi-sine tones per run
+    double samples_per_cycle{32.0};   ///< Minimum steps per cycle of the highest tone
+    double max_step_s{0.002};         ///< Longest simulation step (s)
+    std::size_t threads{0};           ///< Worker threads (0 = hardware concurrency)
+};
+
+/**
+ * @brief Measured response at one frequency
+ */
+struct FrequencyResponsePoint {
+    double frequency_hz{0.0};  ///< Excitation frequency actually used (snapped to the DFT bin)
+    double gain{0.0};          ///< |Y/U|
+    double phase_deg{0.0};     ///< arg(Y/U), unwrapped along the sweep
+    double coherence{0.0};     ///< Share of output variance at the excitation tones (1 = linear, noise-free)
+};
+
+/**
+ * @brief Logarithmically spaced frequencies from min_hz to max_hz (inclusive)
+ */
+std::vector<double> logFrequencyGrid(double min_hz, double max_hz, std::size_t points);
+
+/**
+ * @brief Measure gain and phase of a target over a log frequency grid
+ *
+ * Runs are spread over a worker pool; each is a headless simulation that
+ * injects the excitation, discards the settle time and then correlates the
+ * input and output against every tone over a whole number of periods
+ * (single-bin DFT). The input held over a step is attributed to the step's
+ * midpoint, so the zero-order hold adds no phase lag to the estimate.
+ * Results are independent of the thread count.
+ *
+ * @param completed Incremented as points finish (optional, for progress bars)
+ * @param cancel Checked between runs; a cancelled sweep returns an empty vector
+ * @return One point per grid frequency, ascending
+ */
+std::vector<FrequencyResponsePoint> analyzeFrequencyResponse(const HeadlessTarget& target,
+                                                             const FrequencyResponseSettings& settings,
+                                                             std::atomic<std::size_t>* completed = nullptr,
+                                                             const std::atomic<bool>* cancel = nullptr);
+
+#endif // ANALYSIS_FREQUENCY_RESPONSE_H
@@ -0,0 +1,266 @@
+#include "analysis/golden_trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include "control/config_hash.h"
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x52544741u;   ///< "AGTR" little-endian
+constexpr std::uint32_t kFormatVersion = 1;
+constexpr std::uint64_t kMaxWidth = 4096;       ///< Sanity bounds on a corrupt header
+constexpr std::uint64_t kMaxSteps = 1u << 24;
+constexpr std::uint64_t kMaxName = 256;
+
+struct Header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t width;
+    std::uint64_t steps;
+    double dt;
+};
+
+/// Continue a chained row hash with one more row (raw bit patterns, -0.0 ≠ +0.0)
+std::uint64_t chainRow(std::uint64_t previous, const double* row, std::size_t width) {
+    ConfigHash hash;
+    hash.add(previous);
+    for (std::size_t i = 0; i < width; ++i) {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &row[i], sizeof(bits));
+        hash.add(bits);
+    }
+    return hash.value();
+}
+
+void writeString(std::ofstream& file, const std::string& text) {
+    const std::uint64_t length = text.size();
+    file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    file.write(text.data(), static_cast<std::streamsize>(length));
+}
+
+bool readString(std::ifstream& file, std::string& text) {
+    std::uint64_t length = 0;
+    file.read(reinterpret_cast<char*>(&length), sizeof(length));
+    if (!file || length > kMaxName) {
+        return false;
+    }
+    text.assign(static_cast<std::size_t>(length), '\0');
+    file.read(&text[0], static_cast<std::streamsize>(length));
+    return static_cast<bool>(file);
+}
+
+bool bitwiseEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+bool withinTolerance(double a, double b, double tolerance) {
+    if (bitwiseEqual(a, b) || (std::isnan(a) && std::isnan(b))) {
+        return true;
+    }
+    const double scale = std::max({1.0, std::abs(a), std::abs(b)});
+    return std::abs(a - b) <= tolerance * scale;
+}
+
+}  // namespace
+
+GoldenTrace::GoldenTrace(std::string scenario, std::vector<std::string> fields, double dt)
+    : scenario_(std::move(scenario)), fields_(std::move(fields)), dt_(dt) {}
+
+void GoldenTrace::append(const double* row) {
+    values_.insert(values_.end(), row, row + fields_.size());
+    hashes_.push_back(chainRow(finalHash(), row, fields_.size()));
+}
+
+bool GoldenTrace::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    const Header header{kMagic, kFormatVersion, fields_.size(), hashes_.size(), dt_};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeString(file, scenario_);
+    for (const auto& field : fields_) {
+        writeString(file, field);
+    }
+    file.write(reinterpret_cast<const char*>(values_.data()),
+               static_cast<std::streamsize>(sizeof(double) * values_.size()));
+    file.write(reinterpret_cast<const char*>(hashes_.data()),
+               static_cast<std::streamsize>(sizeof(std::uint64_t) * hashes_.size()));
+    return static_cast<bool>(file);
+}
+
+bool GoldenTrace::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    Header header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != kMagic || header.version != kFormatVersion ||
+        header.width == 0 || header.width > kMaxWidth || header.steps > kMaxSteps) {
+        return false;
+    }
+
+    GoldenTrace trace;
+    trace.dt_ = header.dt;
+    if (!readString(file, trace.scenario_)) {
+        return false;
+    }
+    trace.fields_.resize(static_cast<std::size_t>(header.width));
+    for (auto& field : trace.fields_) {
+        if (!readString(file, field)) {
+            return false;
+        }
+    }
+    trace.values_.resize(static_cast<std::size_t>(header.width * header.steps));
+    trace.hashes_.resize(static_cast<std::size_t>(header.steps));
+    file.read(reinterpret_cast<char*>(trace.values_.data()),
+              static_cast<std::streamsize>(sizeof(double) * trace.values_.size()));
+    file.read(reinterpret_cast<char*>(trace.hashes_.data()),
+              static_cast<std::streamsize>(sizeof(std::uint64_t) * trace.hashes_.size()));
+    if (!file) {
+        return false;
+    }
+
+    // Reject files whose rows were edited or truncated behind the hashes' back.
+    std::uint64_t chained = 0;
+    for (std::size_t step = 0; step < trace.hashes_.size(); ++step) {
+        chained = chainRow(chained, &trace.values_[step * trace.width()], trace.width());
+        if (chained != trace.hashes_[step]) {
+            return false;
+        }
+    }
+    *this = std::move(trace);
+    return true;
+}
+
+std::string TraceDiff::describe() const {
+    if (match) {
+        return "traces match";
+    }
+    char text[256];
+    std::snprintf(text, sizeof(text), "first divergence at step %zu, field %s: golden %.17g, recorded %.17g",
+                  step, field.c_str(), expected, actual);
+    return text;
+}
+
+TraceDiff compareTraces(const GoldenTrace& golden, const GoldenTrace& actual, double tolerance) {
+    TraceDiff diff;
+    if (golden.fields() != actual.fields()) {
+        diff.match = false;
+        diff.field = "layout";
+        return diff;
+    }
+
+    const std::size_t common = std::min(golden.steps(), actual.steps());
+    const std::size_t width = golden.width();
+    for (std::size_t step = 0; step < common; ++step) {
+        // Bitwise mode skips straight past every step whose chained hash agrees.
+        if (tolerance == 0.0 && golden.stepHash(step) == actual.stepHash(step)) {
+            continue;
+        }
+        for (std::size_t field = 0; field < width; ++field) {
+            const double expected = golden.value(step, field);
+            const double recorded = actual.value(step, field);
+            const bool same = tolerance == 0.0 ? bitwiseEqual(expected, recorded)
+                                               : withinTolerance(expected, recorded, tolerance);
+            if (!same) {
+                diff.match = false;
+                diff.step = step;
+                diff.field = golden.fields()[field];
+                diff.expected = expected;
+                diff.actual = recorded;
+                return diff;
+            }
+        }
+    }
+    if (golden.steps() != actual.steps()) {
+        diff.match = false;
+        diff.step = common;
+        diff.field = "steps";
+        diff.expected = static_cast<double>(golden.steps());
+        diff.actual = static_cast<double>(actual.steps());
+    }
+    return diff;
+}
+
+std::vector<std::string> traceFields(std::size_t rotor_count) {
+    std::vector<std::string> fields = {
+        "time",
+        "position.n", "position.e", "position.d",
+        "velocity.n", "velocity.e", "velocity.d",
+        "quaternion.w", "quaternion.x", "quaternion.y", "quaternion.z",
+        "rate.p", "rate.q", "rate.r",
+    };
+    for (std::size_t i = 0; i < rotor_count; ++i) {
+        fields.push_back("omega." + std::to_string(i));
+    }
+    const char* tail[] = {
+        "torque_cmd.x", "torque_cmd.y", "torque_cmd.z", "thrust_cmd",
+        "estimator.w", "estimator.x", "estimator.y", "estimator.z",
+        "first_order.output",
+        "rotor_history.size", "rotor_history.rpm", "rotor_history.thrust",
+    };
+    fields.insert(fields.end(), std::begin(tail), std::end(tail));
+    return fields;
+}
+
+void sampleTraceRow(const SimulationState& state, std::size_t rotor_count, double* row) {
+    std::size_t i = 0;
+    row[i++] = state.time_seconds;
+    for (int axis = 0; axis < 3; ++axis) {
+        row[i++] = state.physics.position[axis];
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        row[i++] = state.physics.velocity[axis];
+    }
+    for (std::size_t k = 0; k < 4; ++k) {
+        row[i++] = state.quaternion[k];
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        row[i++] = state.angular_rate_rad_s[axis];
+    }
+    for (std::size_t r = 0; r < rotor_count; ++r) {
+        row[i++] = state.motor_state.omega_rad_s[r];
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        row[i++] = state.controller_state.torque_command_nm[axis];
+    }
+    row[i++] = state.controller_state.thrust_command_newton;
+    for (std::size_t k = 0; k < 4; ++k) {
+        row[i++] = state.estimator.quaternion[k];
+    }
+    row[i++] = state.dynamics_state.output;
+    const auto& history = state.rotor_history.rotors[0];
+    row[i++] = static_cast<double>(history.size());
+    row[i++] = history.empty() ? 0.0 : history.back().rpm;
+    row[i++] = history.empty() ? 0.0 : history.back().thrust;
+}
+
+GoldenTrace recordTrace(const TraceScenario& scenario) {
+    SimulationState state;
+    ModuleScheduler scheduler;
+    scenario.build(scheduler, state);
+
+    const std::size_t rotor_count = state.vehicle_config.rotor_count;
+    GoldenTrace trace(scenario.name, traceFields(rotor_count), scenario.dt);
+    std::vector<double> row(trace.width());
+    for (std::size_t step = 0; step < scenario.steps; ++step) {
+        if (scenario.script) {
+            scenario.script(step, state);
+        }
+        state.last_dt = scenario.dt;
+        scheduler.advance(scenario.dt, state);
+        sampleTraceRow(state, rotor_count, row.data());
+        trace.append(row.data());
+    }
+    if (scenario.finish) {
+        scenario.finish(state);
+    }
+    return trace;
+}
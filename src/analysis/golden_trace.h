@@ -0,0 +1,123 @@
+/**
+ * @file golden_trace.h
+ * @brief Per-step state traces of headless scenarios, stored and diffed against golden copies
+ */
+
+#ifndef ANALYSIS_GOLDEN_TRACE_H
+#define ANALYSIS_GOLDEN_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+
+/**
+ * @class GoldenTrace
+ * @brief Fixed-width table of doubles, one row per simulation step, with chained row hashes
+ *
+ * Row k's hash is FNV-1a over the bit patterns of rows 0..k, so two traces
+ * are bitwise equal up to step k exactly when their step-k hashes match,
+ * and the first divergence is found without touching the values. The
+ * values are kept so the diverging field can be named.
+ *
+ * On disk: a small header (magic, version, width, steps, dt), the field
+ * names, then the raw rows and hashes in host byte order. Traces are only
+ * meaningful for the platform and compiler flags that recorded them.
+ */
+class GoldenTrace {
+public:
+    GoldenTrace() = default;
+    GoldenTrace(std::string scenario, std::vector<std::string> fields, double dt);
+
+    /// Append one row of width() values
+    void append(const double* row);
+
+    const std::string& scenario() const { return scenario_; }
+    const std::vector<std::string>& fields() const { return fields_; }
+    std::size_t width() const { return fields_.size(); }
+    std::size_t steps() const { return hashes_.size(); }
+    double dt() const { return dt_; }
+    double value(std::size_t step, std::size_t field) const { return values_[step * fields_.size() + field]; }
+    std::uint64_t stepHash(std::size_t step) const { return hashes_[step]; }
+    /// Hash of the whole trace (0 if empty)
+    std::uint64_t finalHash() const { return hashes_.empty() ? 0 : hashes_.back(); }
+
+    /**
+     * @brief Write the trace to a binary file
+     * @return false if the file could not be written
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Replace the trace with one read from disk
+     * @return false (trace unchanged) if the file is missing, truncated,
+     *         from another format version, or its hashes do not match its rows
+     */
+    bool load(const std::string& path);
+
+private:
+    std::string scenario_;
+    std::vector<std::string> fields_;
+    double dt_{0.0};
+    std::vector<double> values_;
+    std::vector<std::uint64_t> hashes_;
+};
+
+/**
+ * @brief Result of compareTraces(): the first diverging step and field, if any
+ */
+struct TraceDiff {
+    bool match{true};
+    std::size_t step{0};         ///< First diverging step
+    std::string field;           ///< First diverging field of that step ("layout" if the shapes differ)
+    double expected{0.0};        ///< Golden value
+    double actual{0.0};          ///< Recorded value
+
+    /// One-line human-readable report
+    std::string describe() const;
+};
+
+/**
+ * @brief Compare a recorded trace against its golden copy
+ *
+ * @param tolerance 0 for bitwise comparison; otherwise values match when
+ *        |a − b| ≤ tolerance·max(1, |a|, |b|)
+ */
+TraceDiff compareTraces(const GoldenTrace& golden, const GoldenTrace& actual, double tolerance = 0.0);
+
+/**
+ * @brief A scripted headless run
+ */
+struct TraceScenario {
+    std::string name;                                                       ///< File stem of the golden trace
+    double dt{1.0 / 60.0};                                                  ///< Frame length (s)
+    std::size_t steps{600};                                                 ///< Frames to run
+    std::function<void(ModuleScheduler&, SimulationState&)> build;          ///< Add modules and initialize them
+    std::function<void(std::size_t, SimulationState&)> script;              ///< Inputs before frame k (optional)
+    std::function<void(const SimulationState&)> finish;                     ///< Inspect the final state (optional)
+};
+
+/**
+ * @brief Field names of the standard trace layout for a vehicle with rotor_count rotors
+ *
+ * Time, plant position/velocity/attitude/rates, actual rotor speeds,
+ * controller torque and thrust commands, estimator attitude, first-order
+ * module output and the rotor-history length and latest sample.
+ */
+std::vector<std::string> traceFields(std::size_t rotor_count);
+
+/**
+ * @brief Sample the standard trace layout into row (traceFields(rotor_count).size() values)
+ */
+void sampleTraceRow(const SimulationState& state, std::size_t rotor_count, double* row);
+
+/**
+ * @brief Run a scenario from a fresh state and record the standard layout after every frame
+ */
+GoldenTrace recordTrace(const TraceScenario& scenario);
+
+#endif // ANALYSIS_GOLDEN_TRACE_H
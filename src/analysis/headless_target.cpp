@@ -0,0 +1,76 @@
+#include "analysis/headless_target.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+
+#include "modules/attitude_controller.h"
+#include "modules/first_order_dynamics.h"
+#include "modules/motor_dynamics.h"
+#include "modules/quadcopter_dynamics.h"
+
+HeadlessTarget firstOrderTarget(const SimulationState::DynamicsConfig& config) {
+    HeadlessTarget target;
+    target.name = "First-order";
+    // Eight time constants leave 0.03 % of the start-up transient.
+    target.settle_s = 8.0 * std::max(config.time_constant, 0.0);
+    target.nominal_gain = config.gain;
+    target.build = [config](ModuleScheduler& scheduler, SimulationState& state) {
+        state.dynamics_config = config;
+        state.dynamics_config.input_mode = SimulationState::DynamicsConfig::InputMode::Constant;
+        state.dynamics_config.input_target = 0.0;
+        scheduler.add(std::make_unique<FirstOrderDynamicsModule>());
+        scheduler.initialize(state);
+    };
+    target.inject = [](double input, SimulationState& state) {
+        state.dynamics_config.input_target = input;
+    };
+    target.measure = [](const SimulationState& state) {
+        return state.dynamics_state.output;
+    };
+    return target;
+}
+
+std::vector<HeadlessTarget> firstOrderGrid(const SimulationState::DynamicsConfig& base,
+                                           const std::vector<double>& time_constants,
+                                           const std::vector<double>& gains) {
+    std::vector<HeadlessTarget> targets;
+    targets.reserve(time_constants.size() * gains.size());
+    for (const double tau : time_constants) {
+        for (const double gain : gains) {
+            SimulationState::DynamicsConfig config = base;
+            config.time_constant = tau;
+            config.gain = gain;
+            targets.push_back(firstOrderTarget(config));
+            char label[64];
+            std::snprintf(label, sizeof(label), "First-order tau=%g K=%g", tau, gain);
+            targets.back().name = label;
+        }
+    }
+    return targets;
+}
+
+HeadlessTarget attitudeLoopTarget(SimulationState::Airframe airframe,
+                                  const SimulationState::ControllerConfig& controller,
+                                  int axis) {
+    HeadlessTarget target;
+    target.name = axis == 1 ? "Pitch loop" : "Roll loop";
+    target.settle_s = 2.0;
+    target.build = [airframe, controller](ModuleScheduler& scheduler, SimulationState& state) {
+        state.vehicle_config.airframe = airframe;
+        state.controller_config = controller;
+        state.controller_config.mode = SimulationState::ControllerConfig::Mode::Attitude;
+        scheduler.add(makeAttitudeControllerModule(airframe));
+        scheduler.add(makeMotorDynamicsModule(airframe));
+        scheduler.add(makeMultirotorDynamicsModule(airframe));
+        scheduler.initialize(state);
+    };
+    if (axis == 1) {
+        target.inject = [](double input, SimulationState& state) { state.controller_setpoint.pitch_rad = input; };
+        target.measure = [](const SimulationState& state) { return state.euler().pitch; };
+    } else {
+        target.inject = [](double input, SimulationState& state) { state.controller_setpoint.roll_rad = input; };
+        target.measure = [](const SimulationState& state) { return state.euler().roll; };
+    }
+    return target;
+}
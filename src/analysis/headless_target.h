@@ -0,0 +1,54 @@
+/**
+ * @file headless_target.h
+ * @brief Single-input, single-output module pipelines for headless analysis runs
+ */
+
+#ifndef ANALYSIS_HEADLESS_TARGET_H
+#define ANALYSIS_HEADLESS_TARGET_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+
+/**
+ * @brief A module pipeline with one scalar input to drive and one scalar output to measure
+ *
+ * Every run gets a fresh SimulationState and ModuleScheduler, so the
+ * callbacks must not share mutable state; the analyzers call them from
+ * several threads at once.
+ */
+struct HeadlessTarget {
+    std::string name;                                                   ///< Label for plots and reports
+    double settle_s{0.0};                                               ///< Time for the start-up transient to die away (s)
+    double nominal_gain{1.0};                                           ///< Expected steady-state output per unit input
+    std::function<void(ModuleScheduler&, SimulationState&)> build;      ///< Add modules and initialize them
+    std::function<void(double, SimulationState&)> inject;               ///< Write the input for the next step
+    std::function<double(const SimulationState&)> measure;             ///< Read the output after a step
+};
+
+/**
+ * @brief FirstOrderDynamicsModule from dynamics_config.input_target to dynamics_state.output
+ */
+HeadlessTarget firstOrderTarget(const SimulationState::DynamicsConfig& config);
+
+/**
+ * @brief First-order targets for every (time constant, gain) pair, time constant major
+ */
+std::vector<HeadlessTarget> firstOrderGrid(const SimulationState::DynamicsConfig& base,
+                                           const std::vector<double>& time_constants,
+                                           const std::vector<double>& gains);
+
+/**
+ * @brief Closed attitude loop: roll (axis 0) or pitch (axis 1) setpoint to the plant's Euler angle
+ *
+ * Cascaded attitude controller, motor lags and rigid-body plant of the given
+ * airframe, starting from the hover trim.
+ */
+HeadlessTarget attitudeLoopTarget(SimulationState::Airframe airframe,
+                                  const SimulationState::ControllerConfig& controller,
+                                  int axis);
+
+#endif // ANALYSIS_HEADLESS_TARGET_H
@@ -0,0 +1,49 @@
+/**
+ * @file parallel.h
+ * @brief Minimal worker pool for independent headless runs
+ */
+
+#ifndef ANALYSIS_PARALLEL_H
+#define ANALYSIS_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Call job(i) for every i in [0, count) on up to `threads` threads
+ *
+ * Jobs are handed out one at a time from a shared counter, so long and
+ * short runs balance themselves. The calling thread works too. Stops
+ * handing out jobs once *cancel is set; jobs already running finish.
+ *
+ * @param threads Worker count including the caller (0 = hardware concurrency)
+ */
+template <typename Job>
+void parallelFor(std::size_t count, std::size_t threads, Job&& job, const std::atomic<bool>* cancel = nullptr) {
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) {
+                return;
+            }
+            job(i);
+        }
+    };
+
+    std::size_t thread_count = threads != 0 ? threads : std::thread::hardware_concurrency();
+    thread_count = std::min(std::max<std::size_t>(thread_count, 1), std::max<std::size_t>(count, 1));
+    std::vector<std::thread> pool;
+    pool.reserve(thread_count - 1);
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+#endif // ANALYSIS_PARALLEL_H
@@ -0,0 +1,34 @@
+#include "analysis/scenario_runner.h"
+
+#include <memory>
+
+#include "modules/rig_pipeline.h"
+
+TraceScenario scriptedTrace(const std::string& name, const ScenarioScript& script, const RigConfig& config,
+                            const std::string& sitl_link) {
+    TraceScenario scenario;
+    scenario.name = name;
+    scenario.dt = script.frameDt();
+    scenario.steps = script.frames();
+    // The lambda owns the link name for as long as the scenario (and its runs) live.
+    scenario.build = [script, config, sitl_link](ModuleScheduler& scheduler, SimulationState& state) {
+        config.apply(state);
+        state.sitl_config.link_name = sitl_link.c_str();
+        scheduler.add(std::make_unique<ScenarioPlayerModule>(script));
+        addRigModules(scheduler, config.airframe());
+        scheduler.initialize(state);
+    };
+    return scenario;
+}
+
+ScenarioOutcome runScenario(const std::string& name, const ScenarioScript& script, const RigConfig& config,
+                            const std::string& sitl_link) {
+    ScenarioOutcome outcome;
+    TraceScenario scenario = scriptedTrace(name, script, config, sitl_link);
+    scenario.finish = [&outcome](const SimulationState& state) {
+        outcome.status = state.scenario_status;
+        outcome.final_state = state.snapshot();
+    };
+    outcome.trace = recordTrace(scenario);
+    return outcome;
+}
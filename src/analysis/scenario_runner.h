@@ -0,0 +1,49 @@
+/**
+ * @file scenario_runner.h
+ * @brief Headless playback of scenario scripts through the rig pipeline
+ */
+
+#ifndef ANALYSIS_SCENARIO_RUNNER_H
+#define ANALYSIS_SCENARIO_RUNNER_H
+
+#include <string>
+
+#include "analysis/golden_trace.h"
+#include "config/rig_config.h"
+#include "core/simulation_state.h"
+#include "modules/scenario_player.h"
+
+/// SITL segment of headless runs (the GUI uses SitlConfig's default)
+constexpr const char* kHeadlessSitlLink = "/aerodyn_sitl_headless";
+
+/**
+ * @brief A golden-trace scenario that plays a script
+ *
+ * A fresh state, configured by config, runs the same pipeline as the GUI
+ * (a ScenarioPlayerModule, then addRigModules()) for script.frames()
+ * frames of script.frameDt(), so the trace matches a GUI session of the
+ * same script and configuration frame for frame.
+ * The SITL bridge gets its own segment name so a headless run never takes
+ * over the link of a running GUI.
+ */
+TraceScenario scriptedTrace(const std::string& name, const ScenarioScript& script,
+                            const RigConfig& config = RigConfig{},
+                            const std::string& sitl_link = kHeadlessSitlLink);
+
+/**
+ * @brief Result of runScenario()
+ */
+struct ScenarioOutcome {
+    GoldenTrace trace;                              ///< Standard layout, one row per frame
+    SimulationState::ScenarioStatus status;         ///< Assertion results at the end of the run
+    SimulationHotState final_state;
+};
+
+/**
+ * @brief Play a script headless and collect its trace and assertion results
+ */
+ScenarioOutcome runScenario(const std::string& name, const ScenarioScript& script,
+                            const RigConfig& config = RigConfig{},
+                            const std::string& sitl_link = kHeadlessSitlLink);
+
+#endif // ANALYSIS_SCENARIO_RUNNER_H
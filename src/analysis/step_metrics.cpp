@@ -0,0 +1,125 @@
+#include "analysis/step_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "analysis/parallel.h"
+
+namespace {
+
+/// Time at which a linear segment from (t0, v0) to (t1, v1) reaches level
+double crossingTime(double t0, double v0, double t1, double v1, double level) {
+    if (v1 == v0) {
+        return t1;
+    }
+    return t0 + (t1 - t0) * std::clamp((level - v0) / (v1 - v0), 0.0, 1.0);
+}
+
+}  // namespace
+
+void StepMetricsAccumulator::reset(double start_time, double initial_output, double final_target, double band) {
+    metrics_ = StepMetrics{};
+    start_time_ = start_time;
+    initial_output_ = initial_output;
+    final_target_ = final_target;
+    step_ = final_target - initial_output;
+    band_ = std::abs(band * step_);
+    previous_t_ = start_time;
+    previous_output_ = initial_output;
+    previous_abs_error_ = 0.0;
+    peak_ = 0.0;
+    t10_ = StepMetrics::kUnset;
+    inside_band_ = step_ == 0.0;
+}
+
+void StepMetricsAccumulator::add(double t, double reference, double output) {
+    const double abs_error = std::abs(reference - output);
+    if (metrics_.samples == 0) {
+        // The first interval starts from the initial output against the current reference.
+        previous_abs_error_ = std::abs(reference - initial_output_);
+    }
+
+    const double h = t - previous_t_;
+    const double tau0 = previous_t_ - start_time_;
+    const double tau1 = t - start_time_;
+    metrics_.iae += 0.5 * h * (previous_abs_error_ + abs_error);
+    metrics_.itae += 0.5 * h * (tau0 * previous_abs_error_ + tau1 * abs_error);
+    metrics_.max_abs_error = std::max(metrics_.max_abs_error, abs_error);
+    metrics_.steady_state_error = reference - output;
+    ++metrics_.samples;
+
+    if (step_ != 0.0) {
+        // Progress along the step: 0 at the initial output, 1 at the target.
+        const double p0 = (previous_output_ - initial_output_) / step_;
+        const double p1 = (output - initial_output_) / step_;
+        if (std::isnan(t10_) && p1 >= 0.1) {
+            t10_ = crossingTime(tau0, p0, tau1, p1, 0.1);
+        }
+        if (std::isnan(metrics_.rise_time_s) && !std::isnan(t10_) && p1 >= 0.9) {
+            metrics_.rise_time_s = crossingTime(tau0, p0, tau1, p1, 0.9) - t10_;
+        }
+
+        const double excursion = 100.0 * (p1 - 1.0);
+        if (excursion > peak_) {
+            peak_ = excursion;
+            metrics_.overshoot_pct = excursion;
+            metrics_.peak_time_s = tau1;
+        }
+
+        const double distance0 = std::abs(previous_output_ - final_target_);
+        const double distance1 = std::abs(output - final_target_);
+        const bool inside = distance1 <= band_;
+        if (inside && !inside_band_) {
+            metrics_.settling_time_s = crossingTime(tau0, distance0, tau1, distance1, band_);
+        } else if (!inside) {
+            metrics_.settling_time_s = StepMetrics::kUnset;
+        }
+        inside_band_ = inside;
+    }
+
+    previous_t_ = t;
+    previous_output_ = output;
+    previous_abs_error_ = abs_error;
+}
+
+StepMetrics runStepTest(const HeadlessTarget& target, const StepTestSettings& settings) {
+    SimulationState state;
+    ModuleScheduler scheduler;
+    target.build(scheduler, state);
+
+    const bool ramp = settings.kind == StepTestSettings::Kind::Ramp;
+    const double dt = settings.dt > 0.0 ? settings.dt : 0.001;
+    const std::size_t steps = static_cast<std::size_t>(std::ceil(settings.duration_s / dt));
+    const double initial_output = target.measure(state);
+    const double final_target = ramp ? initial_output : target.nominal_gain * settings.amplitude;
+
+    StepMetricsAccumulator accumulator;
+    accumulator.reset(0.0, initial_output, final_target, settings.band);
+    for (std::size_t n = 0; n < steps; ++n) {
+        const double t = static_cast<double>(n + 1) * dt;
+        // A ramp input is held at its value mid-step, like the sampled reference it stands for.
+        const double input = ramp ? settings.amplitude * (t - 0.5 * dt) : settings.amplitude;
+        target.inject(input, state);
+        scheduler.advance(dt, state);
+        const double reference = ramp ? target.nominal_gain * settings.amplitude * t : final_target;
+        accumulator.add(t, reference, target.measure(state));
+    }
+    return accumulator.metrics();
+}
+
+std::vector<StepMetrics> runStepTests(const std::vector<HeadlessTarget>& targets,
+                                      const StepTestSettings& settings,
+                                      std::atomic<std::size_t>* completed,
+                                      const std::atomic<bool>* cancel) {
+    std::vector<StepMetrics> results(targets.size());
+    parallelFor(targets.size(), settings.threads, [&](std::size_t i) {
+        results[i] = runStepTest(targets[i], settings);
+        if (completed) {
+            completed->fetch_add(1, std::memory_order_relaxed);
+        }
+    }, cancel);
+    if (cancel && cancel->load()) {
+        return {};
+    }
+    return results;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file step_metrics.h
+ * @brief Streaming step/ramp response metrics and parallel batch tests
+ */
+
+#ifndef ANALYSIS_STEP_METRICS_H
+#define ANALYSIS_STEP_METRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "analysis/headless_target.h"
+
+/**
+ * @brief Classical response figures of one test
+ *
+ * Rise time, settling time and overshoot are taken relative to the step
+ * from the initial output to the final target; they are NaN (overshoot 0)
+ * for ramps and for figures the run was too short to reach.
+ */
+struct StepMetrics {
+    static constexpr double kUnset = std::numeric_limits<double>::quiet_NaN();
+
+    double rise_time_s{kUnset};        ///< 10 % → 90 % of the step
+    double settling_time_s{kUnset};    ///< Last entry into the ±band around the target (NaN if outside at the end)
+    double overshoot_pct{0.0};         ///< Peak excursion beyond the target, % of the step
+    double peak_time_s{kUnset};        ///< Time of that peak
+    double steady_state_error{0.0};    ///< Reference − output at the last sample
+    double max_abs_error{0.0};         ///< Largest |reference − output|
+    double iae{0.0};                   ///< ∫|e| dt
+    double itae{0.0};                  ///< ∫t·|e| dt
+    std::size_t samples{0};            ///< Samples accumulated
+};
+
+/**
+ * @class StepMetricsAccumulator
+ * @brief Updates StepMetrics sample by sample, O(1) memory
+ *
+ * No trace is stored: threshold crossings are interpolated between the
+ * previous and current sample, the settling time is the re-entry after
+ * the latest excursion outside the band, and the error integrals use the
+ * trapezoid rule. Suitable both for headless batch runs and for the live
+ * simulation (one add() per frame).
+ */
+class StepMetricsAccumulator {
+public:
+    /**
+     * @brief Start a new test
+     *
+     * @param start_time Time the input changed (s)
+     * @param initial_output Output at start_time
+     * @param final_target Output the response should settle at; equal to
+     *        initial_output for tests without a step (ramps)
+     * @param band Settling band as a fraction of the step (0.02 = 2 %)
+     */
+    void reset(double start_time, double initial_output, double final_target, double band = 0.02);
+
+    /**
+     * @brief Accumulate one sample
+     *
+     * @param t Sample time (s), non-decreasing
+     * @param reference Output the system should have at t (the final target for steps)
+     * @param output Measured output at t
+     */
+    void add(double t, double reference, double output);
+
+    const StepMetrics& metrics() const { return metrics_; }
+    double startTime() const { return start_time_; }
+    double finalTarget() const { return final_target_; }
+
+private:
+    StepMetrics metrics_;
+    double start_time_{0.0};
+    double initial_output_{0.0};
+    double final_target_{0.0};
+    double step_{0.0};              ///< final_target − initial_output
+    double band_{0.0};              ///< Absolute settling band
+    double previous_t_{0.0};
+    double previous_output_{0.0};
+    double previous_abs_error_{0.0};
+    double peak_{0.0};              ///< Largest excursion past the target (% of the step)
+    double t10_{StepMetrics::kUnset};  ///< Time the output crossed 10 % of the step
+    bool inside_band_{false};       ///< Previous sample was within the band
+};
+
+/**
+ * @brief Batch test settings
+ */
+struct StepTestSettings {
+    enum class Kind {
+        Step,  ///< Input jumps to amplitude at t = 0
+        Ramp   ///< Input rises at amplitude per second
+    };
+    Kind kind{Kind::Step};
+    double amplitude{1.0};        ///< Step height or ramp slope (input units)
+    double duration_s{10.0};      ///< Test length (s)
+    double dt{0.001};             ///< Simulation step (s)
+    double band{0.02};            ///< Settling band, fraction of the step
+    std::size_t threads{0};       ///< Worker threads (0 = hardware concurrency)
+};
+
+/**
+ * @brief Run one step or ramp test on a fresh instance of target
+ *
+ * The reference output is nominal_gain times the input, so steady-state
+ * error and the error integrals are measured against the response the
+ * target is expected to reach.
+ */
+StepMetrics runStepTest(const HeadlessTarget& target, const StepTestSettings& settings);
+
+/**
+ * @brief runStepTest() for every target, spread over a worker pool
+ *
+ * @param completed Incremented as tests finish (optional)
+ * @param cancel Checked between tests; a cancelled batch returns an empty vector
+ * @return One entry per target, in order
+ */
+std::vector<StepMetrics> runStepTests(const std::vector<HeadlessTarget>& targets,
+                                      const StepTestSettings& settings,
+                                      std::atomic<std::size_t>* completed = nullptr,
+                                      const std::atomic<bool>* cancel = nullptr);
+
+#endif // ANALYSIS_STEP_METRICS_H
@@ -1,11 +1,10 @@
 #include "application.h"
 #include "render/renderer.h"
-#include "modules/quaternion_demo.h"
-#include "modules/quadcopter_dynamics.h"
-#include "modules/first_order_dynamics.h"
-#include "modules/sensor_simulator.h"
-#include "modules/complementary_estimator.h"
-#include "modules/rotor_telemetry.h"
+#include "core/attitude_history.h"
+#include "core/frame_arena.h"
+#include "core/memory_accounting.h"
+#include "modules/rig_pipeline.h"
+#include "modules/scenario_player.h"
 #include "gui/panel_manager.h"
 #include "gui/widgets/card.h"
 #include "gui/style.h"
@@ -17,6 +16,8 @@
 #include "gui/panels/power_panel.h"
 #include "gui/panels/sensor_panel.h"
 #include "gui/panels/rotor_analysis_panel.h"
+#include "gui/panels/bode_panel.h"
+#include "gui/panels/memory_panel.h"
 #include "attitude/euler.h"
 #include "attitude/dcm.h"
 #include "attitude/quaternion.h"
@@ -24,9 +25,11 @@
 #include <iostream>
 #include <algorithm>
 #include <string>
+#include <cstddef>
 #include <cstdio>
 #include <cstdint>
 #include <cmath>
+#include <cstdlib>
 #include <limits>
 
 #ifndef M_PI
@@ -42,8 +45,134 @@
 namespace {
 constexpr float kTopNavHeight = 64.0f;
 constexpr float kDockspaceMargin = 24.0f;
+constexpr std::size_t kDefaultHistoryCapBytes = 64u << 20;   ///< Decimated: the plotted window is kept
+constexpr std::size_t kDefaultPlotCapBytes = 16u << 20;      ///< Evicted: panel plots shorten
+constexpr double kMaxFrameIntervalS = 1.0 / 30.0;   ///< Slower frames lose simulated time
 
-void DrawTopNavigation() {
+/**
+ * @brief Real-time status pill: measured factor, coloured by whether the loop keeps up
+ *
+ * Green while every update meets its deadline and the factor is within 5 %
+ * of the target, amber when only the factor lags, red when the last window
+ * had deadline misses. The tooltip carries the counts behind the colour.
+ */
+void DrawRealtimePill(const SimulationState& state) {
+    const ui::Palette& palette = ui::Colors();
+    const auto& realtime = state.realtime;
+    const bool lagging = realtime.target_factor > 0.0 && realtime.factor < 0.95 * realtime.target_factor;
+    const ImVec4& status = realtime.window_misses > 0 ? palette.danger
+                         : lagging                    ? palette.warning
+                                                      : palette.success;
+
+    char label[48];
+    std::snprintf(label, sizeof(label), "RTF %.2fx###realtime_pill", realtime.factor);
+    ui::PushPillButtonStyle(ui::PillStyle::Secondary);
+    ImGui::PushStyleColor(ImGuiCol_Text, status);
+    ImGui::Button(label);
+    ImGui::PopStyleColor();
+    ui::PopPillButtonStyle();
+
+    if (ImGui::IsItemHovered()) {
+        ImGui::BeginTooltip();
+        ImGui::Text("Real-time factor %.3f (target %.2f, last tick %.3f)", realtime.factor,
+                    realtime.target_factor, realtime.tick_factor);
+        ImGui::Text("Deadline misses: %llu in the last %.1f s, %llu total",
+                    static_cast<unsigned long long>(realtime.window_misses),
+                    SimulationState::Realtime::kWindowS,
+                    static_cast<unsigned long long>(realtime.deadline_misses));
+        ImGui::Text("Worst lateness: %.1f us", realtime.worst_lateness_us);
+        ImGui::Text("Dropped by the frame cap: %.3f s", realtime.dropped_s);
+        ImGui::EndTooltip();
+    }
+}
+
+/**
+ * @brief Start UDP telemetry streaming if the environment asks for it
+ *
+ * AERODYN_TELEMETRY_UDP=host:port enables it; the optional
+ * AERODYN_TELEMETRY_UDP_CHANNELS=name[@hz],... picks channels and rate
+ * limits (default: every channel, every sample).
+ */
+bool StartUdpStreaming(UdpTelemetryStreamer& streamer) {
+    const char* target = std::getenv("AERODYN_TELEMETRY_UDP");
+    if (!target || !*target) {
+        return false;
+    }
+    const std::string endpoint(target);
+    const std::size_t colon = endpoint.rfind(':');
+    const long port = colon == std::string::npos ? 0 : std::strtol(endpoint.c_str() + colon + 1, nullptr, 10);
+    if (port <= 0 || port > 65535) {
+        std::cerr << "AERODYN_TELEMETRY_UDP must be host:port, got " << endpoint << std::endl;
+        return false;
+    }
+    if (const char* list = std::getenv("AERODYN_TELEMETRY_UDP_CHANNELS")) {
+        const std::string channels(list);
+        std::size_t begin = 0;
+        while (begin < channels.size()) {
+            const std::size_t end = std::min(channels.find(',', begin), channels.size());
+            const std::string entry = channels.substr(begin, end - begin);
+            const std::size_t at = entry.find('@');
+            if (!entry.empty()) {
+                streamer.select(entry.substr(0, at).c_str(),
+                                at == std::string::npos ? 0.0 : std::strtod(entry.c_str() + at + 1, nullptr));
+            }
+            begin = end + 1;
+        }
+    }
+    if (!streamer.start(endpoint.substr(0, colon).c_str(), static_cast<std::uint16_t>(port))) {
+        std::cerr << "UDP telemetry disabled: " << streamer.error() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Load the scenario named by AERODYN_SCENARIO, if any
+ *
+ * A scenario drives the setpoints instead of the keyboard and runs at its
+ * own fixed frame length, so the session matches a headless run of the
+ * same script (analysis/scenario_runner.h) frame for frame.
+ */
+bool LoadScenario(ScenarioScript& script, SimulationState& state) {
+    const char* path = std::getenv("AERODYN_SCENARIO");
+    if (!path || !*path) {
+        return false;
+    }
+    if (!script.load(path)) {
+        std::cerr << "Scenario disabled: " << script.error() << std::endl;
+        return false;
+    }
+    state.control.use_fixed_dt = true;
+    state.control.fixed_dt = script.frameDt();
+    std::cout << "Scenario " << path << ": " << script.events().size() << " events over "
+              << script.duration() << " s at dt " << script.frameDt() << " s" << std::endl;
+    return true;
+}
+
+/**
+ * @brief Load the vehicle configuration named by AERODYN_CONFIG, if any, and watch it
+ *
+ * Runs before the modules are built, so the plant and controllers start
+ * from the file's values; saving the file later reloads it in flight.
+ */
+void LoadRigConfig(RigConfig& config, ConfigWatcher& watcher, SimulationState& state) {
+    const char* path = std::getenv("AERODYN_CONFIG");
+    if (!path || !*path) {
+        return;
+    }
+    if (!config.load(path)) {
+        std::cerr << "Vehicle configuration ignored: " << config.error() << std::endl;
+        return;
+    }
+    config.apply(state);
+    if (!watcher.watch(path)) {
+        std::cerr << "Configuration hot reload disabled: " << watcher.error() << std::endl;
+    }
+    std::cout << "Vehicle configuration " << path << ": " << config.rotorCount() << " rotors, "
+              << config.vehicle().mass << " kg" << std::endl;
+}
+
+void DrawTopNavigation(const SimulationState& state) {
     ImGuiViewport* viewport = ImGui::GetMainViewport();
     const ImVec2 nav_pos = viewport->Pos;
     const ImVec2 nav_size = ImVec2(viewport->Size.x, kTopNavHeight);
@@ -81,7 +210,7 @@ void DrawTopNavigation() {
         ImGui::PopStyleColor();
         ImGui::EndGroup();
 
-        float nav_right_width = 420.0f;
+        float nav_right_width = 540.0f;
         float available = ImGui::GetContentRegionAvail().x;
         if (available > nav_right_width) {
             ImGui::Dummy(ImVec2(available - nav_right_width, 0.0f));
@@ -98,6 +227,9 @@ void DrawTopNavigation() {
         ImGui::PopStyleColor();
 
         ImGui::SameLine(0.0f, 28.0f);
+        DrawRealtimePill(state);
+
+        ImGui::SameLine(0.0f, 12.0f);
         ui::PushPillButtonStyle(ui::PillStyle::Primary);
         ImGui::Button("Connected");
         ui::PopPillButtonStyle();
@@ -205,11 +337,9 @@ Application::~Application() {
  *
  * Step 8: initializeModules()
  *    │
- *    ├─► Creates QuaternionDemoModule
- *    ├─► Creates SensorSimulatorModule
- *    ├─► Creates ComplementaryEstimatorModule
- *    ├─► Creates FirstOrderDynamicsModule
- *    ├─► Creates RotorTelemetryModule
+ *    ├─► Creates ScenarioPlayerModule first if AERODYN_SCENARIO names a script
+ *    ├─► Creates the rig pipeline (addRigModules): controllers and motor lag
+ *    │   before the plant, then sensors, estimator and rotor telemetry
  *    └─► Calls initialize() on each module
  *
  * Step 9: initializePanels()
@@ -341,6 +471,19 @@ bool Application::init() {
     // Step 10: Initialize application modules and GUI panels
     // These are custom components that encapsulate specific application logic
     // (e.g., physics simulation, sensor data) and their corresponding UI panels.
+    MemoryAccounting::setCap(MemoryTag::History, kDefaultHistoryCapBytes, MemoryAccounting::Policy::Decimate);
+    MemoryAccounting::setCap(MemoryTag::Plot, kDefaultPlotCapBytes, MemoryAccounting::Policy::Evict);
+    // External tools read telemetry from shared memory; the rig runs fine without it.
+    if (telemetryPublisher.open(shm_telemetry::kDefaultName)) {
+        simulationState.telemetry.addSink(&telemetryPublisher);
+    } else {
+        std::cerr << "Shared-memory telemetry disabled: " << telemetryPublisher.error() << std::endl;
+    }
+    if (StartUdpStreaming(telemetryStreamer)) {
+        simulationState.telemetry.addSink(&telemetryStreamer);
+    }
+    LoadRigConfig(rigConfig, configWatcher, simulationState);
+    scenarioLoaded = LoadScenario(scenario, simulationState);
     initializeModules();
     initializePanels();
     lastFrame = glfwGetTime(); // Record the time for delta time calculations
@@ -361,40 +504,128 @@ bool Application::running() const {
 }
 
 void Application::initializeModules() {
-    // Use QuadcopterDynamicsModule for physics-based simulation
-    modules.emplace_back(std::make_unique<QuadcopterDynamicsModule>());
-    // Keep QuaternionDemoModule commented out (replaced by QuadcopterDynamicsModule)
-    // modules.emplace_back(std::make_unique<QuaternionDemoModule>());
-    modules.emplace_back(std::make_unique<FirstOrderDynamicsModule>());
-    modules.emplace_back(std::make_unique<SensorSimulatorModule>());
-    modules.emplace_back(std::make_unique<ComplementaryEstimatorModule>());
-    modules.emplace_back(std::make_unique<RotorTelemetryModule>());
-    for (auto& module : modules) {
-        module->initialize(simulationState);
+    // Physics-based plant, instantiated for the configured airframe (quad X by default)
+    const SimulationState::Airframe airframe = simulationState.vehicle_config.airframe;
+    // A scenario applies its events before anything else runs in a step
+    if (scenarioLoaded) {
+        modules.add(std::make_unique<ScenarioPlayerModule>(scenario));
     }
-    transform.model = simulationState.model_matrix;
+    // Same pipeline as headless runs: controllers, SITL bridge, motor lag,
+    // plant, first-order system, sensors, estimator, rotor telemetry
+    addRigModules(modules, airframe);
+    modules.initialize(simulationState);
+    timeline.reset(modules, simulationState, RewindTimeline::Settings{});
+    transform.model = simulationState.modelMatrix();
 }
 
 
 
+void Application::reloadRigConfig() {
+    RigConfig next;
+    if (!next.load(configWatcher.path())) {
+        std::cerr << "Configuration reload rejected, keeping the running one: " << next.error() << std::endl;
+        return;
+    }
+    if (next.airframe() != simulationState.vehicle_config.airframe) {
+        std::cerr << "Configuration reload rejected: changing the airframe needs a restart" << std::endl;
+        return;
+    }
+    const unsigned changed = next.apply(simulationState);
+    const std::size_t reconfigured = modules.reconfigure(changed, simulationState);
+    rigConfig = next;
+    std::cout << "Configuration reloaded: " << reconfigured << " module(s) reconfigured" << std::endl;
+}
+
 void Application::tick() {
     float currentFrame = glfwGetTime();
     double real_dt = static_cast<double>(currentFrame - lastFrame);
     lastFrame = currentFrame;
 
     updateCamera(static_cast<float>(real_dt));
+    if (configWatcher.poll()) {
+        reloadRigConfig();
+    }
 
     // === ROTATION MODE TOGGLE ===
     // Two modes: Manual (discrete steps) vs Automatic (continuous angular rates)
     // Toggle with 'M' key, controlled in keyCallback
 
-    if (!simulationState.control.manual_rotation_mode) {
-        // AUTOMATIC MODE: Continuous angular rate control (like flying a drone)
-        glm::dvec3& body_rates = simulationState.angular_rate_deg_per_sec;
+    using ControllerMode = SimulationState::ControllerConfig::Mode;
+    const ControllerMode controller_mode = simulationState.controller_config.mode;
+    auto& setpoint = simulationState.controller_setpoint;
+
+    const bool attitude_setpoint = controller_mode == ControllerMode::Attitude ||
+                                   controller_mode == ControllerMode::Mpc;
+    if (simulationState.scenario_status.active) {
+        // The scenario owns the setpoints; keys would make the run irreproducible
+    } else if (!simulationState.control.manual_rotation_mode && attitude_setpoint) {
+        // AUTOMATIC MODE, attitude or MPC controller: keys tilt the attitude setpoint
+        const double kSetpointRateRadPerSec = deg2rad(90.0);
+        const double kMaxTiltRad = deg2rad(35.0);
+        auto steer = [&](int key, double& angle, double direction) {
+            if (glfwGetKey(window, key) == GLFW_PRESS) {
+                angle += direction * kSetpointRateRadPerSec * real_dt;
+            }
+        };
+        steer(GLFW_KEY_Q, setpoint.roll_rad, 1.0);
+        steer(GLFW_KEY_E, setpoint.roll_rad, -1.0);
+        steer(GLFW_KEY_UP, setpoint.pitch_rad, 1.0);
+        steer(GLFW_KEY_DOWN, setpoint.pitch_rad, -1.0);
+        steer(GLFW_KEY_I, setpoint.pitch_rad, 1.0);
+        steer(GLFW_KEY_K, setpoint.pitch_rad, -1.0);
+        steer(GLFW_KEY_LEFT, setpoint.yaw_rad, 1.0);
+        steer(GLFW_KEY_RIGHT, setpoint.yaw_rad, -1.0);
+        steer(GLFW_KEY_J, setpoint.yaw_rad, 1.0);
+        steer(GLFW_KEY_L, setpoint.yaw_rad, -1.0);
+        setpoint.roll_rad = std::clamp(setpoint.roll_rad, -kMaxTiltRad, kMaxTiltRad);
+        setpoint.pitch_rad = std::clamp(setpoint.pitch_rad, -kMaxTiltRad, kMaxTiltRad);
+
+        if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS) {
+            setpoint.roll_rad = 0.0;   // Level out, keep heading
+            setpoint.pitch_rad = 0.0;
+        }
+    } else if (!simulationState.control.manual_rotation_mode && controller_mode == ControllerMode::Lqr) {
+        // AUTOMATIC MODE, LQR: keys move the position setpoint in the heading
+        // frame and set the pirouette (yaw) rate
+        const double kSetpointSpeedMps = 1.0;
+        const double kYawRateStepRadPerSec = deg2rad(60.0);
+        const double c = std::cos(setpoint.yaw_rad);
+        const double s = std::sin(setpoint.yaw_rad);
+        auto move = [&](int key, double forward, double right) {
+            if (glfwGetKey(window, key) == GLFW_PRESS) {
+                const double step = kSetpointSpeedMps * real_dt;
+                setpoint.position_ned.x += step * (c * forward - s * right);
+                setpoint.position_ned.y += step * (s * forward + c * right);
+            }
+        };
+        move(GLFW_KEY_UP, 1.0, 0.0);
+        move(GLFW_KEY_DOWN, -1.0, 0.0);
+        move(GLFW_KEY_I, 1.0, 0.0);
+        move(GLFW_KEY_K, -1.0, 0.0);
+        move(GLFW_KEY_E, 0.0, 1.0);
+        move(GLFW_KEY_Q, 0.0, -1.0);
+        double yaw_rate = 0.0;
+        if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_J) == GLFW_PRESS) {
+            yaw_rate -= kYawRateStepRadPerSec;
+        }
+        if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS) {
+            yaw_rate += kYawRateStepRadPerSec;
+        }
+        setpoint.rate_rad_s = glm::dvec3(0.0, 0.0, yaw_rate);
+
+        if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS) {
+            setpoint.position_ned = simulationState.physics.position;   // Hold here
+        }
+    } else if (!simulationState.control.manual_rotation_mode) {
+        // AUTOMATIC MODE: Continuous angular rate control (like flying a drone);
+        // with the rate controller active the keys drive its setpoint instead
+        glm::dvec3& body_rates = controller_mode == ControllerMode::Rate
+                                     ? setpoint.rate_rad_s
+                                     : simulationState.angular_rate_rad_s;
         auto adjust_rotation = [&](int key, int axis, double direction) {
             if (glfwGetKey(window, key) == GLFW_PRESS) {
-                const double kRotationAccelDegPerSec2 = 180.0;
-                body_rates[axis] += direction * kRotationAccelDegPerSec2 * real_dt;
+                const double kRotationAccelRadPerSec2 = deg2rad(180.0);
+                body_rates[axis] += direction * kRotationAccelRadPerSec2 * real_dt;
             }
         };
 
@@ -417,34 +648,60 @@ void Application::tick() {
         if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS) {
             body_rates = glm::dvec3(0.0f);
         }
-    } else {
+    } else if (controller_mode == ControllerMode::Off) {
         // MANUAL MODE: Keep angular rates at zero (rotation via W/A/S/D/Q/E in keyCallback)
-        simulationState.angular_rate_deg_per_sec = glm::dvec3(0.0);
+        simulationState.angular_rate_rad_s = glm::dvec3(0.0);
     }
 
     if (!simulationState.control.paused) {
+        // Deadlines assume real time in fixed-dt mode, the chosen speed otherwise
+        simulationState.realtime.wall_interval_s = real_dt;
+        simulationState.realtime.target_factor = simulationState.control.use_fixed_dt
+                                                     ? 1.0
+                                                     : simulationState.control.time_scale;
+        simulationState.realtime.max_tick_s = kMaxFrameIntervalS * simulationState.control.time_scale;
+
+        // A variable tick follows the wall clock only up to the frame cap, so
+        // slow frames (rendering included) show as a real-time factor below target
         double dt = simulationState.control.use_fixed_dt
                         ? simulationState.control.fixed_dt
-                        : real_dt * simulationState.control.time_scale;
-
-        simulationState.last_dt = dt;
-        simulationState.time_seconds += dt;  // Increment simulation time
-
-        if (dt > 0.0) {
-            for (auto& module : modules) {
-                module->update(dt, simulationState);
-            }
+                        : ModuleScheduler::capTick(real_dt * simulationState.control.time_scale, simulationState);
+
+        if (!timeline.atEnd()) {
+            // Rewound: play the recording back until it catches up with live
+            const double speed = simulationState.attitude_history_video.playback_speed;
+            timeline.seek(simulationState.time_seconds + real_dt * speed, modules, simulationState);
+        } else if (dt > 0.0) {
+            // Advances time_seconds, splitting the frame at fixed-rate module
+            // deadlines, and records the tick for rewinding
+            timeline.step(dt, modules, simulationState);
+        } else {
+            simulationState.last_dt = 0.0;
         }
     } else {
         simulationState.last_dt = 0.0;
     }
 
+    const auto& scenario_status = simulationState.scenario_status;
+    if (scenario_status.active && !scenarioReported && scenario_status.dispatched == scenario_status.events) {
+        scenarioReported = true;
+        std::cout << "Scenario complete: " << scenario_status.assertions_passed << " assertion(s) passed, "
+                  << scenario_status.assertions_failed << " failed" << std::endl;
+        if (!scenario_status.first_failure.empty()) {
+            std::cout << "  first failure: " << scenario_status.first_failure << std::endl;
+        }
+    }
+
     captureAttitudeHistorySample();
-    transform.model = simulationState.model_matrix;
+    transform.model = simulationState.modelMatrix();
     render3D();
 }
 
 void Application::shutdown() {
+    simulationState.telemetry.removeSink(&telemetryPublisher);
+    telemetryPublisher.close();
+    simulationState.telemetry.removeSink(&telemetryStreamer);
+    telemetryStreamer.stop();
     destroyRenderTarget();
 
     // Cleanup Dear ImGui
@@ -484,7 +741,7 @@ void Application::keyCallback(GLFWwindow* window, int key, int scancode, int act
                   << std::endl;
         // Reset angular rates when switching to manual mode
         if (app->simulationState.control.manual_rotation_mode) {
-            app->simulationState.angular_rate_deg_per_sec = glm::dvec3(0.0);
+            app->simulationState.angular_rate_rad_s = glm::dvec3(0.0);
         }
         return;
     }
@@ -494,25 +751,26 @@ void Application::keyCallback(GLFWwindow* window, int key, int scancode, int act
     if (!app->simulationState.control.manual_rotation_mode) {
         return;  // Automatic mode: use arrow keys/Q/E/I/K/J/L in tick() instead
     }
+    if (app->simulationState.scenario_status.active) {
+        return;  // A scenario is steering
+    }
     if (action == GLFW_PRESS || action == GLFW_REPEAT) {
         // Check if Shift is held for fine control (1 degree vs 5 degrees)
         bool shift_held = (mods & GLFW_MOD_SHIFT) != 0;
         const double rotation_deg = shift_held ? 1.0 : 5.0;  // 1° with Shift, 5° default
 
-        // Convert current quaternion to Euler angles
-        double roll, pitch, yaw;
-        double q[4] = {
-            app->simulationState.quaternion[0],  // w
-            app->simulationState.quaternion[1],  // x
-            app->simulationState.quaternion[2],  // y
-            app->simulationState.quaternion[3]   // z
-        };
-        quaternion_to_euler(q, &roll, &pitch, &yaw);
+        // With an attitude-tracking controller active the keys step its
+        // setpoint; otherwise they rotate the vehicle directly.
+        auto& setpoint = app->simulationState.controller_setpoint;
+        using ControllerMode = SimulationState::ControllerConfig::Mode;
+        const ControllerMode mode = app->simulationState.controller_config.mode;
+        const bool steer_setpoint = mode == ControllerMode::Attitude || mode == ControllerMode::Mpc;
 
-        // Convert to degrees for easier manipulation
-        roll = rad2deg(roll);
-        pitch = rad2deg(pitch);
-        yaw = rad2deg(yaw);
+        // Current attitude as Euler angles (shared lazy view), in degrees for easier manipulation
+        const EulerAngles& current = app->simulationState.euler();
+        double roll = rad2deg(steer_setpoint ? setpoint.roll_rad : current.roll);
+        double pitch = rad2deg(steer_setpoint ? setpoint.pitch_rad : current.pitch);
+        double yaw = rad2deg(steer_setpoint ? setpoint.yaw_rad : current.yaw);
 
         // Apply rotation based on key
         if (key == GLFW_KEY_W || key == GLFW_KEY_I || key == GLFW_KEY_UP) {
@@ -539,16 +797,30 @@ void Application::keyCallback(GLFWwindow* window, int key, int scancode, int act
             // Yaw right
             yaw -= rotation_deg;
         }
+        else if (key == GLFW_KEY_R && steer_setpoint) {
+            // Level setpoint, heading north
+            setpoint.roll_rad = 0.0;
+            setpoint.pitch_rad = 0.0;
+            setpoint.yaw_rad = 0.0;
+            return;
+        }
         else if (key == GLFW_KEY_R) {
             // Reset to identity quaternion (no rotation)
-            app->simulationState.quaternion = {1.0, 0.0, 0.0, 0.0};
-            app->simulationState.angular_rate_deg_per_sec = glm::dvec3(0.0, 0.0, 0.0);
+            app->simulationState.setAttitude({1.0, 0.0, 0.0, 0.0});
+            app->simulationState.angular_rate_rad_s = glm::dvec3(0.0, 0.0, 0.0);
             return;
         }
         else {
             return;  // No rotation key pressed
         }
 
+        if (steer_setpoint) {
+            setpoint.roll_rad = deg2rad(roll);
+            setpoint.pitch_rad = deg2rad(pitch);
+            setpoint.yaw_rad = deg2rad(yaw);
+            return;
+        }
+
         // Convert back to radians and then to quaternion
         EulerAngles euler_angles;
         euler_angles.roll = deg2rad(roll);
@@ -560,7 +832,7 @@ void Application::keyCallback(GLFWwindow* window, int key, int scancode, int act
         euler_to_quaternion(&euler_angles, q_new);
 
         // Update state
-        app->simulationState.quaternion = {q_new[0], q_new[1], q_new[2], q_new[3]};
+        app->simulationState.setAttitude({q_new[0], q_new[1], q_new[2], q_new[3]});
     }
 }
 
@@ -600,7 +872,10 @@ void Application::scrollCallback(GLFWwindow* window, double xoffset, double yoff
 }
 
 void Application::render3D() {
-    transform.model = simulationState.model_matrix;
+    // Everything the previous frame's UI allocated from the arena is dead now.
+    frameArena().reset();
+
+    transform.model = simulationState.modelMatrix();
 
     // Step 1: Clear the framebuffer
     glClearColor(0.06f, 0.08f, 0.10f, 1.0f);
@@ -638,46 +913,9 @@ void Application::render3D() {
 }
 
 void Application::captureAttitudeHistorySample() {
-    auto& history = simulationState.attitude_history;
-    const double now = simulationState.time_seconds;
-
-    if (!std::isfinite(now)) {
-        return;
-    }
-
     // Note: Removed video_cfg.recording check - telemetry graphs should always update
     // The recording flag only affects video/trail features, not real-time telemetry
-
-    if (now < history.last_sample_time) {
-        history.samples.clear();
-        history.last_sample_time = -std::numeric_limits<double>::infinity();
-    }
-
-    const double interval = std::max(1e-6, history.sample_interval);
-    if (!history.samples.empty() && (now - history.last_sample_time) < interval) {
-        return;
-    }
-
-    SimulationState::AttitudeSample sample;
-    sample.timestamp = now;
-    sample.quaternion = simulationState.quaternion;
-    sample.roll = simulationState.euler.roll;
-    sample.pitch = simulationState.euler.pitch;
-    sample.yaw = simulationState.euler.yaw;
-    // Convert angular rates from deg/s to rad/s for storage
-    sample.angular_rate = simulationState.angular_rate_deg_per_sec * (M_PI / 180.0);
-    history.samples.emplace_back(sample);
-    history.last_sample_time = now;
-
-    const double window = std::max(interval, std::max(0.1, history.window_seconds));
-    while (!history.samples.empty() && (now - history.samples.front().timestamp) > window) {
-        history.samples.pop_front();
-    }
-
-    const size_t max_samples = static_cast<size_t>(window / interval) + 8;
-    while (history.samples.size() > max_samples && !history.samples.empty()) {
-        history.samples.pop_front();
-    }
+    captureAttitudeSample(simulationState);
 }
 
 void Application::renderDashboardLayout(ImGuiIO& io) {
@@ -735,11 +973,13 @@ void Application::renderDashboardLayout(ImGuiIO& io) {
             ImGui::DockBuilderDockWindow("Sensor Suite", dock_bottom_right);
             ImGui::DockBuilderDockWindow("Flight Telemetry", dock_bottom_center);
             ImGui::DockBuilderDockWindow("Dynamics", dock_right_bottom);
+            ImGui::DockBuilderDockWindow("Bode", dock_right_bottom);
+            ImGui::DockBuilderDockWindow("Memory", dock_right_bottom);
             ImGui::DockBuilderFinish(dockspace_id);
         }
     }
 
-    DrawTopNavigation();
+    DrawTopNavigation(simulationState);
 
     ui::CardOptions scene_card;
     scene_card.min_size = ImVec2(640.0f, 420.0f);
@@ -795,9 +1035,9 @@ void Application::renderDashboardLayout(ImGuiIO& io) {
                 euler_buf,
                 sizeof(euler_buf),
                 "Euler (deg): R %.1f  P %.1f  Y %.1f",
-                rad2deg(simulationState.euler.roll),
-                rad2deg(simulationState.euler.pitch),
-                rad2deg(simulationState.euler.yaw));
+                rad2deg(simulationState.euler().roll),
+                rad2deg(simulationState.euler().pitch),
+                rad2deg(simulationState.euler().yaw));
 
             ImVec2 text_pos = canvas_pos + ImVec2(18.0f, 18.0f);
             draw_list->AddText(text_pos,
@@ -812,9 +1052,9 @@ void Application::renderDashboardLayout(ImGuiIO& io) {
                 rates_buf,
                 sizeof(rates_buf),
                 "Body Rate (deg/s): R %.1f  P %.1f  Y %.1f",
-                simulationState.angular_rate_deg_per_sec.x,
-                simulationState.angular_rate_deg_per_sec.y,
-                simulationState.angular_rate_deg_per_sec.z);
+                rad2deg(simulationState.angular_rate_rad_s.x),
+                rad2deg(simulationState.angular_rate_rad_s.y),
+                rad2deg(simulationState.angular_rate_rad_s.z));
 
             draw_list->AddText(text_pos + ImVec2(0.0f, 40.0f),
                                ImGui::ColorConvertFloat4ToU32(palette.text_muted),
@@ -889,13 +1129,10 @@ void Application::renderDashboardLayout(ImGuiIO& io) {
                                         const char* label,
                                         const char* icon_code,
                                         auto popup_builder) {
-            std::string text = label;
-            if (fonts.icon && icon_code) {
-                text = std::string(icon_code) + " " + label;
-            }
+            const char* text = (fonts.icon && icon_code) ? frameArena().format("%s %s", icon_code, label) : label;
             ImGui::PushID(id);
             ui::PushPillButtonStyle(ui::PillStyle::Secondary);
-            if (ImGui::Button(text.c_str(), ImVec2(120.0f, 0.0f))) {
+            if (ImGui::Button(text, ImVec2(120.0f, 0.0f))) {
                 ImGui::OpenPopup("popup");
             }
             bool hovered = ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenBlockedByPopup);
@@ -1016,6 +1253,38 @@ void Application::renderDashboardLayout(ImGuiIO& io) {
                     ImGui::EndPopup();
                 }
             });
+
+        // Timeline scrubber: drag back to rewind, play on to replay, branch to fly on from there
+        ImGui::SameLine(0.0f, 24.0f);
+        const bool live = timeline.atEnd();
+        const double timeline_start = timeline.startTime();
+        const double timeline_end = timeline.endTime();
+        double playhead = simulationState.time_seconds;
+        const float button_width = 80.0f;
+        ImGui::SetNextItemWidth(std::max(120.0f, ImGui::GetContentRegionAvail().x - 2.0f * (button_width + 12.0f) - 24.0f));
+        if (ImGui::SliderScalar("##timeline", ImGuiDataType_Double, &playhead, &timeline_start, &timeline_end,
+                                live ? "Live %.1f s" : "Replay %.1f s")) {
+            timeline.seek(playhead, modules, simulationState);
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Drag to rewind (last %.0f s, keyframe every %.1f s)",
+                              timeline_end - timeline_start, timeline.settings().keyframe_interval_s);
+        }
+        ImGui::SameLine(0.0f, 12.0f);
+        ImGui::BeginDisabled(live);
+        ui::PushPillButtonStyle(ui::PillStyle::Secondary);
+        if (ImGui::Button("Branch", ImVec2(button_width, 0.0f))) {
+            timeline.branch();
+        }
+        if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled)) {
+            ImGui::SetTooltip("Fly on from here; the recording after this point is discarded");
+        }
+        ImGui::SameLine(0.0f, 12.0f);
+        if (ImGui::Button("Live", ImVec2(button_width, 0.0f))) {
+            timeline.seek(timeline_end, modules, simulationState);
+        }
+        ui::PopPillButtonStyle();
+        ImGui::EndDisabled();
     }
     ui::EndCard();
 
@@ -1051,15 +1320,17 @@ void Application::renderLegacyLayout() {
 
         ImGui::Separator();
         float body_rates[3] = {
-            static_cast<float>(simulationState.angular_rate_deg_per_sec.x),
-            static_cast<float>(simulationState.angular_rate_deg_per_sec.y),
-            static_cast<float>(simulationState.angular_rate_deg_per_sec.z)
+            static_cast<float>(rad2deg(simulationState.angular_rate_rad_s.x)),
+            static_cast<float>(rad2deg(simulationState.angular_rate_rad_s.y)),
+            static_cast<float>(rad2deg(simulationState.angular_rate_rad_s.z))
         };
         if (ImGui::SliderFloat3("Body Rates (deg/s)", body_rates, -360.0f, 360.0f, "%.1f")) {
-            simulationState.angular_rate_deg_per_sec = glm::dvec3(body_rates[0], body_rates[1], body_rates[2]);
+            simulationState.angular_rate_rad_s = glm::dvec3(deg2rad(body_rates[0]),
+                                                           deg2rad(body_rates[1]),
+                                                           deg2rad(body_rates[2]));
         }
         if (ImGui::Button("Zero Rates")) {
-            simulationState.angular_rate_deg_per_sec = glm::dvec3(0.0);
+            simulationState.angular_rate_rad_s = glm::dvec3(0.0);
         }
 
         bool paused = simulationState.control.paused;
@@ -1105,17 +1376,18 @@ void Application::renderLegacyLayout() {
 
         ImGui::Separator();
         ImGui::Text("Euler (deg)");
+        const EulerAngles& euler = simulationState.euler();
         ImGui::Text("Roll %.1f  Pitch %.1f  Yaw %.1f",
-                    rad2deg(simulationState.euler.roll),
-                    rad2deg(simulationState.euler.pitch),
-                    rad2deg(simulationState.euler.yaw));
+                    rad2deg(euler.roll),
+                    rad2deg(euler.pitch),
+                    rad2deg(euler.yaw));
 
         ImGui::Separator();
         ImGui::Text("Body Rates (deg/s)");
         ImGui::Text("Roll %.1f  Pitch %.1f  Yaw %.1f",
-                    simulationState.angular_rate_deg_per_sec.x,
-                    simulationState.angular_rate_deg_per_sec.y,
-                    simulationState.angular_rate_deg_per_sec.z);
+                    rad2deg(simulationState.angular_rate_rad_s.x),
+                    rad2deg(simulationState.angular_rate_rad_s.y),
+                    rad2deg(simulationState.angular_rate_rad_s.z));
     }
     ImGui::End();
 }
@@ -1145,6 +1417,8 @@ void Application::initializePanels() {
     panelManager.registerPanel(std::make_unique<DynamicsPanel>());
     panelManager.registerPanel(std::make_unique<EstimatorPanel>());
     panelManager.registerPanel(std::make_unique<RotorAnalysisPanel>());
+    panelManager.registerPanel(std::make_unique<BodePanel>());
+    panelManager.registerPanel(std::make_unique<MemoryPanel>());
 }
 
 ImTextureID Application::renderSceneToTexture(const ImVec2& size) {
@@ -1209,6 +1483,10 @@ bool Application::ensureRenderTarget(int width, int height) {
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
 
+    // RGBA8 color plus D24S8 depth/stencil: 8 bytes per pixel.
+    renderTargetBytes = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 8;
+    MemoryAccounting::charge(MemoryTag::Gpu, renderTargetBytes);
+
     bool complete = (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
@@ -1232,6 +1510,8 @@ void Application::destroyRenderTarget() {
         glDeleteFramebuffers(1, &fbo);
         fbo = 0;
     }
+    MemoryAccounting::refund(MemoryTag::Gpu, renderTargetBytes);
+    renderTargetBytes = 0;
     sceneWidth = 0;
     sceneHeight = 0;
 }
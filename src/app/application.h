@@ -18,7 +18,14 @@
 #include "render/camera.h"
 #include "core/simulation_state.h"
 #include "core/module.h"
+#include "core/module_scheduler.h"
+#include "core/rewind_timeline.h"
+#include "config/config_watcher.h"
+#include "config/rig_config.h"
 #include "gui/panel_manager.h"
+#include "ipc/shm_telemetry_publisher.h"
+#include "ipc/udp_telemetry_streamer.h"
+#include "modules/scenario_player.h"
 #include "imgui.h"
 
 /**
@@ -133,10 +140,19 @@ private:
     GLuint depthBuffer;                              ///< Depth/stencil renderbuffer
     int sceneWidth = 0;                              ///< Current render target width
     int sceneHeight = 0;                             ///< Current render target height
+    std::size_t renderTargetBytes = 0;               ///< GPU bytes charged for the render target
 
     // === Simulation State and Modules ===
     SimulationState simulationState;                 ///< Shared simulation state
-    std::vector<std::unique_ptr<Module>> modules;    ///< Registered simulation modules
+    ModuleScheduler modules;                         ///< Registered simulation modules (multi-rate)
+    RewindTimeline timeline;                         ///< Keyframes and input journal for scrubbing/branching
+    ShmTelemetryPublisher telemetryPublisher;        ///< Mirrors telemetry channels into shared memory
+    UdpTelemetryStreamer telemetryStreamer;          ///< Optional network stream (AERODYN_TELEMETRY_UDP)
+    ScenarioScript scenario;                         ///< Script from AERODYN_SCENARIO, played instead of the keys
+    bool scenarioLoaded = false;                     ///< scenario parsed and in the pipeline
+    bool scenarioReported = false;                   ///< Results printed once the script ran out
+    RigConfig rigConfig;                             ///< Vehicle configuration from AERODYN_CONFIG (defaults otherwise)
+    ConfigWatcher configWatcher;                     ///< Reloads rigConfig when its file is saved
     PanelManager panelManager;                       ///< UI panel manager
 
     // === Initialization Helpers ===
@@ -152,6 +168,15 @@ private:
      */
     void initializeModules();
 
+    /**
+     * @brief Apply a saved change to the AERODYN_CONFIG file in flight
+     *
+     * Invalid files and airframe changes are reported and leave the running
+     * configuration in place; otherwise only the modules listening to the
+     * changed sections are reconfigured (ModuleScheduler::reconfigure()).
+     */
+    void reloadRigConfig();
+
     /**
      * @brief Initialize all UI panels
      *
@@ -0,0 +1,105 @@
+#include "config/config_watcher.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <climits>
+#include <sys/inotify.h>
+#endif
+
+namespace {
+
+long long modificationTimeNs(const std::string& path) {
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0) {
+        return -1;
+    }
+#if defined(__APPLE__)
+    return static_cast<long long>(info.st_mtimespec.tv_sec) * 1000000000LL + info.st_mtimespec.tv_nsec;
+#else
+    return static_cast<long long>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+#endif
+}
+
+}  // namespace
+
+bool ConfigWatcher::watch(const std::string& path) {
+    close();
+    path_ = path;
+    const std::size_t slash = path.rfind('/');
+    const std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    name_ = slash == std::string::npos ? path : path.substr(slash + 1);
+    mtime_ns_ = modificationTimeNs(path);
+
+#if defined(__linux__)
+    fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd_ < 0) {
+        error_ = std::string("inotify_init1: ") + std::strerror(errno);
+        return false;
+    }
+    watch_ = ::inotify_add_watch(fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch_ < 0) {
+        error_ = "watch " + directory + ": " + std::strerror(errno);
+        close();
+        return false;
+    }
+#endif
+    error_.clear();
+    return true;
+}
+
+void ConfigWatcher::close() {
+#if defined(__linux__)
+    if (fd_ >= 0) {
+        ::close(fd_);   // Drops the watch with it
+    }
+#endif
+    fd_ = -1;
+    watch_ = -1;
+}
+
+bool ConfigWatcher::active() const {
+#if defined(__linux__)
+    return fd_ >= 0;
+#else
+    return !path_.empty();
+#endif
+}
+
+bool ConfigWatcher::poll() {
+#if defined(__linux__)
+    if (fd_ < 0) {
+        return false;
+    }
+    bool changed = false;
+    alignas(inotify_event) char buffer[16 * (sizeof(inotify_event) + NAME_MAX + 1)];
+    for (;;) {
+        const ssize_t length = ::read(fd_, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;  // EAGAIN: drained
+        }
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len > 0 && name_ == event->name && (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+                changed = true;
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+    return changed;
+#else
+    if (path_.empty()) {
+        return false;
+    }
+    const long long mtime = modificationTimeNs(path_);
+    if (mtime == mtime_ns_) {
+        return false;
+    }
+    mtime_ns_ = mtime;
+    return mtime >= 0;
+#endif
+}
@@ -0,0 +1,59 @@
+/**
+ * @file config_watcher.h
+ * @brief Notices when a configuration file is rewritten, without blocking the frame loop
+ */
+
+#ifndef CONFIG_CONFIG_WATCHER_H
+#define CONFIG_CONFIG_WATCHER_H
+
+#include <string>
+
+/**
+ * @class ConfigWatcher
+ * @brief inotify watch on one file, polled once per frame
+ *
+ * The watch is on the file's directory, filtered by name, so it survives
+ * editors that save by writing a temporary file and renaming it over the
+ * original (the file's own inode would be gone). Only completed writes
+ * (close after write, rename into place) count, so a reload never sees a
+ * half-written file. Several events between polls report one change.
+ *
+ * poll() is a non-blocking read of the inotify descriptor: no syscall
+ * beyond that and no thread. Off Linux the file's modification time is
+ * compared instead.
+ */
+class ConfigWatcher {
+public:
+    ConfigWatcher() = default;
+    ~ConfigWatcher() { close(); }
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    /**
+     * @brief Start watching path (replaces any previous watch)
+     * @return false if the directory cannot be watched; error() says why
+     */
+    bool watch(const std::string& path);
+
+    void close();
+
+    /**
+     * @brief Whether the file was written or replaced since the last poll
+     */
+    bool poll();
+
+    bool active() const;
+    const std::string& path() const { return path_; }
+    const std::string& error() const { return error_; }
+
+private:
+    std::string path_;
+    std::string name_;      ///< File name within the watched directory
+    std::string error_;
+    int fd_{-1};
+    int watch_{-1};
+    long long mtime_ns_{-1};    ///< Last modification time seen (portable fallback)
+};
+
+#endif // CONFIG_CONFIG_WATCHER_H
@@ -0,0 +1,475 @@
+#include "config/rig_config.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+#include "modules/airframe_layout.h"
+
+namespace {
+
+using Airframe = SimulationState::Airframe;
+using RotorGeometry = SimulationState::RotorGeometry;
+constexpr std::size_t kMaxRotors = SimulationState::kMaxRotors;
+
+struct AirframeName {
+    const char* name;
+    Airframe airframe;
+};
+
+constexpr AirframeName kAirframes[] = {{"quadx", Airframe::QuadX},
+                                       {"quadplus", Airframe::QuadPlus},
+                                       {"hex", Airframe::HexX},
+                                       {"octo", Airframe::OctoX}};
+
+using Turbulence = SimulationState::WindConfig::Turbulence;
+
+struct TurbulenceName {
+    const char* name;
+    Turbulence turbulence;
+};
+
+constexpr TurbulenceName kTurbulences[] = {{"off", Turbulence::Off},
+                                           {"dryden", Turbulence::Dryden},
+                                           {"vonkarman", Turbulence::VonKarman}};
+
+enum class Index {
+    None,       ///< key only
+    Optional,   ///< key applies to every rotor, key[i] to one
+    Required    ///< key[i] only
+};
+
+struct Key {
+    const char* name;
+    std::size_t values;     ///< Numbers taken (0: one word)
+    Index index;
+};
+
+// Per-rotor keys are written rotor[i].field; they are looked up as rotor.field.
+constexpr Key kKeys[] = {
+    {"airframe", 0, Index::None},
+    {"vehicle.mass", 1, Index::None},
+    {"vehicle.gravity", 1, Index::None},
+    {"vehicle.inertia", 3, Index::None},
+    {"vehicle.arm_length", 1, Index::None},
+    {"vehicle.drag_coefficient", 1, Index::None},
+    {"rotor.thrust_coefficient", 1, Index::Optional},
+    {"rotor.torque_coefficient", 1, Index::Optional},
+    {"rotor.position", 3, Index::Required},
+    {"rotor.axis", 3, Index::Required},
+    {"rotor.direction", 1, Index::Required},
+    {"motor.lag", 0, Index::None},
+    {"motor.time_constant", 1, Index::Optional},
+    {"motor.omega_min", 1, Index::None},
+    {"motor.omega_max", 1, Index::None},
+    {"estimator.kp", 1, Index::None},
+    {"estimator.ki", 1, Index::None},
+    {"wind.turbulence", 0, Index::None},
+    {"wind.steady", 3, Index::None},
+    {"wind.sigma", 2, Index::None},
+    {"wind.length", 2, Index::None},
+    {"wind.airspeed", 1, Index::None},
+    {"wind.seed", 1, Index::None},
+    {"wind.gust", 3, Index::None},
+    {"wind.gust_start", 1, Index::None},
+    {"wind.gust_duration", 1, Index::None},
+};
+
+/// One parsed line
+struct Statement {
+    std::size_t key;
+    bool has_index;
+    std::size_t index;
+    std::array<double, 3> values;
+    std::string word;
+    std::uint32_t line;
+};
+
+bool parseNumber(const std::string& token, double& value) {
+    char* end = nullptr;
+    value = std::strtod(token.c_str(), &end);
+    return !token.empty() && end == token.c_str() + token.size() && std::isfinite(value);
+}
+
+/// Take "[i]" out of a key: "rotor[2].axis" -> "rotor.axis", index 2
+bool splitIndex(const std::string& token, std::string& key, std::size_t& index, bool& has_index) {
+    const std::size_t open = token.find('[');
+    has_index = open != std::string::npos;
+    if (!has_index) {
+        key = token;
+        return true;
+    }
+    const std::size_t close = token.find(']', open);
+    if (open == 0 || close == std::string::npos || close == open + 1) {
+        return false;
+    }
+    const std::string digits = token.substr(open + 1, close - open - 1);
+    if (digits.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    index = static_cast<std::size_t>(std::strtoul(digits.c_str(), nullptr, 10));
+    key = token.substr(0, open) + token.substr(close + 1);
+    return key.find('[') == std::string::npos;
+}
+
+/// Range check of a key's values; empty if fine
+std::string checkRange(const std::string& key, std::array<double, 3>& v) {
+    if (key == "vehicle.mass" || key == "vehicle.gravity" || key == "vehicle.arm_length" ||
+        key == "rotor.thrust_coefficient" || key == "rotor.torque_coefficient" || key == "motor.omega_max") {
+        return v[0] > 0.0 ? std::string() : key + " must be positive";
+    }
+    if (key == "vehicle.inertia") {
+        return v[0] > 0.0 && v[1] > 0.0 && v[2] > 0.0 ? std::string() : key + " needs three positive moments";
+    }
+    if (key == "vehicle.drag_coefficient" || key == "motor.time_constant" || key == "motor.omega_min" ||
+        key == "estimator.kp" || key == "estimator.ki" || key == "wind.airspeed" || key == "wind.gust_start" ||
+        key == "wind.gust_duration") {
+        return v[0] >= 0.0 ? std::string() : key + " must not be negative";
+    }
+    if (key == "wind.sigma") {
+        return v[0] >= 0.0 && v[1] >= 0.0 ? std::string() : key + " needs two intensities of at least 0";
+    }
+    if (key == "wind.length") {
+        return v[0] > 0.0 && v[1] > 0.0 ? std::string() : key + " needs two positive scale lengths";
+    }
+    if (key == "wind.seed") {
+        return v[0] >= 0.0 && v[0] <= 9007199254740992.0 && v[0] == std::floor(v[0])
+                   ? std::string()
+                   : key + " is a whole number from 0 to 2^53";
+    }
+    if (key == "rotor.direction") {
+        return v[0] == 1.0 || v[0] == -1.0 ? std::string() : key + " is 1 (CW) or -1 (CCW)";
+    }
+    if (key == "rotor.axis") {
+        const double norm = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (norm < 1e-9) {
+            return key + " must not be zero";
+        }
+        for (double& component : v) {
+            component /= norm;
+        }
+    }
+    return std::string();
+}
+
+bool sameGeometry(const RotorGeometry& a, const RotorGeometry& b) {
+    return a.position_body_m == b.position_body_m && a.axis_body == b.axis_body && a.direction == b.direction &&
+           a.thrust_coeff == b.thrust_coeff && a.torque_coeff == b.torque_coeff;
+}
+
+}  // namespace
+
+bool RigConfig::parse(const std::string& text) {
+    std::vector<Statement> statements;
+    std::istringstream lines(text);
+    std::string line;
+    std::uint32_t line_number = 0;
+
+    auto fail = [&](std::uint32_t at, const std::string& message) {
+        error_ = (at != 0 ? "line " + std::to_string(at) + ": " : std::string()) + message;
+        return false;
+    };
+
+    while (std::getline(lines, line)) {
+        ++line_number;
+        const std::size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream words(line);
+        std::vector<std::string> tokens;
+        for (std::string token; words >> token;) {
+            tokens.push_back(token);
+        }
+        if (tokens.empty()) {
+            continue;
+        }
+
+        Statement statement{};
+        statement.line = line_number;
+        std::string key;
+        if (!splitIndex(tokens[0], key, statement.index, statement.has_index)) {
+            return fail(line_number, "malformed index in '" + tokens[0] + "'");
+        }
+        const Key* found = std::find_if(std::begin(kKeys), std::end(kKeys),
+                                        [&](const Key& k) { return key == k.name; });
+        if (found == std::end(kKeys)) {
+            return fail(line_number, "unknown key '" + tokens[0] + "'");
+        }
+        statement.key = static_cast<std::size_t>(found - std::begin(kKeys));
+        if (statement.has_index && found->index == Index::None) {
+            return fail(line_number, key + " takes no index");
+        }
+        if (!statement.has_index && found->index == Index::Required) {
+            const std::size_t dot = key.find('.');
+            return fail(line_number, key.substr(0, dot) + "[i]" + key.substr(dot) + " needs a rotor index");
+        }
+        if (statement.has_index && statement.index >= kMaxRotors) {
+            return fail(line_number, "index " + std::to_string(statement.index) + " is past the last rotor");
+        }
+
+        const std::size_t wanted = std::max<std::size_t>(found->values, 1);
+        if (tokens.size() != 1 + wanted) {
+            return fail(line_number, tokens[0] + " takes " + std::to_string(wanted) +
+                                         (found->values == 0 ? " word" : " value(s)"));
+        }
+        if (found->values == 0) {
+            statement.word = tokens[1];
+        } else {
+            for (std::size_t k = 0; k < found->values; ++k) {
+                if (!parseNumber(tokens[1 + k], statement.values[k])) {
+                    return fail(line_number, "'" + tokens[1 + k] + "' is not a number");
+                }
+            }
+            const std::string problem = checkRange(key, statement.values);
+            if (!problem.empty()) {
+                return fail(line_number, problem);
+            }
+        }
+        if (key == "motor.lag" && statement.word != "on" && statement.word != "off") {
+            return fail(line_number, "motor.lag is on or off");
+        }
+        if (key == "airframe" &&
+            std::none_of(std::begin(kAirframes), std::end(kAirframes),
+                         [&](const AirframeName& a) { return statement.word == a.name; })) {
+            return fail(line_number, "airframe is one of quadx, quadplus, hex, octo");
+        }
+        if (key == "wind.turbulence" &&
+            std::none_of(std::begin(kTurbulences), std::end(kTurbulences),
+                         [&](const TurbulenceName& t) { return statement.word == t.name; })) {
+            return fail(line_number, "wind.turbulence is one of off, dryden, vonkarman");
+        }
+
+        for (const Statement& earlier : statements) {
+            if (earlier.key == statement.key && earlier.has_index == statement.has_index &&
+                (!statement.has_index || earlier.index == statement.index)) {
+                return fail(line_number, tokens[0] + " already set on line " + std::to_string(earlier.line));
+            }
+        }
+        statements.push_back(statement);
+    }
+
+    // Resolve against the built-in defaults: keys for every rotor first,
+    // then the per-rotor edits on top of them.
+    SimulationState::VehicleConfig vehicle{};
+    SimulationState::RotorConfig rotor{};
+    SimulationState::MotorConfig motor{};
+    SimulationState::EstimatorConfig estimator{};
+    SimulationState::WindConfig wind{};
+    bool rotor_edits = false;
+    for (const Statement& s : statements) {
+        const std::string key = kKeys[s.key].name;
+        const auto& v = s.values;
+        if (s.has_index) {
+            rotor_edits = rotor_edits || key.compare(0, 6, "rotor.") == 0;
+            continue;
+        }
+        if (key == "airframe") {
+            vehicle.airframe = std::find_if(std::begin(kAirframes), std::end(kAirframes),
+                                            [&](const AirframeName& a) { return s.word == a.name; })->airframe;
+        } else if (key == "vehicle.mass") {
+            vehicle.mass = v[0];
+        } else if (key == "vehicle.gravity") {
+            vehicle.gravity = v[0];
+        } else if (key == "vehicle.inertia") {
+            vehicle.Ixx = v[0];
+            vehicle.Iyy = v[1];
+            vehicle.Izz = v[2];
+        } else if (key == "vehicle.arm_length") {
+            vehicle.arm_length = v[0];
+        } else if (key == "vehicle.drag_coefficient") {
+            vehicle.drag_coefficient = v[0];
+        } else if (key == "rotor.thrust_coefficient") {
+            rotor.thrust_coefficient = v[0];
+        } else if (key == "rotor.torque_coefficient") {
+            rotor.torque_coefficient = v[0];
+        } else if (key == "motor.lag") {
+            motor.lag_enabled = s.word == "on";
+        } else if (key == "motor.time_constant") {
+            motor.time_constant_s.fill(v[0]);
+        } else if (key == "motor.omega_min") {
+            motor.omega_min_rad_s = v[0];
+        } else if (key == "motor.omega_max") {
+            motor.omega_max_rad_s = v[0];
+        } else if (key == "estimator.kp") {
+            estimator.kp = static_cast<float>(v[0]);
+        } else if (key == "estimator.ki") {
+            estimator.ki = static_cast<float>(v[0]);
+        } else if (key == "wind.turbulence") {
+            wind.turbulence = std::find_if(std::begin(kTurbulences), std::end(kTurbulences),
+                                           [&](const TurbulenceName& t) { return s.word == t.name; })->turbulence;
+        } else if (key == "wind.steady") {
+            wind.steady_ned = glm::dvec3(v[0], v[1], v[2]);
+        } else if (key == "wind.sigma") {
+            wind.sigma_horizontal_m_s = v[0];
+            wind.sigma_vertical_m_s = v[1];
+        } else if (key == "wind.length") {
+            wind.length_horizontal_m = v[0];
+            wind.length_vertical_m = v[1];
+        } else if (key == "wind.airspeed") {
+            wind.airspeed_m_s = v[0];
+        } else if (key == "wind.seed") {
+            wind.seed = static_cast<std::uint64_t>(v[0]);
+        } else if (key == "wind.gust") {
+            wind.gust_ned = glm::dvec3(v[0], v[1], v[2]);
+        } else if (key == "wind.gust_start") {
+            wind.gust_start_s = v[0];
+        } else if (key == "wind.gust_duration") {
+            wind.gust_duration_s = v[0];
+        }
+    }
+
+    const std::size_t rotor_count =
+        visitAirframe(vehicle.airframe, [](auto layout) { return decltype(layout)::kRotorCount; });
+    if (rotor_edits) {
+        vehicle.rotor_table_set = true;
+        visitAirframe(vehicle.airframe, [&](auto layout) {
+            using Layout = decltype(layout);
+            for (std::size_t i = 0; i < Layout::kRotorCount; ++i) {
+                RotorGeometry& entry = vehicle.rotor_table[i];
+                entry.position_body_m = {vehicle.arm_length * Layout::kRotors[i].arm_x,
+                                         vehicle.arm_length * Layout::kRotors[i].arm_y, 0.0};
+                entry.axis_body = {0.0, 0.0, -1.0};
+                entry.direction = Layout::kRotors[i].direction;
+                entry.thrust_coeff = rotor.thrust_coefficient;
+                entry.torque_coeff = rotor.torque_coefficient;
+            }
+        });
+    }
+    for (const Statement& s : statements) {
+        if (!s.has_index) {
+            continue;
+        }
+        const std::string key = kKeys[s.key].name;
+        if (s.index >= rotor_count) {
+            return fail(s.line, "rotor index " + std::to_string(s.index) + " on a " +
+                                    std::to_string(rotor_count) + "-rotor airframe");
+        }
+        const auto& v = s.values;
+        RotorGeometry& entry = vehicle.rotor_table[s.index];
+        if (key == "motor.time_constant") {
+            motor.time_constant_s[s.index] = v[0];
+        } else if (key == "rotor.position") {
+            entry.position_body_m = {v[0], v[1], v[2]};
+        } else if (key == "rotor.axis") {
+            entry.axis_body = {v[0], v[1], v[2]};
+        } else if (key == "rotor.direction") {
+            entry.direction = v[0];
+        } else if (key == "rotor.thrust_coefficient") {
+            entry.thrust_coeff = v[0];
+        } else if (key == "rotor.torque_coefficient") {
+            entry.torque_coeff = v[0];
+        }
+    }
+
+    // Checks across keys
+    const double I[3] = {vehicle.Ixx, vehicle.Iyy, vehicle.Izz};
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        if (I[axis] > I[(axis + 1) % 3] + I[(axis + 2) % 3]) {
+            return fail(0, "vehicle.inertia is not physically realizable (each moment must be at most the sum of the other two)");
+        }
+    }
+    if (motor.omega_min_rad_s >= motor.omega_max_rad_s) {
+        return fail(0, "motor.omega_min must be below motor.omega_max");
+    }
+    double max_lift = 0.0;
+    for (std::size_t i = 0; i < rotor_count; ++i) {
+        const double kt = vehicle.rotor_table_set ? vehicle.rotor_table[i].thrust_coeff : rotor.thrust_coefficient;
+        const double up = vehicle.rotor_table_set ? -vehicle.rotor_table[i].axis_body[2] : 1.0;
+        max_lift += kt * motor.omega_max_rad_s * motor.omega_max_rad_s * std::max(up, 0.0);
+    }
+    if (max_lift <= vehicle.mass * vehicle.gravity) {
+        std::ostringstream message;
+        message << "rotors cannot lift the vehicle: " << max_lift << " N at motor.omega_max against a weight of "
+                << vehicle.mass * vehicle.gravity << " N";
+        return fail(0, message.str());
+    }
+
+    vehicle_ = vehicle;
+    rotor_ = rotor;
+    motor_ = motor;
+    estimator_ = estimator;
+    wind_ = wind;
+    error_.clear();
+    return true;
+}
+
+bool RigConfig::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        error_ = "cannot read " + path;
+        return false;
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    if (!parse(text.str())) {
+        error_ = path + ": " + error_;
+        return false;
+    }
+    return true;
+}
+
+std::size_t RigConfig::rotorCount() const {
+    return visitAirframe(vehicle_.airframe, [](auto layout) { return decltype(layout)::kRotorCount; });
+}
+
+unsigned RigConfig::apply(SimulationState& state) const {
+    auto& vehicle = state.vehicle_config;
+    unsigned changed = 0;
+    if (vehicle.airframe != vehicle_.airframe) {
+        changed |= ConfigSection::kAirframe;
+    }
+    if (vehicle.mass != vehicle_.mass || vehicle.gravity != vehicle_.gravity || vehicle.Ixx != vehicle_.Ixx ||
+        vehicle.Iyy != vehicle_.Iyy || vehicle.Izz != vehicle_.Izz ||
+        vehicle.drag_coefficient != vehicle_.drag_coefficient) {
+        changed |= ConfigSection::kVehicle;
+    }
+    bool same_table = vehicle.rotor_table_set == vehicle_.rotor_table_set;
+    for (std::size_t i = 0; same_table && vehicle_.rotor_table_set && i < kMaxRotors; ++i) {
+        same_table = sameGeometry(vehicle.rotor_table[i], vehicle_.rotor_table[i]);
+    }
+    if (!same_table || vehicle.arm_length != vehicle_.arm_length ||
+        state.rotor_config.thrust_coefficient != rotor_.thrust_coefficient ||
+        state.rotor_config.torque_coefficient != rotor_.torque_coefficient) {
+        changed |= ConfigSection::kRotors;
+    }
+    const auto& motor = state.motor_config;
+    if (motor.lag_enabled != motor_.lag_enabled || motor.time_constant_s != motor_.time_constant_s ||
+        motor.omega_min_rad_s != motor_.omega_min_rad_s || motor.omega_max_rad_s != motor_.omega_max_rad_s) {
+        changed |= ConfigSection::kMotors;
+    }
+    if (state.estimator_config.kp != estimator_.kp || state.estimator_config.ki != estimator_.ki) {
+        changed |= ConfigSection::kEstimator;
+    }
+    const auto& wind = state.wind_config;
+    if (wind.turbulence != wind_.turbulence || wind.steady_ned != wind_.steady_ned ||
+        wind.sigma_horizontal_m_s != wind_.sigma_horizontal_m_s || wind.sigma_vertical_m_s != wind_.sigma_vertical_m_s ||
+        wind.length_horizontal_m != wind_.length_horizontal_m || wind.length_vertical_m != wind_.length_vertical_m ||
+        wind.airspeed_m_s != wind_.airspeed_m_s || wind.seed != wind_.seed || wind.gust_ned != wind_.gust_ned ||
+        wind.gust_start_s != wind_.gust_start_s || wind.gust_duration_s != wind_.gust_duration_s) {
+        changed |= ConfigSection::kWind;
+    }
+
+    vehicle.airframe = vehicle_.airframe;
+    vehicle.mass = vehicle_.mass;
+    vehicle.gravity = vehicle_.gravity;
+    vehicle.Ixx = vehicle_.Ixx;
+    vehicle.Iyy = vehicle_.Iyy;
+    vehicle.Izz = vehicle_.Izz;
+    vehicle.arm_length = vehicle_.arm_length;
+    vehicle.drag_coefficient = vehicle_.drag_coefficient;
+    vehicle.rotor_table = vehicle_.rotor_table;
+    vehicle.rotor_table_set = vehicle_.rotor_table_set;
+    state.rotor_config.thrust_coefficient = rotor_.thrust_coefficient;
+    state.rotor_config.torque_coefficient = rotor_.torque_coefficient;
+    state.motor_config = motor_;
+    state.estimator_config = estimator_;
+    state.wind_config = wind_;
+    return changed;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file rig_config.h
+ * @brief Vehicle and rig configuration files, parsed once into a validated, read-only snapshot
+ */
+
+#ifndef CONFIG_RIG_CONFIG_H
+#define CONFIG_RIG_CONFIG_H
+
+#include <cstddef>
+#include <string>
+
+#include "core/module.h"
+#include "core/simulation_state.h"
+
+/**
+ * @class RigConfig
+ * @brief A validated vehicle/rig configuration
+ *
+ * One `key value...` statement per line; '#' starts a comment. Keys left
+ * out keep the built-in defaults (the SimulationState initializers), so an
+ * empty file describes the stock 450 mm quad X:
+ *
+ * @code
+ * airframe quadx                       # quadx | quadplus | hex | octo
+ * vehicle.mass 0.5                     # kg
+ * vehicle.gravity 9.81                 # m/s²
+ * vehicle.inertia 0.0075 0.0075 0.013  # Ixx Iyy Izz (kg·m²)
+ * vehicle.arm_length 0.225             # m, hub distance of the layout table
+ * vehicle.drag_coefficient 0.01
+ * rotor.thrust_coefficient 1.2e-6      # N/(rad/s)², every rotor
+ * rotor.torque_coefficient 2.5e-8      # N·m/(rad/s)², every rotor
+ * rotor[2].position -0.16 -0.16 0.01   # m, body FRD
+ * rotor[2].axis 0 0.05 -1              # thrust direction (normalized on load)
+ * rotor[2].direction 1                 # +1 CW, -1 CCW
+ * rotor[2].thrust_coefficient 1.1e-6   # also rotor[i].torque_coefficient
+ * motor.lag on                         # on | off
+ * motor.time_constant 0.03             # s, every motor; motor.time_constant[i] for one
+ * motor.omega_min 0                    # rad/s
+ * motor.omega_max 2000                 # rad/s
+ * estimator.kp 2
+ * estimator.ki 0.05
+ * wind.turbulence off                  # off | dryden | vonkarman
+ * wind.steady 0 0 0                    # m/s, NED (where the air goes)
+ * wind.sigma 1.46 0.77                 # m/s RMS, horizontal vertical
+ * wind.length 67.4 10                  # m, horizontal vertical scale lengths
+ * wind.airspeed 0                      # m/s the filters assume; 0: steady wind speed
+ * wind.seed 1
+ * wind.gust 0 0 0                      # m/s, NED peak of a 1-cosine gust
+ * wind.gust_start 0                    # s
+ * wind.gust_duration 0                 # s; 0: no gust
+ * @endcode
+ *
+ * rotor[i] keys edit entry i of the airframe's layout table (placed at
+ * vehicle.arm_length with the rotor.* coefficients); any of them hands the
+ * plant a full rotor table (VehicleConfig::rotor_table) instead. A key may
+ * appear once. Beyond syntax and ranges, parse() checks rotor indices
+ * against the airframe, that the inertia is physically realizable and
+ * that the rotors can lift the vehicle at motor.omega_max.
+ *
+ * There are no setters: a reload parses a new RigConfig and swaps it in
+ * only if it is valid.
+ */
+class RigConfig {
+public:
+    /**
+     * @brief Replace the configuration with one parsed from text
+     * @return false (configuration unchanged) on the first problem; error() says where and why
+     */
+    bool parse(const std::string& text);
+
+    /**
+     * @brief Parse a configuration file
+     * @return false if the file cannot be read or is invalid
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Write the configuration into state
+     *
+     * Call before the modules are built, or follow with
+     * ModuleScheduler::reconfigure() for a live change. Runtime fields
+     * (published rotor geometry, rotor count) are left to the plant.
+     *
+     * @return ConfigSection bits of the sections whose values changed;
+     *         kAirframe means the pipeline has to be rebuilt
+     */
+    unsigned apply(SimulationState& state) const;
+
+    SimulationState::Airframe airframe() const { return vehicle_.airframe; }
+    std::size_t rotorCount() const;
+    const SimulationState::VehicleConfig& vehicle() const { return vehicle_; }
+    const SimulationState::RotorConfig& rotor() const { return rotor_; }
+    const SimulationState::MotorConfig& motor() const { return motor_; }
+    const SimulationState::EstimatorConfig& estimator() const { return estimator_; }
+    const SimulationState::WindConfig& wind() const { return wind_; }
+    const std::string& error() const { return error_; }
+
+private:
+    SimulationState::VehicleConfig vehicle_{};
+    SimulationState::RotorConfig rotor_{};
+    SimulationState::MotorConfig motor_{};
+    SimulationState::EstimatorConfig estimator_{};
+    SimulationState::WindConfig wind_{};
+    std::string error_;
+};
+
+#endif // CONFIG_RIG_CONFIG_H
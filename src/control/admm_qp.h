@@ -0,0 +1,247 @@
+/**
+ * @file admm_qp.h
+ * @brief Fixed-size, allocation-free ADMM solver for small convex QPs
+ */
+
+#ifndef CONTROL_ADMM_QP_H
+#define CONTROL_ADMM_QP_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+#include "core/small_matrix.h"
+
+/**
+ * @class AdmmQp
+ * @brief Solves min ½xᵀHx + fᵀx  s.t.  l ≤ Ax ≤ u  by operator splitting (OSQP-style ADMM)
+ *
+ * H and A are fixed by configure(), which factors the KKT-reduced matrix
+ * H + σI + ρAᵀA once (Cholesky). Each solve() then only changes f, l and u,
+ * as in a receding-horizon controller, and every iteration is two
+ * triangular solves plus a few fixed-size products: no allocation, bounded
+ * work per iteration.
+ *
+ * The iterates (x, z, y) persist between solves and serve as the warm
+ * start; callers may shift them (see primal()/slack()/dual()) when the
+ * problem moves in time. solve() stops on converged residuals, after
+ * max_iterations, or when the caller's deadline passes (checked every
+ * check_interval iterations, together with the residuals). The current
+ * iterate is always usable: it is clipped to the constraints in z and is
+ * the best available estimate in x.
+ *
+ * @tparam Nv Decision variables
+ * @tparam Nc Constraint rows
+ */
+template <std::size_t Nv, std::size_t Nc>
+class AdmmQp {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        double rho{0.1};                ///< Constraint penalty (scaled by the mean diagonal of H)
+        double sigma{1e-6};             ///< Primal regularization
+        double alpha{1.6};              ///< Over-relaxation in (0, 2)
+        double eps_abs{1e-5};
+        double eps_rel{1e-4};
+        std::size_t max_iterations{200};
+        std::size_t check_interval{5};  ///< Residual and clock checks every this many iterations
+    };
+
+    enum class Status {
+        Solved,         ///< Residuals within tolerance
+        MaxIterations,  ///< Iteration cap reached first
+        TimeBudget,     ///< Deadline reached first
+        NotConfigured   ///< configure() has not succeeded
+    };
+
+    struct Result {
+        Status status{Status::NotConfigured};
+        std::size_t iterations{0};
+        double primal_residual{0.0};    ///< ‖Ax - z‖∞
+        double dual_residual{0.0};      ///< ‖Hx + f + Aᵀy‖∞
+    };
+
+    /**
+     * @brief Set the problem matrices and factor the ADMM linear system
+     * @return false if H + σI + ρAᵀA is not positive definite (H not PSD)
+     */
+    bool configure(const SmallMatrix<Nv, Nv>& h, const SmallMatrix<Nc, Nv>& a, const Settings& settings) {
+        h_ = h;
+        a_ = a;
+        at_ = transpose(a);
+        settings_ = settings;
+        double diagonal = 0.0;
+        for (std::size_t i = 0; i < Nv; ++i) {
+            diagonal += h.m[i][i];
+        }
+        rho_ = settings.rho * std::max(diagonal / static_cast<double>(Nv), 1e-12);
+
+        SmallMatrix<Nv, Nv> kkt = at_ * a;
+        for (std::size_t i = 0; i < Nv; ++i) {
+            for (std::size_t j = 0; j < Nv; ++j) {
+                kkt.m[i][j] = h.m[i][j] + rho_ * kkt.m[i][j];
+            }
+            kkt.m[i][i] += settings.sigma;
+        }
+        configured_ = factor(kkt);
+        return configured_;
+    }
+
+    /// Forget the warm start
+    void reset() {
+        x_.fill(0.0);
+        z_.fill(0.0);
+        y_.fill(0.0);
+    }
+
+    /**
+     * @brief Run ADMM from the current iterate
+     * @param f Linear cost
+     * @param lower Constraint lower bounds (may be -inf)
+     * @param upper Constraint upper bounds (may be +inf)
+     * @param deadline Stop once this time has passed
+     */
+    Result solve(const SmallVector<Nv>& f, const SmallVector<Nc>& lower, const SmallVector<Nc>& upper,
+                 Clock::time_point deadline) {
+        Result result;
+        if (!configured_) {
+            return result;
+        }
+        result.status = Status::MaxIterations;
+        const double alpha = settings_.alpha;
+        const std::size_t interval = std::max<std::size_t>(settings_.check_interval, 1);
+
+        for (std::size_t iteration = 1; iteration <= settings_.max_iterations; ++iteration) {
+            // x̃ = (H + σI + ρAᵀA)⁻¹ (σx - f + Aᵀ(ρz - y))
+            SmallVector<Nc> scaled{};
+            for (std::size_t i = 0; i < Nc; ++i) {
+                scaled[i] = rho_ * z_[i] - y_[i];
+            }
+            SmallVector<Nv> rhs = at_ * scaled;
+            for (std::size_t i = 0; i < Nv; ++i) {
+                rhs[i] += settings_.sigma * x_[i] - f[i];
+            }
+            const SmallVector<Nv> x_tilde = backSubstitute(rhs);
+            const SmallVector<Nc> z_tilde = a_ * x_tilde;
+
+            for (std::size_t i = 0; i < Nv; ++i) {
+                x_[i] = alpha * x_tilde[i] + (1.0 - alpha) * x_[i];
+            }
+            for (std::size_t i = 0; i < Nc; ++i) {
+                const double relaxed = alpha * z_tilde[i] + (1.0 - alpha) * z_[i];
+                const double z_next = std::clamp(relaxed + y_[i] / rho_, lower[i], upper[i]);
+                y_[i] += rho_ * (relaxed - z_next);
+                z_[i] = z_next;
+            }
+            result.iterations = iteration;
+
+            if (iteration % interval != 0 && iteration != settings_.max_iterations) {
+                continue;
+            }
+            if (converged(f, result)) {
+                result.status = Status::Solved;
+                return result;
+            }
+            if (Clock::now() >= deadline) {
+                result.status = Status::TimeBudget;
+                return result;
+            }
+        }
+        return result;
+    }
+
+    /// Warm-start iterates (decision variables, constraint slacks, scaled duals)
+    SmallVector<Nv>& primal() { return x_; }
+    SmallVector<Nc>& slack() { return z_; }
+    SmallVector<Nc>& dual() { return y_; }
+    const SmallVector<Nv>& solution() const { return x_; }
+    bool configured() const { return configured_; }
+
+private:
+    SmallMatrix<Nv, Nv> h_{};
+    SmallMatrix<Nc, Nv> a_{};
+    SmallMatrix<Nv, Nc> at_{};
+    SmallMatrix<Nv, Nv> cholesky_{};    ///< Lower factor L of H + σI + ρAᵀA
+    Settings settings_{};
+    double rho_{0.1};
+    bool configured_{false};
+
+    SmallVector<Nv> x_{};
+    SmallVector<Nc> z_{};
+    SmallVector<Nc> y_{};
+
+    bool factor(const SmallMatrix<Nv, Nv>& m) {
+        cholesky_ = SmallMatrix<Nv, Nv>{};
+        for (std::size_t j = 0; j < Nv; ++j) {
+            double diagonal = m.m[j][j];
+            for (std::size_t k = 0; k < j; ++k) {
+                diagonal -= cholesky_.m[j][k] * cholesky_.m[j][k];
+            }
+            if (!(diagonal > 0.0)) {
+                return false;
+            }
+            cholesky_.m[j][j] = std::sqrt(diagonal);
+            for (std::size_t i = j + 1; i < Nv; ++i) {
+                double sum = m.m[i][j];
+                for (std::size_t k = 0; k < j; ++k) {
+                    sum -= cholesky_.m[i][k] * cholesky_.m[j][k];
+                }
+                cholesky_.m[i][j] = sum / cholesky_.m[j][j];
+            }
+        }
+        return true;
+    }
+
+    SmallVector<Nv> backSubstitute(const SmallVector<Nv>& b) const {
+        SmallVector<Nv> w{};
+        for (std::size_t i = 0; i < Nv; ++i) {
+            double sum = b[i];
+            for (std::size_t k = 0; k < i; ++k) {
+                sum -= cholesky_.m[i][k] * w[k];
+            }
+            w[i] = sum / cholesky_.m[i][i];
+        }
+        for (std::size_t i = Nv; i-- > 0;) {
+            double sum = w[i];
+            for (std::size_t k = i + 1; k < Nv; ++k) {
+                sum -= cholesky_.m[k][i] * w[k];
+            }
+            w[i] = sum / cholesky_.m[i][i];
+        }
+        return w;
+    }
+
+    static double infinityNorm(const double* values, std::size_t n) {
+        double norm = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            norm = std::max(norm, std::abs(values[i]));
+        }
+        return norm;
+    }
+
+    bool converged(const SmallVector<Nv>& f, Result& result) const {
+        const SmallVector<Nc> ax = a_ * x_;
+        SmallVector<Nc> primal{};
+        for (std::size_t i = 0; i < Nc; ++i) {
+            primal[i] = ax[i] - z_[i];
+        }
+        const SmallVector<Nv> hx = h_ * x_;
+        const SmallVector<Nv> aty = at_ * y_;
+        SmallVector<Nv> dual{};
+        for (std::size_t i = 0; i < Nv; ++i) {
+            dual[i] = hx[i] + f[i] + aty[i];
+        }
+        result.primal_residual = infinityNorm(primal.data(), Nc);
+        result.dual_residual = infinityNorm(dual.data(), Nv);
+
+        const double primal_scale = std::max(infinityNorm(ax.data(), Nc), infinityNorm(z_.data(), Nc));
+        const double dual_scale = std::max({infinityNorm(hx.data(), Nv), infinityNorm(aty.data(), Nv),
+                                            infinityNorm(f.data(), Nv)});
+        return result.primal_residual <= settings_.eps_abs + settings_.eps_rel * primal_scale &&
+               result.dual_residual <= settings_.eps_abs + settings_.eps_rel * dual_scale;
+    }
+};
+
+#endif // CONTROL_ADMM_QP_H
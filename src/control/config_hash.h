@@ -0,0 +1,74 @@
+/**
+ * @file config_hash.h
+ * @brief Stable 64-bit hash of the plant parameters that controller synthesis depends on
+ */
+
+#ifndef CONTROL_CONFIG_HASH_H
+#define CONTROL_CONFIG_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "core/simulation_state.h"
+
+/**
+ * @class ConfigHash
+ * @brief Incremental FNV-1a (64-bit) over explicitly listed fields
+ *
+ * Fields are fed one by one rather than hashing raw structs, so padding,
+ * runtime-only members and field reordering never change the key.
+ * -0.0 is folded onto +0.0 so equal values always hash equally.
+ */
+class ConfigHash {
+public:
+    ConfigHash& add(std::uint64_t value) {
+        for (std::size_t byte = 0; byte < sizeof(value); ++byte) {
+            hash_ ^= (value >> (8 * byte)) & 0xffu;
+            hash_ *= kPrime;
+        }
+        return *this;
+    }
+
+    ConfigHash& add(double value) {
+        if (value == 0.0) {
+            value = 0.0;
+        }
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return add(bits);
+    }
+
+    std::uint64_t value() const { return hash_; }
+
+private:
+    static constexpr std::uint64_t kOffsetBasis = 0xcbf29ce484222325ull;
+    static constexpr std::uint64_t kPrime = 0x100000001b3ull;
+
+    std::uint64_t hash_{kOffsetBasis};
+};
+
+/**
+ * @brief Add the physical vehicle and rotor parameters to a hash
+ *
+ * Covers mass, gravity, inertia, airframe and every active rotor's published
+ * geometry and coefficients (VehicleConfig), plus RotorConfig. Bookkeeping
+ * such as rotor_geometry_revision is deliberately excluded.
+ */
+inline void hashPlantConfig(ConfigHash& hash,
+                            const SimulationState::VehicleConfig& vehicle,
+                            const SimulationState::RotorConfig& rotor) {
+    hash.add(vehicle.mass).add(vehicle.arm_length).add(vehicle.gravity).add(vehicle.drag_coefficient);
+    hash.add(static_cast<std::uint64_t>(vehicle.airframe)).add(static_cast<std::uint64_t>(vehicle.rotor_count));
+    hash.add(vehicle.Ixx).add(vehicle.Iyy).add(vehicle.Izz);
+    for (std::size_t i = 0; i < vehicle.rotor_count && i < vehicle.rotors.size(); ++i) {
+        const auto& geometry = vehicle.rotors[i];
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            hash.add(geometry.position_body_m[axis]).add(geometry.axis_body[axis]);
+        }
+        hash.add(geometry.direction).add(geometry.thrust_coeff).add(geometry.torque_coeff);
+    }
+    hash.add(rotor.thrust_coefficient).add(rotor.torque_coefficient).add(rotor.arm_length_m);
+}
+
+#endif // CONTROL_CONFIG_HASH_H
@@ -0,0 +1,163 @@
+/**
+ * @file gain_schedule.h
+ * @brief Table of feedback gains indexed by a scalar operating point
+ */
+
+#ifndef CONTROL_GAIN_SCHEDULE_H
+#define CONTROL_GAIN_SCHEDULE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/small_matrix.h"
+
+/**
+ * @class GainSchedule
+ * @brief Gains synthesized offline at a set of operating points, interpolated at runtime
+ *
+ * Points are kept in ascending order. interpolate() blends the two
+ * neighbouring gains linearly and clamps outside the table, so the runtime
+ * lookup is a binary search plus one fixed-size blend with no allocation.
+ *
+ * save()/load() use a small binary format tagged with a caller-supplied key
+ * (e.g. a hash of the plant and weights the gains were computed for); load()
+ * rejects files whose key, dimensions or format version do not match, so a
+ * stale cache is recomputed rather than silently reused.
+ *
+ * @tparam Nu Control inputs (gain rows)
+ * @tparam Nx States (gain columns)
+ */
+template <std::size_t Nu, std::size_t Nx>
+class GainSchedule {
+public:
+    using Gain = SmallMatrix<Nu, Nx>;
+
+    void clear() {
+        points_.clear();
+        gains_.clear();
+    }
+
+    /**
+     * @brief Insert a gain, keeping points sorted (an existing point is replaced)
+     */
+    void insert(double point, const Gain& gain) {
+        const auto it = std::lower_bound(points_.begin(), points_.end(), point);
+        const auto index = static_cast<std::size_t>(it - points_.begin());
+        if (it != points_.end() && *it == point) {
+            gains_[index] = gain;
+            return;
+        }
+        points_.insert(it, point);
+        gains_.insert(gains_.begin() + static_cast<std::ptrdiff_t>(index), gain);
+    }
+
+    bool empty() const { return points_.empty(); }
+    std::size_t size() const { return points_.size(); }
+    double point(std::size_t index) const { return points_[index]; }
+    const Gain& gain(std::size_t index) const { return gains_[index]; }
+
+    /**
+     * @brief Gain at an operating point (linear between entries, clamped at the ends)
+     * @return false if the table is empty (out is left untouched)
+     */
+    bool interpolate(double point, Gain& out) const {
+        if (points_.empty()) {
+            return false;
+        }
+        if (!(point > points_.front())) {
+            out = gains_.front();
+            return true;
+        }
+        if (point >= points_.back()) {
+            out = gains_.back();
+            return true;
+        }
+        const auto upper = static_cast<std::size_t>(
+            std::upper_bound(points_.begin(), points_.end(), point) - points_.begin());
+        const std::size_t lower = upper - 1;
+        const double t = (point - points_[lower]) / (points_[upper] - points_[lower]);
+        const Gain& a = gains_[lower];
+        const Gain& b = gains_[upper];
+        for (std::size_t i = 0; i < Nu; ++i) {
+            for (std::size_t j = 0; j < Nx; ++j) {
+                out.m[i][j] = a.m[i][j] + t * (b.m[i][j] - a.m[i][j]);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Write the table to a binary file
+     * @return false if the file could not be written
+     */
+    bool save(const std::string& path, std::uint64_t key) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        const Header header{kMagic, kFormatVersion, key, Nu, Nx, points_.size()};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (std::size_t i = 0; i < points_.size(); ++i) {
+            file.write(reinterpret_cast<const char*>(&points_[i]), sizeof(double));
+            file.write(reinterpret_cast<const char*>(gains_[i].m.data()), sizeof(double) * Nu * Nx);
+        }
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief Replace the table with one read from disk
+     * @return false (table unchanged) if the file is missing, truncated or was
+     *         written for a different key, size or format version
+     */
+    bool load(const std::string& path, std::uint64_t key) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        Header header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.magic != kMagic || header.version != kFormatVersion || header.key != key ||
+            header.rows != Nu || header.cols != Nx || header.count == 0 || header.count > kMaxPoints) {
+            return false;
+        }
+        std::vector<double> points(header.count);
+        std::vector<Gain> gains(header.count);
+        for (std::size_t i = 0; i < header.count; ++i) {
+            file.read(reinterpret_cast<char*>(&points[i]), sizeof(double));
+            file.read(reinterpret_cast<char*>(gains[i].m.data()), sizeof(double) * Nu * Nx);
+        }
+        if (!file || !std::is_sorted(points.begin(), points.end())) {
+            return false;
+        }
+        points_ = std::move(points);
+        gains_ = std::move(gains);
+        return true;
+    }
+
+private:
+    static constexpr std::uint32_t kMagic = 0x53474b41u;   ///< "AKGS" little-endian
+    static constexpr std::uint32_t kFormatVersion = 1;
+    static constexpr std::uint64_t kMaxPoints = 4096;      ///< Sanity bound on a corrupt header
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t key;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t count;
+    };
+
+    static_assert(sizeof(SmallMatrix<Nu, Nx>) == sizeof(double) * Nu * Nx,
+                  "SmallMatrix must be densely packed for binary I/O");
+
+    std::vector<double> points_;
+    std::vector<Gain> gains_;
+};
+
+#endif // CONTROL_GAIN_SCHEDULE_H
@@ -0,0 +1,235 @@
+/**
+ * @file hover_lqr.h
+ * @brief Hover linearization of the multirotor plant and LQR gain-schedule synthesis
+ */
+
+#ifndef CONTROL_HOVER_LQR_H
+#define CONTROL_HOVER_LQR_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "control/gain_schedule.h"
+#include "control/riccati.h"
+#include "control/trim.h"
+#include "core/jacobian.h"
+#include "core/simulation_state.h"
+#include "core/small_matrix.h"
+#include "modules/vehicle_derivative.h"
+
+/**
+ * @brief Layout of the 12-element hover error state
+ *
+ * [δp (3) | δv (3) | δθ (3) | δω (3)]
+ * Position and velocity errors are resolved in the heading frame (NED
+ * rotated by the reference yaw), δθ = 2·vec(q_ref⁻¹ ⊗ q) is the small body
+ * rotation from the reference attitude, and δω is the body-rate error.
+ */
+enum HoverErrorIndex : std::size_t {
+    kErrorPosition = 0,
+    kErrorVelocity = 3,
+    kErrorAttitude = 6,
+    kErrorRate = 9,
+    kHoverErrorSize = 12
+};
+
+/**
+ * @brief Continuous-time model δẋ = A δx + B δu about one trim point
+ */
+template <std::size_t RotorCount>
+struct HoverLinearization {
+    SmallMatrix<kHoverErrorSize, kHoverErrorSize> a{};
+    SmallMatrix<kHoverErrorSize, RotorCount> b{};   ///< Per rotor-speed input (rad/s)
+    SmallVector<RotorCount> trim_omega_rad_s{};      ///< Rotor speeds at trim (solveTrim())
+    double trim_residual{0.0};                       ///< ‖δẋ‖ at the trim point (should be ~0)
+};
+
+/**
+ * @brief Build the dynamic_models vehicle description from a VehicleConfig
+ *
+ * Uses the rotor geometry the plant publishes in vehicle.rotors (the first
+ * RotorCount entries) and the diagonal inertia.
+ */
+template <std::size_t RotorCount>
+dm_vehicle_config_t vehicleModelConfig(const SimulationState::VehicleConfig& vehicle) {
+    static_assert(RotorCount <= DM_MAX_ROTORS, "Rotor count exceeds dynamic_models limit");
+    dm_vehicle_config_t config{};
+    config.rotor_count = static_cast<int>(RotorCount);
+    config.mass = vehicle.mass;
+    config.gravity = vehicle.gravity;
+    const double inertia[3] = {vehicle.Ixx, vehicle.Iyy, vehicle.Izz};
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            config.inertia[i][j] = i == j ? inertia[i] : 0.0;
+            config.inertia_inv[i][j] = i == j ? 1.0 / inertia[i] : 0.0;
+        }
+    }
+    for (std::size_t i = 0; i < RotorCount; ++i) {
+        const auto& geometry = vehicle.rotors[i];
+        dm_rotor_config_t& rotor = config.rotors[i];
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            rotor.position_body[axis] = geometry.position_body_m[axis];
+            rotor.axis_body[axis] = geometry.axis_body[axis];
+        }
+        rotor.direction = geometry.direction;
+        rotor.thrust_coeff = geometry.thrust_coeff;
+        rotor.torque_coeff = geometry.torque_coeff;
+    }
+    return config;
+}
+
+/**
+ * @brief Hover error dynamics while pirouetting at a constant yaw rate
+ *
+ * The reference hovers at the origin with attitude yaw(ψ(t)), ψ̇ = yaw_rate,
+ * and body rate Ω = (0, 0, yaw_rate). Errors are taken relative to that
+ * reference in the rotating heading frame, where the plant (yaw invariant,
+ * with isotropic drag in calm air) is time-invariant; the derivative is
+ * evaluated at ψ = 0:
+ *
+ *   δṗ = v - Ω × δp,   δv̇ = v̇ - Ω × δv,   δθ̇ = 2·vec(q̇ - ½[0, Ω] ⊗ δq),   δω̇ = ω̇
+ *
+ * Templated on the scalar type like vehicleDerivative(), so linearizeHover()
+ * can differentiate it with dual numbers.
+ *
+ * @param drag_coefficient Air-relative drag (N per m/s); a wind would turn
+ *        with the heading frame, so the model is linearized in calm air
+ */
+template <std::size_t RotorCount, typename Scalar>
+void hoverErrorDerivative(const dm_vehicle_config_t& config, const Scalar* rotor_omega, double yaw_rate,
+                          double drag_coefficient,
+                          const std::array<Scalar, kHoverErrorSize>& x, std::array<Scalar, kHoverErrorSize>& dx) {
+    using std::sqrt;
+    VehicleStateVector<Scalar> full{};
+    const Scalar half[3] = {0.5 * x[kErrorAttitude], 0.5 * x[kErrorAttitude + 1], 0.5 * x[kErrorAttitude + 2]};
+    const Scalar dq_w_sq = 1.0 - half[0] * half[0] - half[1] * half[1] - half[2] * half[2];
+    const Scalar dq_w = primal(dq_w_sq) > 0.0 ? sqrt(dq_w_sq) : Scalar(0.0);
+    for (std::size_t i = 0; i < 3; ++i) {
+        full[kStatePosition + i] = x[kErrorPosition + i];
+        full[kStateVelocity + i] = x[kErrorVelocity + i];
+        full[kStateQuaternion + 1 + i] = half[i];
+        full[kStateAngularRate + i] = x[kErrorRate + i];
+    }
+    full[kStateQuaternion] = dq_w;
+    full[kStateAngularRate + 2] += yaw_rate;
+
+    VehicleStateVector<Scalar> rate{};
+    AirRelativeDrag drag;
+    drag.coefficient = drag_coefficient;
+    vehicleDerivative<RotorCount, Scalar>(config, rotor_omega, full, rate, drag);
+
+    // Rotating-frame correction -Ω × e with Ω × e = (-r e_y, r e_x, 0)
+    for (std::size_t i = 0; i < 3; ++i) {
+        dx[kErrorPosition + i] = rate[kStatePosition + i];
+        dx[kErrorVelocity + i] = rate[kStateVelocity + i];
+    }
+    for (std::size_t base : {std::size_t{kErrorPosition}, std::size_t{kErrorVelocity}}) {
+        dx[base + 0] += yaw_rate * x[base + 1];
+        dx[base + 1] -= yaw_rate * x[base + 0];
+    }
+
+    // ½[0, Ω] ⊗ δq with Ω = (0, 0, r)
+    const Scalar reference[4] = {-0.5 * yaw_rate * half[2],
+                                 -0.5 * yaw_rate * half[1],
+                                  0.5 * yaw_rate * half[0],
+                                  0.5 * yaw_rate * dq_w};
+    for (std::size_t i = 0; i < 3; ++i) {
+        dx[kErrorAttitude + i] = 2.0 * (rate[kStateQuaternion + 1 + i] - reference[1 + i]);
+        dx[kErrorRate + i] = rate[kStateAngularRate + i];
+    }
+}
+
+/**
+ * @brief Linearize the hover error dynamics with forward-mode AD
+ *
+ * The trim rotor speeds come from solveTrim() for the pirouette (falling
+ * back to the closed-form hover speed if it fails), so uneven rotor
+ * coefficients or geometry still linearize about a true equilibrium. A and
+ * B are the exact derivatives there (one dual-number evaluation of
+ * hoverErrorDerivative(), see forwardJacobian()), so the gains carry no
+ * finite-difference truncation or round-off error. Drag adds
+ * -drag_coefficient / mass to the velocity rows of A.
+ */
+template <std::size_t RotorCount>
+HoverLinearization<RotorCount> linearizeHover(const dm_vehicle_config_t& config, double yaw_rate,
+                                              double drag_coefficient = 0.0) {
+    HoverLinearization<RotorCount> model;
+    TrimCondition pirouette;
+    pirouette.turn_rate_rad_s = yaw_rate;
+    pirouette.drag.coefficient = drag_coefficient;
+    const TrimSolution<RotorCount> trim = solveTrim<RotorCount>(config, pirouette);
+    if (trim.converged) {
+        model.trim_omega_rad_s = trim.rotor_omega_rad_s;
+    } else {
+        model.trim_omega_rad_s.fill(hoverRotorSpeed<RotorCount>(config));
+    }
+    const SmallVector<RotorCount>& omega = model.trim_omega_rad_s;
+
+    const SmallVector<kHoverErrorSize> x{};
+    SmallVector<kHoverErrorSize> derivative{};
+    forwardJacobian<kHoverErrorSize, RotorCount>(
+        [&config, yaw_rate, drag_coefficient](const auto& error, const auto* rotor_omega, auto& dx) {
+            hoverErrorDerivative<RotorCount>(config, rotor_omega, yaw_rate, drag_coefficient, error, dx);
+        },
+        x, omega, derivative, model.a, model.b);
+
+    double residual = 0.0;
+    for (double value : derivative) {
+        residual += value * value;
+    }
+    model.trim_residual = std::sqrt(residual);
+    return model;
+}
+
+/**
+ * @brief Outcome of synthesizeHoverSchedule()
+ */
+struct HoverLqrReport {
+    bool success{false};            ///< Every point converged
+    std::size_t max_iterations{0};  ///< Worst Newton–Kleinman iteration count over the points
+    double max_trim_residual{0.0};  ///< Worst trim residual over the points
+};
+
+/**
+ * @brief LQR gains for hover at each scheduled yaw rate
+ *
+ * Weights follow Bryson's rule: Q = diag(1/max_state_error²),
+ * R = I/max_rotor_speed_delta², so each entry is the error (or rotor-speed
+ * excursion) considered "large" in its own units.
+ */
+template <std::size_t RotorCount, std::size_t Points>
+HoverLqrReport synthesizeHoverSchedule(const dm_vehicle_config_t& config,
+                                       const std::array<double, kHoverErrorSize>& max_state_error,
+                                       double max_rotor_speed_delta,
+                                       const std::array<double, Points>& yaw_rates,
+                                       GainSchedule<RotorCount, kHoverErrorSize>& schedule,
+                                       double drag_coefficient = 0.0) {
+    HoverLqrReport report;
+    schedule.clear();
+    SmallMatrix<kHoverErrorSize, kHoverErrorSize> q{};
+    for (std::size_t i = 0; i < kHoverErrorSize; ++i) {
+        q.m[i][i] = 1.0 / (max_state_error[i] * max_state_error[i]);
+    }
+    SmallMatrix<RotorCount, RotorCount> r{};
+    for (std::size_t i = 0; i < RotorCount; ++i) {
+        r.m[i][i] = 1.0 / (max_rotor_speed_delta * max_rotor_speed_delta);
+    }
+
+    report.success = true;
+    for (double yaw_rate : yaw_rates) {
+        const HoverLinearization<RotorCount> model = linearizeHover<RotorCount>(config, yaw_rate, drag_coefficient);
+        const CareSolution<kHoverErrorSize, RotorCount> solution = solveCare(model.a, model.b, q, r);
+        report.max_iterations = std::max(report.max_iterations, solution.iterations);
+        report.max_trim_residual = std::max(report.max_trim_residual, model.trim_residual);
+        if (!solution.converged) {
+            report.success = false;
+            continue;
+        }
+        schedule.insert(yaw_rate, solution.gain);
+    }
+    return report;
+}
+
+#endif // CONTROL_HOVER_LQR_H
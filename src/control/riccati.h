@@ -0,0 +1,211 @@
+/**
+ * @file riccati.h
+ * @brief Continuous-time Lyapunov and algebraic Riccati equation solvers
+ *
+ * Offline synthesis code: sizes are fixed at compile time, but the
+ * Kronecker-form Lyapunov solve uses a heap workspace of (N²)² doubles, so
+ * call these from initialization or tools, not from a control tick.
+ */
+
+#ifndef CONTROL_RICCATI_H
+#define CONTROL_RICCATI_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "core/small_matrix.h"
+
+namespace riccati_detail {
+
+/// Solve the dense system M x = b in place (M is n×n row-major); false if singular
+inline bool solveDense(std::vector<double>& m, std::vector<double>& b, std::size_t n) {
+    for (std::size_t col = 0; col < n; ++col) {
+        std::size_t pivot = col;
+        double best = std::abs(m[col * n + col]);
+        for (std::size_t row = col + 1; row < n; ++row) {
+            const double magnitude = std::abs(m[row * n + col]);
+            if (magnitude > best) {
+                best = magnitude;
+                pivot = row;
+            }
+        }
+        if (!(best > 0.0)) {
+            return false;
+        }
+        if (pivot != col) {
+            for (std::size_t j = 0; j < n; ++j) {
+                std::swap(m[col * n + j], m[pivot * n + j]);
+            }
+            std::swap(b[col], b[pivot]);
+        }
+        const double inv = 1.0 / m[col * n + col];
+        for (std::size_t row = col + 1; row < n; ++row) {
+            const double factor = m[row * n + col] * inv;
+            if (factor == 0.0) {
+                continue;
+            }
+            for (std::size_t j = col; j < n; ++j) {
+                m[row * n + j] -= factor * m[col * n + j];
+            }
+            b[row] -= factor * b[col];
+        }
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        double sum = b[i];
+        for (std::size_t j = i + 1; j < n; ++j) {
+            sum -= m[i * n + j] * b[j];
+        }
+        b[i] = sum / m[i * n + i];
+    }
+    return true;
+}
+
+template <std::size_t N>
+double frobeniusNorm(const SmallMatrix<N, N>& a) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            sum += a.m[i][j] * a.m[i][j];
+        }
+    }
+    return std::sqrt(sum);
+}
+
+}  // namespace riccati_detail
+
+/**
+ * @brief Solve Aᵀ X + X A + C = 0 for X
+ *
+ * Uses the Kronecker form (I ⊗ Aᵀ + Aᵀ ⊗ I) vec(X) = -vec(C). Symmetric C
+ * gives symmetric X; the result is symmetrized to remove round-off.
+ *
+ * @return false if A and -A share an eigenvalue (no unique solution)
+ */
+template <std::size_t N>
+bool solveLyapunov(const SmallMatrix<N, N>& a, const SmallMatrix<N, N>& c, SmallMatrix<N, N>& x) {
+    constexpr std::size_t kUnknowns = N * N;
+    std::vector<double> m(kUnknowns * kUnknowns, 0.0);
+    std::vector<double> rhs(kUnknowns, 0.0);
+    // Row (i, j) of vec(X) (column-major, k = i + j N):
+    //   Σ_p A(p, i) X(p, j) + Σ_q X(i, q) A(q, j) = -C(i, j)
+    for (std::size_t j = 0; j < N; ++j) {
+        for (std::size_t i = 0; i < N; ++i) {
+            const std::size_t row = i + j * N;
+            for (std::size_t p = 0; p < N; ++p) {
+                m[row * kUnknowns + (p + j * N)] += a.m[p][i];
+            }
+            for (std::size_t q = 0; q < N; ++q) {
+                m[row * kUnknowns + (i + q * N)] += a.m[q][j];
+            }
+            rhs[row] = -c.m[i][j];
+        }
+    }
+    if (!riccati_detail::solveDense(m, rhs, kUnknowns)) {
+        return false;
+    }
+    for (std::size_t j = 0; j < N; ++j) {
+        for (std::size_t i = 0; i < N; ++i) {
+            x.m[i][j] = rhs[i + j * N];
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = i + 1; j < N; ++j) {
+            const double mean = 0.5 * (x.m[i][j] + x.m[j][i]);
+            x.m[i][j] = mean;
+            x.m[j][i] = mean;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Result of solveCare()
+ */
+template <std::size_t Nx, std::size_t Nu>
+struct CareSolution {
+    SmallMatrix<Nu, Nx> gain{};     ///< K = R⁻¹ Bᵀ P (u = -K x)
+    SmallMatrix<Nx, Nx> cost{};     ///< Stabilizing Riccati solution P
+    std::size_t iterations{0};      ///< Newton–Kleinman iterations used
+    bool converged{false};
+};
+
+/**
+ * @brief Solve AᵀP + PA - PBR⁻¹BᵀP + Q = 0 by Newton–Kleinman iteration
+ *
+ * The initial stabilizing gain comes from Bass' method,
+ * K₀ = Bᵀ Z⁻¹ with (A + βI) Z + Z (A + βI)ᵀ = 2BBᵀ and β above the spectral
+ * abscissa of A (the ∞-norm is used as a cheap bound). Each Newton step
+ * solves one Lyapunov equation for the current closed loop
+ *
+ *   (A - BK)ᵀ P + P (A - BK) + Q + KᵀRK = 0,   K ← R⁻¹BᵀP
+ *
+ * and converges quadratically from any stabilizing start. (A, B) must be
+ * stabilizable and R positive definite.
+ *
+ * @param tolerance Stop when ‖P_k+1 - P_k‖_F ≤ tolerance · ‖P_k+1‖_F
+ */
+template <std::size_t Nx, std::size_t Nu>
+CareSolution<Nx, Nu> solveCare(const SmallMatrix<Nx, Nx>& a, const SmallMatrix<Nx, Nu>& b,
+                               const SmallMatrix<Nx, Nx>& q, const SmallMatrix<Nu, Nu>& r,
+                               std::size_t max_iterations = 50, double tolerance = 1e-12) {
+    CareSolution<Nx, Nu> solution;
+    SmallMatrix<Nu, Nu> r_inverse{};
+    if (!invert(r, r_inverse)) {
+        return solution;
+    }
+    const SmallMatrix<Nu, Nx> bt = transpose(b);
+
+    // Bass initialization.
+    double beta = 0.0;
+    for (std::size_t i = 0; i < Nx; ++i) {
+        double row_sum = 0.0;
+        for (std::size_t j = 0; j < Nx; ++j) {
+            row_sum += std::abs(a.m[i][j]);
+        }
+        beta = std::max(beta, row_sum);
+    }
+    beta += 1.0;
+    SmallMatrix<Nx, Nx> shifted_t = transpose(a);
+    for (std::size_t i = 0; i < Nx; ++i) {
+        shifted_t.m[i][i] += beta;
+    }
+    SmallMatrix<Nx, Nx> bbt = b * bt;
+    for (std::size_t i = 0; i < Nx; ++i) {
+        for (std::size_t j = 0; j < Nx; ++j) {
+            bbt.m[i][j] *= -2.0;
+        }
+    }
+    SmallMatrix<Nx, Nx> z{};
+    SmallMatrix<Nx, Nx> z_inverse{};
+    if (!solveLyapunov(shifted_t, bbt, z) || !invert(z, z_inverse, 0.0)) {
+        return solution;
+    }
+    SmallMatrix<Nu, Nx> k = bt * z_inverse;
+
+    SmallMatrix<Nx, Nx> p_previous{};
+    for (std::size_t iteration = 1; iteration <= max_iterations; ++iteration) {
+        const SmallMatrix<Nx, Nx> closed = a - b * k;
+        SmallMatrix<Nx, Nx> c = q + transpose(k) * r * k;
+        SmallMatrix<Nx, Nx> p{};
+        if (!solveLyapunov(closed, c, p)) {
+            return solution;
+        }
+        k = r_inverse * bt * p;
+        solution.iterations = iteration;
+
+        const double change = riccati_detail::frobeniusNorm(p - p_previous);
+        const double scale = riccati_detail::frobeniusNorm(p);
+        p_previous = p;
+        if (iteration > 1 && change <= tolerance * scale) {
+            solution.converged = true;
+            break;
+        }
+    }
+    solution.gain = k;
+    solution.cost = p_previous;
+    return solution;
+}
+
+#endif // CONTROL_RICCATI_H
@@ -0,0 +1,292 @@
+/**
+ * @file trim.h
+ * @brief Newton solver for multirotor equilibrium (trim) rotor speeds and attitude
+ */
+
+#ifndef CONTROL_TRIM_H
+#define CONTROL_TRIM_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "core/jacobian.h"
+#include "core/small_matrix.h"
+#include "modules/vehicle_derivative.h"
+
+/**
+ * @brief Steady flight condition to trim for
+ *
+ * Straight flight at constant velocity (hover, cruise, climb or descent)
+ * when turn_rate_rad_s is zero; otherwise a coordinated level turn in which
+ * the velocity vector and the heading both rotate at turn_rate_rad_s.
+ * Drag acts on the velocity relative to drag.wind_ned, so a turn is only a
+ * true equilibrium in calm air.
+ */
+struct TrimCondition {
+    std::array<double, 3> velocity_ned_m_s{};   ///< Velocity at the start of the turn (m/s)
+    double heading_rad{0.0};                    ///< Yaw angle the attitude is solved at
+    double turn_rate_rad_s{0.0};                ///< Constant heading rate ψ̇ (rad/s)
+    AirRelativeDrag drag{};                     ///< Vehicle drag coefficient and steady wind (none by default)
+};
+
+struct TrimSettings {
+    std::size_t max_iterations{25};
+    double tolerance{1e-9};         ///< ‖residual‖∞ in m/s² and rad/s²
+};
+
+/**
+ * @brief Unknowns of the trim problem: [roll, pitch, ω_0 … ω_{R-1}]
+ */
+enum TrimUnknownIndex : std::size_t {
+    kTrimRoll = 0,
+    kTrimPitch = 1,
+    kTrimRotorSpeed = 2
+};
+
+constexpr std::size_t kTrimResidualSize = 6;    ///< Translational then rotational acceleration error
+
+/**
+ * @brief Equilibrium found by solveTrim()
+ */
+template <std::size_t RotorCount>
+struct TrimSolution {
+    bool converged{false};
+    std::size_t iterations{0};                  ///< Newton steps taken
+    double residual{0.0};                       ///< ‖residual‖∞ at the returned point
+    double roll_rad{0.0};
+    double pitch_rad{0.0};
+    std::array<double, 4> quaternion{1.0, 0.0, 0.0, 0.0};  ///< Body-to-NED [w, x, y, z]
+    std::array<double, 3> body_rate_rad_s{};
+    SmallVector<RotorCount> rotor_omega_rad_s{};
+};
+
+/**
+ * @brief Common rotor speed whose total vertical thrust balances gravity
+ *
+ * Exact hover trim for layouts whose rotors cancel each other's moments at
+ * equal speed (every layout in airframe_layout.h), and the starting point
+ * of solveTrim(); returns 0 if the rotors produce no upward thrust.
+ */
+template <std::size_t RotorCount>
+double hoverRotorSpeed(const dm_vehicle_config_t& config) {
+    double lift_per_omega_sq = 0.0;
+    for (std::size_t i = 0; i < RotorCount; ++i) {
+        lift_per_omega_sq += -config.rotors[i].axis_body[2] * config.rotors[i].thrust_coeff;
+    }
+    return lift_per_omega_sq > 0.0 ? std::sqrt(config.mass * config.gravity / lift_per_omega_sq) : 0.0;
+}
+
+/**
+ * @brief Acceleration error of the vehicle held at the trim unknowns
+ *
+ * The attitude is yaw(heading)·pitch·roll and the body rate is the one that
+ * keeps roll and pitch constant while the heading turns at ψ̇:
+ * (-ψ̇ sinθ, ψ̇ sinφ cosθ, ψ̇ cosφ cosθ). At equilibrium the translational
+ * acceleration equals the turn's centripetal term (0, 0, ψ̇) × v and the
+ * angular acceleration is zero. Drag is balanced by tilting the thrust.
+ *
+ * Templated on the scalar type so solveTrim() can differentiate it exactly.
+ */
+template <std::size_t RotorCount, typename Scalar>
+void trimResidual(const dm_vehicle_config_t& config, const TrimCondition& condition,
+                  const std::array<Scalar, kTrimRotorSpeed + RotorCount>& unknowns,
+                  std::array<Scalar, kTrimResidualSize>& residual) {
+    using std::cos;
+    using std::sin;
+    const Scalar& roll = unknowns[kTrimRoll];
+    const Scalar& pitch = unknowns[kTrimPitch];
+    const Scalar c_r = cos(0.5 * roll);
+    const Scalar s_r = sin(0.5 * roll);
+    const Scalar c_p = cos(0.5 * pitch);
+    const Scalar s_p = sin(0.5 * pitch);
+    const double c_y = std::cos(0.5 * condition.heading_rad);
+    const double s_y = std::sin(0.5 * condition.heading_rad);
+
+    VehicleStateVector<Scalar> x{};
+    for (std::size_t i = 0; i < 3; ++i) {
+        x[kStateVelocity + i] = condition.velocity_ned_m_s[i];
+    }
+    x[kStateQuaternion + 0] = c_y * (c_r * c_p) + s_y * (s_r * s_p);
+    x[kStateQuaternion + 1] = c_y * (s_r * c_p) - s_y * (c_r * s_p);
+    x[kStateQuaternion + 2] = c_y * (c_r * s_p) + s_y * (s_r * c_p);
+    x[kStateQuaternion + 3] = s_y * (c_r * c_p) - c_y * (s_r * s_p);
+
+    const double yaw_rate = condition.turn_rate_rad_s;
+    const Scalar cos_pitch = cos(pitch);
+    x[kStateAngularRate + 0] = -yaw_rate * sin(pitch);
+    x[kStateAngularRate + 1] = yaw_rate * (sin(roll) * cos_pitch);
+    x[kStateAngularRate + 2] = yaw_rate * (cos(roll) * cos_pitch);
+
+    VehicleStateVector<Scalar> rate{};
+    vehicleDerivative<RotorCount, Scalar>(config, unknowns.data() + kTrimRotorSpeed, x, rate, condition.drag);
+
+    const double* v = condition.velocity_ned_m_s.data();
+    residual[0] = rate[kStateVelocity + 0] + yaw_rate * v[1];
+    residual[1] = rate[kStateVelocity + 1] - yaw_rate * v[0];
+    residual[2] = rate[kStateVelocity + 2];
+    for (std::size_t i = 0; i < 3; ++i) {
+        residual[3 + i] = rate[kStateAngularRate + i];
+    }
+}
+
+/**
+ * @brief Solve for the rotor speeds and roll/pitch that hold a steady condition
+ *
+ * Newton iteration on trimResidual() with its exact Jacobian (forward-mode
+ * AD, see dualJacobian()) and a backtracking line search. Six equations
+ * constrain 2 + RotorCount unknowns, so each step is the minimum-norm
+ * correction Δ = -Jᵀ(JJᵀ)⁻¹F, with rotor speeds measured in units of the
+ * hover speed so angles and speeds weigh alike; for a quad this is the plain
+ * Newton step, for hex and octo it keeps the rotor speeds as even as the
+ * condition allows. A converged quad hover trim takes two or three steps.
+ *
+ * @param config Vehicle description (as built by vehicleModelConfig())
+ * @param condition Flight condition to hold
+ * @param settings Iteration limit and tolerance
+ * @param initial_guess Previous solution to start from (e.g. a neighbouring
+ *        point of a sweep); hover at the closed-form speed if null
+ */
+template <std::size_t RotorCount>
+TrimSolution<RotorCount> solveTrim(const dm_vehicle_config_t& config, const TrimCondition& condition,
+                                   const TrimSettings& settings = TrimSettings{},
+                                   const TrimSolution<RotorCount>* initial_guess = nullptr) {
+    constexpr std::size_t kUnknowns = kTrimRotorSpeed + RotorCount;
+    constexpr std::size_t kEquations = kTrimResidualSize;
+    static_assert(kUnknowns >= kEquations, "Trim needs at least four rotors");
+
+    const double hover_omega = hoverRotorSpeed<RotorCount>(config);
+    SmallVector<kUnknowns> z{};
+    if (initial_guess != nullptr) {
+        z[kTrimRoll] = initial_guess->roll_rad;
+        z[kTrimPitch] = initial_guess->pitch_rad;
+        for (std::size_t i = 0; i < RotorCount; ++i) {
+            z[kTrimRotorSpeed + i] = initial_guess->rotor_omega_rad_s[i];
+        }
+    } else {
+        for (std::size_t i = 0; i < RotorCount; ++i) {
+            z[kTrimRotorSpeed + i] = hover_omega;
+        }
+    }
+    SmallVector<kUnknowns> scale{};
+    scale.fill(std::max(hover_omega, 1.0));
+    scale[kTrimRoll] = 1.0;
+    scale[kTrimPitch] = 1.0;
+
+    auto residualNorm = [&config, &condition](const SmallVector<kUnknowns>& point) {
+        SmallVector<kEquations> f{};
+        trimResidual<RotorCount, double>(config, condition, point, f);
+        double norm = 0.0;
+        for (double value : f) {
+            norm = std::max(norm, std::abs(value));
+        }
+        return norm;
+    };
+
+    TrimSolution<RotorCount> solution;
+    SmallVector<kEquations> f{};
+    SmallMatrix<kEquations, kUnknowns> jacobian{};
+    for (;;) {
+        dualJacobian<kEquations, kUnknowns>(
+            [&config, &condition](const auto& unknowns, auto& residual) {
+                trimResidual<RotorCount>(config, condition, unknowns, residual);
+            },
+            z, f, jacobian);
+        solution.residual = 0.0;
+        for (double value : f) {
+            solution.residual = std::max(solution.residual, std::abs(value));
+        }
+        solution.converged = solution.residual <= settings.tolerance;
+        if (solution.converged || solution.iterations >= settings.max_iterations ||
+            !std::isfinite(solution.residual)) {
+            break;
+        }
+
+        // Minimum-norm step in scaled unknowns: solve (J_s J_sᵀ) y = F by Cholesky.
+        SmallMatrix<kEquations, kUnknowns> scaled = jacobian;
+        for (std::size_t i = 0; i < kEquations; ++i) {
+            for (std::size_t j = 0; j < kUnknowns; ++j) {
+                scaled.m[i][j] *= scale[j];
+            }
+        }
+        SmallMatrix<kEquations, kEquations> gram = scaled * transpose(scaled);
+        bool factored = true;
+        for (std::size_t j = 0; j < kEquations && factored; ++j) {
+            double diagonal = gram.m[j][j];
+            for (std::size_t k = 0; k < j; ++k) {
+                diagonal -= gram.m[j][k] * gram.m[j][k];
+            }
+            if (!(diagonal > 0.0)) {
+                factored = false;
+                break;
+            }
+            gram.m[j][j] = std::sqrt(diagonal);
+            for (std::size_t i = j + 1; i < kEquations; ++i) {
+                double sum = gram.m[i][j];
+                for (std::size_t k = 0; k < j; ++k) {
+                    sum -= gram.m[i][k] * gram.m[j][k];
+                }
+                gram.m[i][j] = sum / gram.m[j][j];
+            }
+        }
+        if (!factored) {
+            break;  // Singular: the rotors cannot control some residual direction
+        }
+        SmallVector<kEquations> y = f;
+        for (std::size_t i = 0; i < kEquations; ++i) {
+            for (std::size_t k = 0; k < i; ++k) {
+                y[i] -= gram.m[i][k] * y[k];
+            }
+            y[i] /= gram.m[i][i];
+        }
+        for (std::size_t i = kEquations; i-- > 0;) {
+            for (std::size_t k = i + 1; k < kEquations; ++k) {
+                y[i] -= gram.m[k][i] * y[k];
+            }
+            y[i] /= gram.m[i][i];
+        }
+        SmallVector<kUnknowns> step = transpose(scaled) * y;
+        for (std::size_t j = 0; j < kUnknowns; ++j) {
+            step[j] *= -scale[j];
+        }
+
+        // Backtrack until the residual decreases (the full step almost always does).
+        double alpha = 1.0;
+        SmallVector<kUnknowns> trial{};
+        for (int halving = 0; halving < 8; ++halving, alpha *= 0.5) {
+            for (std::size_t j = 0; j < kUnknowns; ++j) {
+                trial[j] = z[j] + alpha * step[j];
+            }
+            if (residualNorm(trial) < (1.0 - 1e-4 * alpha) * solution.residual) {
+                break;
+            }
+        }
+        z = trial;
+        ++solution.iterations;
+    }
+
+    solution.roll_rad = z[kTrimRoll];
+    solution.pitch_rad = z[kTrimPitch];
+    for (std::size_t i = 0; i < RotorCount; ++i) {
+        // Thrust depends on ω², so a speed that crossed zero is the same trim.
+        solution.rotor_omega_rad_s[i] = std::abs(z[kTrimRotorSpeed + i]);
+    }
+    const double c_r = std::cos(0.5 * solution.roll_rad);
+    const double s_r = std::sin(0.5 * solution.roll_rad);
+    const double c_p = std::cos(0.5 * solution.pitch_rad);
+    const double s_p = std::sin(0.5 * solution.pitch_rad);
+    const double c_y = std::cos(0.5 * condition.heading_rad);
+    const double s_y = std::sin(0.5 * condition.heading_rad);
+    solution.quaternion = {c_y * c_r * c_p + s_y * s_r * s_p,
+                           c_y * s_r * c_p - s_y * c_r * s_p,
+                           c_y * c_r * s_p + s_y * s_r * c_p,
+                           s_y * c_r * c_p - c_y * s_r * s_p};
+    const double yaw_rate = condition.turn_rate_rad_s;
+    solution.body_rate_rad_s = {-yaw_rate * std::sin(solution.pitch_rad),
+                                yaw_rate * std::sin(solution.roll_rad) * std::cos(solution.pitch_rad),
+                                yaw_rate * std::cos(solution.roll_rad) * std::cos(solution.pitch_rad)};
+    return solution;
+}
+
+#endif // CONTROL_TRIM_H
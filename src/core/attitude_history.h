@@ -0,0 +1,67 @@
+/**
+ * @file attitude_history.h
+ * @brief Sampling and pruning of the plotted attitude history
+ */
+
+#ifndef CORE_ATTITUDE_HISTORY_H
+#define CORE_ATTITUDE_HISTORY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "core/memory_accounting.h"
+#include "core/simulation_state.h"
+
+/**
+ * @brief Append the current attitude to state.attitude_history and drop stale samples
+ *
+ * Samples at most once per sample_interval (times the decimation the
+ * History memory cap imposes), keeps window_seconds of history (and never
+ * more samples than the window can hold), and starts over when simulation
+ * time runs backwards (reset or rewind).
+ */
+inline void captureAttitudeSample(SimulationState& state) {
+    auto& history = state.attitude_history;
+    const double now = state.time_seconds;
+
+    if (!std::isfinite(now)) {
+        return;
+    }
+
+    if (now < history.last_sample_time) {
+        history.samples.clear();
+        history.last_sample_time = -std::numeric_limits<double>::infinity();
+    }
+
+    const double interval = std::max(1e-6, history.sample_interval) * history.decimation;
+    if (!history.samples.empty() && (now - history.last_sample_time) < interval) {
+        return;
+    }
+
+    const EulerAngles& euler = state.euler();
+    SimulationState::AttitudeSample sample;
+    sample.timestamp = now;
+    sample.quaternion = state.quaternion;
+    sample.roll = euler.roll;
+    sample.pitch = euler.pitch;
+    sample.yaw = euler.yaw;
+    sample.angular_rate = state.angular_rate_rad_s;
+    history.samples.emplace_back(sample);
+    history.last_sample_time = now;
+
+    const double window = std::max(interval, std::max(0.1, history.window_seconds));
+    while (!history.samples.empty() && (now - history.samples.front().timestamp) > window) {
+        history.samples.pop_front();
+    }
+
+    const std::size_t max_samples = static_cast<std::size_t>(window / interval) + 8;
+    while (history.samples.size() > max_samples && !history.samples.empty()) {
+        history.samples.pop_front();
+    }
+
+    enforceMemoryCap(MemoryTag::History, history.samples, history.decimation);
+}
+
+#endif // CORE_ATTITUDE_HISTORY_H
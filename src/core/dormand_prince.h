@@ -0,0 +1,338 @@
+/**
+ * @file dormand_prince.h
+ * @brief Embedded Runge-Kutta 5(4) integrator (Dormand-Prince) with dense output
+ */
+
+#ifndef CORE_DORMAND_PRINCE_H
+#define CORE_DORMAND_PRINCE_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Continuous extension of an adaptive integration over one interval
+ *
+ * Stores the fourth-order Dormand-Prince interpolation coefficients of every
+ * accepted step so consumers can evaluate the trajectory at any time inside
+ * the integrated interval without re-running the dynamics.
+ *
+ * clear() keeps the segment storage, so a trajectory that is refilled every
+ * frame stops allocating once it has seen the busiest frame.
+ *
+ * @tparam N State dimension
+ */
+template <std::size_t N>
+class DenseTrajectory {
+public:
+    using Vector = std::array<double, N>;
+
+    /**
+     * @struct Segment
+     * @brief Interpolant for one accepted step [t0, t0 + h]
+     */
+    struct Segment {
+        double t0{0.0};                 ///< Step start time (s)
+        double h{0.0};                  ///< Step length (s)
+        std::array<Vector, 5> coeff{};  ///< Hairer's rcont1..rcont5 coefficients
+    };
+
+    /// Drop all segments (capacity is retained)
+    void clear() { segments_.clear(); }
+
+    /// Append an accepted step; segments must be pushed in time order
+    void append(const Segment& segment) { segments_.push_back(segment); }
+
+    bool empty() const { return segments_.empty(); }
+    std::size_t size() const { return segments_.size(); }
+    double startTime() const { return segments_.empty() ? 0.0 : segments_.front().t0; }
+    double endTime() const {
+        return segments_.empty() ? 0.0 : segments_.back().t0 + segments_.back().h;
+    }
+
+    /**
+     * @brief Evaluate the interpolant at time t
+     * @param t Query time (s); must lie within [startTime(), endTime()]
+     * @param out Interpolated state
+     * @return false if the trajectory is empty or t is outside the covered interval
+     */
+    bool sample(double t, Vector& out) const {
+        if (segments_.empty() || t < startTime() || t > endTime()) {
+            return false;
+        }
+        // Segments are contiguous and sorted; find the last one starting at or before t.
+        auto it = std::upper_bound(segments_.begin(), segments_.end(), t,
+                                   [](double time, const Segment& s) { return time < s.t0; });
+        const Segment& s = (it == segments_.begin()) ? *it : *(it - 1);
+
+        const double theta = (s.h > 0.0) ? std::clamp((t - s.t0) / s.h, 0.0, 1.0) : 0.0;
+        const double theta1 = 1.0 - theta;
+        for (std::size_t i = 0; i < N; ++i) {
+            out[i] = s.coeff[0][i] +
+                     theta * (s.coeff[1][i] +
+                              theta1 * (s.coeff[2][i] +
+                                        theta * (s.coeff[3][i] + theta1 * s.coeff[4][i])));
+        }
+        return true;
+    }
+
+private:
+    std::vector<Segment> segments_;
+};
+
+/**
+ * @brief Adaptive Dormand-Prince RK5(4) stepper with FSAL reuse
+ *
+ * Uses the classic DOPRI5 tableau: six new derivative evaluations per step,
+ * with the seventh stage (evaluated at the accepted end point) reused as the
+ * first stage of the next step. The local error estimate from the embedded
+ * fourth-order solution drives the step size, so smooth phases take long
+ * steps while fast transients are resolved with short ones.
+ *
+ * The derivative functor is called as `f(t, y, dydt)` with
+ * `const std::array<double, N>&` input and `std::array<double, N>&` output.
+ *
+ * @tparam N State dimension
+ */
+template <std::size_t N>
+class DormandPrince45 {
+public:
+    using Vector = std::array<double, N>;
+
+    /**
+     * @struct Settings
+     * @brief Error-control and step-size limits
+     */
+    struct Settings {
+        double relative_tolerance{1e-6};  ///< Relative local error tolerance
+        double absolute_tolerance{1e-8};  ///< Absolute local error tolerance
+        double initial_step{0.0025};      ///< First trial step when no history exists (s)
+        double min_step{1e-7};            ///< Smallest step before giving up (s)
+        double max_step{0.05};            ///< Largest step ever attempted (s)
+        double safety{0.9};               ///< Safety factor on the optimal step estimate
+        double min_scale{0.2};            ///< Largest shrink per step
+        double max_scale{5.0};            ///< Largest growth per step
+    };
+
+    /**
+     * @struct Stats
+     * @brief Work counters accumulated across calls
+     */
+    struct Stats {
+        std::uint64_t accepted_steps{0};        ///< Steps that passed error control
+        std::uint64_t rejected_steps{0};        ///< Trial steps retried with a smaller h
+        std::uint64_t derivative_evaluations{0}; ///< Calls to the derivative functor
+    };
+
+    enum class Status {
+        Ok,             ///< Reached the requested end time
+        StepUnderflow,  ///< Error control demanded h < min_step
+        NonFinite       ///< Derivative produced NaN/Inf at the minimum step
+    };
+
+    Settings settings;
+
+    /// Forget the step-size history (next call starts from settings.initial_step)
+    void reset() { next_step_ = 0.0; }
+
+    /// Step size the controller will try first on the next call (0 if none yet)
+    double suggestedStep() const { return next_step_; }
+
+    /// Resume with a step-size history saved from suggestedStep() (checkpoint/rewind)
+    void restoreStep(double step) { next_step_ = std::max(step, 0.0); }
+
+    /**
+     * @brief Integrate y from t0 to t1
+     *
+     * The first stage is evaluated fresh on every call because callers
+     * usually change inputs (e.g. rotor commands) between calls; FSAL reuse
+     * applies to consecutive steps within the interval.
+     *
+     * @param f Derivative functor
+     * @param t0 Start time (s)
+     * @param t1 End time (s), t1 > t0
+     * @param y State at t0 on entry; state at t1 on success (untouched on failure)
+     * @param stats Counters to accumulate into
+     * @param dense Optional trajectory that receives one segment per accepted step
+     * @return Status::Ok on success
+     */
+    template <typename Derivative>
+    Status integrate(Derivative&& f, double t0, double t1, Vector& y, Stats& stats,
+                     DenseTrajectory<N>* dense = nullptr) {
+        if (dense != nullptr) {
+            dense->clear();
+        }
+
+        Vector y_curr = y;
+        Vector k1, k2, k3, k4, k5, k6, k7, y_stage, y_next;
+
+        double t = t0;
+        double h = (next_step_ > 0.0) ? next_step_ : settings.initial_step;
+        h = std::clamp(h, settings.min_step, settings.max_step);
+
+        f(t, y_curr, k1);
+        ++stats.derivative_evaluations;
+
+        bool last_rejected = false;
+        while (t < t1) {
+            // Land exactly on t1 instead of leaving a sliver for the next step.
+            const double remaining = t1 - t;
+            const bool final_step = h >= remaining * (1.0 - 1e-12);
+            const double h_try = final_step ? remaining : h;
+
+            stage(y_stage, y_curr, h_try, k1, kA21);
+            f(t + kC2 * h_try, y_stage, k2);
+            stage(y_stage, y_curr, h_try, k1, kA31, k2, kA32);
+            f(t + kC3 * h_try, y_stage, k3);
+            stage(y_stage, y_curr, h_try, k1, kA41, k2, kA42, k3, kA43);
+            f(t + kC4 * h_try, y_stage, k4);
+            stage(y_stage, y_curr, h_try, k1, kA51, k2, kA52, k3, kA53, k4, kA54);
+            f(t + kC5 * h_try, y_stage, k5);
+            stage(y_stage, y_curr, h_try, k1, kA61, k2, kA62, k3, kA63, k4, kA64, k5, kA65);
+            f(t + h_try, y_stage, k6);
+            stage(y_next, y_curr, h_try, k1, kB1, k3, kB3, k4, kB4, k5, kB5, k6, kB6);
+            f(t + h_try, y_next, k7);
+            stats.derivative_evaluations += 6;
+
+            const double err = errorNorm(y_curr, y_next, h_try, k1, k3, k4, k5, k6, k7);
+
+            if (!std::isfinite(err) || err > 1.0) {
+                ++stats.rejected_steps;
+                const double scale = std::isfinite(err)
+                    ? std::max(settings.min_scale, settings.safety * std::pow(err, -0.2))
+                    : settings.min_scale;
+                h = h_try * std::min(1.0, scale);
+                last_rejected = true;
+                if (h < settings.min_step) {
+                    next_step_ = settings.min_step;
+                    return std::isfinite(err) ? Status::StepUnderflow : Status::NonFinite;
+                }
+                continue;
+            }
+
+            if (dense != nullptr) {
+                appendSegment(*dense, t, h_try, y_curr, y_next, k1, k3, k4, k5, k6, k7);
+            }
+
+            ++stats.accepted_steps;
+            t = final_step ? t1 : t + h_try;
+            y_curr = y_next;
+            k1 = k7;  // FSAL
+
+            double scale = (err > 0.0) ? settings.safety * std::pow(err, -0.2) : settings.max_scale;
+            scale = std::clamp(scale, settings.min_scale, last_rejected ? 1.0 : settings.max_scale);
+            // A truncated final step says little about the natural step length.
+            const double h_new = std::clamp(h_try * scale, settings.min_step, settings.max_step);
+            h = final_step ? std::max(h, h_new) : h_new;
+            last_rejected = false;
+        }
+
+        next_step_ = std::clamp(h, settings.min_step, settings.max_step);
+        y = y_curr;
+        return Status::Ok;
+    }
+
+private:
+    // Dormand & Prince (1980) coefficients.
+    static constexpr double kC2 = 1.0 / 5.0;
+    static constexpr double kC3 = 3.0 / 10.0;
+    static constexpr double kC4 = 4.0 / 5.0;
+    static constexpr double kC5 = 8.0 / 9.0;
+
+    static constexpr double kA21 = 1.0 / 5.0;
+    static constexpr double kA31 = 3.0 / 40.0;
+    static constexpr double kA32 = 9.0 / 40.0;
+    static constexpr double kA41 = 44.0 / 45.0;
+    static constexpr double kA42 = -56.0 / 15.0;
+    static constexpr double kA43 = 32.0 / 9.0;
+    static constexpr double kA51 = 19372.0 / 6561.0;
+    static constexpr double kA52 = -25360.0 / 2187.0;
+    static constexpr double kA53 = 64448.0 / 6561.0;
+    static constexpr double kA54 = -212.0 / 729.0;
+    static constexpr double kA61 = 9017.0 / 3168.0;
+    static constexpr double kA62 = -355.0 / 33.0;
+    static constexpr double kA63 = 46732.0 / 5247.0;
+    static constexpr double kA64 = 49.0 / 176.0;
+    static constexpr double kA65 = -5103.0 / 18656.0;
+
+    static constexpr double kB1 = 35.0 / 384.0;
+    static constexpr double kB3 = 500.0 / 1113.0;
+    static constexpr double kB4 = 125.0 / 192.0;
+    static constexpr double kB5 = -2187.0 / 6784.0;
+    static constexpr double kB6 = 11.0 / 84.0;
+
+    // Fifth- minus fourth-order weights (error estimate).
+    static constexpr double kE1 = 71.0 / 57600.0;
+    static constexpr double kE3 = -71.0 / 16695.0;
+    static constexpr double kE4 = 71.0 / 1920.0;
+    static constexpr double kE5 = -17253.0 / 339200.0;
+    static constexpr double kE6 = 22.0 / 525.0;
+    static constexpr double kE7 = -1.0 / 40.0;
+
+    // Dense output weights (Hairer, Norsett & Wanner, DOPRI5 contd5).
+    static constexpr double kD1 = -12715105075.0 / 11282082432.0;
+    static constexpr double kD3 = 87487479700.0 / 32700410799.0;
+    static constexpr double kD4 = -10690763975.0 / 1880347072.0;
+    static constexpr double kD5 = 701980252875.0 / 199316789632.0;
+    static constexpr double kD6 = -1453857185.0 / 822651844.0;
+    static constexpr double kD7 = 69997945.0 / 29380423.0;
+
+    double next_step_{0.0};
+
+    /// out = y + h * sum(a_j * k_j)
+    template <typename... Terms>
+    static void stage(Vector& out, const Vector& y, double h, const Terms&... terms) {
+        for (std::size_t i = 0; i < N; ++i) {
+            out[i] = y[i] + h * weightedSum(i, terms...);
+        }
+    }
+
+    static double weightedSum(std::size_t) { return 0.0; }
+
+    template <typename... Rest>
+    static double weightedSum(std::size_t i, const Vector& k, double a, const Rest&... rest) {
+        return a * k[i] + weightedSum(i, rest...);
+    }
+
+    /// RMS of the scaled local error estimate; <= 1 means the step is accepted
+    double errorNorm(const Vector& y0, const Vector& y1, double h,
+                     const Vector& k1, const Vector& k3, const Vector& k4,
+                     const Vector& k5, const Vector& k6, const Vector& k7) const {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            const double e = h * (kE1 * k1[i] + kE3 * k3[i] + kE4 * k4[i] +
+                                  kE5 * k5[i] + kE6 * k6[i] + kE7 * k7[i]);
+            const double scale = settings.absolute_tolerance +
+                                 settings.relative_tolerance *
+                                     std::max(std::abs(y0[i]), std::abs(y1[i]));
+            const double r = e / scale;
+            sum += r * r;
+        }
+        return std::sqrt(sum / static_cast<double>(N));
+    }
+
+    static void appendSegment(DenseTrajectory<N>& dense, double t0, double h,
+                              const Vector& y0, const Vector& y1,
+                              const Vector& k1, const Vector& k3, const Vector& k4,
+                              const Vector& k5, const Vector& k6, const Vector& k7) {
+        typename DenseTrajectory<N>::Segment segment;
+        segment.t0 = t0;
+        segment.h = h;
+        for (std::size_t i = 0; i < N; ++i) {
+            const double ydiff = y1[i] - y0[i];
+            const double bspl = h * k1[i] - ydiff;
+            segment.coeff[0][i] = y0[i];
+            segment.coeff[1][i] = ydiff;
+            segment.coeff[2][i] = bspl;
+            segment.coeff[3][i] = ydiff - h * k7[i] - bspl;
+            segment.coeff[4][i] = h * (kD1 * k1[i] + kD3 * k3[i] + kD4 * k4[i] +
+                                       kD5 * k5[i] + kD6 * k6[i] + kD7 * k7[i]);
+        }
+        dense.append(segment);
+    }
+};
+
+#endif // CORE_DORMAND_PRINCE_H
@@ -0,0 +1,69 @@
+/**
+ * @file excitation.h
+ * @brief Test signals for frequency-response work: logarithmic chirp and Schroeder multi-sine
+ */
+
+#ifndef CORE_EXCITATION_H
+#define CORE_EXCITATION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace excitation {
+
+constexpr double kPi = 3.14159265358979323846;
+
+/**
+ * @brief Logarithmic (exponential) sine sweep from start_hz to end_hz, repeated every duration_s
+ *
+ * The instantaneous frequency is start_hz·(end_hz/start_hz)^(t/duration_s),
+ * so every decade gets the same share of the sweep. Falls back to a plain
+ * sine at start_hz when the band is empty.
+ */
+inline double logChirp(double t, double start_hz, double end_hz, double duration_s, double amplitude) {
+    if (start_hz <= 0.0 || duration_s <= 0.0) {
+        return 0.0;
+    }
+    const double tau = std::fmod(std::max(t, 0.0), duration_s);
+    const double ratio = end_hz / start_hz;
+    if (ratio <= 0.0 || std::abs(ratio - 1.0) < 1e-9) {
+        return amplitude * std::sin(2.0 * kPi * start_hz * tau);
+    }
+    const double log_ratio = std::log(ratio);
+    const double phase = 2.0 * kPi * start_hz * duration_s / log_ratio
+                         * (std::exp(log_ratio * tau / duration_s) - 1.0);
+    return amplitude * std::sin(phase);
+}
+
+/**
+ * @brief Schroeder phase of tone k (1-based) in an n-tone flat-spectrum multi-sine
+ *
+ * φₖ = −πk(k−1)/n keeps the crest factor of the sum near √2 instead of the
+ * √(2n) of equal phases, so more power per tone fits under an amplitude limit.
+ */
+inline double schroederPhase(std::size_t k, std::size_t n) {
+    return -kPi * static_cast<double>(k) * static_cast<double>(k - 1) / static_cast<double>(n);
+}
+
+/**
+ * @brief Multi-sine with tones at base_hz, 2·base_hz, …, tones·base_hz and Schroeder phases
+ *
+ * Each tone has amplitude amplitude/√tones, so the signal power matches a
+ * single sine of the given amplitude. Periodic in 1/base_hz.
+ */
+inline double schroederMultiSine(double t, double base_hz, std::size_t tones, double amplitude) {
+    if (tones == 0 || base_hz <= 0.0) {
+        return 0.0;
+    }
+    const double tone_amplitude = amplitude / std::sqrt(static_cast<double>(tones));
+    double sum = 0.0;
+    for (std::size_t k = 1; k <= tones; ++k) {
+        sum += std::sin(2.0 * kPi * base_hz * static_cast<double>(k) * t + schroederPhase(k, tones));
+    }
+    return tone_amplitude * sum;
+}
+
+}  // namespace excitation
+
+#endif // CORE_EXCITATION_H
@@ -0,0 +1,142 @@
+/**
+ * @file first_order_lag_bank.h
+ * @brief Bank of independent first-order lags stepped together (structure of arrays)
+ */
+
+#ifndef CORE_FIRST_ORDER_LAG_BANK_H
+#define CORE_FIRST_ORDER_LAG_BANK_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+/**
+ * @brief N first-order systems G_i(s) = K_i / (τ_i s + 1) with output saturation
+ *
+ * Each channel is discretized exactly for a zero-order-hold input:
+ *
+ *   x[k+1] = a_i x[k] + (1 - a_i) K_i u[k],   a_i = exp(-dt / τ_i)
+ *
+ * so the response is independent of how a frame is split into steps and is
+ * unconditionally stable for any dt. The decay factors are cached and only
+ * recomputed when dt or a time constant changes, leaving step() as a few
+ * multiply-adds and a clamp per channel.
+ *
+ * Parameters and state are stored as separate contiguous, 32-byte aligned
+ * arrays (structure of arrays) and the step loop is branch-free, so the
+ * compiler vectorizes it across channels on any SIMD ISA. Use one channel
+ * per rotor, or rotors × vehicles for a swarm.
+ *
+ * @tparam N Number of channels
+ */
+template <std::size_t N>
+class FirstOrderLagBank {
+public:
+    static constexpr std::size_t kChannels = N;
+    static constexpr double kMinTimeConstant = 1e-4;  ///< Shorter τ is clamped (s)
+
+    FirstOrderLagBank() {
+        state_.fill(0.0);
+        time_constant_.fill(1.0);
+        gain_.fill(1.0);
+        lower_.fill(-std::numeric_limits<double>::infinity());
+        upper_.fill(std::numeric_limits<double>::infinity());
+        decay_.fill(0.0);
+        input_weight_.fill(0.0);
+    }
+
+    /// Set τ for one channel (seconds); cheap to call every frame with an unchanged value
+    void setTimeConstant(std::size_t channel, double tau) {
+        tau = std::max(tau, kMinTimeConstant);
+        if (time_constant_[channel] != tau) {
+            time_constant_[channel] = tau;
+            cached_dt_ = -1.0;
+        }
+    }
+
+    /// Set τ for all channels (seconds)
+    void setTimeConstants(double tau) {
+        for (std::size_t i = 0; i < N; ++i) {
+            setTimeConstant(i, tau);
+        }
+    }
+
+    /// Set steady-state gain K for one channel
+    void setGain(std::size_t channel, double gain) {
+        if (gain_[channel] != gain) {
+            gain_[channel] = gain;
+            cached_dt_ = -1.0;
+        }
+    }
+
+    /// Set output saturation limits for one channel
+    void setLimits(std::size_t channel, double lower, double upper) {
+        lower_[channel] = lower;
+        upper_[channel] = std::max(lower, upper);
+    }
+
+    /// Set output saturation limits for all channels
+    void setLimits(double lower, double upper) {
+        lower_.fill(lower);
+        upper_.fill(std::max(lower, upper));
+    }
+
+    /// Overwrite channel outputs (e.g. to sync with externally edited state)
+    void load(const double* values) {
+        std::copy(values, values + N, state_.begin());
+    }
+
+    /// Set every channel to the same output
+    void reset(double value = 0.0) { state_.fill(value); }
+
+    /// Current outputs, one per channel
+    const std::array<double, N>& outputs() const { return state_; }
+    double output(std::size_t channel) const { return state_[channel]; }
+
+    /**
+     * @brief Advance every channel by dt with inputs held constant
+     * @param dt Step length (seconds); non-positive steps are ignored
+     * @param input N inputs, one per channel
+     */
+    void step(double dt, const double* input) {
+        if (!(dt > 0.0)) {
+            return;
+        }
+        if (dt != cached_dt_) {
+            updateCoefficients(dt);
+        }
+
+        double* __restrict x = state_.data();
+        const double* __restrict a = decay_.data();
+        const double* __restrict b = input_weight_.data();
+        const double* __restrict lo = lower_.data();
+        const double* __restrict hi = upper_.data();
+        for (std::size_t i = 0; i < N; ++i) {
+            const double next = a[i] * x[i] + b[i] * input[i];
+            x[i] = std::min(std::max(next, lo[i]), hi[i]);
+        }
+    }
+
+private:
+    alignas(32) std::array<double, N> state_;
+    alignas(32) std::array<double, N> decay_;         ///< exp(-dt/τ)
+    alignas(32) std::array<double, N> input_weight_;  ///< (1 - exp(-dt/τ)) K
+    alignas(32) std::array<double, N> lower_;
+    alignas(32) std::array<double, N> upper_;
+    alignas(32) std::array<double, N> time_constant_;
+    alignas(32) std::array<double, N> gain_;
+    double cached_dt_{-1.0};
+
+    void updateCoefficients(double dt) {
+        for (std::size_t i = 0; i < N; ++i) {
+            const double a = std::exp(-dt / time_constant_[i]);
+            decay_[i] = a;
+            input_weight_[i] = (1.0 - a) * gain_[i];
+        }
+        cached_dt_ = dt;
+    }
+};
+
+#endif // CORE_FIRST_ORDER_LAG_BANK_H
@@ -0,0 +1,198 @@
+/**
+ * @file frame_arena.h
+ * @brief Frame-scoped bump allocator for UI and plot temporaries
+ */
+
+#ifndef CORE_FRAME_ARENA_H
+#define CORE_FRAME_ARENA_H
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "core/memory_accounting.h"
+
+/**
+ * @class FrameArena
+ * @brief Bump allocator whose allocations all die together at reset()
+ *
+ * Allocation is a pointer bump inside one block; freeing is a no-op. When a
+ * frame needs more than the block holds, overflow blocks are taken from
+ * the heap for the rest of that frame, and the next reset() replaces
+ * everything with one block sized for the peak. After a frame or two of
+ * warm-up, a frame that asks for no more than its predecessors therefore
+ * never touches the global heap.
+ *
+ * Block bytes are charged to MemoryTag::Plot. Not thread-safe: one arena
+ * per thread (the UI thread uses frameArena()).
+ */
+class FrameArena {
+public:
+    static constexpr std::size_t kDefaultBytes = 256 * 1024;
+
+    explicit FrameArena(std::size_t initial_bytes = kDefaultBytes) {
+        replaceBlock(std::max<std::size_t>(initial_bytes, 64));
+    }
+
+    ~FrameArena() {
+        releaseOverflow();
+        MemoryAccounting::refund(MemoryTag::Plot, capacity_);
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief Uninitialised, aligned storage valid until the next reset()
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        std::size_t offset = alignUp(offset_, alignment);
+        if (offset + bytes > current_capacity_) {
+            growForFrame(bytes + alignment);
+            offset = alignUp(offset_, alignment);
+        }
+        used_ += offset + bytes - offset_;
+        offset_ = offset + bytes;
+        high_water_ = std::max(high_water_, used_);
+        return current_ + offset;
+    }
+
+    template <typename T>
+    T* allocateArray(std::size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief printf into arena storage; the string lives until the next reset()
+     */
+    const char* format(const char* fmt, ...) {
+        std::va_list args;
+        va_start(args, fmt);
+        std::va_list retry;
+        va_copy(retry, args);
+        // Try in place first; most labels fit in what is left of the block.
+        const std::size_t room = current_capacity_ - offset_;
+        char* text = current_ + offset_;
+        const int length = std::vsnprintf(text, room, fmt, args);
+        va_end(args);
+        if (length < 0) {
+            va_end(retry);
+            return "";
+        }
+        const std::size_t bytes = static_cast<std::size_t>(length) + 1;
+        if (bytes <= room) {
+            allocate(bytes, 1);
+        } else {
+            text = allocateArray<char>(bytes);
+            std::vsnprintf(text, bytes, fmt, retry);
+        }
+        va_end(retry);
+        return text;
+    }
+
+    /**
+     * @brief Invalidate every allocation; coalesce overflow into one block sized for the peak
+     */
+    void reset() {
+        if (!overflow_.empty()) {
+            releaseOverflow();
+            replaceBlock(high_water_ + high_water_ / 2);
+        }
+        offset_ = 0;
+        used_ = 0;
+    }
+
+    std::size_t used() const { return used_; }                  ///< Bytes handed out this frame
+    std::size_t capacity() const { return capacity_; }          ///< Bytes in the main block
+    std::size_t highWater() const { return high_water_; }       ///< Most bytes any frame used
+    std::size_t heapBlocks() const { return heap_blocks_; }     ///< Blocks taken from the heap so far
+
+private:
+    std::unique_ptr<char[]> block_;                 ///< Main block, reused every frame
+    std::size_t capacity_{0};
+    char* current_{nullptr};                        ///< Block being bumped (main or last overflow)
+    std::size_t offset_{0};                         ///< Bump offset in current_
+    std::size_t current_capacity_{0};
+    std::vector<std::unique_ptr<char[]>> overflow_; ///< This frame's extra blocks
+    std::size_t overflow_bytes_{0};
+    std::size_t used_{0};
+    std::size_t high_water_{0};
+    std::size_t heap_blocks_{0};
+
+    static std::size_t alignUp(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    void replaceBlock(std::size_t bytes) {
+        MemoryAccounting::refund(MemoryTag::Plot, capacity_);
+        block_.reset(new char[bytes]);
+        MemoryAccounting::charge(MemoryTag::Plot, bytes);
+        ++heap_blocks_;
+        capacity_ = bytes;
+        current_ = block_.get();
+        current_capacity_ = bytes;
+        offset_ = 0;
+    }
+
+    void growForFrame(std::size_t min_bytes) {
+        const std::size_t bytes = std::max(min_bytes, capacity_);
+        overflow_.emplace_back(new char[bytes]);
+        MemoryAccounting::charge(MemoryTag::Plot, bytes);
+        overflow_bytes_ += bytes;
+        ++heap_blocks_;
+        current_ = overflow_.back().get();
+        current_capacity_ = bytes;
+        offset_ = 0;
+    }
+
+    void releaseOverflow() {
+        overflow_.clear();
+        MemoryAccounting::refund(MemoryTag::Plot, overflow_bytes_);
+        overflow_bytes_ = 0;
+        current_ = block_.get();
+        current_capacity_ = capacity_;
+    }
+};
+
+/**
+ * @brief The UI thread's arena, reset by Application::render3D() at the start of every frame
+ *
+ * Anything allocated from it during a frame (plot copies, labels) must not
+ * be kept past that frame.
+ */
+inline FrameArena& frameArena() {
+    static FrameArena arena;
+    return arena;
+}
+
+/**
+ * @brief std::allocator stand-in that bumps a FrameArena; deallocate is a no-op
+ */
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    FrameArena* arena;
+
+    ArenaAllocator(FrameArena& owner = frameArena()) noexcept : arena(&owner) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(std::size_t n) { return arena->allocateArray<T>(n); }
+    void deallocate(T*, std::size_t) noexcept {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.arena; }
+};
+
+/// Frame-lifetime vector; reserve() up front, since every regrowth leaves the old buffer behind
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // CORE_FRAME_ARENA_H
@@ -0,0 +1,120 @@
+/**
+ * @file jacobian.h
+ * @brief State and input Jacobians of ẋ = f(x, u) by forward-mode AD or central differences
+ */
+
+#ifndef CORE_JACOBIAN_H
+#define CORE_JACOBIAN_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "core/dual.h"
+#include "core/small_matrix.h"
+
+/**
+ * @brief Exact A = ∂f/∂x and B = ∂f/∂u in one evaluation of f
+ *
+ * Seeds every state and input as an independent variable of
+ * Dual<Nx + Nu> and evaluates f once; row i of [A | B] is the gradient of
+ * output i.
+ *
+ * @param f Generic callable f(const std::array<S, Nx>& x, const S* u, std::array<S, Nx>& dxdt),
+ *          invoked with S = Dual<Nx + Nu>
+ * @param x Linearization state
+ * @param u Linearization input
+ * @param value f(x, u)
+ * @param a ∂f/∂x
+ * @param b ∂f/∂u
+ */
+template <std::size_t Nx, std::size_t Nu, typename Function>
+void forwardJacobian(Function&& f, const SmallVector<Nx>& x, const SmallVector<Nu>& u,
+                     SmallVector<Nx>& value, SmallMatrix<Nx, Nx>& a, SmallMatrix<Nx, Nu>& b) {
+    using Scalar = Dual<Nx + Nu>;
+    std::array<Scalar, Nx> x_dual{};
+    std::array<Scalar, Nu> u_dual{};
+    for (std::size_t j = 0; j < Nx; ++j) {
+        x_dual[j] = Scalar::variable(x[j], j);
+    }
+    for (std::size_t j = 0; j < Nu; ++j) {
+        u_dual[j] = Scalar::variable(u[j], Nx + j);
+    }
+
+    std::array<Scalar, Nx> dxdt{};
+    f(x_dual, u_dual.data(), dxdt);
+    for (std::size_t i = 0; i < Nx; ++i) {
+        value[i] = dxdt[i].value;
+        std::copy_n(dxdt[i].grad.begin(), Nx, a.m[i].begin());
+        std::copy_n(dxdt[i].grad.begin() + Nx, Nu, b.m[i].begin());
+    }
+}
+
+/**
+ * @brief Exact Jacobian of a general map y = f(z) from ℝᴺ to ℝᴹ in one evaluation
+ *
+ * @param f Generic callable f(const std::array<S, N>& z, std::array<S, M>& y),
+ *          invoked with S = Dual<N>
+ * @param z Evaluation point
+ * @param value f(z)
+ * @param jacobian ∂f/∂z
+ */
+template <std::size_t M, std::size_t N, typename Function>
+void dualJacobian(Function&& f, const SmallVector<N>& z, SmallVector<M>& value, SmallMatrix<M, N>& jacobian) {
+    using Scalar = Dual<N>;
+    std::array<Scalar, N> z_dual{};
+    for (std::size_t j = 0; j < N; ++j) {
+        z_dual[j] = Scalar::variable(z[j], j);
+    }
+
+    std::array<Scalar, M> y{};
+    f(z_dual, y);
+    for (std::size_t i = 0; i < M; ++i) {
+        value[i] = y[i].value;
+        std::copy_n(y[i].grad.begin(), N, jacobian.m[i].begin());
+    }
+}
+
+/**
+ * @brief A and B by central differences (2·(Nx + Nu) evaluations of f)
+ *
+ * Reference implementation for validating forwardJacobian() and for
+ * functions that are not templated on their scalar type. Inputs are stepped
+ * relative to their magnitude (at least input_step).
+ *
+ * @param f Callable f(const std::array<double, Nx>& x, const double* u, std::array<double, Nx>& dxdt)
+ */
+template <std::size_t Nx, std::size_t Nu, typename Function>
+void centralDifferenceJacobian(Function&& f, const SmallVector<Nx>& x, const SmallVector<Nu>& u,
+                               SmallVector<Nx>& value, SmallMatrix<Nx, Nx>& a, SmallMatrix<Nx, Nu>& b,
+                               double state_step = 1e-6, double input_step = 1e-6) {
+    SmallVector<Nx> x_step = x;
+    SmallVector<Nu> u_step = u;
+    SmallVector<Nx> plus{};
+    SmallVector<Nx> minus{};
+    f(x, u.data(), value);
+
+    for (std::size_t j = 0; j < Nx; ++j) {
+        x_step[j] = x[j] + state_step;
+        f(x_step, u.data(), plus);
+        x_step[j] = x[j] - state_step;
+        f(x_step, u.data(), minus);
+        x_step[j] = x[j];
+        for (std::size_t i = 0; i < Nx; ++i) {
+            a.m[i][j] = (plus[i] - minus[i]) / (2.0 * state_step);
+        }
+    }
+    for (std::size_t j = 0; j < Nu; ++j) {
+        const double h = input_step * std::max(1.0, u[j] < 0.0 ? -u[j] : u[j]);
+        u_step[j] = u[j] + h;
+        f(x, u_step.data(), plus);
+        u_step[j] = u[j] - h;
+        f(x, u_step.data(), minus);
+        u_step[j] = u[j];
+        for (std::size_t i = 0; i < Nx; ++i) {
+            b.m[i][j] = (plus[i] - minus[i]) / (2.0 * h);
+        }
+    }
+}
+
+#endif // CORE_JACOBIAN_H
@@ -0,0 +1,255 @@
+/**
+ * @file memory_accounting.h
+ * @brief Per-subsystem memory counters, tagged allocators and hard caps
+ */
+
+#ifndef CORE_MEMORY_ACCOUNTING_H
+#define CORE_MEMORY_ACCOUNTING_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Subsystem a tracked allocation is charged to
+ */
+enum class MemoryTag : std::size_t {
+    History,    ///< SimulationState sample histories (attitude, rotors, sensors)
+    Plot,       ///< Panel-private plot buffers and per-frame plot copies
+    Log,        ///< Telemetry channel rings
+    Gpu,        ///< Render targets and vertex buffers (reported by the renderer)
+    Count
+};
+
+constexpr std::size_t kMemoryTagCount = static_cast<std::size_t>(MemoryTag::Count);
+
+/**
+ * @class MemoryAccounting
+ * @brief Process-wide live/peak byte counters and caps, one slot per MemoryTag
+ *
+ * Containers charge their tag through TrackedAllocator; memory the
+ * allocator cannot see (GPU objects) is reported with charge()/refund().
+ * Counters are relaxed atomics, so headless analyses running on worker
+ * threads may allocate tracked containers concurrently.
+ *
+ * A cap is not enforced by the allocator (an allocation never fails);
+ * owners of growable buffers call enforceMemoryCap() when they append,
+ * which evicts or decimates their samples while the tag is over its cap.
+ */
+class MemoryAccounting {
+public:
+    /// What an over-cap buffer gives up
+    enum class Policy {
+        Evict,      ///< Drop the oldest samples (the retained window shrinks)
+        Decimate    ///< Drop every other sample and halve the sampling rate (the window is kept)
+    };
+
+    struct Usage {
+        std::int64_t live_bytes{0};
+        std::int64_t peak_bytes{0};         ///< Since start or resetPeaks()
+        std::uint64_t allocations{0};       ///< Allocation calls since start
+        std::size_t cap_bytes{0};           ///< 0 = uncapped
+        Policy policy{Policy::Evict};
+        std::uint64_t enforcements{0};      ///< Evict/decimate actions taken
+    };
+
+    static void charge(MemoryTag tag, std::size_t bytes) {
+        Slot& slot = slotFor(tag);
+        const std::int64_t live = slot.live.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed) +
+                                  static_cast<std::int64_t>(bytes);
+        slot.allocations.fetch_add(1, std::memory_order_relaxed);
+        std::int64_t peak = slot.peak.load(std::memory_order_relaxed);
+        while (live > peak && !slot.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    static void refund(MemoryTag tag, std::size_t bytes) {
+        slotFor(tag).live.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    static Usage usage(MemoryTag tag) {
+        const Slot& slot = slotFor(tag);
+        Usage usage;
+        usage.live_bytes = slot.live.load(std::memory_order_relaxed);
+        usage.peak_bytes = slot.peak.load(std::memory_order_relaxed);
+        usage.allocations = slot.allocations.load(std::memory_order_relaxed);
+        usage.cap_bytes = slot.cap.load(std::memory_order_relaxed);
+        usage.policy = slot.policy.load(std::memory_order_relaxed);
+        usage.enforcements = slot.enforcements.load(std::memory_order_relaxed);
+        return usage;
+    }
+
+    /**
+     * @brief Set a tag's cap (0 removes it) and what over-cap buffers do
+     */
+    static void setCap(MemoryTag tag, std::size_t bytes, Policy policy) {
+        Slot& slot = slotFor(tag);
+        slot.cap.store(bytes, std::memory_order_relaxed);
+        slot.policy.store(policy, std::memory_order_relaxed);
+    }
+
+    static bool overCap(MemoryTag tag) {
+        const Slot& slot = slotFor(tag);
+        const std::size_t cap = slot.cap.load(std::memory_order_relaxed);
+        return cap > 0 && slot.live.load(std::memory_order_relaxed) > static_cast<std::int64_t>(cap);
+    }
+
+    /// Below half the cap (or uncapped): decimated buffers may sample faster again
+    static bool wellUnderCap(MemoryTag tag) {
+        const Slot& slot = slotFor(tag);
+        const std::size_t cap = slot.cap.load(std::memory_order_relaxed);
+        return cap == 0 || 2 * slot.live.load(std::memory_order_relaxed) < static_cast<std::int64_t>(cap);
+    }
+
+    static Policy policy(MemoryTag tag) { return slotFor(tag).policy.load(std::memory_order_relaxed); }
+
+    static void noteEnforcement(MemoryTag tag) {
+        slotFor(tag).enforcements.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Restart every peak from the current live value
+    static void resetPeaks() {
+        for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+            Slot& slot = slotFor(static_cast<MemoryTag>(i));
+            slot.peak.store(slot.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    static const char* name(MemoryTag tag) {
+        switch (tag) {
+        case MemoryTag::History: return "Histories";
+        case MemoryTag::Plot:    return "Plots";
+        case MemoryTag::Log:     return "Logs";
+        case MemoryTag::Gpu:     return "GPU buffers";
+        default:                 return "?";
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::int64_t> live{0};
+        std::atomic<std::int64_t> peak{0};
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::size_t> cap{0};
+        std::atomic<Policy> policy{Policy::Evict};
+        std::atomic<std::uint64_t> enforcements{0};
+    };
+
+    static Slot& slotFor(MemoryTag tag) {
+        static std::array<Slot, kMemoryTagCount> slots;
+        return slots[static_cast<std::size_t>(tag)];
+    }
+};
+
+/**
+ * @brief Stateless std::allocator stand-in that charges every byte to Tag
+ */
+template <typename T, MemoryTag Tag>
+struct TrackedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = TrackedAllocator<U, Tag>;
+    };
+
+    TrackedAllocator() noexcept = default;
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        T* p = std::allocator<T>().allocate(n);
+        MemoryAccounting::charge(Tag, n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        MemoryAccounting::refund(Tag, n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const TrackedAllocator<U, Tag>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const TrackedAllocator<U, Tag>&) const noexcept { return false; }
+};
+
+template <typename T, MemoryTag Tag>
+using TrackedDeque = std::deque<T, TrackedAllocator<T, Tag>>;
+
+template <typename T, MemoryTag Tag>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+
+/// Coarsest decimation before an over-cap buffer falls back to eviction
+constexpr int kMaxDecimation = 64;
+
+/// What a buffer owner must do to its samples after appending
+enum class MemoryCapAction { None, Evict, Decimate };
+
+/**
+ * @brief Decide whether buffers charged to tag must shed samples after an append
+ *
+ * Call once per append, even when several buffers share one sampling rate
+ * (then apply the action to each). Decimate doubles decimation, which the
+ * owner multiplies into its sampling interval; past kMaxDecimation the
+ * buffer is evicted instead. Once the tag is back under half its cap,
+ * decimation relaxes one step per call.
+ *
+ * @param decimation Owner's sampling-interval multiplier (≥ 1)
+ */
+inline MemoryCapAction memoryCapAction(MemoryTag tag, int& decimation) {
+    if (!MemoryAccounting::overCap(tag)) {
+        if (decimation > 1 && MemoryAccounting::wellUnderCap(tag)) {
+            decimation /= 2;
+        }
+        return MemoryCapAction::None;
+    }
+    MemoryAccounting::noteEnforcement(tag);
+    if (MemoryAccounting::policy(tag) == MemoryAccounting::Policy::Decimate && decimation < kMaxDecimation) {
+        decimation *= 2;
+        return MemoryCapAction::Decimate;
+    }
+    return MemoryCapAction::Evict;
+}
+
+/**
+ * @brief Apply a memoryCapAction() to one buffer
+ *
+ * Evict drops the oldest eighth of the samples; Decimate drops every other
+ * sample, keeping the newest. Freed deque blocks go back to the allocator.
+ */
+template <typename T, typename Alloc>
+void applyMemoryCapAction(MemoryCapAction action, std::deque<T, Alloc>& samples) {
+    if (action == MemoryCapAction::None || samples.size() < 2) {
+        return;
+    }
+    if (action == MemoryCapAction::Decimate) {
+        std::size_t write = 0;
+        for (std::size_t read = (samples.size() - 1) % 2; read < samples.size(); read += 2) {
+            samples[write++] = samples[read];
+        }
+        samples.erase(samples.begin() + static_cast<std::ptrdiff_t>(write), samples.end());
+    } else {
+        const std::size_t drop = std::max<std::size_t>(1, samples.size() / 8);
+        samples.erase(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(drop));
+    }
+    samples.shrink_to_fit();
+}
+
+/**
+ * @brief memoryCapAction() and applyMemoryCapAction() for a buffer with its own rate
+ * @return true if samples were dropped
+ */
+template <typename T, typename Alloc>
+bool enforceMemoryCap(MemoryTag tag, std::deque<T, Alloc>& samples, int& decimation) {
+    const MemoryCapAction action = memoryCapAction(tag, decimation);
+    applyMemoryCapAction(action, samples);
+    return action != MemoryCapAction::None;
+}
+
+#endif // CORE_MEMORY_ACCOUNTING_H
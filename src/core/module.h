@@ -7,6 +7,22 @@
 #define MODULE_H
 
 class SimulationState;
+class ModuleCheckpoint;
+
+/**
+ * @struct ConfigSection
+ * @brief Bits naming the parts of the configuration a live reload changed (see RigConfig::apply())
+ */
+struct ConfigSection {
+    enum : unsigned {
+        kVehicle = 1u << 0,     ///< Mass, gravity, inertia, drag (VehicleConfig)
+        kRotors = 1u << 1,      ///< Rotor geometry and coefficients (VehicleConfig, RotorConfig)
+        kMotors = 1u << 2,      ///< MotorConfig
+        kEstimator = 1u << 3,   ///< EstimatorConfig
+        kAirframe = 1u << 4,    ///< Rotor layout; needs a new pipeline, not a reconfigure
+        kWind = 1u << 5         ///< WindConfig
+    };
+};
 
 /**
  * @class Module
@@ -14,9 +30,10 @@ class SimulationState;
  *
  * Modules encapsulate discrete simulation components (dynamics, sensors, estimators, etc.)
  * and operate on the shared SimulationState. Each module is initialized once and updated
- * each simulation tick.
+ * each simulation tick, or at its own fixed rate when period() is positive.
  *
  * @see SimulationState
+ * @see ModuleScheduler
  */
 class Module {
 public:
@@ -42,6 +59,48 @@ public:
      * @param state Reference to the shared simulation state (read/write)
      */
     virtual void update(double dt, SimulationState& state) = 0;
+
+    /**
+     * @brief Short display name used by the profiler
+     */
+    virtual const char* name() const { return "Module"; }
+
+    /**
+     * @brief Fixed update period in seconds, or 0 to run once per tick
+     *
+     * A module with a positive period is stepped by ModuleScheduler at
+     * exactly that rate, with dt equal to the period, independent of the
+     * frame rate.
+     */
+    virtual double period() const { return 0.0; }
+
+    /**
+     * @brief Save or restore the private state update() carries between calls
+     *
+     * Used by the rewind timeline: a module whose output depends on more
+     * than SimulationState and its configuration (filter memories,
+     * integrators, warm starts) lists those fields here so a keyframe can
+     * put it back exactly. Stateless modules keep the default.
+     *
+     * @see ModuleCheckpoint
+     */
+    virtual void checkpoint(ModuleCheckpoint& archive) {}
+
+    /**
+     * @brief ConfigSection bits whose live changes this module must be told about
+     *
+     * Modules that read their configuration from the state on every update
+     * keep the default and are left alone by a reload.
+     */
+    virtual unsigned configSections() const { return 0; }
+
+    /**
+     * @brief Re-read the configuration after a live change, keeping the dynamic state
+     *
+     * Called by ModuleScheduler::reconfigure() instead of initialize(), so
+     * the vehicle carries on from where it is with the new parameters.
+     */
+    virtual void configure(SimulationState& state) {}
 };
 
 #endif // MODULE_H
@@ -0,0 +1,79 @@
+/**
+ * @file module_checkpoint.h
+ * @brief Byte archive a module writes its private run-time state into (checkpoint/rewind)
+ */
+
+#ifndef CORE_MODULE_CHECKPOINT_H
+#define CORE_MODULE_CHECKPOINT_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @class ModuleCheckpoint
+ * @brief Measures, saves or loads a flat run of trivially copyable fields
+ *
+ * A module lists the fields that evolve from update to update once, in
+ * Module::checkpoint(), and the same list serves all three modes:
+ *
+ * @code
+ * void checkpoint(ModuleCheckpoint& archive) override {
+ *     archive.io(integral_);
+ *     archive.io(previous_rate_);
+ * }
+ * @endcode
+ *
+ * Anything rebuilt from the configuration (gains, factorizations, caches
+ * keyed on dt) stays out. The archive never allocates: Save and Load work
+ * on a caller-owned buffer sized by a previous Measure pass.
+ */
+class ModuleCheckpoint {
+public:
+    enum class Mode {
+        Measure,    ///< Only count bytes
+        Save,       ///< Copy fields into the buffer
+        Load        ///< Copy fields out of the buffer
+    };
+
+    /// Archive that counts the bytes a Save would need
+    ModuleCheckpoint() = default;
+
+    ModuleCheckpoint(Mode mode, unsigned char* buffer, std::size_t capacity)
+        : mode_(mode), buffer_(buffer), capacity_(capacity) {}
+
+    template <typename T>
+    void io(T& field) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint fields must be trivially copyable");
+        bytes(&field, sizeof(T));
+    }
+
+    void bytes(void* data, std::size_t size) {
+        if (mode_ != Mode::Measure) {
+            if (offset_ + size > capacity_) {
+                overflowed_ = true;
+                return;
+            }
+            if (mode_ == Mode::Save) {
+                std::memcpy(buffer_ + offset_, data, size);
+            } else {
+                std::memcpy(data, buffer_ + offset_, size);
+            }
+        }
+        offset_ += size;
+    }
+
+    Mode mode() const { return mode_; }
+    bool loading() const { return mode_ == Mode::Load; }
+    std::size_t size() const { return offset_; }        ///< Bytes measured, saved or loaded so far
+    bool overflowed() const { return overflowed_; }     ///< A field did not fit in the buffer
+
+private:
+    Mode mode_{Mode::Measure};
+    unsigned char* buffer_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t offset_{0};
+    bool overflowed_{false};
+};
+
+#endif // CORE_MODULE_CHECKPOINT_H
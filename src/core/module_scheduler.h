@@ -0,0 +1,268 @@
+/**
+ * @file module_scheduler.h
+ * @brief Ordered, multi-rate module pipeline with per-module timing
+ */
+
+#ifndef MODULE_SCHEDULER_H
+#define MODULE_SCHEDULER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/module.h"
+#include "core/module_checkpoint.h"
+#include "core/simulation_state.h"
+
+/**
+ * @class ModuleScheduler
+ * @brief Runs modules in registration order, honouring fixed-rate modules
+ *
+ * Modules with period() == 0 run once per sub-step with the sub-step length.
+ * Modules with a positive period run at exactly that rate with dt equal to
+ * the period. A frame is split at every fixed-rate deadline, so e.g. a
+ * 500 Hz controller and the plant interleave as they would on a vehicle
+ * (controller output held constant between its updates) instead of the
+ * controller running several times against a stale plant state.
+ *
+ * The scheduler owns simulation time: each sub-step advances
+ * SimulationState::time_seconds before the modules run, matching the
+ * convention that update() sees the end time of the interval it covers.
+ *
+ * Update cost is measured with a steady clock around every module call and
+ * written to SimulationState::profile; the hot path does not allocate.
+ * The same clock reads check every update against its wall deadline and
+ * feed the real-time factor (SimulationState::Realtime), which are also
+ * recorded as the sim.rtf, sim.lateness_us and sim.deadline_misses
+ * telemetry channels.
+ */
+class ModuleScheduler {
+public:
+    /// Sub-steps per tick before the remainder is run as one step (guards against tiny periods)
+    static constexpr std::size_t kMaxSubsteps = 4096;
+
+    /**
+     * @brief Append a module; modules run in the order they were added
+     */
+    void add(std::unique_ptr<Module> module) {
+        entries_.push_back(Entry{std::move(module), 0.0});
+    }
+
+    std::size_t size() const { return entries_.size(); }
+    Module& module(std::size_t index) { return *entries_[index].module; }
+
+    /**
+     * @brief Initialize every module and reset the profile slots
+     */
+    void initialize(SimulationState& state) {
+        for (auto& entry : entries_) {
+            entry.module->initialize(state);
+            entry.until_due = 0.0;
+        }
+        auto& profile = state.profile;
+        profile.count = std::min(entries_.size(), SimulationState::ModuleProfile::kMaxSlots);
+        for (std::size_t i = 0; i < profile.count; ++i) {
+            profile.slots[i] = SimulationState::ModuleProfile::Slot{};
+            profile.slots[i].name = entries_[i].module->name();
+            profile.slots[i].period_s = entries_[i].module->period();
+        }
+        profile.tick_us = 0.0;
+
+        // Keep what the caller set; restart the measurements.
+        SimulationState::Realtime realtime;
+        realtime.wall_interval_s = state.realtime.wall_interval_s;
+        realtime.target_factor = state.realtime.target_factor;
+        realtime.max_tick_s = state.realtime.max_tick_s;
+        state.realtime = realtime;
+        rtf_channel_ = state.telemetry.registerChannel("sim.rtf", "x");
+        lateness_channel_ = state.telemetry.registerChannel("sim.lateness_us", "us");
+        miss_channel_ = state.telemetry.registerChannel("sim.deadline_misses", "");
+    }
+
+    /**
+     * @brief Save or restore every module's private state and fixed-rate phase
+     *
+     * Together with SimulationState::snapshot() this is everything advance()
+     * depends on besides the configuration and the controller setpoint.
+     */
+    void checkpoint(ModuleCheckpoint& archive) {
+        for (auto& entry : entries_) {
+            archive.io(entry.until_due);
+            entry.module->checkpoint(archive);
+        }
+    }
+
+    /**
+     * @brief configure() every module that listens to one of the changed sections
+     * @param changed ConfigSection bits
+     * @return Modules reconfigured
+     */
+    std::size_t reconfigure(unsigned changed, SimulationState& state) {
+        std::size_t count = 0;
+        for (auto& entry : entries_) {
+            if ((entry.module->configSections() & changed) != 0) {
+                entry.module->configure(state);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Clamp a tick derived from the wall clock to realtime.max_tick_s
+     *
+     * A frame that took longer than the cap allows cannot be made up; the
+     * excess is added to realtime.dropped_s and the smaller tick lowers the
+     * real-time factor.
+     *
+     * @return Simulated time the tick should advance
+     */
+    static double capTick(double dt, SimulationState& state) {
+        auto& realtime = state.realtime;
+        if (realtime.max_tick_s <= 0.0 || dt <= realtime.max_tick_s) {
+            return dt;
+        }
+        realtime.dropped_s += dt - realtime.max_tick_s;
+        return realtime.max_tick_s;
+    }
+
+    /**
+     * @brief Advance simulation time by dt, running every module that is due
+     */
+    void advance(double dt, SimulationState& state) {
+        const auto tick_start = Clock::now();
+        tick_start_ = tick_start;
+        wall_per_sim_ = state.realtime.target_factor > 0.0 ? 1.0 / state.realtime.target_factor : 0.0;
+        tick_misses_ = 0;
+        tick_lateness_us_ = 0.0;
+        double remaining = dt;
+        double elapsed = 0.0;   // Simulated time since the tick began
+        std::size_t substeps = 0;
+        while (remaining > kTimeEpsilon) {
+            // Next sub-step ends at the earliest fixed-rate deadline in this
+            // tick; a module due now is next due one period later.
+            double step = remaining;
+            if (++substeps < kMaxSubsteps) {
+                for (const auto& entry : entries_) {
+                    const double period = entry.module->period();
+                    if (period > 0.0) {
+                        step = std::min(step, entry.until_due > kTimeEpsilon ? entry.until_due : period);
+                    }
+                }
+            }
+
+            state.time_seconds += step;
+            for (std::size_t i = 0; i < entries_.size(); ++i) {
+                Entry& entry = entries_[i];
+                const double period = entry.module->period();
+                if (period <= 0.0) {
+                    run(i, step, elapsed + step, state);
+                    continue;
+                }
+                if (entry.until_due <= kTimeEpsilon) {
+                    run(i, period, elapsed + period, state);
+                    entry.until_due += period;
+                }
+                entry.until_due -= step;
+            }
+            remaining -= step;
+            elapsed += step;
+        }
+        state.profile.tick_us = microsecondsSince(tick_start);
+        trackRealtime(dt, state);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Deadlines closer than this are treated as reached (floating-point slack)
+    static constexpr double kTimeEpsilon = 1e-12;
+    /// Weight of the newest sample in the moving-average update time
+    static constexpr double kMeanWeight = 0.05;
+
+    struct Entry {
+        std::unique_ptr<Module> module;
+        double until_due;   ///< Time until a fixed-rate module is next due (s)
+    };
+
+    std::vector<Entry> entries_;
+    std::size_t rtf_channel_{TelemetryChannels::kInvalid};
+    std::size_t lateness_channel_{TelemetryChannels::kInvalid};
+    std::size_t miss_channel_{TelemetryChannels::kInvalid};
+
+    // Deadline bookkeeping of the tick in progress
+    Clock::time_point tick_start_{};
+    double wall_per_sim_{0.0};      ///< 1 / target_factor, or 0 when deadlines are off
+    std::uint64_t tick_misses_{0};
+    double tick_lateness_us_{0.0};
+
+    static double microseconds(Clock::duration elapsed) {
+        return std::chrono::duration<double, std::micro>(elapsed).count();
+    }
+
+    static double microsecondsSince(Clock::time_point start) {
+        return microseconds(Clock::now() - start);
+    }
+
+    /**
+     * @param deadline_s Simulated time since the tick began by which the
+     *        update is due (its release plus its period)
+     */
+    void run(std::size_t index, double dt, double deadline_s, SimulationState& state) {
+        const auto start = Clock::now();
+        entries_[index].module->update(dt, state);
+        if (index >= state.profile.count) {
+            return;
+        }
+        const auto finish = Clock::now();
+        auto& slot = state.profile.slots[index];
+        slot.last_us = microseconds(finish - start);
+        slot.mean_us = slot.calls == 0 ? slot.last_us
+                                       : slot.mean_us + kMeanWeight * (slot.last_us - slot.mean_us);
+        slot.max_us = std::max(slot.max_us, slot.last_us);
+        ++slot.calls;
+
+        if (wall_per_sim_ > 0.0) {
+            const double lateness_us = microseconds(finish - tick_start_) - 1e6 * deadline_s * wall_per_sim_;
+            if (lateness_us > 0.0) {
+                ++slot.deadline_misses;
+                slot.worst_lateness_us = std::max(slot.worst_lateness_us, lateness_us);
+                ++tick_misses_;
+                tick_lateness_us_ = std::max(tick_lateness_us_, lateness_us);
+            }
+        }
+    }
+
+    /// Fold the finished tick into the real-time factor, miss counts and channels
+    void trackRealtime(double dt, SimulationState& state) {
+        auto& realtime = state.realtime;
+        realtime.deadline_misses += tick_misses_;
+        realtime.worst_lateness_us = std::max(realtime.worst_lateness_us, tick_lateness_us_);
+        realtime.window_open_misses += tick_misses_;
+        if (wall_per_sim_ > 0.0) {
+            state.telemetry.record(lateness_channel_, state.time_seconds, tick_lateness_us_);
+            state.telemetry.record(miss_channel_, state.time_seconds, static_cast<double>(tick_misses_));
+        }
+
+        if (realtime.wall_interval_s <= 0.0) {
+            return;
+        }
+        realtime.tick_factor = dt / realtime.wall_interval_s;
+        state.telemetry.record(rtf_channel_, state.time_seconds, realtime.tick_factor);
+        realtime.window_sim_s += dt;
+        realtime.window_wall_s += realtime.wall_interval_s;
+        if (realtime.window_wall_s >= SimulationState::Realtime::kWindowS) {
+            realtime.factor = realtime.window_sim_s / realtime.window_wall_s;
+            realtime.window_misses = realtime.window_open_misses;
+            realtime.window_sim_s = 0.0;
+            realtime.window_wall_s = 0.0;
+            realtime.window_open_misses = 0;
+        }
+    }
+};
+
+#endif // MODULE_SCHEDULER_H
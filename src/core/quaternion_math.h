@@ -0,0 +1,35 @@
+/**
+ * @file quaternion_math.h
+ * @brief Quaternion helpers shared by the attitude-tracking controllers
+ */
+
+#ifndef CORE_QUATERNION_MATH_H
+#define CORE_QUATERNION_MATH_H
+
+#include <array>
+#include <cmath>
+
+/// Hamilton product a ⊗ b, quaternions stored [w, x, y, z]
+inline std::array<double, 4> quaternionMultiply(const std::array<double, 4>& a,
+                                                const std::array<double, 4>& b) {
+    return {a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+            a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+            a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1],
+            a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0]};
+}
+
+/// Body-to-NED quaternion from ZYX (yaw-pitch-roll) Euler angles
+inline std::array<double, 4> quaternionFromEuler(double roll, double pitch, double yaw) {
+    const double cr = std::cos(0.5 * roll);
+    const double sr = std::sin(0.5 * roll);
+    const double cp = std::cos(0.5 * pitch);
+    const double sp = std::sin(0.5 * pitch);
+    const double cy = std::cos(0.5 * yaw);
+    const double sy = std::sin(0.5 * yaw);
+    return {cr * cp * cy + sr * sp * sy,
+            sr * cp * cy - cr * sp * sy,
+            cr * sp * cy + sr * cp * sy,
+            cr * cp * sy - sr * sp * cy};
+}
+
+#endif  // CORE_QUATERNION_MATH_H
@@ -0,0 +1,370 @@
+/**
+ * @file rewind_timeline.h
+ * @brief Keyframe ring and input journal for seeking and branching a recorded run
+ */
+
+#ifndef CORE_REWIND_TIMELINE_H
+#define CORE_REWIND_TIMELINE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "core/attitude_history.h"
+#include "core/memory_accounting.h"
+#include "core/module_checkpoint.h"
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+
+/**
+ * @class RewindTimeline
+ * @brief Records a run compactly and puts the simulation back at any recorded time
+ *
+ * Two things are recorded while the simulation runs live (step()):
+ * - a journal of every tick's dt plus the pilot inputs (controller
+ *   setpoint, commanded body rates) whenever they change;
+ * - every keyframe_interval_s a keyframe: the hot vehicle block
+ *   (SimulationState::snapshot()), the setpoint and every module's
+ *   checkpoint() data, in a fixed-stride ring preallocated for
+ *   max_keyframes entries.
+ *
+ * seek() restores the nearest keyframe at or before the target and replays
+ * the journal up to it. The scheduler is deterministic, so the replayed
+ * state is bit-identical to the recorded one, and no seek replays more
+ * than one keyframe interval. Seeking forward from a replayed position
+ * continues from there instead of reloading. When the ring is full the
+ * oldest keyframe and the journal before it are dropped, bounding how far
+ * back a seek can go to max_keyframes × keyframe_interval_s.
+ *
+ * Edits the journal cannot express (attitude resets, manual rotation
+ * steps, anything else written into the hot block between ticks) force a
+ * keyframe instead; moving time itself starts a new recording.
+ * Configuration is not recorded: replay uses the current settings, so a
+ * seek after changing gains shows what the recorded inputs would have done
+ * with them. branch() forgets everything after the playhead so the run
+ * continues live from there.
+ *
+ * Keyframes and the journal are charged to MemoryTag::History.
+ */
+class RewindTimeline {
+public:
+    using ControllerSetpoint = SimulationState::ControllerSetpoint;
+
+    struct Settings {
+        double keyframe_interval_s{1.0};    ///< Simulated time between keyframes (s)
+        std::size_t max_keyframes{600};     ///< Ring length (600 × 1 s covers a 10-minute session)
+    };
+
+    /**
+     * @brief Start a new recording at the current state
+     *
+     * Call after the scheduler is initialized, and again whenever modules
+     * are added (the per-keyframe module size is measured here).
+     */
+    void reset(ModuleScheduler& modules, const SimulationState& state, const Settings& settings) {
+        settings_ = settings;
+        settings_.keyframe_interval_s = std::max(settings_.keyframe_interval_s, 1e-3);
+        settings_.max_keyframes = std::max<std::size_t>(settings_.max_keyframes, 2);
+        ModuleCheckpoint measure;
+        modules.checkpoint(measure);
+        module_bytes_ = measure.size();
+        stride_ = kHotBytes + sizeof(ControllerSetpoint) + module_bytes_;
+        ring_.assign(stride_ * settings_.max_keyframes, 0);
+        restart(modules, state);
+    }
+
+    void reset(ModuleScheduler& modules, const SimulationState& state) {
+        reset(modules, state, settings_);
+    }
+
+    /**
+     * @brief Run one live tick and record it
+     *
+     * Stepping from a rewound playhead branches there first. Sets
+     * last_dt; the caller samples the plotted histories afterwards.
+     */
+    void step(double dt, ModuleScheduler& modules, SimulationState& state) {
+        if (keyframes_.empty()) {
+            reset(modules, state);
+        }
+        if (!atEnd()) {
+            branch();
+        }
+        noteEdits(modules, state);
+        state.last_dt = dt;
+        modules.advance(dt, state);
+        ticks_.push_back(Tick{dt, state.time_seconds});
+        ++playhead_;
+        if (state.time_seconds - keyframes_.back().time >= settings_.keyframe_interval_s) {
+            saveKeyframe(modules, state);
+        }
+        remember(state);
+    }
+
+    /**
+     * @brief Put the simulation at the last recorded tick at or before time_s
+     *
+     * Times outside the recording are clamped to it. Histories and
+     * telemetry newer than the restored keyframe are discarded and
+     * refilled by the replay. Edits made since the last step or seek are
+     * dropped.
+     *
+     * @return Simulation time reached
+     */
+    double seek(double time_s, ModuleScheduler& modules, SimulationState& state) {
+        if (keyframes_.empty()) {
+            return state.time_seconds;
+        }
+        // Ticks are recorded in time order: the target is the number of
+        // ticks that end at or before time_s.
+        const auto last = std::upper_bound(ticks_.begin(), ticks_.end(), time_s,
+                                           [](double t, const Tick& tick) { return t < tick.end_time; });
+        std::uint64_t target = first_tick_ + static_cast<std::uint64_t>(last - ticks_.begin());
+        target = std::max(target, keyframes_.front().tick);
+
+        auto keyframe = std::upper_bound(keyframes_.begin(), keyframes_.end(), target,
+                                         [](std::uint64_t tick, const Keyframe& k) { return tick < k.tick; });
+        --keyframe;
+        std::uint64_t from = playhead_;
+        if (playhead_ > target || playhead_ < keyframe->tick || edited(state)) {
+            loadKeyframe(*keyframe, modules, state);
+            discardAfter(keyframe->time, state);
+            from = keyframe->tick;
+        }
+        replay(from, target, modules, state);
+        return state.time_seconds;
+    }
+
+    /**
+     * @brief Forget the recording after the playhead; the next step() continues live from here
+     */
+    void branch() {
+        while (first_tick_ + ticks_.size() > playhead_) {
+            ticks_.pop_back();
+        }
+        while (!inputs_.empty() && inputs_.back().tick >= playhead_) {
+            inputs_.pop_back();
+        }
+        while (keyframes_.size() > 1 && keyframes_.back().tick > playhead_) {
+            keyframes_.pop_back();
+        }
+    }
+
+    bool atEnd() const { return playhead_ == first_tick_ + ticks_.size(); }
+
+    /// Earliest time a seek can reach
+    double startTime() const { return keyframes_.empty() ? 0.0 : keyframes_.front().time; }
+
+    /// Time of the newest recorded tick
+    double endTime() const {
+        if (!ticks_.empty()) {
+            return ticks_.back().end_time;
+        }
+        return keyframes_.empty() ? 0.0 : keyframes_.back().time;
+    }
+
+    std::size_t keyframeCount() const { return keyframes_.size(); }
+    std::size_t tickCount() const { return ticks_.size(); }
+    std::size_t inputCount() const { return inputs_.size(); }
+    std::size_t keyframeBytes() const { return stride_; }
+    const Settings& settings() const { return settings_; }
+
+private:
+    static constexpr std::size_t kHotBytes = sizeof(SimulationHotState);
+
+    struct Tick {
+        double dt;          ///< Frame length passed to ModuleScheduler::advance (s)
+        double end_time;    ///< time_seconds after the tick
+    };
+
+    /// Pilot inputs that take effect before tick `tick`
+    struct Input {
+        std::uint64_t tick;
+        ControllerSetpoint setpoint;
+        glm::dvec3 angular_rate_rad_s;
+    };
+
+    struct Keyframe {
+        std::uint64_t tick;     ///< State before this tick
+        double time;
+        std::size_t slot;       ///< Index into ring_
+    };
+
+    Settings settings_{};
+    std::size_t module_bytes_{0};
+    std::size_t stride_{0};
+    TrackedVector<unsigned char, MemoryTag::History> ring_;
+    TrackedDeque<Keyframe, MemoryTag::History> keyframes_;
+    TrackedDeque<Tick, MemoryTag::History> ticks_;
+    TrackedDeque<Input, MemoryTag::History> inputs_;
+    std::uint64_t first_tick_{0};   ///< Absolute index of ticks_.front()
+    std::uint64_t playhead_{0};     ///< Ticks applied to the current state
+
+    // The state as the last step or replay left it, to tell edits apart
+    std::array<unsigned char, kHotBytes> after_{};
+    ControllerSetpoint after_setpoint_{};
+
+    static const unsigned char* hotBytes(const SimulationState& state) {
+        return reinterpret_cast<const unsigned char*>(static_cast<const SimulationHotState*>(&state));
+    }
+
+    /// Byte offset of a hot-block field
+    static std::size_t offsetOf(const SimulationState& state, const void* field) {
+        return static_cast<std::size_t>(static_cast<const unsigned char*>(field) - hotBytes(state));
+    }
+
+    static bool sameSetpoint(const ControllerSetpoint& a, const ControllerSetpoint& b) {
+        return std::memcmp(&a, &b, sizeof(ControllerSetpoint)) == 0;
+    }
+
+    void restart(ModuleScheduler& modules, const SimulationState& state) {
+        keyframes_.clear();
+        ticks_.clear();
+        inputs_.clear();
+        first_tick_ = 0;
+        playhead_ = 0;
+        saveKeyframe(modules, state);
+        remember(state);
+    }
+
+    void remember(const SimulationState& state) {
+        std::memcpy(after_.data(), hotBytes(state), kHotBytes);
+        after_setpoint_ = state.controller_setpoint;
+    }
+
+    bool edited(const SimulationState& state) const {
+        return std::memcmp(after_.data(), hotBytes(state), kHotBytes) != 0 ||
+               !sameSetpoint(after_setpoint_, state.controller_setpoint);
+    }
+
+    /// Journal input changes made since the last tick; keyframe anything else
+    void noteEdits(ModuleScheduler& modules, SimulationState& state) {
+        const unsigned char* hot = hotBytes(state);
+        if (std::memcmp(after_.data(), hot, kHotBytes) == 0) {
+            if (!sameSetpoint(after_setpoint_, state.controller_setpoint)) {
+                journalInput(state);
+            }
+            return;
+        }
+        double recorded_time;
+        std::memcpy(&recorded_time, after_.data() + offsetOf(state, &state.time_seconds), sizeof(double));
+        if (recorded_time != state.time_seconds) {
+            restart(modules, state);    // Time was reset: the recording no longer applies
+            return;
+        }
+        const std::size_t rate = offsetOf(state, &state.angular_rate_rad_s);
+        const std::size_t rate_end = rate + sizeof(glm::dvec3);
+        if (std::memcmp(after_.data(), hot, rate) == 0 &&
+            std::memcmp(after_.data() + rate_end, hot + rate_end, kHotBytes - rate_end) == 0) {
+            journalInput(state);        // Only the commanded body rates changed
+        } else {
+            saveKeyframe(modules, state);
+        }
+    }
+
+    void journalInput(const SimulationState& state) {
+        inputs_.push_back(Input{playhead_, state.controller_setpoint, state.angular_rate_rad_s});
+    }
+
+    void saveKeyframe(ModuleScheduler& modules, const SimulationState& state) {
+        if (!keyframes_.empty() && keyframes_.back().tick == playhead_) {
+            keyframes_.back().time = state.time_seconds;
+        } else {
+            if (keyframes_.size() == settings_.max_keyframes) {
+                dropOldestKeyframe();
+            }
+            const std::size_t slot = keyframes_.empty() ? 0 : (keyframes_.back().slot + 1) % settings_.max_keyframes;
+            keyframes_.push_back(Keyframe{playhead_, state.time_seconds, slot});
+        }
+        unsigned char* data = ring_.data() + keyframes_.back().slot * stride_;
+        std::memcpy(data, hotBytes(state), kHotBytes);
+        std::memcpy(data + kHotBytes, &state.controller_setpoint, sizeof(ControllerSetpoint));
+        ModuleCheckpoint archive(ModuleCheckpoint::Mode::Save, data + kHotBytes + sizeof(ControllerSetpoint),
+                                 module_bytes_);
+        modules.checkpoint(archive);
+    }
+
+    void loadKeyframe(const Keyframe& keyframe, ModuleScheduler& modules, SimulationState& state) {
+        unsigned char* data = ring_.data() + keyframe.slot * stride_;
+        SimulationHotState hot;
+        std::memcpy(&hot, data, kHotBytes);
+        state.restore(hot);
+        std::memcpy(&state.controller_setpoint, data + kHotBytes, sizeof(ControllerSetpoint));
+        ModuleCheckpoint archive(ModuleCheckpoint::Mode::Load, data + kHotBytes + sizeof(ControllerSetpoint),
+                                 module_bytes_);
+        modules.checkpoint(archive);
+        playhead_ = keyframe.tick;
+    }
+
+    void dropOldestKeyframe() {
+        keyframes_.pop_front();
+        const std::uint64_t oldest = keyframes_.front().tick;
+        while (first_tick_ < oldest && !ticks_.empty()) {
+            ticks_.pop_front();
+            ++first_tick_;
+        }
+        while (!inputs_.empty() && inputs_.front().tick < oldest) {
+            inputs_.pop_front();
+        }
+    }
+
+    /// Apply journaled ticks [from, to) to a state that is at tick `from`
+    void replay(std::uint64_t from, std::uint64_t to, ModuleScheduler& modules, SimulationState& state) {
+        // Replay as fast as possible: no wall-clock deadlines or RTF samples.
+        const double wall_interval_s = state.realtime.wall_interval_s;
+        const double target_factor = state.realtime.target_factor;
+        state.realtime.wall_interval_s = 0.0;
+        state.realtime.target_factor = 0.0;
+
+        auto input = std::lower_bound(inputs_.begin(), inputs_.end(), from,
+                                      [](const Input& in, std::uint64_t tick) { return in.tick < tick; });
+        for (std::uint64_t tick = from; tick < to; ++tick) {
+            for (; input != inputs_.end() && input->tick == tick; ++input) {
+                state.controller_setpoint = input->setpoint;
+                state.angular_rate_rad_s = input->angular_rate_rad_s;
+            }
+            const Tick& recorded = ticks_[static_cast<std::size_t>(tick - first_tick_)];
+            modules.advance(recorded.dt, state);
+            state.last_dt = recorded.dt;
+            captureAttitudeSample(state);
+        }
+        playhead_ = to;
+
+        state.realtime.wall_interval_s = wall_interval_s;
+        state.realtime.target_factor = target_factor;
+        remember(state);
+    }
+
+    /// Drop history and telemetry samples the replay is about to produce again
+    static void discardAfter(double time_s, SimulationState& state) {
+        auto& attitude = state.attitude_history;
+        while (!attitude.samples.empty() && attitude.samples.back().timestamp > time_s) {
+            attitude.samples.pop_back();
+        }
+        attitude.last_sample_time = attitude.samples.empty() ? -std::numeric_limits<double>::infinity()
+                                                             : attitude.samples.back().timestamp;
+
+        auto& rotors = state.rotor_history;
+        for (auto& samples : rotors.rotors) {
+            while (!samples.empty() && samples.back().timestamp > time_s) {
+                samples.pop_back();
+            }
+        }
+        rotors.last_sample_time = rotors.rotors[0].empty() ? -std::numeric_limits<double>::infinity()
+                                                           : rotors.rotors[0].back().timestamp;
+
+        auto& sensors = state.sensor_history;
+        while (!sensors.samples.empty() && sensors.samples.back().timestamp > time_s) {
+            sensors.samples.pop_back();
+        }
+        sensors.last_sample_time = sensors.samples.empty() ? -std::numeric_limits<double>::infinity()
+                                                           : sensors.samples.back().timestamp;
+
+        state.telemetry.discardAfter(time_s);
+    }
+};
+
+#endif // CORE_REWIND_TIMELINE_H
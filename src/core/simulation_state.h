@@ -7,11 +7,154 @@
 #define SIMULATION_STATE_H
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <limits>
+#include <string>
+#include <type_traits>
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include "attitude/euler.h"
+#include "attitude/quaternion.h"
+#include "core/dormand_prince.h"
+#include "core/memory_accounting.h"
+#include "core/telemetry_channels.h"
+
+/**
+ * @struct SimulationHotState
+ * @brief The vehicle state modules advance every step, as one trivially copyable block
+ *
+ * Time, attitude, rigid-body state, motor commands and speeds, controller
+ * internals, sensor and estimator outputs, rotor telemetry and power: the
+ * fields a step reads and writes. Histories, configuration, telemetry
+ * channels and UI settings live in SimulationState around it, so a full
+ * vehicle snapshot (SimulationState::snapshot()) is a single memcpy of
+ * about a kilobyte, cheap enough for a rewind buffer or a worker thread.
+ *
+ * Keep it trivially copyable: no containers, strings or pointers to
+ * other state.
+ */
+struct SimulationHotState {
+    /// Capacity of every per-rotor array; only the first vehicle_config.rotor_count entries are live.
+    static constexpr std::size_t kMaxRotors = 8;
+
+    // === Timing ===
+    double time_seconds{0.0};      ///< Elapsed simulation time (seconds)
+    double last_dt{0.0};           ///< Last frame's timestep (seconds)
+
+    // === Attitude Representation (canonical) ===
+    std::array<double, 4> quaternion{1.0, 0.0, 0.0, 0.0};     ///< Current attitude quaternion [w, x, y, z] (write via SimulationState::setAttitude())
+    glm::dvec3 angular_rate_rad_s{0.0, 0.0, 0.5235987755982988}; ///< Angular velocity (rad/s) about body axes
+
+    // === Physics State (6-DOF Rigid Body) ===
+    /**
+     * @struct PhysicsState
+     * @brief Complete 6-DOF rigid body state for quadcopter dynamics
+     */
+    struct PhysicsState {
+        glm::dvec3 position{0.0, 0.0, 0.0};         ///< Position in inertial frame (m)
+        glm::dvec3 velocity{0.0, 0.0, 0.0};         ///< Velocity in inertial frame (m/s)
+        glm::dvec3 force_body{0.0, 0.0, 0.0};       ///< Total force in body frame (N)
+        glm::dvec3 torque_body{0.0, 0.0, 0.0};      ///< Total torque in body frame (N·m)
+        glm::dvec3 acceleration{0.0, 0.0, 0.0};     ///< Acceleration in inertial frame (m/s²)
+        double mass{0.5};                            ///< Vehicle mass (kg)
+        glm::dmat3 inertia{{0.01, 0.0, 0.0},        ///< Inertia tensor (kg·m²)
+                           {0.0, 0.01, 0.0},
+                           {0.0, 0.0, 0.02}};
+        bool integration_valid{true};                ///< Last plant step passed every numerical gate
+        int last_result{0};                          ///< Last dm_result_t value without coupling UI to the C header
+        std::uint64_t accepted_steps{0};             ///< Successfully committed plant steps
+        std::uint64_t rejected_steps{0};             ///< Plant steps rejected before state commit
+    } physics;
+
+    /**
+     * @struct MotorCommands
+     * @brief Commanded rotor speeds for control input
+     */
+    struct MotorCommands {
+        std::array<double, kMaxRotors> omega_rad_s{};   ///< Commanded angular velocities (rad/s)
+        std::array<double, kMaxRotors> throttle_0_1{};  ///< Throttle commands [0, 1]
+    } motor_commands;
+
+    /**
+     * @struct MotorState
+     * @brief Actual rotor speeds after motor dynamics (what the plant sees)
+     */
+    struct MotorState {
+        std::array<double, kMaxRotors> omega_rad_s{};   ///< Actual angular velocities (rad/s)
+    } motor_state;
+
+    /**
+     * @struct ControllerState
+     * @brief Controller internals published for plots and tuning
+     */
+    struct ControllerState {
+        glm::dvec3 rate_setpoint_rad_s{0.0};     ///< Rate loop reference actually used
+        glm::dvec3 rate_integral{0.0};           ///< Integrator state (rad/s²)
+        glm::dvec3 accel_command_rad_s2{0.0};    ///< Rate loop output
+        glm::dvec3 torque_command_nm{0.0};       ///< Body torque sent to the mixer
+        double thrust_command_newton{0.0};       ///< Collective thrust sent to the mixer
+        bool saturated{false};                   ///< A motor hit its speed limit on the last update
+        std::uint64_t updates{0};                ///< Controller updates since initialize
+    } controller_state;
+
+    /**
+     * @struct DynamicsState
+     * @brief State variables for first-order dynamics module
+     */
+    struct DynamicsState {
+        double input{0.0};          ///< Current input to the dynamics system
+        double output{0.0};         ///< Current output of the dynamics system
+        double internal_state{0.0}; ///< Internal state variable
+    } dynamics_state;
+
+    /**
+     * @struct SensorFrame
+     * @brief Simulated IMU sensor measurements
+     */
+    struct SensorFrame {
+        glm::vec3 gyro_rad_s{0.0f};   ///< Gyroscope measurement (rad/s) in body frame
+        glm::vec3 accel_mps2{0.0f};   ///< Accelerometer measurement (m/s²) in body frame
+    } sensor;
+
+    /**
+     * @struct EstimatorState
+     * @brief State estimate from sensor fusion algorithm
+     */
+    struct EstimatorState {
+        std::array<double, 4> quaternion{1.0, 0.0, 0.0, 0.0}; ///< Estimated attitude quaternion [w, x, y, z]
+        EulerAngles euler{0.0, 0.0, 0.0, EULER_ZYX};         ///< Estimated attitude in Euler angles
+    } estimator;
+
+    /**
+     * @struct RotorTelemetry
+     * @brief Computed rotor performance metrics
+     */
+    struct RotorTelemetry {
+        std::array<double, kMaxRotors> rpm{};                  ///< Rotor speeds (RPM)
+        std::array<double, kMaxRotors> thrust_newton{};        ///< Individual thrust per rotor (N)
+        std::array<double, kMaxRotors> torque_newton_metre{};  ///< Individual torque per rotor (N·m)
+        double total_thrust_newton{0.0};                                ///< Sum of all rotor thrust (N)
+        double total_power_watt{0.0};                                   ///< Total electrical power consumption (W)
+    } rotor;
+
+    /**
+     * @struct PowerHistory
+     * @brief Electrical power consumption tracking
+     */
+    struct PowerHistory {
+        double bus_voltage{22.2};   ///< Battery/bus voltage (V)
+        double bus_current{0.0};    ///< Total current draw (A)
+        double energy_joule{0.0};   ///< Cumulative energy consumed (J)
+    } power;
+
+    // === Environment ===
+    glm::dvec3 wind_ned{0.0};   ///< Air velocity at the vehicle: steady + gust + turbulence (m/s, NED; WindFieldModule)
+};
+
+static_assert(std::is_trivially_copyable<SimulationHotState>::value,
+              "SimulationHotState must stay a plain block of data");
 
 /**
  * @struct SimulationState
@@ -25,13 +168,125 @@
  * - Single source of truth for all simulation data
  * - Modules communicate through state (loose coupling)
  * - Panels have read/write access for interactive control
+ *
+ * The per-step vehicle state is the SimulationHotState base (first in
+ * memory, trivially copyable); everything declared here is configuration,
+ * history, telemetry or UI state.
+ *
+ * Attitude is stored canonically as a quaternion plus body rates in rad/s.
+ * Euler angles, the DCM and the render model matrix are derived views that
+ * are computed on first access after the pose changes and then shared by
+ * every consumer, so headless runs never pay for render-only conversions.
  */
-struct SimulationState {
-    // === Attitude Representation ===
-    EulerAngles euler{0.0, 0.0, 0.0, EULER_ZYX};              ///< Current attitude in Euler angles (ZYX convention)
-    std::array<double, 4> quaternion{1.0, 0.0, 0.0, 0.0};     ///< Current attitude quaternion [w, x, y, z]
-    glm::mat4 model_matrix{1.0f};                             ///< Model transformation matrix for rendering
-    glm::dvec3 angular_rate_deg_per_sec{0.0, 0.0, 30.0};     ///< Angular velocity (deg/s) about body axes
+struct SimulationState : SimulationHotState {
+    /// Row-major body-to-NED direction cosine matrix, as produced by quaternion_to_dcm().
+    using Dcm = double[3][3];
+
+    /// Supported multirotor airframes (geometry tables live in modules/airframe_layout.h)
+    enum class Airframe {
+        QuadX,     ///< 4 rotors, arms at 45 deg
+        QuadPlus,  ///< 4 rotors, arms on the body axes
+        HexX,      ///< 6 rotors
+        OctoX      ///< 8 rotors
+    };
+
+    /**
+     * @brief Copy of the hot vehicle block (one memcpy; histories and configuration are not included)
+     */
+    SimulationHotState snapshot() const {
+        return static_cast<const SimulationHotState&>(*this);
+    }
+
+    /**
+     * @brief Overwrite the hot vehicle block from a snapshot and invalidate all derived views
+     *
+     * Histories, configuration and telemetry are left as they are.
+     */
+    void restore(const SimulationHotState& hot) {
+        static_cast<SimulationHotState&>(*this) = hot;
+        markPoseDirty();
+    }
+
+    /**
+     * @brief Replace the attitude quaternion and invalidate all derived views
+     * @param q Attitude quaternion [w, x, y, z] (body to NED)
+     */
+    void setAttitude(const std::array<double, 4>& q) {
+        quaternion = q;
+        markPoseDirty();
+    }
+
+    /**
+     * @brief Invalidate derived views after writing quaternion or physics.position directly
+     */
+    void markPoseDirty() const {
+        derived_.dirty = DerivedViews::kAll;
+    }
+
+    /**
+     * @brief Attitude in ZYX Euler angles (rad), computed lazily from the quaternion
+     */
+    const EulerAngles& euler() const {
+        if (derived_.dirty & DerivedViews::kEuler) {
+            quaternion_to_euler(quaternion.data(),
+                                &derived_.euler.roll,
+                                &derived_.euler.pitch,
+                                &derived_.euler.yaw);
+            derived_.euler.order = EULER_ZYX;
+            derived_.dirty &= ~DerivedViews::kEuler;
+        }
+        return derived_.euler;
+    }
+
+    /**
+     * @brief Body-to-NED direction cosine matrix, computed lazily from the quaternion
+     */
+    const Dcm& dcm() const {
+        if (derived_.dirty & DerivedViews::kDcm) {
+            quaternion_to_dcm(quaternion.data(), derived_.dcm);
+            derived_.dirty &= ~DerivedViews::kDcm;
+        }
+        return derived_.dcm;
+    }
+
+    /**
+     * @brief Render-space model matrix (translation + attitude), computed lazily
+     *
+     * Physics stays in NED; the NED -> renderer (right/east, up, back/-north)
+     * adaptation happens only here, at the render boundary.
+     */
+    const glm::mat4& modelMatrix() const {
+        if (derived_.dirty & DerivedViews::kModelMatrix) {
+            const Dcm& body_to_ned = dcm();
+            glm::mat4 ned_from_body(1.0f);
+            for (int row = 0; row < 3; ++row) {
+                for (int col = 0; col < 3; ++col) {
+                    ned_from_body[col][row] = static_cast<float>(body_to_ned[row][col]);
+                }
+            }
+
+            glm::mat4 render_from_ned(1.0f);
+            render_from_ned[0][0] = 0.0f;
+            render_from_ned[1][0] = 1.0f;
+            render_from_ned[2][0] = 0.0f;
+            render_from_ned[0][1] = 0.0f;
+            render_from_ned[1][1] = 0.0f;
+            render_from_ned[2][1] = -1.0f;
+            render_from_ned[0][2] = -1.0f;
+            render_from_ned[1][2] = 0.0f;
+            render_from_ned[2][2] = 0.0f;
+
+            const glm::vec4 position_ned(static_cast<float>(physics.position.x),
+                                         static_cast<float>(physics.position.y),
+                                         static_cast<float>(physics.position.z),
+                                         1.0f);
+            const glm::vec3 position_render = glm::vec3(render_from_ned * position_ned);
+            derived_.model_matrix =
+                glm::translate(glm::mat4(1.0f), position_render) * render_from_ned * ned_from_body;
+            derived_.dirty &= ~DerivedViews::kModelMatrix;
+        }
+        return derived_.model_matrix;
+    }
 
     /**
      * @struct AttitudeSample
@@ -47,10 +302,11 @@ struct SimulationState {
     };
 
     struct AttitudeHistory {
-        std::deque<AttitudeSample> samples;     ///< Ring-buffer of samples (oldest at front)
+        TrackedDeque<AttitudeSample, MemoryTag::History> samples;  ///< Ring-buffer of samples (oldest at front)
         double window_seconds{15.0};            ///< Time window to retain (seconds)
         double sample_interval{0.016};          ///< Desired sampling period (seconds) - ~60Hz for smooth plots
         double last_sample_time{-std::numeric_limits<double>::infinity()}; ///< Timestamp of last captured sample
+        int decimation{1};                      ///< Sampling-interval multiplier imposed by the memory cap
     } attitude_history;
 
     /**
@@ -68,13 +324,12 @@ struct SimulationState {
     };
 
     struct RotorHistory {
-        std::deque<RotorSample> rotor1_samples;  ///< Motor 1 telemetry
-        std::deque<RotorSample> rotor2_samples;  ///< Motor 2 telemetry
-        std::deque<RotorSample> rotor3_samples;  ///< Motor 3 telemetry
-        std::deque<RotorSample> rotor4_samples;  ///< Motor 4 telemetry
+        using Samples = TrackedDeque<RotorSample, MemoryTag::History>;
+        std::array<Samples, kMaxRotors> rotors;  ///< Per-motor telemetry (first rotor_count used)
         double window_seconds{60.0};             ///< Time window (60s for rotor analysis)
         double sample_interval{0.1};             ///< Sample rate (10 Hz)
         double last_sample_time{-std::numeric_limits<double>::infinity()};
+        int decimation{1};                       ///< Sampling-interval multiplier imposed by the memory cap
     } rotor_history;
 
     /**
@@ -89,7 +344,7 @@ struct SimulationState {
     };
 
     struct SensorHistory {
-        std::deque<SensorSample> samples;
+        TrackedDeque<SensorSample, MemoryTag::History> samples;
         double window_seconds{30.0};     ///< Time window (30s for sensor plots)
         double sample_interval{0.01};    ///< Sample rate (100 Hz, typical IMU rate)
         double last_sample_time{-std::numeric_limits<double>::infinity()};
@@ -102,31 +357,49 @@ struct SimulationState {
         float trail_width{2.0f};                ///< Pixel width for trail rendering
     } attitude_history_video;
 
+    /**
+     * @struct PlantIntegration
+     * @brief Integrator selection and error control for the vehicle plant
+     *
+     * FixedRk4 substeps every frame at a fixed 2.5 ms through dynamic_models.
+     * DormandPrince45 adapts the step to the local error estimate, so calm
+     * flight takes few long steps and aggressive maneuvers take many short
+     * ones. In adaptive mode physics.rejected_steps also counts trial steps
+     * that failed error control and were retried (these do not pause).
+     */
+    struct PlantIntegration {
+        enum class Method {
+            FixedRk4,        ///< dm_vehicle_step_rk4_checked at <= 2.5 ms substeps
+            DormandPrince45  ///< Adaptive embedded RK5(4) with FSAL and dense output
+        };
+        Method method{Method::FixedRk4};        ///< Active integration scheme
+        double relative_tolerance{1e-6};         ///< Adaptive relative error tolerance
+        double absolute_tolerance{1e-8};         ///< Adaptive absolute error tolerance
+        double max_step_s{0.05};                 ///< Upper bound on adaptive step length (s)
+        double min_step_s{1e-7};                 ///< Adaptive steps below this abort the frame (s)
+        double last_step_s{0.0};                 ///< Step length the controller will try next (s)
+        std::uint64_t derivative_evaluations{0}; ///< Right-hand-side evaluations (adaptive mode)
+        bool record_trajectory{false};           ///< Keep the dense output in trajectory (analysis only)
 
-    // === Timing ===
-    double time_seconds{0.0};      ///< Elapsed simulation time (seconds)
-    double last_dt{0.0};           ///< Last frame's timestep (seconds)
+        /// Continuous extension of the last frame's adaptive solution, packed as
+        /// [position(3), velocity(3), quaternion(4), body rates(3)] over
+        /// [time_seconds - last_dt, time_seconds]. Empty in FixedRk4 mode and
+        /// unless record_trajectory is set; nothing in the pipeline reads it, as
+        /// modules run at sub-step boundaries where the plant state is exact.
+        DenseTrajectory<13> trajectory;
+    } plant_integration;
 
-    // === Physics State (6-DOF Rigid Body) ===
     /**
-     * @struct PhysicsState
-     * @brief Complete 6-DOF rigid body state for quadcopter dynamics
+     * @struct RotorGeometry
+     * @brief One rotor as configured in the plant (body FRD frame)
      */
-    struct PhysicsState {
-        glm::dvec3 position{0.0, 0.0, 0.0};         ///< Position in inertial frame (m)
-        glm::dvec3 velocity{0.0, 0.0, 0.0};         ///< Velocity in inertial frame (m/s)
-        glm::dvec3 force_body{0.0, 0.0, 0.0};       ///< Total force in body frame (N)
-        glm::dvec3 torque_body{0.0, 0.0, 0.0};      ///< Total torque in body frame (N·m)
-        glm::dvec3 acceleration{0.0, 0.0, 0.0};     ///< Acceleration in inertial frame (m/s²)
-        double mass{0.5};                            ///< Vehicle mass (kg)
-        glm::dmat3 inertia{{0.01, 0.0, 0.0},        ///< Inertia tensor (kg·m²)
-                           {0.0, 0.01, 0.0},
-                           {0.0, 0.0, 0.02}};
-        bool integration_valid{true};                ///< Last plant step passed every numerical gate
-        int last_result{0};                          ///< Last dm_result_t value without coupling UI to the C header
-        std::uint64_t accepted_steps{0};             ///< Successfully committed plant steps
-        std::uint64_t rejected_steps{0};             ///< Plant steps rejected before state commit
-    } physics;
+    struct RotorGeometry {
+        std::array<double, 3> position_body_m{};        ///< Hub position relative to the CoM (m)
+        std::array<double, 3> axis_body{{0.0, 0.0, -1.0}}; ///< Unit thrust direction
+        double direction{1.0};                          ///< Spin sense (+1 CW, -1 CCW)
+        double thrust_coeff{0.0};                       ///< N/(rad/s)²
+        double torque_coeff{0.0};                       ///< N·m/(rad/s)²
+    };
 
     /**
      * @struct VehicleConfig
@@ -136,62 +409,280 @@ struct SimulationState {
         double mass{0.5};                ///< Total mass including battery (kg)
         double arm_length{0.225};        ///< Distance from center to rotor (m)
         double gravity{9.81};            ///< Gravitational acceleration (m/s²)
-        double drag_coefficient{0.01};   ///< Linear drag coefficient
+        double drag_coefficient{0.01};   ///< Linear air-relative drag (N per m/s; in the plant when a wind module runs, and in the LQR design)
+        Airframe airframe{Airframe::QuadX}; ///< Rotor layout instantiated at startup
+        std::size_t rotor_count{4};      ///< Active rotors (written by the plant from its layout)
 
         // Inertia tensor (kg·m²) - typical 450mm quadcopter
         double Ixx{0.0075};  ///< Moment of inertia about X axis
         double Iyy{0.0075};  ///< Moment of inertia about Y axis
         double Izz{0.0130};  ///< Moment of inertia about Z axis
+
+        std::array<RotorGeometry, kMaxRotors> rotors{};  ///< Rotor geometry published by the plant
+        std::uint64_t rotor_geometry_revision{0};         ///< Bumped whenever rotors changes (0 = unset)
+
+        /// Geometry the plant builds instead of its layout table (set by config files, see RigConfig)
+        std::array<RotorGeometry, kMaxRotors> rotor_table{};
+        bool rotor_table_set{false};     ///< false: layout table at arm_length with RotorConfig coefficients
     } vehicle_config;
 
     /**
-     * @struct MotorCommands
-     * @brief Commanded rotor speeds for control input
+     * @struct TrimStatus
+     * @brief Hover equilibrium the plant solved for at initialize (see control/trim.h)
      */
-    struct MotorCommands {
-        std::array<double, 4> omega_rad_s{0.0, 0.0, 0.0, 0.0};  ///< Commanded angular velocities (rad/s)
-        std::array<double, 4> throttle_0_1{0.0, 0.0, 0.0, 0.0}; ///< Throttle commands [0, 1]
-    } motor_commands;
+    struct TrimStatus {
+        bool converged{false};               ///< Newton solve met its tolerance
+        std::size_t iterations{0};           ///< Newton steps taken
+        double residual{0.0};                ///< Worst acceleration error at the solution (m/s², rad/s²)
+        double solve_us{0.0};                ///< Wall time of the solve (µs)
+        double roll_rad{0.0};
+        double pitch_rad{0.0};
+        std::array<double, kMaxRotors> rotor_omega_rad_s{};  ///< Trim rotor speeds
+    } trim;
 
     /**
-     * @struct DynamicsConfig
-     * @brief Configuration for first-order dynamics test module
+     * @struct MotorConfig
+     * @brief Motor/ESC response from commanded to actual rotor speed
+     *
+     * Each rotor follows its command as a first-order lag with its own time
+     * constant, saturated to [omega_min_rad_s, omega_max_rad_s].
      */
-    struct DynamicsConfig {
-        double input_target{1.0};           ///< Target input value (constant mode)
-        bool use_sine{false};               ///< Enable sinusoidal input signal
-        double sine_frequency_hz{0.5};      ///< Frequency for sinusoidal input (Hz)
-        double time_constant{1.0};          ///< First-order system time constant (seconds)
-        double gain{1.0};                   ///< System gain
-    } dynamics_config;
+    struct MotorConfig {
+        bool lag_enabled{true};             ///< false: actual speed tracks the saturated command instantly
+        std::array<double, kMaxRotors> time_constant_s{
+            0.03, 0.03, 0.03, 0.03, 0.03, 0.03, 0.03, 0.03}; ///< Per-rotor time constants (s)
+        double omega_min_rad_s{0.0};        ///< Lowest achievable rotor speed (rad/s)
+        double omega_max_rad_s{2000.0};     ///< Highest achievable rotor speed (rad/s)
+    } motor_config;
 
     /**
-     * @struct DynamicsState
-     * @brief State variables for first-order dynamics module
+     * @struct Disturbance
+     * @brief External loads and actuator faults applied by the plant (set by scenarios or panels)
+     *
+     * The wrench is applied as a velocity and body-rate impulse (wrench × dt)
+     * at the start of each plant step, before the rotor-driven integration of
+     * that step, so the frame's integration starts from the kicked state. A
+     * rotor's effectiveness scales the thrust and drag torque it produces at
+     * its actual speed (1 = healthy, 0 = lost).
      */
-    struct DynamicsState {
-        double input{0.0};          ///< Current input to the dynamics system
-        double output{0.0};         ///< Current output of the dynamics system
-        double internal_state{0.0}; ///< Internal state variable
-    } dynamics_state;
+    struct Disturbance {
+        glm::dvec3 force_ned{0.0};      ///< External force in the NED frame (N)
+        glm::dvec3 torque_body{0.0};    ///< External torque about the body axes (N·m)
+        std::array<double, kMaxRotors> rotor_effectiveness{
+            {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0}}; ///< Per-rotor thrust/torque scale [0, 1]
+    } disturbance;
 
     /**
-     * @struct SensorFrame
-     * @brief Simulated IMU sensor measurements
+     * @struct WindConfig
+     * @brief Steady wind, a discrete gust and continuous turbulence (WindFieldModule)
+     *
+     * Turbulence intensities and scale lengths are MIL-F-8785C's; the
+     * defaults are light turbulence 10 m above ground
+     * (lowAltitudeTurbulence(7.7, 10) in core/turbulence_field.h).
+     * Horizontal turbulence is resolved along and across the steady wind
+     * (along north in calm air), vertical turbulence along down.
      */
-    struct SensorFrame {
-        glm::vec3 gyro_rad_s{0.0f};   ///< Gyroscope measurement (rad/s) in body frame
-        glm::vec3 accel_mps2{0.0f};   ///< Accelerometer measurement (m/s²) in body frame
-    } sensor;
+    struct WindConfig {
+        enum class Turbulence {
+            Off,
+            Dryden,     ///< Rational spectrum
+            VonKarman   ///< -5/3 inertial range (rational approximation)
+        };
+        Turbulence turbulence{Turbulence::Off};
+        glm::dvec3 steady_ned{0.0};         ///< Mean air velocity (m/s, NED; the direction the air moves)
+        double sigma_horizontal_m_s{1.46};  ///< RMS of the along/across components
+        double sigma_vertical_m_s{0.77};    ///< RMS of the vertical component
+        double length_horizontal_m{67.4};   ///< Scale length of the along/across components
+        double length_vertical_m{10.0};     ///< Scale length of the vertical component
+        double airspeed_m_s{0.0};           ///< Speed the frozen field is flown through; ≤ 0: |steady_ned|, at least 1 m/s
+        std::uint64_t seed{1};              ///< Same seed, same turbulence (Monte Carlo runs)
+        glm::dvec3 gust_ned{0.0};           ///< Peak of the 1-cosine gust (m/s, NED)
+        double gust_start_s{0.0};           ///< Simulation time the gust starts (s)
+        double gust_duration_s{0.0};        ///< Rise and decay time (s); 0 disables the gust
+    } wind_config;
 
     /**
-     * @struct EstimatorState
-     * @brief State estimate from sensor fusion algorithm
+     * @struct WindStatus
+     * @brief Components of wind_ned and the drag they cause, for panels and plots
      */
-    struct EstimatorState {
-        std::array<double, 4> quaternion{1.0, 0.0, 0.0, 0.0}; ///< Estimated attitude quaternion [w, x, y, z]
-        EulerAngles euler{0.0, 0.0, 0.0, EULER_ZYX};         ///< Estimated attitude in Euler angles
-    } estimator;
+    struct WindStatus {
+        bool active{false};                 ///< A wind module is in the pipeline; the plant applies air-relative drag
+        glm::dvec3 gust_ned{0.0};           ///< Gust part of the last sample (m/s)
+        glm::dvec3 turbulence_ned{0.0};     ///< Turbulence part of the last sample (m/s)
+        glm::dvec3 drag_force_ned{0.0};     ///< -drag_coefficient (velocity - wind_ned) at the start of the last plant step (N)
+        std::uint64_t samples{0};           ///< Wind samples since initialize
+    } wind;
+
+    /**
+     * @struct ControllerConfig
+     * @brief Cascaded attitude (P) / body-rate (PID) controller tuning
+     *
+     * Per-axis arrays are ordered roll, pitch, yaw. The rate loop commands
+     * angular acceleration, which the controller scales by the inertia, so
+     * the gains carry over between airframes.
+     */
+    struct ControllerConfig {
+        enum class Mode {
+            Off,       ///< Motor commands are left to other sources
+            Rate,      ///< Track ControllerSetpoint::rate_rad_s
+            Attitude,  ///< Track the setpoint attitude (rate loop inside)
+            Lqr,       ///< Hold ControllerSetpoint::position_ned with the scheduled LQR (LqrConfig)
+            Mpc,       ///< Track the setpoint attitude with the receding-horizon controller (MpcConfig)
+            External   ///< Rotor commands come from a flight-controller process (SitlConfig)
+        };
+        Mode mode{Mode::Attitude};
+        double rate_hz{500.0};                                      ///< Loop rate (applied at initialize)
+        std::array<double, 3> attitude_kp{{6.0, 6.0, 2.5}};         ///< Attitude error → rate (1/s)
+        std::array<double, 3> rate_kp{{20.0, 20.0, 6.0}};           ///< Rate error → accel (1/s)
+        std::array<double, 3> rate_ki{{10.0, 10.0, 2.0}};           ///< Integral gain (1/s²)
+        std::array<double, 3> rate_kd{{0.02, 0.02, 0.0}};           ///< Derivative gain on measured rate (-)
+        std::array<double, 3> rate_ff{{0.0, 0.0, 0.0}};             ///< Rate setpoint feed-forward (1/s)
+        double d_cutoff_hz{30.0};                                   ///< D-term low-pass cutoff (Hz)
+        std::array<double, 3> max_rate_rad_s{{3.5, 3.5, 1.5}};      ///< Attitude loop output limit
+        std::array<double, 3> max_accel_rad_s2{{200.0, 200.0, 5.0}}; ///< Rate loop output limit
+        std::array<double, 3> integral_limit_rad_s2{{20.0, 20.0, 2.0}}; ///< Integrator clamp
+    } controller_config;
+
+    /**
+     * @struct ControllerSetpoint
+     * @brief Pilot/guidance references for the controller
+     */
+    struct ControllerSetpoint {
+        double roll_rad{0.0};                    ///< Attitude mode reference (ZYX Euler)
+        double pitch_rad{0.0};
+        double yaw_rad{0.0};
+        glm::dvec3 rate_rad_s{0.0};              ///< Rate mode reference (body, rad/s)
+        double collective_thrust_newton{0.0};    ///< Total thrust; ≤ 0 holds hover (tilt-compensated)
+        glm::dvec3 position_ned{0.0};            ///< LQR mode position reference (m); yaw_rad is its heading
+    } controller_setpoint;
+
+    /**
+     * @struct LqrConfig
+     * @brief Hover LQR synthesis settings (Bryson's rule weights and schedule)
+     *
+     * Error states are ordered [position (3), velocity (3), attitude (3),
+     * body rate (3)], position and velocity in the heading frame. Gains are
+     * synthesized for each yaw-rate point and interpolated at the commanded
+     * yaw rate (controller_setpoint.rate_rad_s.z in LQR mode).
+     */
+    struct LqrConfig {
+        std::array<double, 12> max_state_error{{1.0, 1.0, 0.5,      // m
+                                                1.0, 1.0, 0.5,      // m/s
+                                                0.3, 0.3, 0.5,      // rad
+                                                2.0, 2.0, 1.0}};    // rad/s
+        double max_rotor_speed_delta_rad_s{150.0};                    ///< Input weight scale (rad/s)
+        std::array<double, 5> yaw_rate_points_rad_s{{-2.0, -1.0, 0.0, 1.0, 2.0}}; ///< Schedule (ascending)
+        bool use_disk_cache{true};                                    ///< Load/store gains in cache_directory
+        std::string cache_directory{"lqr_cache"};                     ///< One file per plant/weights hash
+    } lqr_config;
+
+    /**
+     * @struct LqrStatus
+     * @brief Outcome of the last gain-schedule synthesis or cache load
+     */
+    struct LqrStatus {
+        bool ready{false};                   ///< A valid gain schedule is loaded
+        bool from_cache{false};              ///< Gains came from disk rather than a fresh solve
+        std::uint64_t config_hash{0};        ///< Cache key of the active schedule
+        std::size_t riccati_iterations{0};   ///< Worst Newton–Kleinman iteration count (fresh solves)
+        double synthesis_ms{0.0};            ///< Wall time of the last solve or load (ms)
+    } lqr_status;
+
+    /**
+     * @struct MpcConfig
+     * @brief Linear MPC attitude tracking (per-axis condensed QP, ADMM solver)
+     *
+     * Per-axis arrays are ordered roll, pitch, yaw. Acceleration and rate
+     * limits are taken from ControllerConfig (max_accel_rad_s2,
+     * max_rate_rad_s); the horizon length is fixed at compile time.
+     */
+    struct MpcConfig {
+        double step_s{0.02};                                        ///< Prediction model step (s)
+        std::array<double, 3> attitude_weight{{400.0, 400.0, 100.0}}; ///< Per rad² of attitude error
+        std::array<double, 3> rate_weight{{4.0, 4.0, 4.0}};         ///< Per (rad/s)² of body rate
+        std::array<double, 3> accel_weight{{1e-3, 1e-3, 1e-2}};     ///< Per (rad/s²)² of command
+        double terminal_factor{10.0};                               ///< Extra weight on the final state
+        double budget_us{1000.0};                                   ///< Solver time budget per tick (µs)
+        std::size_t max_iterations{200};                            ///< ADMM iteration cap per axis
+    } mpc_config;
+
+    /**
+     * @struct MpcStatus
+     * @brief Last MPC solve, also recorded as telemetry channels "mpc.*"
+     */
+    struct MpcStatus {
+        double solve_us{0.0};               ///< Wall time of the last tick's three solves (µs)
+        std::size_t iterations{0};          ///< ADMM iterations summed over the axes
+        bool converged{false};              ///< Every axis met its tolerances
+        std::uint64_t budget_overruns{0};   ///< Ticks stopped by the time budget
+        std::uint64_t solves{0};            ///< Ticks solved since initialize
+    } mpc_status;
+
+    /**
+     * @struct SitlConfig
+     * @brief Lockstep software-in-the-loop link (SitlBridgeModule, ControllerConfig::Mode::External)
+     *
+     * The bridge exchanges one sensor frame for one set of rotor commands
+     * every controller period (controller_config.rate_hz).
+     */
+    struct SitlConfig {
+        const char* link_name{"/aerodyn_sitl"};  ///< Shared-memory segment the controller attaches to
+        double timeout_s{0.5};                  ///< Wait for commands before pausing (<= 0: wait for ever)
+    } sitl_config;
+
+    /**
+     * @struct SitlStatus
+     * @brief Link health, also recorded as telemetry channel "sitl.exchange_us"
+     */
+    struct SitlStatus {
+        bool link_open{false};              ///< Segment created
+        bool connected{false};              ///< The last exchange was answered
+        std::uint64_t exchanges{0};         ///< Answered exchanges since initialize
+        std::uint64_t timeouts{0};          ///< Exchanges the controller missed
+        double last_us{0.0};                ///< Round trip of the last exchange (µs)
+        double mean_us{0.0};                ///< Moving average round trip (µs)
+        double max_us{0.0};                 ///< Worst round trip since initialize (µs)
+    } sitl_status;
+
+    /**
+     * @struct ScenarioStatus
+     * @brief Progress of the scripted scenario (ScenarioPlayerModule), if one is loaded
+     */
+    struct ScenarioStatus {
+        bool active{false};                     ///< A scenario player is in the pipeline
+        std::size_t events{0};                  ///< Events in the script
+        std::size_t dispatched{0};              ///< Events applied or evaluated so far
+        std::uint64_t assertions_passed{0};
+        std::uint64_t assertions_failed{0};
+        std::string first_failure;              ///< Report of the earliest failed assertion (empty if none)
+    } scenario_status;
+
+    /// Named scalar signals recorded per update (see TelemetryChannels)
+    TelemetryChannels telemetry;
+
+    /**
+     * @struct DynamicsConfig
+     * @brief Configuration for first-order dynamics test module
+     */
+    struct DynamicsConfig {
+        enum class InputMode {
+            Constant,   ///< Hold input_target
+            Sine,       ///< Single tone at sine_frequency_hz
+            Chirp,      ///< Logarithmic sweep chirp_start_hz → chirp_end_hz, repeated
+            MultiSine   ///< Schroeder-phased harmonics of multisine_base_hz
+        };
+        InputMode input_mode{InputMode::Constant};
+        double input_target{1.0};           ///< Target input value (constant mode)
+        double excitation_amplitude{1.0};   ///< Peak input of the sine/chirp (multi-sine: RMS-equivalent)
+        double sine_frequency_hz{0.5};      ///< Frequency for sinusoidal input (Hz)
+        double chirp_start_hz{0.05};        ///< Chirp start frequency (Hz)
+        double chirp_end_hz{5.0};           ///< Chirp end frequency (Hz)
+        double chirp_duration_s{30.0};      ///< Length of one sweep (s)
+        double multisine_base_hz{0.1};      ///< Multi-sine fundamental (Hz)
+        int multisine_tones{16};            ///< Multi-sine harmonic count
+        double time_constant{1.0};          ///< First-order system time constant (seconds)
+        double gain{1.0};                   ///< System gain
+    } dynamics_config;
 
     /**
      * @struct RotorConfig
@@ -199,31 +690,77 @@ struct SimulationState {
      */
     struct RotorConfig {
         double thrust_coefficient{1.2e-6};  ///< Thrust coefficient (N/(rad/s)²)
-        double torque_coefficient{2.5e-7};  ///< Torque coefficient (N·m/(rad/s)²)
+        double torque_coefficient{2.5e-8};  ///< Torque coefficient (N·m/(rad/s)²)
         double arm_length_m{0.2};           ///< Distance from rotor to center of mass (meters)
     } rotor_config;
 
     /**
-     * @struct RotorTelemetry
-     * @brief Computed rotor performance metrics
+     * @struct EstimatorConfig
+     * @brief Complementary filter gains (read at initialize and on a live reconfigure)
      */
-    struct RotorTelemetry {
-        std::array<double, 4> rpm{0.0, 0.0, 0.0, 0.0};                  ///< Rotor speeds (RPM)
-        std::array<double, 4> thrust_newton{0.0, 0.0, 0.0, 0.0};        ///< Individual thrust per rotor (N)
-        std::array<double, 4> torque_newton_metre{0.0, 0.0, 0.0, 0.0}; ///< Individual torque per rotor (N·m)
-        double total_thrust_newton{0.0};                                ///< Sum of all rotor thrust (N)
-        double total_power_watt{0.0};                                   ///< Total electrical power consumption (W)
-    } rotor;
+    struct EstimatorConfig {
+        float kp{2.0f};     ///< Proportional gain (attitude correction speed)
+        float ki{0.05f};    ///< Integral gain (gyro bias estimation speed)
+    } estimator_config;
 
     /**
-     * @struct PowerHistory
-     * @brief Electrical power consumption tracking
+     * @struct ModuleProfile
+     * @brief Per-module update cost, filled by ModuleScheduler (fixed slots, no allocation)
      */
-    struct PowerHistory {
-        double bus_voltage{22.2};   ///< Battery/bus voltage (V)
-        double bus_current{0.0};    ///< Total current draw (A)
-        double energy_joule{0.0};   ///< Cumulative energy consumed (J)
-    } power;
+    struct ModuleProfile {
+        static constexpr std::size_t kMaxSlots = 16;
+        struct Slot {
+            const char* name{""};   ///< Module::name()
+            double period_s{0.0};   ///< Module::period() (0 = every tick)
+            double last_us{0.0};    ///< Wall time of the most recent update (µs)
+            double mean_us{0.0};    ///< Exponential moving average of update time (µs)
+            double max_us{0.0};     ///< Worst update since initialize (µs)
+            std::uint64_t calls{0}; ///< Updates since initialize
+            std::uint64_t deadline_misses{0};   ///< Updates that finished after their deadline (see Realtime)
+            double worst_lateness_us{0.0};      ///< Latest finish past a deadline since initialize (µs)
+        };
+        std::array<Slot, kMaxSlots> slots{};
+        std::size_t count{0};       ///< Slots in use
+        double tick_us{0.0};        ///< Wall time of the last whole scheduler tick (µs)
+    } profile;
+
+    /**
+     * @struct Realtime
+     * @brief Whether the loop keeps pace with the wall clock, filled by ModuleScheduler
+     *
+     * The caller states how much wall time each tick stands for and the
+     * sim-to-wall rate it aims for. Every update then has a wall deadline:
+     * the tick's start plus (release + period) / target_factor, where release
+     * is the sub-step start in simulated time since the tick began and period
+     * is the module's own (or the sub-step, for per-tick modules). An update
+     * that finishes later is a deadline miss: at that rate the module could
+     * not have kept up even if it ran the moment it was released.
+     *
+     * Deadlines only see the modules. Frame costs outside the tick, such as
+     * rendering, show in the factor instead, provided the caller's tick is
+     * not simply its wall interval times target_factor: a caller that
+     * derives the tick from the wall clock caps it at max_tick_s through
+     * ModuleScheduler::capTick(), and whatever the cap cuts is time the
+     * simulation has fallen behind.
+     */
+    struct Realtime {
+        static constexpr double kWindowS = 0.5;   ///< Wall time the averaged factor spans
+
+        double wall_interval_s{0.0};    ///< Wall time the next tick stands for (set by the caller; 0 = unknown)
+        double target_factor{0.0};      ///< Intended sim seconds per wall second (set by the caller; 0 = no deadlines)
+        double max_tick_s{0.0};         ///< Most simulated time a wall-clock tick may cover (set by the caller; 0 = uncapped)
+
+        double factor{0.0};             ///< Real-time factor over the last complete window
+        double tick_factor{0.0};        ///< Real-time factor of the last tick
+        std::uint64_t window_misses{0}; ///< Deadline misses in the last complete window
+        std::uint64_t deadline_misses{0};   ///< All modules, since initialize
+        double worst_lateness_us{0.0};  ///< Latest finish past a deadline since initialize (µs)
+        double dropped_s{0.0};          ///< Simulated time cut by max_tick_s since initialize
+
+        double window_sim_s{0.0};       ///< Accumulators of the window in progress
+        double window_wall_s{0.0};
+        std::uint64_t window_open_misses{0};
+    } realtime;
 
     /**
      * @struct SimulationControl
@@ -237,6 +774,25 @@ struct SimulationState {
         double time_scale{1.0};          ///< Simulation speed multiplier
         bool manual_rotation_mode{false}; ///< If true: discrete step rotation (W/A/S/D/Q/E). If false: continuous angular rates (arrow keys)
     } control;
+
+private:
+    /**
+     * @struct DerivedViews
+     * @brief Lazily evaluated attitude views guarded by per-view dirty bits
+     */
+    struct DerivedViews {
+        enum : unsigned {
+            kEuler = 1u << 0,
+            kDcm = 1u << 1,
+            kModelMatrix = 1u << 2,
+            kAll = kEuler | kDcm | kModelMatrix
+        };
+        unsigned dirty{kAll};                           ///< Views that must be recomputed before use
+        EulerAngles euler{0.0, 0.0, 0.0, EULER_ZYX};    ///< Cached Euler angles (rad)
+        Dcm dcm{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}}; ///< Cached body-to-NED DCM
+        glm::mat4 model_matrix{1.0f};                   ///< Cached render model matrix
+    };
+    mutable DerivedViews derived_;
 };
 
 #endif // SIMULATION_STATE_H
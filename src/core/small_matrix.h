@@ -0,0 +1,159 @@
+/**
+ * @file small_matrix.h
+ * @brief Fixed-size dense matrices with constexpr arithmetic
+ *
+ * Sized at compile time and stored inline (no allocation), so control-rate
+ * code runs in constant time and tables for standard airframes can be
+ * evaluated entirely at compile time.
+ */
+
+#ifndef CORE_SMALL_MATRIX_H
+#define CORE_SMALL_MATRIX_H
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @brief Row-major R×C matrix of doubles
+ */
+template <std::size_t R, std::size_t C>
+struct SmallMatrix {
+    static constexpr std::size_t kRows = R;
+    static constexpr std::size_t kCols = C;
+
+    std::array<std::array<double, C>, R> m{};
+
+    constexpr double& operator()(std::size_t row, std::size_t col) { return m[row][col]; }
+    constexpr double operator()(std::size_t row, std::size_t col) const { return m[row][col]; }
+
+    static constexpr SmallMatrix zero() { return SmallMatrix{}; }
+
+    static constexpr SmallMatrix identity() {
+        SmallMatrix out{};
+        for (std::size_t i = 0; i < (R < C ? R : C); ++i) {
+            out.m[i][i] = 1.0;
+        }
+        return out;
+    }
+};
+
+template <std::size_t N>
+using SmallVector = std::array<double, N>;
+
+template <std::size_t R, std::size_t C>
+constexpr SmallMatrix<C, R> transpose(const SmallMatrix<R, C>& a) {
+    SmallMatrix<C, R> out{};
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) {
+            out.m[j][i] = a.m[i][j];
+        }
+    }
+    return out;
+}
+
+template <std::size_t R, std::size_t C>
+constexpr SmallMatrix<R, C> operator+(const SmallMatrix<R, C>& a, const SmallMatrix<R, C>& b) {
+    SmallMatrix<R, C> out{};
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) {
+            out.m[i][j] = a.m[i][j] + b.m[i][j];
+        }
+    }
+    return out;
+}
+
+template <std::size_t R, std::size_t C>
+constexpr SmallMatrix<R, C> operator-(const SmallMatrix<R, C>& a, const SmallMatrix<R, C>& b) {
+    SmallMatrix<R, C> out{};
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) {
+            out.m[i][j] = a.m[i][j] - b.m[i][j];
+        }
+    }
+    return out;
+}
+
+template <std::size_t R, std::size_t K, std::size_t C>
+constexpr SmallMatrix<R, C> operator*(const SmallMatrix<R, K>& a, const SmallMatrix<K, C>& b) {
+    SmallMatrix<R, C> out{};
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t k = 0; k < K; ++k) {
+            const double aik = a.m[i][k];
+            for (std::size_t j = 0; j < C; ++j) {
+                out.m[i][j] += aik * b.m[k][j];
+            }
+        }
+    }
+    return out;
+}
+
+template <std::size_t R, std::size_t C>
+constexpr SmallVector<R> operator*(const SmallMatrix<R, C>& a, const SmallVector<C>& x) {
+    SmallVector<R> out{};
+    for (std::size_t i = 0; i < R; ++i) {
+        double sum = 0.0;
+        for (std::size_t j = 0; j < C; ++j) {
+            sum += a.m[i][j] * x[j];
+        }
+        out[i] = sum;
+    }
+    return out;
+}
+
+/**
+ * @brief Invert a square matrix by Gauss-Jordan elimination with partial pivoting
+ * @param a Matrix to invert
+ * @param out Inverse (unspecified if singular)
+ * @param pivot_tolerance Pivots with magnitude at or below this are treated as singular
+ * @return false if the matrix is singular to within pivot_tolerance
+ */
+template <std::size_t N>
+constexpr bool invert(const SmallMatrix<N, N>& a, SmallMatrix<N, N>& out,
+                      double pivot_tolerance = 1e-14) {
+    SmallMatrix<N, N> work = a;
+    out = SmallMatrix<N, N>::identity();
+    for (std::size_t col = 0; col < N; ++col) {
+        std::size_t pivot = col;
+        double best = work.m[col][col] < 0.0 ? -work.m[col][col] : work.m[col][col];
+        for (std::size_t row = col + 1; row < N; ++row) {
+            const double magnitude = work.m[row][col] < 0.0 ? -work.m[row][col] : work.m[row][col];
+            if (magnitude > best) {
+                best = magnitude;
+                pivot = row;
+            }
+        }
+        if (!(best > pivot_tolerance)) {
+            return false;
+        }
+        if (pivot != col) {
+            for (std::size_t j = 0; j < N; ++j) {
+                const double w = work.m[col][j];
+                work.m[col][j] = work.m[pivot][j];
+                work.m[pivot][j] = w;
+                const double o = out.m[col][j];
+                out.m[col][j] = out.m[pivot][j];
+                out.m[pivot][j] = o;
+            }
+        }
+        const double scale = 1.0 / work.m[col][col];
+        for (std::size_t j = 0; j < N; ++j) {
+            work.m[col][j] *= scale;
+            out.m[col][j] *= scale;
+        }
+        for (std::size_t row = 0; row < N; ++row) {
+            if (row == col) {
+                continue;
+            }
+            const double factor = work.m[row][col];
+            if (factor != 0.0) {
+                for (std::size_t j = 0; j < N; ++j) {
+                    work.m[row][j] -= factor * work.m[col][j];
+                    out.m[row][j] -= factor * out.m[col][j];
+                }
+            }
+        }
+    }
+    return true;
+}
+
+#endif // CORE_SMALL_MATRIX_H
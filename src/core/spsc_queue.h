@@ -0,0 +1,101 @@
+/**
+ * @file spsc_queue.h
+ * @brief Bounded lock-free single-producer/single-consumer queue
+ */
+
+#ifndef CORE_SPSC_QUEUE_H
+#define CORE_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @class SpscQueue
+ * @brief Fixed-capacity FIFO between exactly one producer and one consumer thread
+ *
+ * tryPush() and tryPop() never block and never allocate: each is one
+ * relaxed load of its own index, one acquire load of the other side's, a
+ * copy and one release store. A full queue rejects the item, so the
+ * producer (the simulation thread) decides what to drop. Head and tail sit
+ * on separate cache lines, and each side caches the other's index so the
+ * shared line is only read when the cached copy says full/empty.
+ *
+ * Capacity is fixed by reset() and rounded up to a power of two; call
+ * reset() only while neither side is using the queue.
+ *
+ * @tparam T Trivially copyable item
+ */
+template <typename T>
+class SpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscQueue items are copied without constructors");
+
+public:
+    SpscQueue() = default;
+    explicit SpscQueue(std::size_t capacity) { reset(capacity); }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Allocate room for at least capacity items and empty the queue
+    void reset(std::size_t capacity) {
+        std::size_t slots = 2;
+        while (slots < capacity) {
+            slots <<= 1;
+        }
+        items_.reset(new T[slots]);
+        mask_ = slots - 1;
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        producer_cached_head_ = 0;
+        consumer_cached_tail_ = 0;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    /// Producer: append, or return false if full
+    bool tryPush(const T& item) {
+        const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - producer_cached_head_ > mask_) {
+            producer_cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - producer_cached_head_ > mask_) {
+                return false;
+            }
+        }
+        items_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer: take the oldest item, or return false if empty
+    bool tryPop(T& item) {
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head == consumer_cached_tail_) {
+            consumer_cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == consumer_cached_tail_) {
+                return false;
+            }
+        }
+        item = items_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Items queued (exact only when called by one of the two sides while the other is idle)
+    std::size_t size() const {
+        const std::uint64_t head = head_.load(std::memory_order_acquire);   // Head first: never past tail
+        return static_cast<std::size_t>(tail_.load(std::memory_order_acquire) - head);
+    }
+
+private:
+    std::unique_ptr<T[]> items_;
+    std::size_t mask_{0};
+    alignas(64) std::atomic<std::uint64_t> head_{0};    ///< Next item to pop (consumer writes)
+    std::uint64_t consumer_cached_tail_{0};
+    alignas(64) std::atomic<std::uint64_t> tail_{0};    ///< Next slot to fill (producer writes)
+    std::uint64_t producer_cached_head_{0};
+};
+
+#endif // CORE_SPSC_QUEUE_H
@@ -0,0 +1,202 @@
+/**
+ * @file telemetry_channels.h
+ * @brief Named scalar telemetry channels with fixed-capacity sample rings
+ */
+
+#ifndef CORE_TELEMETRY_CHANNELS_H
+#define CORE_TELEMETRY_CHANNELS_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "core/memory_accounting.h"
+
+/**
+ * @class TelemetrySink
+ * @brief Sees every channel registration and every sample as it is recorded
+ *
+ * For consumers that need the full-rate stream rather than the retained
+ * rings (shared-memory publisher, network streamers). Called on the
+ * recording thread from inside record(), so implementations must not block.
+ */
+class TelemetrySink {
+public:
+    virtual ~TelemetrySink() = default;
+    virtual void onChannel(std::size_t id, const char* name, const char* unit) = 0;
+    virtual void onSample(std::size_t id, double timestamp, double value) = 0;
+};
+
+/**
+ * @class TelemetryChannels
+ * @brief Registry of per-tick scalar signals (solve times, iteration counts, ...)
+ *
+ * Modules register channels once (typically in initialize()) and then
+ * record() one value per update. Each channel keeps the newest kCapacity
+ * samples in a ring allocated at registration, plus running statistics, so
+ * recording from a control loop never allocates.
+ *
+ * Channel names and units must be string literals (or otherwise outlive the
+ * registry); registering an existing name returns its id. Rings are charged
+ * to MemoryTag::Log, and no new channel is created while that tag is over
+ * its cap. Up to kMaxSinks TelemetrySink objects can be attached to see
+ * every sample as well.
+ */
+class TelemetryChannels {
+public:
+    static constexpr std::size_t kMaxChannels = 32;
+    static constexpr std::size_t kCapacity = 2048;      ///< Samples retained per channel
+    static constexpr std::size_t kInvalid = kMaxChannels;
+    static constexpr std::size_t kMaxSinks = 4;
+
+    struct Sample {
+        double timestamp;   ///< Simulation time (s)
+        double value;
+    };
+
+    struct Channel {
+        const char* name{""};
+        const char* unit{""};
+        TrackedVector<Sample, MemoryTag::Log> ring;     ///< kCapacity slots, allocated at registration
+        std::size_t head{0};            ///< Next slot to write
+        std::size_t size{0};            ///< Valid samples (≤ kCapacity)
+        double last{0.0};
+        double max{0.0};                ///< Largest value since the last resetStatistics()
+        double sum{0.0};                ///< For the mean since the last resetStatistics()
+        std::uint64_t count{0};         ///< Samples since the last resetStatistics()
+
+        double mean() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+    };
+
+    /**
+     * @brief Find or create a channel
+     * @return Channel id, or kInvalid if the registry is full or logs are over their memory cap
+     */
+    std::size_t registerChannel(const char* name, const char* unit) {
+        const std::size_t existing = find(name);
+        if (existing != kInvalid) {
+            return existing;
+        }
+        if (count_ == kMaxChannels || MemoryAccounting::overCap(MemoryTag::Log)) {
+            return kInvalid;
+        }
+        Channel& channel = channels_[count_];
+        channel = Channel{};
+        channel.name = name;
+        channel.unit = unit;
+        channel.ring.resize(kCapacity);
+        for (std::size_t i = 0; i < sink_count_; ++i) {
+            sinks_[i]->onChannel(count_, name, unit);
+        }
+        return count_++;
+    }
+
+    /**
+     * @brief Attach a sink; it is told about the channels registered so far first
+     * @return false if kMaxSinks are already attached
+     */
+    bool addSink(TelemetrySink* sink) {
+        if (sink_count_ == kMaxSinks) {
+            return false;
+        }
+        for (std::size_t i = 0; i < count_; ++i) {
+            sink->onChannel(i, channels_[i].name, channels_[i].unit);
+        }
+        sinks_[sink_count_++] = sink;
+        return true;
+    }
+
+    void removeSink(TelemetrySink* sink) {
+        const auto end = sinks_.begin() + sink_count_;
+        sink_count_ = static_cast<std::size_t>(std::remove(sinks_.begin(), end, sink) - sinks_.begin());
+    }
+
+    /**
+     * @brief Channel id for a name, or kInvalid
+     */
+    std::size_t find(const char* name) const {
+        for (std::size_t i = 0; i < count_; ++i) {
+            if (std::strcmp(channels_[i].name, name) == 0) {
+                return i;
+            }
+        }
+        return kInvalid;
+    }
+
+    /**
+     * @brief Append a sample (ignored for kInvalid ids)
+     */
+    void record(std::size_t id, double timestamp, double value) {
+        if (id >= count_) {
+            return;
+        }
+        Channel& channel = channels_[id];
+        channel.ring[channel.head] = Sample{timestamp, value};
+        channel.head = (channel.head + 1) % kCapacity;
+        channel.size = std::min(channel.size + 1, kCapacity);
+        channel.last = value;
+        channel.max = channel.count == 0 ? value : std::max(channel.max, value);
+        channel.sum += value;
+        ++channel.count;
+        for (std::size_t i = 0; i < sink_count_; ++i) {
+            sinks_[i]->onSample(id, timestamp, value);
+        }
+    }
+
+    /**
+     * @brief Clear max/mean/count (the sample ring is kept)
+     */
+    void resetStatistics(std::size_t id) {
+        if (id < count_) {
+            channels_[id].max = 0.0;
+            channels_[id].sum = 0.0;
+            channels_[id].count = 0;
+        }
+    }
+
+    /**
+     * @brief Drop every channel's samples newer than timestamp (rewind); statistics are kept
+     */
+    void discardAfter(double timestamp) {
+        for (std::size_t i = 0; i < count_; ++i) {
+            Channel& channel = channels_[i];
+            while (channel.size > 0) {
+                const std::size_t newest = (channel.head + kCapacity - 1) % kCapacity;
+                if (channel.ring[newest].timestamp <= timestamp) {
+                    break;
+                }
+                channel.head = newest;
+                --channel.size;
+            }
+        }
+    }
+
+    /**
+     * @brief Visit a channel's retained samples, oldest first
+     */
+    template <typename Visitor>
+    void forEachSample(std::size_t id, Visitor&& visit) const {
+        if (id >= count_) {
+            return;
+        }
+        const Channel& channel = channels_[id];
+        const std::size_t start = (channel.head + kCapacity - channel.size) % kCapacity;
+        for (std::size_t i = 0; i < channel.size; ++i) {
+            visit(channel.ring[(start + i) % kCapacity]);
+        }
+    }
+
+    std::size_t size() const { return count_; }
+    const Channel& channel(std::size_t id) const { return channels_[id]; }
+
+private:
+    std::array<Channel, kMaxChannels> channels_{};
+    std::size_t count_{0};
+    std::array<TelemetrySink*, kMaxSinks> sinks_{};
+    std::size_t sink_count_{0};
+};
+
+#endif // CORE_TELEMETRY_CHANNELS_H
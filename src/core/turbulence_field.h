@@ -0,0 +1,448 @@
+/**
+ * @file turbulence_field.h
+ * @brief Dryden / von Kármán turbulence for one vehicle or a swarm: precomputed shaping filters driven by block noise
+ */
+
+#ifndef CORE_TURBULENCE_FIELD_H
+#define CORE_TURBULENCE_FIELD_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "core/small_matrix.h"
+
+/// Power spectrum the shaping filters realize
+enum class TurbulenceSpectrum {
+    Dryden,     ///< Rational spectrum, first/second-order filters
+    VonKarman   ///< -5/3 inertial range, MIL-F-8785C rational approximation (second/third order)
+};
+
+/**
+ * @struct TurbulenceScales
+ * @brief RMS intensities and scale lengths, horizontal (u, v) and vertical (w)
+ */
+struct TurbulenceScales {
+    double sigma_horizontal_m_s{1.0};
+    double sigma_vertical_m_s{1.0};
+    double length_horizontal_m{100.0};
+    double length_vertical_m{100.0};
+};
+
+/**
+ * @brief MIL-F-8785C low-altitude intensities and scale lengths
+ * @param wind_20ft_m_s Mean wind 20 ft (6 m) above ground: 7.7 light, 15 moderate, 23 severe
+ * @param altitude_m Height above ground, clamped to the model's 10..1000 ft
+ */
+inline TurbulenceScales lowAltitudeTurbulence(double wind_20ft_m_s, double altitude_m) {
+    constexpr double kFoot = 0.3048;
+    const double h = std::min(std::max(altitude_m / kFoot, 10.0), 1000.0);
+    const double k = 0.177 + 0.000823 * h;
+    TurbulenceScales scales;
+    scales.sigma_vertical_m_s = 0.1 * wind_20ft_m_s;
+    scales.sigma_horizontal_m_s = scales.sigma_vertical_m_s / std::pow(k, 0.4);
+    scales.length_vertical_m = h * kFoot;
+    scales.length_horizontal_m = h / std::pow(k, 1.2) * kFoot;
+    return scales;
+}
+
+/**
+ * @struct ShapingFilter
+ * @brief One turbulence component as a discrete state-space filter with unit output variance
+ *
+ *   x[k+1] = a x[k] + b n[k],   y[k] = c x[k],   n[k] ~ N(0, 1)
+ *
+ * Only the first `order` states are used.
+ */
+struct ShapingFilter {
+    static constexpr std::size_t kMaxOrder = 3;
+    std::size_t order{0};
+    std::array<std::array<double, kMaxOrder>, kMaxOrder> a{};
+    std::array<double, kMaxOrder> b{};
+    std::array<double, kMaxOrder> c{};
+};
+
+namespace turbulence_detail {
+
+constexpr std::uint64_t kGolden = 0x9e3779b97f4a7c15ull;
+
+/// SplitMix64 finalizer: a statistically strong 64-bit hash of a counter
+inline std::uint64_t mix(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Two independent standard normals from 64 random bits (Box–Muller)
+ *
+ * Branch-free and free of library calls so a loop over vehicles
+ * vectorizes: ln of the radius draw by exponent split and an atanh series
+ * on [√½, √2), the angle's sine and cosine by quadrant (top two bits) and
+ * Taylor polynomials within ±π/4 of the quadrant centre. The result
+ * matches the libm formula to about 1e-11, far below the 2^-31 and 2^-32
+ * resolution of the radius and angle draws.
+ */
+inline void normalPair(std::uint64_t bits, double& first, double& second) {
+    constexpr double kLn2 = 0.6931471805599453;
+    constexpr double kSqrtHalf = 0.7071067811865476;
+    constexpr double kQuarterTurn = 1.5707963267948966;
+
+    // Integer-to-double conversions go through int32, which every SIMD ISA converts natively.
+    // ln u, u in (0, 1): u = m 2^e with m in [1, 2), folded into [√½, √2)
+    const double u = (static_cast<double>(static_cast<std::int32_t>(bits >> 33)) + 0.5) * (1.0 / 2147483648.0);
+    std::uint64_t raw;
+    std::memcpy(&raw, &u, sizeof(raw));
+    double exponent = static_cast<double>(static_cast<std::int32_t>(raw >> 52) - 1023);
+    raw = (raw & 0x000fffffffffffffull) | 0x3ff0000000000000ull;
+    double m;
+    std::memcpy(&m, &raw, sizeof(m));
+    const bool high = m > 1.4142135623730951;
+    m = high ? 0.5 * m : m;
+    exponent = high ? exponent + 1.0 : exponent;
+    const double z = (m - 1.0) / (m + 1.0);
+    const double z2 = z * z;
+    const double series =
+        1.0 + z2 * (1.0 / 3.0 + z2 * (1.0 / 5.0 + z2 * (1.0 / 7.0 + z2 * (1.0 / 9.0 + z2 * (1.0 / 11.0 + z2 * (1.0 / 13.0))))));
+    const double r2 = -2.0 * (exponent * kLn2 + 2.0 * z * series);
+
+    // sqrt(r2) as r2 / sqrt(r2): bit-trick estimate refined by four Newton
+    // steps (std::sqrt's errno path would stop the loop vectorizing)
+    std::memcpy(&raw, &r2, sizeof(raw));
+    raw = 0x5fe6eb50c7b537a9ull - (raw >> 1);
+    double inv_root;
+    std::memcpy(&inv_root, &raw, sizeof(inv_root));
+    for (int step = 0; step < 4; ++step) {
+        inv_root *= 1.5 - 0.5 * r2 * inv_root * inv_root;
+    }
+    const double radius = r2 * inv_root;
+
+    // Angle (q + 1/2 + φ') quarter turns: q from the top two bits, φ in [-π/4, π/4)
+    const std::uint32_t turn = static_cast<std::uint32_t>(bits);
+    const std::uint32_t quadrant = turn >> 30;
+    const double phi =
+        (static_cast<double>(static_cast<std::int32_t>(turn & 0x3fffffffu)) * (1.0 / 1073741824.0) - 0.5) * kQuarterTurn;
+    const double p2 = phi * phi;
+    const double sin_phi =
+        phi * (1.0 + p2 * (-1.0 / 6.0 + p2 * (1.0 / 120.0 + p2 * (-1.0 / 5040.0 +
+                                                                 p2 * (1.0 / 362880.0 + p2 * (-1.0 / 39916800.0))))));
+    const double cos_phi =
+        1.0 + p2 * (-1.0 / 2.0 + p2 * (1.0 / 24.0 + p2 * (-1.0 / 720.0 + p2 * (1.0 / 40320.0 +
+                                                         p2 * (-1.0 / 3628800.0 + p2 * (1.0 / 479001600.0))))));
+    // Quadrant centres are at odd multiples of 45°: cos and sin are ±√½
+    const double cos_centre = (quadrant == 1 || quadrant == 2) ? -kSqrtHalf : kSqrtHalf;
+    const double sin_centre = quadrant >= 2 ? -kSqrtHalf : kSqrtHalf;
+    first = radius * (cos_centre * cos_phi - sin_centre * sin_phi);
+    second = radius * (sin_centre * cos_phi + cos_centre * sin_phi);
+}
+
+/// Matrix exponential by scaling and squaring of a Taylor series (small, well-scaled matrices)
+template <std::size_t N>
+SmallMatrix<N, N> exponential(SmallMatrix<N, N> m) {
+    double norm = 0.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        double row = 0.0;
+        for (std::size_t j = 0; j < N; ++j) {
+            row += std::abs(m(i, j));
+        }
+        norm = std::max(norm, row);
+    }
+    int squarings = 0;
+    while (norm > 0.5) {
+        norm *= 0.5;
+        ++squarings;
+    }
+    const double scale = std::ldexp(1.0, -squarings);
+    for (auto& row : m.m) {
+        for (double& value : row) {
+            value *= scale;
+        }
+    }
+    // ‖m‖ ≤ 0.5: 18 terms reach the rounding floor
+    SmallMatrix<N, N> result = SmallMatrix<N, N>::identity();
+    SmallMatrix<N, N> term = SmallMatrix<N, N>::identity();
+    for (int k = 1; k <= 18; ++k) {
+        term = term * m;
+        for (auto& row : term.m) {
+            for (double& value : row) {
+                value /= k;
+            }
+        }
+        result = result + term;
+    }
+    for (int i = 0; i < squarings; ++i) {
+        result = result * result;
+    }
+    return result;
+}
+
+/**
+ * @brief Discretize H(τs) = Σ num_k (τs)^k / Σ den_k (τs)^k for noise held over dt, scaled to unit variance
+ *
+ * Controllable canonical form, zero-order hold via the exponential of the
+ * augmented [A B; 0 0] matrix, then the stationary state covariance from
+ * the discrete Lyapunov equation (doubling) fixes the output variance to 1
+ * exactly, whatever dt is.
+ */
+inline ShapingFilter discretize(const double* num, const double* den, std::size_t order, double tau, double dt) {
+    constexpr std::size_t kN = ShapingFilter::kMaxOrder + 1;
+    const double lead = den[order] * std::pow(tau, static_cast<double>(order));
+    SmallMatrix<kN, kN> augmented{};
+    for (std::size_t i = 0; i + 1 < order; ++i) {
+        augmented(i, i + 1) = dt;
+    }
+    for (std::size_t j = 0; j < order; ++j) {
+        augmented(order - 1, j) = -den[j] * std::pow(tau, static_cast<double>(j)) / lead * dt;
+    }
+    augmented(order - 1, order) = dt;
+    const SmallMatrix<kN, kN> held = exponential(augmented);
+
+    ShapingFilter filter;
+    filter.order = order;
+    for (std::size_t i = 0; i < order; ++i) {
+        for (std::size_t j = 0; j < order; ++j) {
+            filter.a[i][j] = held(i, j);
+        }
+        filter.b[i] = held(i, order);
+        filter.c[i] = num[i] * std::pow(tau, static_cast<double>(i)) / lead;
+    }
+
+    // P = a P aᵀ + b bᵀ by doubling: after round k, P sums the first 2^(k+1) terms of Σ aⁱ b bᵀ (aⁱ)ᵀ
+    using Matrix = SmallMatrix<ShapingFilter::kMaxOrder, ShapingFilter::kMaxOrder>;
+    Matrix f{};
+    Matrix p{};
+    for (std::size_t i = 0; i < order; ++i) {
+        for (std::size_t j = 0; j < order; ++j) {
+            f(i, j) = filter.a[i][j];
+            p(i, j) = filter.b[i] * filter.b[j];
+        }
+    }
+    for (int round = 0; round < 128; ++round) {
+        p = p + f * p * transpose(f);
+        f = f * f;
+        double largest = 0.0;
+        for (const auto& row : f.m) {
+            for (double value : row) {
+                largest = std::max(largest, std::abs(value));
+            }
+        }
+        if (largest < 1e-20) {
+            break;
+        }
+    }
+    double variance = 0.0;
+    for (std::size_t i = 0; i < order; ++i) {
+        for (std::size_t j = 0; j < order; ++j) {
+            variance += filter.c[i] * p(i, j) * filter.c[j];
+        }
+    }
+    const double gain = variance > 0.0 ? 1.0 / std::sqrt(variance) : 0.0;
+    for (std::size_t i = 0; i < order; ++i) {
+        filter.b[i] *= gain;
+    }
+    return filter;
+}
+
+}  // namespace turbulence_detail
+
+/**
+ * @brief Shaping filter for one turbulence component
+ * @param spectrum Dryden or von Kármán
+ * @param longitudinal true for u (along the mean flow), false for v and w
+ * @param length_m Scale length of the component
+ * @param airspeed_m_s Speed the frozen field is flown through (Taylor's hypothesis), at least 0.1 m/s
+ * @param dt Sample period the filter is built for (s)
+ */
+inline ShapingFilter designShapingFilter(TurbulenceSpectrum spectrum, bool longitudinal, double length_m,
+                                         double airspeed_m_s, double dt) {
+    // MIL-F-8785C transfer functions in τs, τ = L/V; the sqrt(L/πV) gains
+    // drop out of the unit-variance normalization.
+    static constexpr double kDrydenU[2][2] = {{1.0, 0.0}, {1.0, 1.0}};
+    static constexpr double kDrydenVW[2][3] = {{1.0, 1.7320508075688772, 0.0}, {1.0, 2.0, 1.0}};
+    static constexpr double kKarmanU[2][3] = {{1.0, 0.25, 0.0}, {1.0, 1.357, 0.1987}};
+    static constexpr double kKarmanVW[2][4] = {{1.0, 2.7478, 0.3398, 0.0}, {1.0, 2.9958, 1.9754, 0.1539}};
+
+    const double tau = std::max(length_m, 1e-3) / std::max(airspeed_m_s, 0.1);
+    if (spectrum == TurbulenceSpectrum::Dryden) {
+        return longitudinal ? turbulence_detail::discretize(kDrydenU[0], kDrydenU[1], 1, tau, dt)
+                            : turbulence_detail::discretize(kDrydenVW[0], kDrydenVW[1], 2, tau, dt);
+    }
+    return longitudinal ? turbulence_detail::discretize(kKarmanU[0], kKarmanU[1], 2, tau, dt)
+                        : turbulence_detail::discretize(kKarmanVW[0], kKarmanVW[1], 3, tau, dt);
+}
+
+/**
+ * @class TurbulenceField
+ * @brief Independent turbulence at any number of vehicles, advanced one sample at a time
+ *
+ * The three shaping filters (u along the mean flow, v across it, w
+ * vertical) are designed once in configure() for a fixed sample period and
+ * shared by every vehicle, so step() is pure arithmetic:
+ *
+ * 1. one block of Gaussian noise for all vehicles and axes, from a
+ *    counter-based generator (a hash of vehicle key and sample number,
+ *    Box–Muller for the pairs), with no sequential generator state;
+ * 2. per axis, one branch-free pass over the vehicles applying the
+ *    filter's fixed coefficients to structure-of-arrays state.
+ *
+ * Both loops vectorize across vehicles. The noise a vehicle sees depends
+ * only on the seed, its index and the sample number, so a Monte Carlo run
+ * is reproduced by its seed, and vehicle i flies the same turbulence in a
+ * swarm of 1000 as on its own.
+ *
+ * Outputs start from calm air (filter states zero).
+ */
+class TurbulenceField {
+public:
+    static constexpr std::size_t kAxes = 3;
+    static constexpr std::size_t kOrder = ShapingFilter::kMaxOrder;
+
+    enum Axis : std::size_t {
+        kAlong = 0,     ///< u, along the mean wind
+        kAcross = 1,    ///< v, horizontal across it
+        kVertical = 2   ///< w, positive down
+    };
+
+    /**
+     * @brief Size the field and reset it to calm air at sample 0
+     * @param vehicles Number of independent vehicles
+     * @param seed Noise seed
+     */
+    void resize(std::size_t vehicles, std::uint64_t seed) {
+        vehicles_ = vehicles;
+        state_.assign(kAxes * kOrder * vehicles, 0.0);
+        noise_.assign(kAxes * vehicles, 0.0);
+        output_.assign(kAxes * vehicles, 0.0);
+        keys_.resize(vehicles);
+        reseed(seed);
+        sample_ = 0;
+    }
+
+    /// Change the seed without resetting the filters; the noise from the next sample on follows the new seed
+    void reseed(std::uint64_t seed) {
+        seed_ = seed;
+        for (std::size_t i = 0; i < vehicles_; ++i) {
+            keys_[i] = turbulence_detail::mix(turbulence_detail::mix(seed) + (i + 1) * turbulence_detail::kGolden);
+        }
+    }
+
+    /**
+     * @brief Design the shaping filters (all of the field's transcendental math happens here)
+     *
+     * Filter states are kept when only the intensities change and reset to
+     * calm air when the spectrum, a scale length, the airspeed or dt does.
+     */
+    void configure(TurbulenceSpectrum spectrum, const TurbulenceScales& scales, double airspeed_m_s, double dt) {
+        const bool same_shape = configured_ && spectrum == spectrum_ && airspeed_m_s == airspeed_m_s_ && dt == dt_ &&
+                                scales.length_horizontal_m == scales_.length_horizontal_m &&
+                                scales.length_vertical_m == scales_.length_vertical_m;
+        spectrum_ = spectrum;
+        scales_ = scales;
+        airspeed_m_s_ = airspeed_m_s;
+        dt_ = dt;
+        sigma_ = {scales.sigma_horizontal_m_s, scales.sigma_horizontal_m_s, scales.sigma_vertical_m_s};
+        if (same_shape) {
+            return;
+        }
+        filter_[kAlong] = designShapingFilter(spectrum, true, scales.length_horizontal_m, airspeed_m_s, dt);
+        filter_[kAcross] = designShapingFilter(spectrum, false, scales.length_horizontal_m, airspeed_m_s, dt);
+        filter_[kVertical] = designShapingFilter(spectrum, false, scales.length_vertical_m, airspeed_m_s, dt);
+        std::fill(state_.begin(), state_.end(), 0.0);
+        configured_ = true;
+    }
+
+    /// Advance every vehicle by one sample period
+    void step() {
+        generateNoise();
+        for (std::size_t axis = 0; axis < kAxes; ++axis) {
+            switch (filter_[axis].order) {
+                case 1: advance<1>(axis); break;
+                case 2: advance<2>(axis); break;
+                case 3: advance<3>(axis); break;
+                default: break;
+            }
+        }
+        ++sample_;
+    }
+
+    /// Turbulent velocity of every vehicle along one axis (m/s), from the last step()
+    const double* output(std::size_t axis) const { return output_.data() + axis * vehicles_; }
+    double output(std::size_t axis, std::size_t vehicle) const { return output_[axis * vehicles_ + vehicle]; }
+
+    const ShapingFilter& filter(std::size_t axis) const { return filter_[axis]; }
+    std::size_t vehicles() const { return vehicles_; }
+    std::uint64_t samples() const { return sample_; }
+    std::uint64_t seed() const { return seed_; }
+
+    /// Run-time state for checkpoints: filter states, outputs and the sample counter
+    std::vector<double>& stateData() { return state_; }
+    std::vector<double>& outputData() { return output_; }
+    std::uint64_t& sampleCounter() { return sample_; }
+
+private:
+    std::size_t vehicles_{0};
+    std::uint64_t seed_{0};
+    std::uint64_t sample_{0};
+    bool configured_{false};
+    TurbulenceSpectrum spectrum_{TurbulenceSpectrum::Dryden};
+    TurbulenceScales scales_{};
+    double airspeed_m_s_{0.0};
+    double dt_{0.0};
+    std::array<ShapingFilter, kAxes> filter_{};
+    std::array<double, kAxes> sigma_{};
+    std::vector<double> state_;             ///< [axis][state][vehicle]
+    std::vector<double> noise_;             ///< [axis][vehicle], this sample's block
+    std::vector<double> output_;            ///< [axis][vehicle]
+    std::vector<std::uint64_t> keys_;       ///< Per-vehicle stream key
+
+    /// Two hashes per vehicle: one normal pair for u and v, half of one for w
+    void generateNoise() {
+        const std::uint64_t first = (2 * sample_ + 1) * turbulence_detail::kGolden;
+        const std::uint64_t second = first + turbulence_detail::kGolden;
+        const std::uint64_t* __restrict keys = keys_.data();
+        double* __restrict along = noise_.data();
+        double* __restrict across = along + vehicles_;
+        double* __restrict vertical = across + vehicles_;
+        for (std::size_t i = 0; i < vehicles_; ++i) {
+            turbulence_detail::normalPair(turbulence_detail::mix(keys[i] + first), along[i], across[i]);
+        }
+        for (std::size_t i = 0; i < vehicles_; ++i) {
+            double unused;
+            turbulence_detail::normalPair(turbulence_detail::mix(keys[i] + second), vertical[i], unused);
+        }
+    }
+
+    template <std::size_t Order>
+    void advance(std::size_t axis) {
+        const ShapingFilter& f = filter_[axis];
+        const double sigma = sigma_[axis];
+        double* __restrict x[Order];
+        for (std::size_t k = 0; k < Order; ++k) {
+            x[k] = state_.data() + (axis * kOrder + k) * vehicles_;
+        }
+        const double* __restrict n = noise_.data() + axis * vehicles_;
+        double* __restrict y = output_.data() + axis * vehicles_;
+        for (std::size_t i = 0; i < vehicles_; ++i) {
+            double current[Order];
+            double out = 0.0;
+            for (std::size_t k = 0; k < Order; ++k) {
+                current[k] = x[k][i];
+                out += f.c[k] * current[k];
+            }
+            y[i] = sigma * out;
+            for (std::size_t k = 0; k < Order; ++k) {
+                double next = f.b[k] * n[i];
+                for (std::size_t j = 0; j < Order; ++j) {
+                    next += f.a[k][j] * current[j];
+                }
+                x[k][i] = next;
+            }
+        }
+    }
+};
+
+#endif // CORE_TURBULENCE_FIELD_H
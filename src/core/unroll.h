@@ -0,0 +1,34 @@
+/**
+ * @file unroll.h
+ * @brief Compile-time loop unrolling for small fixed-size loops
+ */
+
+#ifndef CORE_UNROLL_H
+#define CORE_UNROLL_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+template <typename F, std::size_t... I>
+constexpr void unrollForImpl(F&& f, std::index_sequence<I...>) {
+    (f(std::integral_constant<std::size_t, I>{}), ...);
+}
+}  // namespace detail
+
+/**
+ * @brief Call f(std::integral_constant<std::size_t, I>{}) for I = 0 .. N-1
+ *
+ * Expands to N straight-line calls, so per-rotor loops over a compile-time
+ * rotor count carry no loop overhead and the index is usable as a constant
+ * expression inside the body (e.g. `Layout::kRotors[i]`).
+ *
+ * @tparam N Iteration count
+ */
+template <std::size_t N, typename F>
+constexpr void unrollFor(F&& f) {
+    detail::unrollForImpl(std::forward<F>(f), std::make_index_sequence<N>{});
+}
+
+#endif // CORE_UNROLL_H
@@ -0,0 +1,191 @@
+#include "gui/panels/bode_panel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "core/simulation_state.h"
+#include "gui/style.h"
+#include "gui/widgets/card.h"
+#include "render/camera.h"
+
+#include "imgui.h"
+#include "implot.h"
+
+namespace {
+
+constexpr const char* kSubjectLabels[] = {"First-order module", "Roll loop", "Pitch loop"};
+
+/// Frequency where the gain first drops 3 dB below its low-frequency value (0 if it never does)
+double bandwidthHz(const std::vector<FrequencyResponsePoint>& points) {
+    if (points.empty() || points.front().gain <= 0.0) {
+        return 0.0;
+    }
+    const double threshold = points.front().gain / std::sqrt(2.0);
+    for (const auto& point : points) {
+        if (point.gain < threshold) {
+            return point.frequency_hz;
+        }
+    }
+    return 0.0;
+}
+
+}  // namespace
+
+BodePanel::~BodePanel() {
+    if (worker_.joinable()) {
+        cancel_ = true;
+        worker_.join();
+    }
+}
+
+void BodePanel::startSweep(const SimulationState& state) {
+    HeadlessTarget target;
+    switch (subject_) {
+    case Subject::FirstOrder:
+        target = firstOrderTarget(state.dynamics_config);
+        break;
+    case Subject::RollLoop:
+    case Subject::PitchLoop:
+        target = attitudeLoopTarget(state.vehicle_config.airframe, state.controller_config,
+                                    subject_ == Subject::PitchLoop ? 1 : 0);
+        break;
+    }
+
+    completed_ = 0;
+    cancel_ = false;
+    finished_ = false;
+    started_at_ = ImGui::GetTime();
+    const FrequencyResponseSettings settings = settings_;
+    worker_ = std::thread([this, target, settings]() {
+        pending_ = analyzeFrequencyResponse(target, settings, &completed_, &cancel_);
+        finished_ = true;
+    });
+}
+
+void BodePanel::collectSweep() {
+    if (!worker_.joinable() || !finished_) {
+        return;
+    }
+    worker_.join();
+    if (!pending_.empty()) {
+        result_ = std::move(pending_);
+        result_label_ = kSubjectLabels[static_cast<int>(subject_)];
+        result_seconds_ = ImGui::GetTime() - started_at_;
+        result_bandwidth_hz_ = bandwidthHz(result_);
+
+        // Plotted every frame; converted once per sweep.
+        plot_frequency_hz_.resize(result_.size());
+        plot_gain_db_.resize(result_.size());
+        plot_phase_deg_.resize(result_.size());
+        for (std::size_t i = 0; i < result_.size(); ++i) {
+            plot_frequency_hz_[i] = result_[i].frequency_hz;
+            plot_gain_db_[i] = 20.0 * std::log10(std::max(result_[i].gain, 1e-12));
+            plot_phase_deg_[i] = result_[i].phase_deg;
+        }
+    }
+    pending_.clear();
+}
+
+void BodePanel::draw(SimulationState& state, Camera& camera) {
+    (void)camera;
+    collectSweep();
+
+    ui::CardOptions options;
+    options.min_size = ImVec2(560.0f, 520.0f);
+    if (!ui::BeginCard(name(), options, nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoCollapse)) {
+        ui::EndCard();
+        return;
+    }
+    ui::CardHeader("Frequency Response", "Headless sweep");
+
+    const bool running = worker_.joinable();
+    if (running) {
+        ImGui::BeginDisabled();
+    }
+    int subject = static_cast<int>(subject_);
+    if (ImGui::Combo("System", &subject, kSubjectLabels, 3)) {
+        subject_ = static_cast<Subject>(subject);
+    }
+    const char* excitation_labels[] = {"Stepped sine", "Multi-sine"};
+    int excitation = static_cast<int>(settings_.excitation);
+    if (ImGui::Combo("Excitation", &excitation, excitation_labels, 2)) {
+        settings_.excitation = static_cast<FrequencyResponseSettings::Excitation>(excitation);
+    }
+    float band[2] = {static_cast<float>(settings_.min_hz), static_cast<float>(settings_.max_hz)};
+    if (ImGui::SliderFloat2("Band (Hz)", band, 0.01f, 100.0f, "%.2f", ImGuiSliderFlags_Logarithmic)) {
+        settings_.min_hz = std::max(band[0], 0.01f);
+        settings_.max_hz = std::max(band[1], band[0]);
+    }
+    int points = static_cast<int>(settings_.points);
+    if (ImGui::SliderInt("Points", &points, 10, 400)) {
+        settings_.points = static_cast<std::size_t>(points);
+    }
+    // Attitude loops want a small excitation (rad) to stay linear.
+    const bool loop_subject = subject_ != Subject::FirstOrder;
+    float amplitude = static_cast<float>(settings_.amplitude);
+    if (ImGui::SliderFloat(loop_subject ? "Amplitude (rad)" : "Amplitude", &amplitude, 0.001f, 1.0f, "%.3f",
+                           ImGuiSliderFlags_Logarithmic)) {
+        settings_.amplitude = amplitude;
+    }
+    if (running) {
+        ImGui::EndDisabled();
+    }
+
+    if (running) {
+        const float fraction = static_cast<float>(completed_.load()) / static_cast<float>(std::max<std::size_t>(settings_.points, 1));
+        ImGui::ProgressBar(fraction, ImVec2(-90.0f, 0.0f));
+        ImGui::SameLine();
+        if (ImGui::Button("Cancel", ImVec2(80.0f, 0.0f))) {
+            cancel_ = true;
+        }
+    } else if (ImGui::Button("Run sweep", ImVec2(120.0f, 0.0f))) {
+        startSweep(state);
+    }
+
+    if (!result_.empty()) {
+        ImGui::SameLine();
+        const double bandwidth = result_bandwidth_hz_;
+        ImGui::PushStyleColor(ImGuiCol_Text, ui::Colors().text_muted);
+        if (bandwidth > 0.0) {
+            ImGui::Text("%s: %zu points in %.1f s, -3 dB at %.2f Hz",
+                        result_label_, result_.size(), result_seconds_, bandwidth);
+        } else {
+            ImGui::Text("%s: %zu points in %.1f s", result_label_, result_.size(), result_seconds_);
+        }
+        ImGui::PopStyleColor();
+    }
+
+    ImGui::Separator();
+    drawPlots();
+    ui::EndCard();
+}
+
+void BodePanel::drawPlots() const {
+    if (result_.empty()) {
+        ImGui::TextDisabled("Run a sweep to plot gain and phase");
+        return;
+    }
+
+    const std::vector<double>& frequency = plot_frequency_hz_;
+    const std::vector<double>& gain_db = plot_gain_db_;
+    const std::vector<double>& phase = plot_phase_deg_;
+    const int count = static_cast<int>(result_.size());
+    const ImVec2 size(-1.0f, 0.5f * (ImGui::GetContentRegionAvail().y - ImGui::GetStyle().ItemSpacing.y));
+
+    if (ImPlot::BeginPlot("##bode_gain", size)) {
+        ImPlot::SetupAxes(nullptr, "Gain (dB)", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Log10);
+        ImPlot::PlotLine(result_label_, frequency.data(), gain_db.data(), count);
+        const double reference[2] = {gain_db.front() - 3.0, gain_db.front() - 3.0};
+        const double span[2] = {frequency.front(), frequency.back()};
+        ImPlot::PlotLine("-3 dB", span, reference, 2);
+        ImPlot::EndPlot();
+    }
+    if (ImPlot::BeginPlot("##bode_phase", size)) {
+        ImPlot::SetupAxes("Frequency (Hz)", "Phase (deg)", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Log10);
+        ImPlot::PlotLine(result_label_, frequency.data(), phase.data(), count);
+        ImPlot::EndPlot();
+    }
+}
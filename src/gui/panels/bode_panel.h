@@ -0,0 +1,71 @@
+/**
+ * @file bode_panel.h
+ * @brief Frequency-response sweeps of the first-order module and the attitude loop
+ */
+
+#ifndef GUI_PANELS_BODE_PANEL_H
+#define GUI_PANELS_BODE_PANEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "analysis/frequency_response.h"
+#include "gui/panel.h"
+
+/**
+ * @class BodePanel
+ * @brief Runs analyzeFrequencyResponse() in the background and plots gain and phase
+ *
+ * The sweep is configured from a snapshot of the live state (dynamics_config,
+ * controller_config, airframe) taken when Run is pressed; the live
+ * simulation keeps running while worker threads simulate the headless
+ * copies. Gain is plotted in dB and phase in degrees against a log
+ * frequency axis, with the -3 dB level marked.
+ */
+class BodePanel : public Panel {
+public:
+    BodePanel() = default;
+    ~BodePanel() override;
+
+    void draw(SimulationState& state, Camera& camera) override;
+    const char* name() const override { return "Bode"; }
+
+private:
+    enum class Subject { FirstOrder, RollLoop, PitchLoop };
+
+    Subject subject_{Subject::FirstOrder};            ///< System to sweep
+    FrequencyResponseSettings settings_;              ///< Sweep grid and excitation
+    std::vector<FrequencyResponsePoint> result_;      ///< Last completed sweep
+    const char* result_label_{""};                    ///< Subject of result_
+    double result_seconds_{0.0};                      ///< Wall time of the last sweep
+    double result_bandwidth_hz_{0.0};                 ///< -3 dB frequency of result_ (0 if none)
+    std::vector<double> plot_frequency_hz_;           ///< result_ as plot columns, rebuilt by collectSweep()
+    std::vector<double> plot_gain_db_;
+    std::vector<double> plot_phase_deg_;
+
+    std::thread worker_;                              ///< Background sweep
+    std::vector<FrequencyResponsePoint> pending_;     ///< Written by worker_ only
+    std::atomic<std::size_t> completed_{0};           ///< Points finished by the running sweep
+    std::atomic<bool> cancel_{false};                 ///< Asks the running sweep to stop
+    std::atomic<bool> finished_{false};               ///< worker_ has written pending_
+    double started_at_{0.0};                          ///< ImGui time the sweep started
+
+    /**
+     * @brief Start a sweep of subject_ from a snapshot of state
+     */
+    void startSweep(const SimulationState& state);
+
+    /**
+     * @brief Join a finished worker and publish its result and plot columns
+     */
+    void collectSweep();
+
+    /**
+     * @brief Draw gain (dB) and phase (deg) against log frequency
+     */
+    void drawPlots() const;
+};
+
+#endif // GUI_PANELS_BODE_PANEL_H
@@ -122,13 +122,14 @@ void ControlPanel::draw(SimulationState& state, Camera& camera) {
 
     ImGui::Separator();
 
-    glm::vec3 body_rates = glm::vec3(state.angular_rate_deg_per_sec);
+    // Body rates are stored in rad/s; the slider edits them in deg/s.
+    glm::vec3 body_rates = glm::vec3(glm::degrees(state.angular_rate_rad_s));
     if (ImGui::SliderFloat3("Body Rates (deg/s)", glm::value_ptr(body_rates), -360.0f, 360.0f, "%.1f")) {
-        state.angular_rate_deg_per_sec = glm::dvec3(body_rates);
+        state.angular_rate_rad_s = glm::radians(glm::dvec3(body_rates));
     }
     ImGui::SameLine();
     if (ImGui::SmallButton("Zero##BodyRates")) {
-        state.angular_rate_deg_per_sec = glm::dvec3(0.0, 0.0, 0.0);
+        state.angular_rate_rad_s = glm::dvec3(0.0, 0.0, 0.0);
     }
 
     ImGui::Separator();
@@ -156,12 +157,175 @@ void ControlPanel::draw(SimulationState& state, Camera& camera) {
     }
 
     ImGui::Separator();
+    using IntegrationMethod = SimulationState::PlantIntegration::Method;
+    auto& integration = state.plant_integration;
+    const bool adaptive = integration.method == IntegrationMethod::DormandPrince45;
+    int method_index = adaptive ? 1 : 0;
+    const char* method_labels[] = {"Fixed RK4 (2.5 ms)", "Adaptive Dormand-Prince 45"};
+    if (ImGui::Combo("Plant integrator", &method_index, method_labels, 2)) {
+        integration.method = method_index == 1 ? IntegrationMethod::DormandPrince45
+                                               : IntegrationMethod::FixedRk4;
+    }
+    if (adaptive) {
+        double rtol = integration.relative_tolerance;
+        const double tol_min = 1e-12;
+        const double tol_max = 1e-2;
+        if (ImGui::DragScalar("Relative tolerance", ImGuiDataType_Double, &rtol, 0.0f,
+                              &tol_min, &tol_max, "%.1e", ImGuiSliderFlags_Logarithmic)) {
+            integration.relative_tolerance = std::clamp(rtol, tol_min, tol_max);
+        }
+        ImGui::Text("Next step: %.2f ms | RHS evals: %llu",
+                    integration.last_step_s * 1000.0,
+                    static_cast<unsigned long long>(integration.derivative_evaluations));
+    }
+    const auto& trim = state.trim;
+    if (trim.converged) {
+        ImGui::Text("Hover trim: %.0f rad/s (rotor 1) | %zu Newton steps in %.0f us", trim.rotor_omega_rad_s[0],
+                    trim.iterations, trim.solve_us);
+    } else {
+        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Hover trim failed (residual %.2e)", trim.residual);
+    }
+
+    const auto& scenario = state.scenario_status;
+    if (scenario.active) {
+        ImGui::Separator();
+        ImGui::Text("Scenario: %zu / %zu events | assertions %llu passed, %llu failed", scenario.dispatched,
+                    scenario.events, static_cast<unsigned long long>(scenario.assertions_passed),
+                    static_cast<unsigned long long>(scenario.assertions_failed));
+        if (!scenario.first_failure.empty()) {
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "First failure: %s", scenario.first_failure.c_str());
+        }
+    }
+
+    ImGui::Separator();
+    using ControllerMode = SimulationState::ControllerConfig::Mode;
+    auto& controller = state.controller_config;
+    int mode_index = static_cast<int>(controller.mode);
+    const char* mode_labels[] = {"Off (open loop)", "Rate (keys set body rates)", "Attitude (keys tilt setpoint)",
+                                 "LQR (keys move position setpoint)", "MPC (keys tilt setpoint)",
+                                 "External (SITL flight controller)"};
+    if (ImGui::Combo("Controller", &mode_index, mode_labels, 6)) {
+        controller.mode = static_cast<ControllerMode>(mode_index);
+    }
+    if (controller.mode == ControllerMode::Lqr) {
+        ImGui::DragScalarN("Position setpoint (NED)", ImGuiDataType_Double,
+                           &state.controller_setpoint.position_ned.x, 3, 0.05f);
+        const auto& lqr = state.lqr_status;
+        if (lqr.ready) {
+            ImGui::Text("Gains %016llx | %s in %.1f ms", static_cast<unsigned long long>(lqr.config_hash),
+                        lqr.from_cache ? "loaded from cache" : "solved", lqr.synthesis_ms);
+        } else if (lqr.config_hash == 0) {
+            ImGui::TextUnformatted("Gains are synthesized on the first LQR update");
+        } else {
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "LQR synthesis failed (commands not written)");
+        }
+        ImGui::Text("%.0f Hz | updates: %llu | %s", controller.rate_hz,
+                    static_cast<unsigned long long>(state.controller_state.updates),
+                    state.controller_state.saturated ? "motor limit" : "unsaturated");
+    } else if (controller.mode == ControllerMode::Mpc) {
+        auto& mpc = state.mpc_config;
+        ImGui::DragScalarN("Attitude weight", ImGuiDataType_Double, mpc.attitude_weight.data(), 3, 1.0f);
+        ImGui::DragScalarN("Rate weight", ImGuiDataType_Double, mpc.rate_weight.data(), 3, 0.05f);
+        ImGui::DragScalarN("Accel weight", ImGuiDataType_Double, mpc.accel_weight.data(), 3, 1e-4f);
+        float budget_us = static_cast<float>(mpc.budget_us);
+        if (ImGui::SliderFloat("Solve budget (us)", &budget_us, 10.0f, 2000.0f, "%.0f")) {
+            mpc.budget_us = budget_us;
+        }
+        const auto& status = state.mpc_status;
+        ImGui::Text("%.0f Hz | solve %.1f us | %zu iterations | %s", controller.rate_hz, status.solve_us,
+                    status.iterations, status.converged ? "converged" : "early stop");
+        ImGui::Text("Budget overruns: %llu of %llu", static_cast<unsigned long long>(status.budget_overruns),
+                    static_cast<unsigned long long>(status.solves));
+    } else if (controller.mode == ControllerMode::External) {
+        const auto& sitl = state.sitl_status;
+        if (!sitl.link_open) {
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "SITL link %s could not be created",
+                               state.sitl_config.link_name);
+        } else {
+            ImGui::Text("%s | %.0f Hz | %s", state.sitl_config.link_name, controller.rate_hz,
+                        sitl.connected ? "in lockstep" : "waiting for controller");
+        }
+        ImGui::Text("Round trip %.1f us (mean %.1f, max %.1f) | %llu exchanges, %llu timeouts", sitl.last_us,
+                    sitl.mean_us, sitl.max_us, static_cast<unsigned long long>(sitl.exchanges),
+                    static_cast<unsigned long long>(sitl.timeouts));
+    } else if (controller.mode != ControllerMode::Off) {
+        ImGui::DragScalarN("Attitude P", ImGuiDataType_Double, controller.attitude_kp.data(), 3, 0.05f);
+        ImGui::DragScalarN("Rate P", ImGuiDataType_Double, controller.rate_kp.data(), 3, 0.1f);
+        ImGui::DragScalarN("Rate I", ImGuiDataType_Double, controller.rate_ki.data(), 3, 0.1f);
+        ImGui::DragScalarN("Rate D", ImGuiDataType_Double, controller.rate_kd.data(), 3, 0.001f);
+        ImGui::DragScalarN("Rate FF", ImGuiDataType_Double, controller.rate_ff.data(), 3, 0.01f);
+        const auto& out = state.controller_state;
+        ImGui::Text("%.0f Hz | updates: %llu | %s", controller.rate_hz,
+                    static_cast<unsigned long long>(out.updates),
+                    out.saturated ? "motor limit" : "unsaturated");
+    }
+
+    if (state.profile.count > 0 &&
+        ImGui::BeginTable("module_profile", 6, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Module");
+        ImGui::TableSetupColumn("Rate");
+        ImGui::TableSetupColumn("Mean (us)");
+        ImGui::TableSetupColumn("Max (us)");
+        ImGui::TableSetupColumn("Misses");
+        ImGui::TableSetupColumn("Late (us)");
+        ImGui::TableHeadersRow();
+        for (std::size_t i = 0; i < state.profile.count; ++i) {
+            const auto& slot = state.profile.slots[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(slot.name);
+            ImGui::TableNextColumn();
+            if (slot.period_s > 0.0) {
+                ImGui::Text("%.0f Hz", 1.0 / slot.period_s);
+            } else {
+                ImGui::TextUnformatted("tick");
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", slot.mean_us);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", slot.max_us);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(slot.deadline_misses));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", slot.worst_lateness_us);
+        }
+        ImGui::EndTable();
+        ImGui::Text("Tick: %.1f us | RTF %.3f (target %.2f) | misses %llu",
+                    state.profile.tick_us, state.realtime.factor, state.realtime.target_factor,
+                    static_cast<unsigned long long>(state.realtime.deadline_misses));
+    }
+
+    const auto& telemetry = state.telemetry;
+    if (telemetry.size() > 0 &&
+        ImGui::BeginTable("telemetry_channels", 4, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Channel");
+        ImGui::TableSetupColumn("Last");
+        ImGui::TableSetupColumn("Mean");
+        ImGui::TableSetupColumn("Max");
+        ImGui::TableHeadersRow();
+        for (std::size_t i = 0; i < telemetry.size(); ++i) {
+            const auto& channel = telemetry.channel(i);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%s %s", channel.name, channel.unit);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", channel.last);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", channel.mean());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", channel.max);
+        }
+        ImGui::EndTable();
+    }
+
     ImGui::Text("Last dt: %.5f s", state.last_dt);
     ImGui::Text("Sim time: %.2f s", state.time_seconds);
     if (state.physics.integration_valid) {
         ImGui::TextColored(ImVec4(0.2f, 0.9f, 0.5f, 1.0f),
-                           "Plant: checked RK4 | accepted: %llu",
-                           static_cast<unsigned long long>(state.physics.accepted_steps));
+                           "Plant: %s | accepted: %llu | rejected: %llu",
+                           adaptive ? "adaptive RK45" : "checked RK4",
+                           static_cast<unsigned long long>(state.physics.accepted_steps),
+                           static_cast<unsigned long long>(state.physics.rejected_steps));
     } else {
         ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f),
                            "Plant rejected step | result: %d | rejected: %llu",
@@ -1,7 +1,9 @@
 #include "gui/panels/dynamics_panel.h"
 
+#include <cmath>
 #include <vector>
 
+#include "core/frame_arena.h"
 #include "core/simulation_state.h"
 #include "render/camera.h"
 #include "imgui.h"
@@ -14,6 +16,10 @@ void DynamicsPanel::appendSample(double time, double input, double output) {
     }
 
     last_recorded_time_ = time;
+    if (++frames_since_sample_ < decimation_) {
+        return;
+    }
+    frames_since_sample_ = 0;
 
     output_history_.emplace_back(static_cast<float>(output));
     input_history_.emplace_back(static_cast<float>(input));
@@ -24,6 +30,28 @@ void DynamicsPanel::appendSample(double time, double input, double output) {
     while (input_history_.size() > kMaxSamples) {
         input_history_.pop_front();
     }
+
+    const MemoryCapAction action = memoryCapAction(MemoryTag::Plot, decimation_);
+    applyMemoryCapAction(action, output_history_);
+    applyMemoryCapAction(action, input_history_);
+}
+
+void DynamicsPanel::trackStep(const SimulationState& state) {
+    const auto& config = state.dynamics_config;
+    if (config.input_mode != SimulationState::DynamicsConfig::InputMode::Constant) {
+        tracking_step_ = false;
+        return;
+    }
+    const double t = state.time_seconds;
+    if (!tracking_step_ || config.input_target != step_input_ || config.gain != step_gain_ ||
+        t < step_metrics_.startTime()) {
+        step_input_ = config.input_target;
+        step_gain_ = config.gain;
+        step_metrics_.reset(t, state.dynamics_state.output, config.gain * config.input_target);
+        tracking_step_ = true;
+        return;
+    }
+    step_metrics_.add(t, step_metrics_.finalTarget(), state.dynamics_state.output);
 }
 
 void DynamicsPanel::draw(SimulationState& state, Camera& camera) {
@@ -32,23 +60,54 @@ void DynamicsPanel::draw(SimulationState& state, Camera& camera) {
     appendSample(state.time_seconds,
                  state.dynamics_state.input,
                  state.dynamics_state.output);
+    trackStep(state);
 
     if (ImGui::Begin(name(), nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
         ImGui::Text("First-order response");
 
-        ImGui::Checkbox("Use Sine Input", &state.dynamics_config.use_sine);
-        if (state.dynamics_config.use_sine) {
-            float freq = static_cast<float>(state.dynamics_config.sine_frequency_hz);
-            if (ImGui::SliderFloat("Sine Frequency (Hz)", &freq, 0.1f, 5.0f)) {
-                state.dynamics_config.sine_frequency_hz = freq;
+        using InputMode = SimulationState::DynamicsConfig::InputMode;
+        auto& config = state.dynamics_config;
+        const char* mode_labels[] = {"Constant", "Sine", "Chirp", "Multi-sine"};
+        int mode = static_cast<int>(config.input_mode);
+        if (ImGui::Combo("Input", &mode, mode_labels, 4)) {
+            config.input_mode = static_cast<InputMode>(mode);
+        }
+
+        if (config.input_mode == InputMode::Constant) {
+            float target = static_cast<float>(config.input_target);
+            if (ImGui::SliderFloat("Step Input", &target, -2.0f, 2.0f)) {
+                config.input_target = target;
             }
         } else {
-            float target = static_cast<float>(state.dynamics_config.input_target);
-            if (ImGui::SliderFloat("Step Input", &target, -2.0f, 2.0f)) {
-                state.dynamics_config.input_target = target;
+            float amplitude = static_cast<float>(config.excitation_amplitude);
+            if (ImGui::SliderFloat("Amplitude", &amplitude, 0.0f, 2.0f)) {
+                config.excitation_amplitude = amplitude;
             }
         }
 
+        if (config.input_mode == InputMode::Sine) {
+            float freq = static_cast<float>(config.sine_frequency_hz);
+            if (ImGui::SliderFloat("Sine Frequency (Hz)", &freq, 0.1f, 5.0f)) {
+                config.sine_frequency_hz = freq;
+            }
+        } else if (config.input_mode == InputMode::Chirp) {
+            float band[2] = {static_cast<float>(config.chirp_start_hz), static_cast<float>(config.chirp_end_hz)};
+            if (ImGui::SliderFloat2("Sweep (Hz)", band, 0.01f, 20.0f, "%.2f", ImGuiSliderFlags_Logarithmic)) {
+                config.chirp_start_hz = band[0];
+                config.chirp_end_hz = band[1];
+            }
+            float duration = static_cast<float>(config.chirp_duration_s);
+            if (ImGui::SliderFloat("Sweep Time (s)", &duration, 5.0f, 120.0f, "%.0f")) {
+                config.chirp_duration_s = duration;
+            }
+        } else if (config.input_mode == InputMode::MultiSine) {
+            float base = static_cast<float>(config.multisine_base_hz);
+            if (ImGui::SliderFloat("Fundamental (Hz)", &base, 0.01f, 2.0f, "%.2f", ImGuiSliderFlags_Logarithmic)) {
+                config.multisine_base_hz = base;
+            }
+            ImGui::SliderInt("Tones", &config.multisine_tones, 1, 64);
+        }
+
         float tau = static_cast<float>(state.dynamics_config.time_constant);
         if (ImGui::SliderFloat("Time Constant (s)", &tau, 0.05f, 10.0f, "%.2f", ImGuiSliderFlags_Logarithmic)) {
             state.dynamics_config.time_constant = tau;
@@ -59,10 +118,8 @@ void DynamicsPanel::draw(SimulationState& state, Camera& camera) {
             state.dynamics_config.gain = gain;
         }
 
-        static std::vector<float> output_buffer;
-        static std::vector<float> input_buffer;
-        output_buffer.assign(output_history_.begin(), output_history_.end());
-        input_buffer.assign(input_history_.begin(), input_history_.end());
+        const ArenaVector<float> output_buffer(output_history_.begin(), output_history_.end());
+        const ArenaVector<float> input_buffer(input_history_.begin(), input_history_.end());
 
         if (!output_buffer.empty()) {
             ImGui::PlotLines("Output", output_buffer.data(), static_cast<int>(output_buffer.size()), 0, nullptr, -2.0f, 2.0f, ImVec2(0, 120));
@@ -72,6 +129,24 @@ void DynamicsPanel::draw(SimulationState& state, Camera& camera) {
         }
 
         ImGui::Text("Current output: %.3f", state.dynamics_state.output);
+
+        const StepMetrics& metrics = step_metrics_.metrics();
+        if (tracking_step_ && metrics.samples > 0) {
+            ImGui::Separator();
+            ImGui::Text("Step to %.3f", step_metrics_.finalTarget());
+            if (std::isnan(metrics.rise_time_s)) {
+                ImGui::Text("Rise time: -");
+            } else {
+                ImGui::Text("Rise time: %.3f s", metrics.rise_time_s);
+            }
+            if (std::isnan(metrics.settling_time_s)) {
+                ImGui::Text("Settling (2%%): -");
+            } else {
+                ImGui::Text("Settling (2%%): %.3f s", metrics.settling_time_s);
+            }
+            ImGui::Text("Overshoot: %.1f %%", metrics.overshoot_pct);
+            ImGui::Text("IAE: %.4f  ITAE: %.4f", metrics.iae, metrics.itae);
+        }
     }
     ImGui::End();
 }
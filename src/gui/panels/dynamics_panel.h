@@ -9,6 +9,8 @@
 #include <deque>
 #include <utility>
 
+#include "analysis/step_metrics.h"
+#include "core/memory_accounting.h"
 #include "gui/panel.h"
 
 /**
@@ -18,6 +20,8 @@
  * Provides:
  * - Configuration controls (gain, time constant, input mode)
  * - Real-time plotting of input/output time series
+ * - Step metrics (rise/settling time, overshoot, IAE) of the live response,
+ *   restarted whenever the constant input changes
  * - History buffer with configurable sample count
  *
  * Useful for:
@@ -32,9 +36,20 @@ public:
 
 private:
     static constexpr std::size_t kMaxSamples = 512; ///< Max samples in history buffer
-    std::deque<float> output_history_;              ///< Output time series
-    std::deque<float> input_history_;               ///< Input time series
+    TrackedDeque<float, MemoryTag::Plot> output_history_;  ///< Output time series
+    TrackedDeque<float, MemoryTag::Plot> input_history_;   ///< Input time series
     double last_recorded_time_{0.0};                ///< Last sample timestamp
+    int decimation_{1};                             ///< Frames per sample imposed by the Plot memory cap
+    int frames_since_sample_{0};                    ///< Frames skipped since the last sample
+    StepMetricsAccumulator step_metrics_;           ///< Live metrics of the latest step
+    double step_input_{0.0};                        ///< Constant input the metrics refer to
+    double step_gain_{0.0};                         ///< Gain the metrics refer to
+    bool tracking_step_{false};                     ///< step_metrics_ holds a step in progress
+
+    /**
+     * @brief Restart step_metrics_ when the constant input or gain changed, then add a sample
+     */
+    void trackStep(const SimulationState& state);
 
     /**
      * @brief Add a sample to the history buffers
@@ -3,10 +3,9 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
-#include <cstdio>
-#include <string>
 
 #include "attitude/attitude_utils.h"
+#include "core/frame_arena.h"
 #include "core/simulation_state.h"
 #include "gui/style.h"
 #include "gui/widgets/card.h"
@@ -18,38 +17,26 @@
 #include "implot.h"
 
 namespace {
-std::string FormatEuler(double roll, double pitch, double yaw) {
-    char buffer[96];
-    std::snprintf(buffer,
-                  sizeof(buffer),
-                  "%.1f deg, %.1f deg, %.1f deg",
-                  rad2deg(roll),
-                  rad2deg(pitch),
-                  rad2deg(yaw));
-    return std::string(buffer);
+const char* FormatEuler(double roll, double pitch, double yaw) {
+    return frameArena().format("%.1f deg, %.1f deg, %.1f deg",
+                               rad2deg(roll),
+                               rad2deg(pitch),
+                               rad2deg(yaw));
 }
 
-std::string FormatEulerDelta(double roll, double pitch, double yaw) {
-    char buffer[96];
-    std::snprintf(buffer,
-                  sizeof(buffer),
-                  "d %.2f deg, %.2f deg, %.2f deg",
-                  rad2deg(roll),
-                  rad2deg(pitch),
-                  rad2deg(yaw));
-    return std::string(buffer);
+const char* FormatEulerDelta(double roll, double pitch, double yaw) {
+    return frameArena().format("d %.2f deg, %.2f deg, %.2f deg",
+                               rad2deg(roll),
+                               rad2deg(pitch),
+                               rad2deg(yaw));
 }
 
-std::string FormatQuaternion(const std::array<double, 4>& q) {
-    char buffer[128];
-    std::snprintf(buffer,
-                  sizeof(buffer),
-                  "[%.3f, %.3f, %.3f, %.3f]",
-                  q[0],
-                  q[1],
-                  q[2],
-                  q[3]);
-    return std::string(buffer);
+const char* FormatQuaternion(const std::array<double, 4>& q) {
+    return frameArena().format("[%.3f, %.3f, %.3f, %.3f]",
+                               q[0],
+                               q[1],
+                               q[2],
+                               q[3]);
 }
 }  // namespace
 
@@ -67,32 +54,32 @@ void EstimatorPanel::draw(SimulationState& state, Camera& camera) {
     const ui::Palette& palette = ui::Colors();
     ui::CardHeader("State Estimation", "Kalman Filter");
 
-    const auto& true_euler = state.euler;
+    const auto& true_euler = state.euler();
     const auto& est_euler = state.estimator.euler;
 
-    std::string true_orientation = FormatEuler(true_euler.roll, true_euler.pitch, true_euler.yaw);
-    std::string est_orientation = FormatEuler(est_euler.roll, est_euler.pitch, est_euler.yaw);
+    const char* true_orientation = FormatEuler(true_euler.roll, true_euler.pitch, true_euler.yaw);
+    const char* est_orientation = FormatEuler(est_euler.roll, est_euler.pitch, est_euler.yaw);
     double err_roll = est_euler.roll - true_euler.roll;
     double err_pitch = est_euler.pitch - true_euler.pitch;
     double err_yaw = est_euler.yaw - true_euler.yaw;
-    std::string error_orientation = FormatEulerDelta(err_roll, err_pitch, err_yaw);
+    const char* error_orientation = FormatEulerDelta(err_roll, err_pitch, err_yaw);
     double max_error_deg = std::max({std::abs(rad2deg(err_roll)),
                                      std::abs(rad2deg(err_pitch)),
                                      std::abs(rad2deg(err_yaw))});
-    std::string estimator_quat = FormatQuaternion(state.estimator.quaternion);
+    const char* estimator_quat = FormatQuaternion(state.estimator.quaternion);
 
-    ui::ValueChip("True Orientation", true_orientation.c_str(), ui::ChipConfig{220.0f});
+    ui::ValueChip("True Orientation", true_orientation, ui::ChipConfig{220.0f});
     ImGui::Dummy(ImVec2(0.0f, 6.0f));
-    ui::ValueChip("Estimated Orientation", est_orientation.c_str(), ui::ChipConfig{220.0f});
+    ui::ValueChip("Estimated Orientation", est_orientation, ui::ChipConfig{220.0f});
     ImGui::Dummy(ImVec2(0.0f, 6.0f));
 
     ui::ChipConfig error_config;
     error_config.min_width = 220.0f;
     error_config.variant = max_error_deg < 1.0 ? ui::ChipVariant::Positive : ui::ChipVariant::Negative;
-    ui::ValueChip("Orientation Error", error_orientation.c_str(), error_config);
+    ui::ValueChip("Orientation Error", error_orientation, error_config);
 
     ImGui::Dummy(ImVec2(0.0f, 6.0f));
-    ui::ValueChip("Estimator Quaternion", estimator_quat.c_str(), ui::ChipConfig{240.0f});
+    ui::ValueChip("Estimator Quaternion", estimator_quat, ui::ChipConfig{240.0f});
 
     ImGui::Dummy(ImVec2(0.0f, 10.0f));
     ImGui::PushStyleColor(ImGuiCol_Text, palette.text_muted);
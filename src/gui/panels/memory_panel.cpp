@@ -0,0 +1,151 @@
+#include "gui/panels/memory_panel.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "core/memory_accounting.h"
+#include "core/simulation_state.h"
+#include "gui/style.h"
+#include "gui/widgets/card.h"
+#include "render/camera.h"
+
+#include "imgui.h"
+
+namespace {
+
+constexpr double kMiB = 1024.0 * 1024.0;
+
+/// Human-readable byte count ("812 B", "14.2 KiB", "3.50 MiB")
+void formatBytes(char* buffer, std::size_t size, std::int64_t bytes) {
+    const double value = static_cast<double>(std::max<std::int64_t>(bytes, 0));
+    if (value < 1024.0) {
+        std::snprintf(buffer, size, "%.0f B", value);
+    } else if (value < kMiB) {
+        std::snprintf(buffer, size, "%.1f KiB", value / 1024.0);
+    } else {
+        std::snprintf(buffer, size, "%.2f MiB", value / kMiB);
+    }
+}
+
+void historyRow(const char* label, std::size_t samples, int decimation) {
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(label);
+    ImGui::TableNextColumn();
+    ImGui::Text("%zu", samples);
+    ImGui::TableNextColumn();
+    if (decimation > 1) {
+        ImGui::PushStyleColor(ImGuiCol_Text, ui::Colors().warning);
+        ImGui::Text("1/%d", decimation);
+        ImGui::PopStyleColor();
+    } else {
+        ImGui::TextUnformatted("full rate");
+    }
+}
+
+}  // namespace
+
+void MemoryPanel::draw(SimulationState& state, Camera& camera) {
+    (void)camera;
+
+    ui::CardOptions options;
+    options.min_size = ImVec2(520.0f, 300.0f);
+    if (!ui::BeginCard(name(), options, nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoCollapse)) {
+        ui::EndCard();
+        return;
+    }
+    ui::CardHeader("Memory", "Per subsystem");
+
+    const ui::Palette& palette = ui::Colors();
+    const char* policy_labels[] = {"Evict", "Decimate"};
+    if (ImGui::BeginTable("memory_usage", 7, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Subsystem");
+        ImGui::TableSetupColumn("Live");
+        ImGui::TableSetupColumn("Peak");
+        ImGui::TableSetupColumn("Allocs");
+        ImGui::TableSetupColumn("Cap (MiB)");
+        ImGui::TableSetupColumn("Policy");
+        ImGui::TableSetupColumn("Enforced");
+        ImGui::TableHeadersRow();
+        for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+            const MemoryTag tag = static_cast<MemoryTag>(i);
+            const MemoryAccounting::Usage usage = MemoryAccounting::usage(tag);
+            char live[32];
+            char peak[32];
+            formatBytes(live, sizeof(live), usage.live_bytes);
+            formatBytes(peak, sizeof(peak), usage.peak_bytes);
+
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(MemoryAccounting::name(tag));
+            ImGui::TableNextColumn();
+            if (MemoryAccounting::overCap(tag)) {
+                ImGui::PushStyleColor(ImGuiCol_Text, palette.danger);
+                ImGui::TextUnformatted(live);
+                ImGui::PopStyleColor();
+            } else {
+                ImGui::TextUnformatted(live);
+            }
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(peak);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(usage.allocations));
+
+            // Nothing appends to GPU buffers at run time, so there is no cap to enforce.
+            if (tag == MemoryTag::Gpu) {
+                ImGui::TableNextColumn();
+                ImGui::TextDisabled("-");
+                ImGui::TableNextColumn();
+                ImGui::TextDisabled("-");
+            } else {
+                float cap_mib = static_cast<float>(static_cast<double>(usage.cap_bytes) / kMiB);
+                int policy = static_cast<int>(usage.policy);
+                bool changed = false;
+                ImGui::TableNextColumn();
+                ImGui::SetNextItemWidth(90.0f);
+                changed |= ImGui::InputFloat("##cap", &cap_mib, 1.0f, 16.0f, "%.1f");
+                ImGui::TableNextColumn();
+                ImGui::SetNextItemWidth(100.0f);
+                changed |= ImGui::Combo("##policy", &policy, policy_labels, 2);
+                if (changed) {
+                    const double bytes = std::max(0.0, static_cast<double>(cap_mib)) * kMiB;
+                    MemoryAccounting::setCap(tag, static_cast<std::size_t>(bytes),
+                                             static_cast<MemoryAccounting::Policy>(policy));
+                }
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(usage.enforcements));
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+
+    if (ImGui::Button("Reset peaks", ImVec2(120.0f, 0.0f))) {
+        MemoryAccounting::resetPeaks();
+    }
+    ImGui::SameLine();
+    ImGui::PushStyleColor(ImGuiCol_Text, palette.text_muted);
+    ImGui::TextUnformatted("Cap 0 = uncapped");
+    ImGui::PopStyleColor();
+
+    ImGui::Separator();
+    if (ImGui::BeginTable("memory_histories", 3, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("History");
+        ImGui::TableSetupColumn("Samples");
+        ImGui::TableSetupColumn("Sampling");
+        ImGui::TableHeadersRow();
+        historyRow("Attitude", state.attitude_history.samples.size(), state.attitude_history.decimation);
+        std::size_t rotor_samples = 0;
+        for (const auto& rotor : state.rotor_history.rotors) {
+            rotor_samples += rotor.size();
+        }
+        historyRow("Rotors", rotor_samples, state.rotor_history.decimation);
+        historyRow("Sensors", state.sensor_history.samples.size(), 1);
+        ImGui::EndTable();
+    }
+
+    ui::EndCard();
+}
@@ -0,0 +1,29 @@
+/**
+ * @file memory_panel.h
+ * @brief Per-subsystem memory usage and caps
+ */
+
+#ifndef GUI_PANELS_MEMORY_PANEL_H
+#define GUI_PANELS_MEMORY_PANEL_H
+
+#include "gui/panel.h"
+
+/**
+ * @class MemoryPanel
+ * @brief Live and peak bytes per MemoryTag, with editable hard caps
+ *
+ * One row per subsystem (histories, plots, logs, GPU buffers) shows the
+ * bytes currently held, the peak since start (or the last reset), the
+ * allocation count, and how often the cap has been enforced. Caps are set
+ * in MiB (0 = uncapped) together with the policy over-cap buffers follow.
+ * GPU buffers are reported by the renderer and only accounted, never capped.
+ * Below the table the state histories list their sample counts and the
+ * decimation the cap currently imposes on them.
+ */
+class MemoryPanel : public Panel {
+public:
+    const char* name() const override { return "Memory"; }
+    void draw(SimulationState& state, Camera& camera) override;
+};
+
+#endif // GUI_PANELS_MEMORY_PANEL_H
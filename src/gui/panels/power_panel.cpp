@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 
+#include "core/frame_arena.h"
 #include "core/simulation_state.h"
 #include "render/camera.h"
 #include "gui/style.h"
@@ -21,9 +22,13 @@ constexpr float kChartHeight = 160.0f;
 void PowerPanel::draw(SimulationState& state, Camera& camera) {
     (void)camera;
 
-    power_history_.emplace_back(static_cast<float>(state.rotor.total_power_watt));
-    while (power_history_.size() > kMaxSamples) {
-        power_history_.pop_front();
+    if (++frames_since_sample_ >= decimation_) {
+        frames_since_sample_ = 0;
+        power_history_.emplace_back(static_cast<float>(state.rotor.total_power_watt));
+        while (power_history_.size() > kMaxSamples) {
+            power_history_.pop_front();
+        }
+        enforceMemoryCap(MemoryTag::Plot, power_history_, decimation_);
     }
 
     ui::CardOptions options;
@@ -94,7 +99,7 @@ void PowerPanel::draw(SimulationState& state, Camera& camera) {
                              16.0f);
 
     if (power_history_.size() >= 2) {
-        std::vector<float> samples(power_history_.begin(), power_history_.end());
+        const ArenaVector<float> samples(power_history_.begin(), power_history_.end());
         float min_power = *std::min_element(samples.begin(), samples.end());
         float max_power = *std::max_element(samples.begin(), samples.end());
         if (std::abs(max_power - min_power) < 1e-3f) {
@@ -105,16 +110,17 @@ void PowerPanel::draw(SimulationState& state, Camera& camera) {
         const std::size_t count = samples.size();
         const float step = count > 1 ? chart_size.x / static_cast<float>(count - 1) : chart_size.x;
 
-        std::vector<ImVec2> line_points;
-        line_points.reserve(count);
+        // One buffer holds the line and, after it, the two corners that close the fill.
+        ArenaVector<ImVec2> fill_points;
+        fill_points.reserve(count + 2);
         for (std::size_t i = 0; i < count; ++i) {
             float normalized = (samples[i] - min_power) / range;
             float x = chart_pos.x + step * static_cast<float>(i);
             float y = chart_pos.y + chart_size.y - normalized * chart_size.y;
-            line_points.emplace_back(x, y);
+            fill_points.emplace_back(x, y);
         }
+        const ImVec2* line_points = fill_points.data();
 
-        std::vector<ImVec2> fill_points = line_points;
         fill_points.emplace_back(chart_pos.x + chart_size.x, chart_pos.y + chart_size.y);
         fill_points.emplace_back(chart_pos.x, chart_pos.y + chart_size.y);
 
@@ -125,13 +131,13 @@ void PowerPanel::draw(SimulationState& state, Camera& camera) {
         draw_list->AddConvexPolyFilled(fill_points.data(), static_cast<int>(fill_points.size()), fill_color);
 
         ImU32 line_color = ImGui::ColorConvertFloat4ToU32(palette.accent_base);
-        draw_list->AddPolyline(line_points.data(),
-                               static_cast<int>(line_points.size()),
+        draw_list->AddPolyline(line_points,
+                               static_cast<int>(count),
                                line_color,
                                false,
                                2.5f);
 
-        ImVec2 last_point = line_points.back();
+        ImVec2 last_point = line_points[count - 1];
         draw_list->AddCircleFilled(last_point, 4.0f, line_color);
     } else {
         ImGui::PushStyleColor(ImGuiCol_Text, palette.text_muted);
@@ -8,6 +8,7 @@
 
 #include <deque>
 
+#include "core/memory_accounting.h"
 #include "gui/panel.h"
 
 /**
@@ -31,7 +32,9 @@ public:
 
 private:
     static constexpr std::size_t kMaxSamples = 512; ///< Max samples in power history
-    std::deque<float> power_history_;               ///< Power consumption time series (W)
+    TrackedDeque<float, MemoryTag::Plot> power_history_;  ///< Power consumption time series (W)
+    int decimation_{1};                             ///< Frames per sample imposed by the Plot memory cap
+    int frames_since_sample_{0};                    ///< Frames skipped since the last sample
 };
 
 #endif // POWER_PANEL_H
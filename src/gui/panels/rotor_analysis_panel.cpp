@@ -16,14 +16,10 @@
 #include "imgui.h"
 #include "implot.h"
 
-const std::deque<SimulationState::RotorSample>& RotorAnalysisPanel::getSamples(const SimulationState& state) const {
-    switch (selected_rotor_) {
-        case 0: return state.rotor_history.rotor1_samples;
-        case 1: return state.rotor_history.rotor2_samples;
-        case 2: return state.rotor_history.rotor3_samples;
-        case 3: return state.rotor_history.rotor4_samples;
-        default: return state.rotor_history.rotor1_samples;
-    }
+const SimulationState::RotorHistory::Samples& RotorAnalysisPanel::getSamples(const SimulationState& state) const {
+    const std::size_t rotor_count = std::max<std::size_t>(state.vehicle_config.rotor_count, 1);
+    const std::size_t index = std::min(static_cast<std::size_t>(std::max(selected_rotor_, 0)), rotor_count - 1);
+    return state.rotor_history.rotors[index];
 }
 
 void RotorAnalysisPanel::draw(SimulationState& state, Camera& camera) {
@@ -141,9 +137,11 @@ void RotorAnalysisPanel::draw(SimulationState& state, Camera& camera) {
 }
 
 void RotorAnalysisPanel::drawRotorSelector(SimulationState& state) {
-    (void)state;
-
     const ui::Palette& palette = ui::Colors();
+    const int rotor_count = static_cast<int>(state.vehicle_config.rotor_count);
+    if (selected_rotor_ >= rotor_count) {
+        selected_rotor_ = 0;
+    }
     ImGui::BeginGroup();
 
     ImGui::PushStyleColor(ImGuiCol_Text, palette.text_muted);
@@ -152,15 +150,20 @@ void RotorAnalysisPanel::drawRotorSelector(SimulationState& state) {
     ImGui::Spacing();
 
     // Tab-style buttons for rotor selection
-    const char* rotor_labels[] = {"Rotor 1", "Rotor 2", "Rotor 3", "Rotor 4"};
-    const ImVec4 colors[] = {
+    const ImVec4 colors[SimulationState::kMaxRotors] = {
         ImVec4(1.0f, 0.3f, 0.3f, 1.0f),  // Red
         ImVec4(0.3f, 1.0f, 0.3f, 1.0f),  // Green
         ImVec4(0.3f, 0.3f, 1.0f, 1.0f),  // Blue
-        ImVec4(1.0f, 0.8f, 0.3f, 1.0f)   // Yellow
+        ImVec4(1.0f, 0.8f, 0.3f, 1.0f),  // Yellow
+        ImVec4(0.9f, 0.4f, 1.0f, 1.0f),  // Violet
+        ImVec4(0.3f, 0.9f, 0.9f, 1.0f),  // Cyan
+        ImVec4(1.0f, 0.55f, 0.2f, 1.0f), // Orange
+        ImVec4(0.8f, 0.8f, 0.8f, 1.0f)   // Grey
     };
 
-    for (int i = 0; i < 4; ++i) {
+    for (int i = 0; i < rotor_count; ++i) {
+        char rotor_label[16];
+        std::snprintf(rotor_label, sizeof(rotor_label), "Rotor %d", i + 1);
         if (selected_rotor_ == i) {
             ImGui::PushStyleColor(ImGuiCol_Button, colors[i]);
             ImGui::PushStyleColor(ImGuiCol_ButtonHovered, colors[i]);
@@ -173,7 +176,7 @@ void RotorAnalysisPanel::drawRotorSelector(SimulationState& state) {
             ImGui::PushStyleColor(ImGuiCol_ButtonActive, colors[i]);
         }
 
-        if (ImGui::Button(rotor_labels[i], ImVec2(100.0f, 40.0f))) {
+        if (ImGui::Button(rotor_label, ImVec2(100.0f, 40.0f))) {
             selected_rotor_ = i;
         }
 
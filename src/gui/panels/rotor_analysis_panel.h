@@ -37,7 +37,7 @@ private:
     /**
      * @brief Get samples deque for selected rotor
      */
-    const std::deque<SimulationState::RotorSample>& getSamples(const SimulationState& state) const;
+    const SimulationState::RotorHistory::Samples& getSamples(const SimulationState& state) const;
 
     /**
      * @brief Draw sidebar with rotor selection tabs
@@ -2,8 +2,8 @@
 
 #include <algorithm>
 #include <cstdio>
-#include <string>
 
+#include "core/frame_arena.h"
 #include "core/simulation_state.h"
 #include "render/camera.h"
 #include "gui/style.h"
@@ -35,11 +35,12 @@ void RotorPanel::draw(SimulationState& state, Camera& camera) {
     const ui::Palette& palette = ui::Colors();
     const ui::FontSet& fonts = ui::Fonts();
 
+    const std::size_t rotor_count = std::min(state.vehicle_config.rotor_count, state.rotor.rpm.size());
     float rpm_sum = 0.0f;
-    for (double rpm : state.rotor.rpm) {
-        rpm_sum += static_cast<float>(rpm);
+    for (std::size_t i = 0; i < rotor_count; ++i) {
+        rpm_sum += static_cast<float>(state.rotor.rpm[i]);
     }
-    float avg_rpm = state.rotor.rpm.empty() ? 0.0f : rpm_sum / static_cast<float>(state.rotor.rpm.size());
+    float avg_rpm = rotor_count == 0 ? 0.0f : rpm_sum / static_cast<float>(rotor_count);
 
     static float previous_avg = 0.0f;
     float delta_percent = 0.0f;
@@ -75,10 +76,21 @@ void RotorPanel::draw(SimulationState& state, Camera& camera) {
     std::snprintf(power_value, sizeof(power_value), "%.0f W", state.rotor.total_power_watt);
     ui::ValueChip("Total Power", power_value, ui::ChipConfig{140.0f});
 
+    // Motor/ESC lag: one slider drives every rotor's time constant
+    ImGui::Dummy(ImVec2(0.0f, 6.0f));
+    ImGui::Checkbox("Motor lag", &state.motor_config.lag_enabled);
+    if (state.motor_config.lag_enabled) {
+        ImGui::SameLine(0.0f, 10.0f);
+        float tau_ms = static_cast<float>(state.motor_config.time_constant_s[0] * 1000.0);
+        ImGui::SetNextItemWidth(140.0f);
+        if (ImGui::SliderFloat("##motor_tau", &tau_ms, 1.0f, 200.0f, "tau %.0f ms", ImGuiSliderFlags_Logarithmic)) {
+            state.motor_config.time_constant_s.fill(static_cast<double>(tau_ms) / 1000.0);
+        }
+    }
+
     ImGui::Dummy(ImVec2(0.0f, 12.0f));
 
     ImVec2 chart_origin = ImGui::GetCursorScreenPos();
-    std::size_t rotor_count = state.rotor.rpm.size();
     float chart_width = rotor_count == 0
                             ? 0.0f
                             : rotor_count * kColumnWidth + (rotor_count - 1) * kColumnSpacing;
@@ -118,9 +130,9 @@ void RotorPanel::draw(SimulationState& state, Camera& camera) {
         draw_list->AddRectFilled(rpm_min, rpm_max, ImGui::ColorConvertFloat4ToU32(palette.accent_base), 8.0f);
         draw_list->AddRectFilled(thrust_min, thrust_max, ImGui::ColorConvertFloat4ToU32(palette.success), 8.0f);
 
-        std::string label = "R" + std::to_string(i + 1);
+        const char* label = frameArena().format("R%zu", i + 1);
         ImVec2 label_pos = ImVec2(column_offset, chart_origin.y + kChartHeight + 10.0f);
-        draw_list->AddText(label_pos, ImGui::ColorConvertFloat4ToU32(palette.text_muted), label.c_str());
+        draw_list->AddText(label_pos, ImGui::ColorConvertFloat4ToU32(palette.text_muted), label);
 
         char rpm_label[32];
         std::snprintf(rpm_label, sizeof(rpm_label), "%.0f", rpm);
@@ -1,5 +1,6 @@
 #include "gui/panels/sensor_panel.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdio>
@@ -59,15 +60,18 @@ void VectorRow(const char* label,
 template <typename Array>
 void ArrayRow(const char* label,
               const Array& values,
+              std::size_t count,
               const char* units,
               float warning_threshold) {
+    constexpr std::size_t kChipsPerLine = 4;
     const ui::Palette& palette = ui::Colors();
     ImGui::PushStyleColor(ImGuiCol_Text, palette.text_muted);
     ImGui::TextUnformatted(label);
     ImGui::PopStyleColor();
     ImGui::Dummy(ImVec2(0.0f, 4.0f));
 
-    for (std::size_t i = 0; i < values.size(); ++i) {
+    count = std::min(count, values.size());
+    for (std::size_t i = 0; i < count; ++i) {
         float value = static_cast<float>(values[i]);
         char buffer[48];
         std::snprintf(buffer, sizeof(buffer), "%.2f %s", value, units);
@@ -79,7 +83,7 @@ void ArrayRow(const char* label,
         char label_buffer[16];
         std::snprintf(label_buffer, sizeof(label_buffer), "R%zu", i + 1);
         ui::ValueChip(label_buffer, buffer, config);
-        if (i + 1 < values.size()) {
+        if (i + 1 < count && (i + 1) % kChipsPerLine != 0) {
             ImGui::SameLine(0.0f, 8.0f);
         }
     }
@@ -104,8 +108,9 @@ void SensorPanel::draw(SimulationState& state, Camera& camera) {
 
     VectorRow("Gyroscope", state.sensor.gyro_rad_s, "rad/s", 1.2f);
     VectorRow("Accelerometer", state.sensor.accel_mps2, "m/s^2", 9.0f);
-    ArrayRow("Rotor Thrust", state.rotor.thrust_newton, "N", 6.0f);
-    ArrayRow("Rotor RPM", state.rotor.rpm, "RPM", 1800.0f);
+    const std::size_t rotor_count = state.vehicle_config.rotor_count;
+    ArrayRow("Rotor Thrust", state.rotor.thrust_newton, rotor_count, "N", 6.0f);
+    ArrayRow("Rotor RPM", state.rotor.rpm, rotor_count, "RPM", 1800.0f);
 
     ImVec2 callout_origin = ImGui::GetCursorScreenPos();
     float callout_radius = 26.0f;
@@ -1,5 +1,6 @@
 #include "gui/panels/telemetry_panel.h"
 
+#include "core/frame_arena.h"
 #include "core/simulation_state.h"
 #include "render/camera.h"
 #include "attitude/attitude_utils.h"
@@ -22,18 +23,18 @@ void TelemetryPanel::draw(SimulationState& state, Camera& camera) {
             ImGui::TextUnformatted("Body rates (deg/s)");
             ImGui::TableNextColumn();
             ImGui::Text("Roll %.1f  Pitch %.1f  Yaw %.1f",
-                        state.angular_rate_deg_per_sec.x,
-                        state.angular_rate_deg_per_sec.y,
-                        state.angular_rate_deg_per_sec.z);
+                        rad2deg(state.angular_rate_rad_s.x),
+                        rad2deg(state.angular_rate_rad_s.y),
+                        rad2deg(state.angular_rate_rad_s.z));
 
             ImGui::TableNextRow();
             ImGui::TableNextColumn();
             ImGui::TextUnformatted("Orientation (deg)");
             ImGui::TableNextColumn();
             ImGui::Text("Roll %.1f  Pitch %.1f  Yaw %.1f",
-                        rad2deg(state.euler.roll),
-                        rad2deg(state.euler.pitch),
-                        rad2deg(state.euler.yaw));
+                        rad2deg(state.euler().roll),
+                        rad2deg(state.euler().pitch),
+                        rad2deg(state.euler().yaw));
 
             ImGui::TableNextRow();
             ImGui::TableNextColumn();
@@ -66,7 +67,7 @@ void TelemetryPanel::draw(SimulationState& state, Camera& camera) {
             };
 
             auto plot_quaternion_component = [&](const char* label, int index, const ImVec4& color) {
-                std::vector<float> values;
+                ArenaVector<float> values;
                 values.reserve(history.size());
                 for (const auto& sample : history) {
                     values.push_back(static_cast<float>(sample.quaternion[index]));
@@ -97,7 +98,7 @@ void TelemetryPanel::draw(SimulationState& state, Camera& camera) {
             };
 
             auto plot_euler_component = [&](const char* label, auto getter, const ImVec4& color) {
-                std::vector<float> values;
+                ArenaVector<float> values;
                 values.reserve(history.size());
                 for (const auto& sample : history) {
                     values.push_back(static_cast<float>(rad2deg(getter(sample))));
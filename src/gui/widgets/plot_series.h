@@ -0,0 +1,42 @@
+/**
+ * @file plot_series.h
+ * @brief Conversion of sample histories into the flat x/y arrays ImPlot draws
+ */
+
+#ifndef GUI_WIDGETS_PLOT_SERIES_H
+#define GUI_WIDGETS_PLOT_SERIES_H
+
+#include <deque>
+#include <vector>
+
+namespace ui {
+
+/**
+ * @brief Copy timestamps and extracted values of samples into x_data / y_data
+ *
+ * Kept free of ImGui/ImPlot so the data preparation behind every plotted
+ * line can be measured headless.
+ *
+ * @tparam T Sample type (must have 'timestamp' member)
+ * @param samples Data samples (oldest first)
+ * @param value_getter Function to extract Y value from sample: [](const T& s) -> double
+ * @param x_data Receives the timestamps (previous contents discarded); any std::vector<double>
+ * @param y_data Receives the values (previous contents discarded)
+ */
+template<typename T, typename Alloc, typename ValueGetter, typename Buffer>
+void ExtractSeries(const std::deque<T, Alloc>& samples, ValueGetter value_getter,
+                   Buffer& x_data, Buffer& y_data) {
+    x_data.clear();
+    y_data.clear();
+    x_data.reserve(samples.size());
+    y_data.reserve(samples.size());
+
+    for (const auto& sample : samples) {
+        x_data.push_back(sample.timestamp);
+        y_data.push_back(value_getter(sample));
+    }
+}
+
+} // namespace ui
+
+#endif // GUI_WIDGETS_PLOT_SERIES_H
@@ -11,6 +11,9 @@
 #include <vector>
 #include <deque>
 
+#include "core/frame_arena.h"
+#include "gui/widgets/plot_series.h"
+
 namespace ui {
 
 /**
@@ -39,19 +42,13 @@ struct PlotConfig {
  * @param value_getter Function to extract Y value from sample: [](const T& s) -> double
  * @param color Optional line color (nullptr = auto)
  */
-template<typename T, typename ValueGetter>
-void PlotLine(const char* label, const std::deque<T>& samples, ValueGetter value_getter, const ImVec4* color = nullptr) {
+template<typename T, typename Alloc, typename ValueGetter>
+void PlotLine(const char* label, const std::deque<T, Alloc>& samples, ValueGetter value_getter, const ImVec4* color = nullptr) {
     if (samples.empty()) return;
 
-    // Extract data into temporary buffers
-    std::vector<double> x_data, y_data;
-    x_data.reserve(samples.size());
-    y_data.reserve(samples.size());
-
-    for (const auto& sample : samples) {
-        x_data.push_back(sample.timestamp);
-        y_data.push_back(value_getter(sample));
-    }
+    // Extract data into frame-arena buffers (no heap traffic once the arena is warm)
+    ArenaVector<double> x_data, y_data;
+    ExtractSeries(samples, value_getter, x_data, y_data);
 
     if (color) {
         ImPlot::PushStyleColor(ImPlotCol_Line, *color);
@@ -72,8 +69,8 @@ void PlotLine(const char* label, const std::deque<T>& samples, ValueGetter value
 /**
  * @brief Plot multiple lines with automatic colors
  */
-template<typename T>
-void PlotAttitudeAngles(const std::deque<T>& samples) {
+template<typename T, typename Alloc>
+void PlotAttitudeAngles(const std::deque<T, Alloc>& samples) {
     if (samples.empty()) return;
 
     // Define colors as static constants
@@ -132,8 +129,8 @@ inline void EndPlot() {
 /**
  * @brief Complete plot widget with frame
  */
-template<typename T, typename ValueGetter>
-void TimeSeriesPlot(const char* label, const std::deque<T>& samples, ValueGetter value_getter, const PlotConfig& config) {
+template<typename T, typename Alloc, typename ValueGetter>
+void TimeSeriesPlot(const char* label, const std::deque<T, Alloc>& samples, ValueGetter value_getter, const PlotConfig& config) {
     if (BeginPlot(config)) {
         PlotLine(label, samples, value_getter);
         EndPlot();
@@ -0,0 +1,89 @@
+/**
+ * @file shm_telemetry_layout.h
+ * @brief Binary layout of the shared-memory telemetry ring (shared by publisher and readers)
+ */
+
+#ifndef IPC_SHM_TELEMETRY_LAYOUT_H
+#define IPC_SHM_TELEMETRY_LAYOUT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The segment is one ShmTelemetryHeader followed by record_capacity
+ * ShmTelemetryRecord slots (a power of two). The publisher is the only
+ * writer; any number of readers map the segment read-only and keep their
+ * own cursor, so readers never write shared memory and never slow the
+ * publisher down.
+ *
+ * Record n lives in slot n & (record_capacity - 1) and is guarded by a
+ * per-slot seqlock: the publisher stores sequence = 2n + 1, the payload,
+ * then sequence = 2n + 2. A reader that wants record n accepts the payload
+ * only if it saw 2n + 2 both before and after reading it; anything larger
+ * means the publisher lapped it.
+ *
+ * Compatibility: readers must check magic and layout_major; layout_minor
+ * only grows with backwards-compatible additions (new fields at the end of
+ * the header, within header_bytes).
+ */
+namespace shm_telemetry {
+
+constexpr std::uint32_t kMagic = 0x4D544441;           ///< "ADTM" little-endian
+constexpr std::uint16_t kLayoutMajor = 1;
+constexpr std::uint16_t kLayoutMinor = 0;
+constexpr std::size_t kMaxChannels = 64;
+constexpr std::size_t kNameBytes = 48;
+constexpr std::size_t kUnitBytes = 16;
+constexpr const char* kDefaultName = "/aerodyn_telemetry";
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "shared-memory seqlocks need lock-free 64-bit atomics");
+
+struct ChannelInfo {
+    char name[kNameBytes];      ///< NUL-terminated, truncated if longer
+    char unit[kUnitBytes];
+};
+
+struct alignas(64) Header {
+    std::uint32_t magic;
+    std::uint16_t layout_major;
+    std::uint16_t layout_minor;
+    std::uint32_t header_bytes;                 ///< sizeof(Header) of the publisher
+    std::uint32_t record_bytes;                 ///< sizeof(Record) of the publisher
+    std::uint64_t record_capacity;              ///< Slots in the ring (power of two)
+    std::uint64_t session;                      ///< Changes when a publisher (re)creates the segment
+    std::atomic<std::uint32_t> ready;           ///< 1 once the header is filled in
+    std::atomic<std::uint32_t> closed;          ///< 1 after the publisher shut down cleanly
+    std::atomic<std::uint32_t> channel_count;   ///< Entries of channels[] that are valid
+    std::uint32_t reserved;
+    alignas(64) std::atomic<std::uint64_t> write_index;    ///< Records published so far
+    alignas(64) ChannelInfo channels[kMaxChannels];
+};
+
+/// One sample; 32 bytes, two per cache line
+struct Record {
+    std::atomic<std::uint64_t> sequence;        ///< Seqlock word (see file comment)
+    std::atomic<std::uint64_t> channel;
+    std::atomic<std::uint64_t> timestamp_bits;  ///< Simulation time (s), IEEE-754 bits
+    std::atomic<std::uint64_t> value_bits;
+};
+
+static_assert(sizeof(Record) == 32, "record layout is part of the format");
+
+/// Bytes of a segment holding `capacity` records
+constexpr std::size_t segmentBytes(std::size_t capacity) {
+    return sizeof(Header) + capacity * sizeof(Record);
+}
+
+inline Record* records(Header* header) {
+    return reinterpret_cast<Record*>(reinterpret_cast<unsigned char*>(header) + sizeof(Header));
+}
+
+inline const Record* records(const Header* header) {
+    return reinterpret_cast<const Record*>(reinterpret_cast<const unsigned char*>(header) + sizeof(Header));
+}
+
+}  // namespace shm_telemetry
+
+#endif // IPC_SHM_TELEMETRY_LAYOUT_H
@@ -0,0 +1,120 @@
+#include "ipc/shm_telemetry_publisher.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+std::uint64_t bits(double value) {
+    std::uint64_t out;
+    std::memcpy(&out, &value, sizeof(out));
+    return out;
+}
+
+void copyTruncated(char* dst, std::size_t size, const char* src) {
+    std::strncpy(dst, src ? src : "", size - 1);
+    dst[size - 1] = '\0';
+}
+
+}  // namespace
+
+bool ShmTelemetryPublisher::open(const char* name, std::size_t capacity) {
+    close();
+    std::size_t slots = 1;
+    while (slots < std::max<std::size_t>(capacity, 2)) {
+        slots <<= 1;
+    }
+
+    // Replace any segment a crashed run left behind; its readers keep their mapping.
+    ::shm_unlink(name);
+    const int fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        error_ = std::string("shm_open: ") + std::strerror(errno);
+        return false;
+    }
+    const std::size_t bytes = shm_telemetry::segmentBytes(slots);
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        error_ = std::string("ftruncate: ") + std::strerror(errno);
+        ::close(fd);
+        ::shm_unlink(name);
+        return false;
+    }
+    void* memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        error_ = std::string("mmap: ") + std::strerror(errno);
+        ::shm_unlink(name);
+        return false;
+    }
+
+    // The new segment is zero-filled: every slot starts at sequence 0 (never written).
+    header_ = new (memory) shm_telemetry::Header;
+    header_->magic = shm_telemetry::kMagic;
+    header_->layout_major = shm_telemetry::kLayoutMajor;
+    header_->layout_minor = shm_telemetry::kLayoutMinor;
+    header_->header_bytes = sizeof(shm_telemetry::Header);
+    header_->record_bytes = sizeof(shm_telemetry::Record);
+    header_->record_capacity = slots;
+    header_->session = static_cast<std::uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count()) ^ static_cast<std::uint64_t>(::getpid());
+    header_->closed.store(0, std::memory_order_relaxed);
+    header_->channel_count.store(0, std::memory_order_relaxed);
+    header_->write_index.store(0, std::memory_order_relaxed);
+    header_->ready.store(1, std::memory_order_release);
+
+    records_ = shm_telemetry::records(header_);
+    mapped_bytes_ = bytes;
+    mask_ = slots - 1;
+    next_ = 0;
+    name_ = name;
+    error_.clear();
+    return true;
+}
+
+void ShmTelemetryPublisher::close() {
+    if (!header_) {
+        return;
+    }
+    header_->closed.store(1, std::memory_order_release);
+    ::munmap(header_, mapped_bytes_);
+    ::shm_unlink(name_.c_str());
+    header_ = nullptr;
+    records_ = nullptr;
+    mapped_bytes_ = 0;
+}
+
+void ShmTelemetryPublisher::onChannel(std::size_t id, const char* name, const char* unit) {
+    if (!header_ || id >= shm_telemetry::kMaxChannels) {
+        return;
+    }
+    shm_telemetry::ChannelInfo& info = header_->channels[id];
+    copyTruncated(info.name, sizeof(info.name), name);
+    copyTruncated(info.unit, sizeof(info.unit), unit);
+    // Readers trust entries below channel_count; publish the strings first.
+    const auto count = static_cast<std::uint32_t>(id + 1);
+    if (header_->channel_count.load(std::memory_order_relaxed) < count) {
+        header_->channel_count.store(count, std::memory_order_release);
+    }
+}
+
+void ShmTelemetryPublisher::onSample(std::size_t id, double timestamp, double value) {
+    if (!header_) {
+        return;
+    }
+    const std::uint64_t n = next_++;
+    shm_telemetry::Record& record = records_[n & mask_];
+    record.sequence.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record.channel.store(id, std::memory_order_relaxed);
+    record.timestamp_bits.store(bits(timestamp), std::memory_order_relaxed);
+    record.value_bits.store(bits(value), std::memory_order_relaxed);
+    record.sequence.store(2 * n + 2, std::memory_order_release);
+    header_->write_index.store(n + 1, std::memory_order_release);
+}
@@ -0,0 +1,65 @@
+/**
+ * @file shm_telemetry_publisher.h
+ * @brief Publishes every telemetry sample into a POSIX shared-memory ring
+ */
+
+#ifndef IPC_SHM_TELEMETRY_PUBLISHER_H
+#define IPC_SHM_TELEMETRY_PUBLISHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "core/telemetry_channels.h"
+#include "ipc/shm_telemetry_layout.h"
+
+/**
+ * @class ShmTelemetryPublisher
+ * @brief Single producer of the shared-memory telemetry ring
+ *
+ * Attach it to SimulationState::telemetry with TelemetryChannels::addSink()
+ * and every record() lands in the ring as well: four atomic stores, no
+ * syscall, no allocation. Local processes read it with ShmTelemetryReader
+ * (see shm_telemetry_layout.h for the format). The segment is created by
+ * open() and unlinked by close(); readers that still have it mapped keep
+ * reading and see the closed flag.
+ */
+class ShmTelemetryPublisher : public TelemetrySink {
+public:
+    static constexpr std::size_t kDefaultCapacity = std::size_t{1} << 16;
+
+    ShmTelemetryPublisher() = default;
+    ~ShmTelemetryPublisher() override { close(); }
+
+    ShmTelemetryPublisher(const ShmTelemetryPublisher&) = delete;
+    ShmTelemetryPublisher& operator=(const ShmTelemetryPublisher&) = delete;
+
+    /**
+     * @brief Create (or replace) the segment
+     * @param name POSIX shared-memory name, starting with '/'
+     * @param capacity Records kept for readers; rounded up to a power of two
+     * @return false on failure; error() says why
+     */
+    bool open(const char* name = shm_telemetry::kDefaultName, std::size_t capacity = kDefaultCapacity);
+
+    /// Mark the ring closed, unmap and unlink it
+    void close();
+
+    bool isOpen() const { return header_ != nullptr; }
+    const std::string& error() const { return error_; }
+    std::uint64_t published() const { return next_; }
+
+    void onChannel(std::size_t id, const char* name, const char* unit) override;
+    void onSample(std::size_t id, double timestamp, double value) override;
+
+private:
+    shm_telemetry::Header* header_{nullptr};
+    shm_telemetry::Record* records_{nullptr};
+    std::size_t mapped_bytes_{0};
+    std::uint64_t mask_{0};
+    std::uint64_t next_{0};     ///< Index of the next record (only this process writes it)
+    std::string name_;
+    std::string error_;
+};
+
+#endif // IPC_SHM_TELEMETRY_PUBLISHER_H
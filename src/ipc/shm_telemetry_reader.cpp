@@ -0,0 +1,169 @@
+#include "ipc/shm_telemetry_reader.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+double fromBits(std::uint64_t bits) {
+    double out;
+    std::memcpy(&out, &bits, sizeof(out));
+    return out;
+}
+
+}  // namespace
+
+bool ShmTelemetryReader::attach(const char* name) {
+    detach();
+    const int fd = ::shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        error_ = std::string("shm_open: ") + std::strerror(errno);
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(shm_telemetry::Header)) {
+        error_ = "segment too small (publisher still starting?)";
+        ::close(fd);
+        return false;
+    }
+    const std::size_t bytes = static_cast<std::size_t>(info.st_size);
+    void* memory = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        error_ = std::string("mmap: ") + std::strerror(errno);
+        return false;
+    }
+
+    const auto* header = static_cast<const shm_telemetry::Header*>(memory);
+    const char* problem = nullptr;
+    if (header->ready.load(std::memory_order_acquire) != 1) {
+        problem = "segment not initialized yet";
+    } else if (header->magic != shm_telemetry::kMagic) {
+        problem = "not a telemetry segment";
+    } else if (header->layout_major != shm_telemetry::kLayoutMajor) {
+        problem = "incompatible layout version";
+    } else if (header->header_bytes < sizeof(shm_telemetry::Header) ||
+               header->record_bytes != sizeof(shm_telemetry::Record) ||
+               header->record_capacity == 0 ||
+               (header->record_capacity & (header->record_capacity - 1)) != 0 ||
+               bytes < header->header_bytes + header->record_capacity * header->record_bytes) {
+        problem = "inconsistent header";
+    }
+    if (problem) {
+        error_ = problem;
+        ::munmap(memory, bytes);
+        return false;
+    }
+
+    header_ = header;
+    records_ = reinterpret_cast<const shm_telemetry::Record*>(static_cast<const unsigned char*>(memory) +
+                                                              header->header_bytes);
+    mapped_bytes_ = bytes;
+    capacity_ = header->record_capacity;
+    const std::uint64_t head = header->write_index.load(std::memory_order_acquire);
+    cursor_ = head > capacity_ ? head - capacity_ : 0;
+    dropped_ = 0;
+    error_.clear();
+    return true;
+}
+
+void ShmTelemetryReader::detach() {
+    if (header_) {
+        ::munmap(const_cast<shm_telemetry::Header*>(header_), mapped_bytes_);
+    }
+    header_ = nullptr;
+    records_ = nullptr;
+    mapped_bytes_ = 0;
+}
+
+std::size_t ShmTelemetryReader::channelCount() const {
+    if (!header_) {
+        return 0;
+    }
+    const std::size_t count = header_->channel_count.load(std::memory_order_acquire);
+    return count < shm_telemetry::kMaxChannels ? count : shm_telemetry::kMaxChannels;
+}
+
+const char* ShmTelemetryReader::channelName(std::size_t channel) const {
+    return channel < channelCount() ? header_->channels[channel].name : "";
+}
+
+const char* ShmTelemetryReader::channelUnit(std::size_t channel) const {
+    return channel < channelCount() ? header_->channels[channel].unit : "";
+}
+
+std::size_t ShmTelemetryReader::findChannel(const char* name) const {
+    const std::size_t count = channelCount();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (std::strncmp(header_->channels[i].name, name, shm_telemetry::kNameBytes) == 0) {
+            return i;
+        }
+    }
+    return count;
+}
+
+std::size_t ShmTelemetryReader::read(Sample* out, std::size_t max) {
+    if (!header_) {
+        return 0;
+    }
+    std::uint64_t head = header_->write_index.load(std::memory_order_acquire);
+    if (head - cursor_ > capacity_) {
+        skipLapped(head);
+    }
+    const std::uint64_t mask = capacity_ - 1;
+    std::size_t count = 0;
+    while (count < max && cursor_ < head) {
+        const shm_telemetry::Record& record = records_[cursor_ & mask];
+        const std::uint64_t expected = 2 * cursor_ + 2;
+        if (record.sequence.load(std::memory_order_acquire) == expected) {
+            const std::uint64_t channel = record.channel.load(std::memory_order_relaxed);
+            const std::uint64_t timestamp = record.timestamp_bits.load(std::memory_order_relaxed);
+            const std::uint64_t value = record.value_bits.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (record.sequence.load(std::memory_order_relaxed) == expected) {
+                out[count++] = Sample{static_cast<std::uint32_t>(channel), fromBits(timestamp), fromBits(value)};
+                ++cursor_;
+                continue;
+            }
+        }
+        // Record cursor_ was published (cursor_ < head) and is gone: lapped mid-read.
+        head = header_->write_index.load(std::memory_order_acquire);
+        skipLapped(head);
+    }
+    return count;
+}
+
+void ShmTelemetryReader::skipLapped(std::uint64_t head) {
+    // Land an eighth of the ring behind the writer so the next reads are not lapped again at once.
+    if (head < capacity_) {
+        return;
+    }
+    const std::uint64_t target = head - capacity_ + capacity_ / 8;
+    if (target > cursor_) {
+        dropped_ += target - cursor_;
+        cursor_ = target;
+    }
+}
+
+void ShmTelemetryReader::skipToLatest() {
+    if (header_) {
+        cursor_ = header_->write_index.load(std::memory_order_acquire);
+    }
+}
+
+std::uint64_t ShmTelemetryReader::available() const {
+    return header_ ? header_->write_index.load(std::memory_order_acquire) - cursor_ : 0;
+}
+
+std::uint64_t ShmTelemetryReader::session() const {
+    return header_ ? header_->session : 0;
+}
+
+bool ShmTelemetryReader::publisherClosed() const {
+    return header_ && header_->closed.load(std::memory_order_acquire) == 1;
+}
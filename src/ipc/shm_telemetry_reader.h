@@ -0,0 +1,95 @@
+/**
+ * @file shm_telemetry_reader.h
+ * @brief Client library for the shared-memory telemetry ring
+ */
+
+#ifndef IPC_SHM_TELEMETRY_READER_H
+#define IPC_SHM_TELEMETRY_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ipc/shm_telemetry_layout.h"
+
+/**
+ * @class ShmTelemetryReader
+ * @brief One consumer of the ring published by ShmTelemetryPublisher
+ *
+ * attach() maps the segment read-only; after that read() copies samples
+ * straight out of shared memory, with no syscall and no deserialization.
+ * Each reader keeps its own cursor, so any number of processes (or
+ * threads, one reader object each) can consume the same ring.
+ *
+ * A reader that falls more than the ring capacity behind loses the oldest
+ * samples; read() skips ahead and counts them in dropped(). It never
+ * returns a torn sample.
+ *
+ * @code
+ * ShmTelemetryReader reader;
+ * if (reader.attach()) {
+ *     ShmTelemetryReader::Sample batch[256];
+ *     const std::size_t n = reader.read(batch, 256);
+ *     // batch[i].channel indexes reader.channelName(...)
+ * }
+ * @endcode
+ */
+class ShmTelemetryReader {
+public:
+    struct Sample {
+        std::uint32_t channel;
+        double timestamp;   ///< Simulation time (s)
+        double value;
+    };
+
+    ShmTelemetryReader() = default;
+    ~ShmTelemetryReader() { detach(); }
+
+    ShmTelemetryReader(const ShmTelemetryReader&) = delete;
+    ShmTelemetryReader& operator=(const ShmTelemetryReader&) = delete;
+
+    /**
+     * @brief Map a published segment; reading starts at the oldest retained sample
+     * @return false if it does not exist yet or has an incompatible layout; error() says why
+     */
+    bool attach(const char* name = shm_telemetry::kDefaultName);
+    void detach();
+
+    bool attached() const { return header_ != nullptr; }
+    const std::string& error() const { return error_; }
+
+    /// Channels registered so far (grows while the publisher runs)
+    std::size_t channelCount() const;
+    const char* channelName(std::size_t channel) const;
+    const char* channelUnit(std::size_t channel) const;
+    /// Channel index for a name, or channelCount() if absent
+    std::size_t findChannel(const char* name) const;
+
+    /**
+     * @brief Copy up to max unread samples, oldest first
+     * @return Samples copied; 0 when caught up
+     */
+    std::size_t read(Sample* out, std::size_t max);
+
+    /// Skip everything published so far; the next read() returns only new samples
+    void skipToLatest();
+
+    std::uint64_t position() const { return cursor_; }      ///< Index of the next record to read
+    std::uint64_t available() const;                        ///< Records published but not yet read
+    std::uint64_t dropped() const { return dropped_; }      ///< Records lost to being lapped
+    std::uint64_t session() const;
+    bool publisherClosed() const;
+
+private:
+    const shm_telemetry::Header* header_{nullptr};
+    const shm_telemetry::Record* records_{nullptr};
+    std::size_t mapped_bytes_{0};
+    std::uint64_t capacity_{0};
+    std::uint64_t cursor_{0};
+    std::uint64_t dropped_{0};
+    std::string error_;
+
+    void skipLapped(std::uint64_t head);
+};
+
+#endif // IPC_SHM_TELEMETRY_READER_H
@@ -0,0 +1,84 @@
+/**
+ * @file sitl_layout.h
+ * @brief Binary layout of the lockstep SITL exchange segment (shared by simulator and controller)
+ */
+
+#ifndef IPC_SITL_LAYOUT_H
+#define IPC_SITL_LAYOUT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The segment holds two single-slot mailboxes, each on its own cache
+ * lines: sensors (simulator → controller) and commands (controller →
+ * simulator). Exchange n is strictly alternating:
+ *
+ *   1. The simulator stores sensor_seq = 2n - 1, fills `sensors` with
+ *      frame = n, then stores sensor_seq = 2n (release).
+ *   2. The controller sees an even sensor_seq it has not answered
+ *      (acquire), copies the frame and accepts it if sensor_seq did not
+ *      change meanwhile, fills `commands` with frame = n, then stores
+ *      command_seq = n.
+ *   3. The simulator sees command_seq == n and applies the commands.
+ *
+ * In lockstep each side writes a mailbox only while the other is waiting
+ * for it. The odd/even sensor word covers the one exception: after a
+ * timeout the simulator may overwrite a frame the controller is still
+ * copying, and the controller then retries. A reply to a frame the
+ * simulator already gave up on carries a stale number and is ignored.
+ *
+ * Compatibility: both sides check magic, layout_major and segment_bytes;
+ * any change to the mailboxes bumps layout_major.
+ */
+namespace sitl {
+
+constexpr std::uint32_t kMagic = 0x4C544953;        ///< "SITL" little-endian
+constexpr std::uint16_t kLayoutMajor = 1;
+constexpr std::uint16_t kLayoutMinor = 0;
+constexpr std::size_t kMaxRotors = 8;
+constexpr const char* kDefaultName = "/aerodyn_sitl";
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "cross-process handshakes need lock-free 64-bit atomics");
+
+/// Simulator → controller, once per controller period
+struct SensorFrame {
+    std::uint64_t frame;                    ///< Exchange number (starts at 1)
+    double time_s;                          ///< Simulation time of the sample (s)
+    double dt_s;                            ///< Controller period (s)
+    double gyro_rad_s[3];                   ///< IMU rate, body frame
+    double accel_mps2[3];                   ///< IMU specific force, body frame
+    double quaternion[4];                   ///< True attitude [w, x, y, z] (body → NED)
+    double angular_rate_rad_s[3];           ///< True body rates
+    double position_ned_m[3];
+    double velocity_ned_mps[3];
+    double trim_omega_rad_s[kMaxRotors];    ///< Hover speeds solved by the plant
+    std::uint32_t rotor_count;
+    std::uint32_t reserved;
+};
+
+/// Controller → simulator, answering the SensorFrame with the same number
+struct MotorCommand {
+    std::uint64_t frame;
+    double omega_rad_s[kMaxRotors];         ///< Commanded rotor speeds (rad/s)
+};
+
+struct alignas(64) Segment {
+    std::uint32_t magic;
+    std::uint16_t layout_major;
+    std::uint16_t layout_minor;
+    std::uint32_t segment_bytes;                    ///< sizeof(Segment) of the simulator
+    std::atomic<std::uint32_t> ready;               ///< 1 once the header is filled in
+    std::atomic<std::uint32_t> closed;              ///< 1 after the simulator shut down
+    std::atomic<std::uint32_t> controllers;         ///< Attached controllers (diagnostic)
+    alignas(64) std::atomic<std::uint64_t> sensor_seq;     ///< 2n once frame n is complete
+    SensorFrame sensors;
+    alignas(64) std::atomic<std::uint64_t> command_seq;    ///< n once frame n is answered
+    MotorCommand commands;
+};
+
+}  // namespace sitl
+
+#endif // IPC_SITL_LAYOUT_H
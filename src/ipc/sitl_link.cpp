@@ -0,0 +1,215 @@
+#include "ipc/sitl_link.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief Poll `done` until it holds, the peer closed, or the timeout passed
+ *
+ * Spins first, then yields; the clock is read only every 64 yields.
+ */
+template <typename Done>
+SitlLink::Wait pollUntil(Done done, const std::atomic<std::uint32_t>* closed, double timeout_s,
+                         std::uint32_t spin_iterations) {
+    for (std::uint32_t i = 0; i < spin_iterations; ++i) {
+        if (done()) {
+            return SitlLink::Wait::Ready;
+        }
+        cpuRelax();
+    }
+    const bool forever = !(timeout_s > 0.0);
+    const Clock::time_point deadline =
+        forever ? Clock::time_point::max()
+                : Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeout_s));
+    for (std::uint32_t i = 0;; ++i) {
+        if (done()) {
+            return SitlLink::Wait::Ready;
+        }
+        if (closed && closed->load(std::memory_order_acquire) == 1) {
+            return SitlLink::Wait::Closed;
+        }
+        if ((i & 63) == 63 && !forever && Clock::now() >= deadline) {
+            return SitlLink::Wait::Timeout;
+        }
+        ::sched_yield();
+    }
+}
+
+}  // namespace
+
+std::uint32_t SitlLink::defaultSpinIterations() {
+    // Spinning only helps when the peer runs on another core meanwhile.
+    return std::thread::hardware_concurrency() > 1 ? 20000 : 0;
+}
+
+bool SitlLink::create(const char* name) {
+    close();
+    // Replace a segment a crashed run left behind; an attached controller sees it closed.
+    ::shm_unlink(name);
+    const int fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        error_ = std::string("shm_open: ") + std::strerror(errno);
+        return false;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(sizeof(sitl::Segment))) != 0) {
+        error_ = std::string("ftruncate: ") + std::strerror(errno);
+        ::close(fd);
+        ::shm_unlink(name);
+        return false;
+    }
+    void* memory = ::mmap(nullptr, sizeof(sitl::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        error_ = std::string("mmap: ") + std::strerror(errno);
+        ::shm_unlink(name);
+        return false;
+    }
+
+    segment_ = new (memory) sitl::Segment;
+    segment_->magic = sitl::kMagic;
+    segment_->layout_major = sitl::kLayoutMajor;
+    segment_->layout_minor = sitl::kLayoutMinor;
+    segment_->segment_bytes = sizeof(sitl::Segment);
+    segment_->closed.store(0, std::memory_order_relaxed);
+    segment_->controllers.store(0, std::memory_order_relaxed);
+    segment_->sensor_seq.store(0, std::memory_order_relaxed);
+    segment_->command_seq.store(0, std::memory_order_relaxed);
+    segment_->ready.store(1, std::memory_order_release);
+
+    creator_ = true;
+    frame_ = 0;
+    name_ = name;
+    error_.clear();
+    return true;
+}
+
+bool SitlLink::attach(const char* name) {
+    close();
+    const int fd = ::shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        error_ = std::string("shm_open: ") + std::strerror(errno);
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) != sizeof(sitl::Segment)) {
+        error_ = "segment size mismatch (simulator still starting, or another layout)";
+        ::close(fd);
+        return false;
+    }
+    void* memory = ::mmap(nullptr, sizeof(sitl::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        error_ = std::string("mmap: ") + std::strerror(errno);
+        return false;
+    }
+
+    auto* segment = static_cast<sitl::Segment*>(memory);
+    const char* problem = nullptr;
+    if (segment->ready.load(std::memory_order_acquire) != 1) {
+        problem = "segment not initialized yet";
+    } else if (segment->magic != sitl::kMagic) {
+        problem = "not a SITL segment";
+    } else if (segment->layout_major != sitl::kLayoutMajor || segment->segment_bytes != sizeof(sitl::Segment)) {
+        problem = "incompatible layout version";
+    } else if (segment->closed.load(std::memory_order_acquire) == 1) {
+        problem = "simulator already closed the segment";
+    }
+    if (problem) {
+        error_ = problem;
+        ::munmap(memory, sizeof(sitl::Segment));
+        return false;
+    }
+
+    segment_ = segment;
+    segment_->controllers.fetch_add(1, std::memory_order_relaxed);
+    creator_ = false;
+    // A frame published before we attached is still waiting for its answer.
+    frame_ = segment_->command_seq.load(std::memory_order_acquire);
+    name_ = name;
+    error_.clear();
+    return true;
+}
+
+void SitlLink::close() {
+    if (!segment_) {
+        return;
+    }
+    if (creator_) {
+        segment_->closed.store(1, std::memory_order_release);
+    } else {
+        segment_->controllers.fetch_sub(1, std::memory_order_relaxed);
+    }
+    ::munmap(segment_, sizeof(sitl::Segment));
+    if (creator_) {
+        ::shm_unlink(name_.c_str());
+    }
+    segment_ = nullptr;
+    creator_ = false;
+}
+
+SitlLink::Wait SitlLink::exchange(sitl::SensorFrame& sensors, sitl::MotorCommand& commands, double timeout_s) {
+    const std::uint64_t n = ++frame_;
+    sensors.frame = n;
+    segment_->sensor_seq.store(2 * n - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    segment_->sensors = sensors;
+    segment_->sensor_seq.store(2 * n, std::memory_order_release);
+
+    const auto& answered = segment_->command_seq;
+    const Wait result = pollUntil([&] { return answered.load(std::memory_order_acquire) == n; }, nullptr,
+                                  timeout_s, spin_iterations_);
+    if (result == Wait::Ready) {
+        commands = segment_->commands;
+    }
+    return result;
+}
+
+SitlLink::Wait SitlLink::waitSensors(sitl::SensorFrame& sensors, double timeout_s) {
+    const auto& published = segment_->sensor_seq;
+    for (;;) {
+        std::uint64_t seq = 0;
+        const Wait result = pollUntil(
+            [&] {
+                seq = published.load(std::memory_order_acquire);
+                return seq != 0 && seq % 2 == 0 && seq / 2 != frame_;
+            },
+            &segment_->closed, timeout_s, spin_iterations_);
+        if (result != Wait::Ready) {
+            return result;
+        }
+        sensors = segment_->sensors;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (published.load(std::memory_order_relaxed) == seq) {
+            frame_ = seq / 2;
+            return Wait::Ready;
+        }
+        // Overwritten while copying: the simulator gave up on that frame.
+    }
+}
+
+void SitlLink::sendCommands(sitl::MotorCommand& commands) {
+    commands.frame = frame_;
+    segment_->commands = commands;
+    segment_->command_seq.store(frame_, std::memory_order_release);
+}
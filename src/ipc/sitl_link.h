@@ -0,0 +1,93 @@
+/**
+ * @file sitl_link.h
+ * @brief Lockstep sensor/command exchange with an external flight-controller process
+ */
+
+#ifndef IPC_SITL_LINK_H
+#define IPC_SITL_LINK_H
+
+#include <cstdint>
+#include <string>
+
+#include "ipc/sitl_layout.h"
+
+/**
+ * @class SitlLink
+ * @brief One end of the shared-memory SITL mailbox pair (see sitl_layout.h)
+ *
+ * The simulator create()s the segment and calls exchange() once per
+ * controller period; the controller attach()es, then loops over
+ * waitSensors() / sendCommands(). Both waits poll the sequence word: first
+ * a short busy spin, which keeps a round trip in the low microseconds when
+ * each side has a core, then sched_yield() so a single-core machine hands
+ * the CPU straight to the peer. No syscall is made while spinning.
+ *
+ * A timeout of zero or less waits for ever (strict lockstep, e.g. headless
+ * runs); a wait also ends when the peer side closed the segment.
+ */
+class SitlLink {
+public:
+    enum class Wait {
+        Ready,      ///< The awaited frame arrived
+        Timeout,
+        Closed      ///< The simulator shut down (controller side only)
+    };
+
+    SitlLink() = default;
+    ~SitlLink() { close(); }
+
+    SitlLink(const SitlLink&) = delete;
+    SitlLink& operator=(const SitlLink&) = delete;
+
+    /**
+     * @brief Simulator side: create (or replace) the segment
+     * @return false on failure; error() says why
+     */
+    bool create(const char* name = sitl::kDefaultName);
+
+    /**
+     * @brief Controller side: map a segment the simulator created
+     * @return false if it does not exist yet or has an incompatible layout
+     */
+    bool attach(const char* name = sitl::kDefaultName);
+
+    /// Detach; the creating side also marks the segment closed and unlinks it
+    void close();
+
+    bool isOpen() const { return segment_ != nullptr; }
+    bool isCreator() const { return creator_; }
+    const std::string& error() const { return error_; }
+
+    /// Busy-poll iterations before yielding (default: 0 on a single core)
+    void setSpinIterations(std::uint32_t iterations) { spin_iterations_ = iterations; }
+
+    /**
+     * @brief Simulator side: publish the next sensor frame and wait for its commands
+     * @param sensors Frame to send; its frame number is assigned here
+     * @param commands Filled with the controller's answer when Ready
+     */
+    Wait exchange(sitl::SensorFrame& sensors, sitl::MotorCommand& commands, double timeout_s);
+
+    /**
+     * @brief Controller side: wait for a sensor frame not answered yet
+     */
+    Wait waitSensors(sitl::SensorFrame& sensors, double timeout_s);
+
+    /// Controller side: answer the frame last returned by waitSensors()
+    void sendCommands(sitl::MotorCommand& commands);
+
+    /// Exchanges started (simulator) or frames received (controller)
+    std::uint64_t frame() const { return frame_; }
+
+private:
+    sitl::Segment* segment_{nullptr};
+    bool creator_{false};
+    std::uint64_t frame_{0};
+    std::uint32_t spin_iterations_{defaultSpinIterations()};
+    std::string name_;
+    std::string error_;
+
+    static std::uint32_t defaultSpinIterations();
+};
+
+#endif // IPC_SITL_LINK_H
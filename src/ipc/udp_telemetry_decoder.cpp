@@ -0,0 +1,129 @@
+#include "ipc/udp_telemetry_decoder.h"
+
+#include <algorithm>
+
+namespace {
+
+const std::string kUnknown;
+
+}  // namespace
+
+UdpTelemetryDecoder::Result UdpTelemetryDecoder::decode(const void* datagram, std::size_t size,
+                                                        std::vector<Sample>& samples) {
+    using namespace udp_telemetry;
+    const auto* bytes = static_cast<const unsigned char*>(datagram);
+    if (size < kHeaderBytes || getU32(bytes) != kMagic) {
+        return Result::Invalid;
+    }
+    if (bytes[4] != kFormatMajor) {
+        return Result::Incompatible;
+    }
+    const auto kind = static_cast<Kind>(bytes[6]);
+    const std::uint32_t session = getU32(bytes + 8);
+    const std::uint32_t sequence = getU32(bytes + 12);
+    const unsigned char* body = bytes + kHeaderBytes;
+    const std::size_t body_size = size - kHeaderBytes;
+
+    if (kind == Kind::Data) {
+        if (body_size < kDataPrefixBytes) {
+            return Result::Invalid;
+        }
+        const double base_time = getF64(body);
+        const std::size_t count = getU16(body + 8);
+        if (body_size < kDataPrefixBytes + count * kSampleBytes) {
+            return Result::Invalid;
+        }
+        track(session, sequence);
+        const unsigned char* in = body + kDataPrefixBytes;
+        for (std::size_t i = 0; i < count; ++i, in += kSampleBytes) {
+            samples.push_back(Sample{getU16(in), base_time + getF32(in + 2), getF32(in + 6)});
+        }
+        return Result::Data;
+    }
+
+    if (kind == Kind::Channels) {
+        if (body_size < 2) {
+            return Result::Invalid;
+        }
+        // Validate the whole table before touching ours.
+        const std::size_t count = getU16(body);
+        std::size_t offset = 2;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (offset + 3 > body_size) {
+                return Result::Invalid;
+            }
+            const std::size_t name_len = body[offset + 2];
+            if (offset + 3 + name_len + 1 > body_size) {
+                return Result::Invalid;
+            }
+            const std::size_t unit_len = body[offset + 3 + name_len];
+            offset += 4 + name_len + unit_len;
+            if (offset > body_size) {
+                return Result::Invalid;
+            }
+        }
+        track(session, sequence);
+        offset = 2;
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t id = getU16(body + offset);
+            const std::size_t name_len = body[offset + 2];
+            const std::size_t unit_len = body[offset + 3 + name_len];
+            if (id < kMaxChannels) {
+                names_[id].assign(reinterpret_cast<const char*>(body + offset + 3), name_len);
+                units_[id].assign(reinterpret_cast<const char*>(body + offset + 4 + name_len), unit_len);
+                channel_count_ = std::max(channel_count_, id + 1);
+            }
+            offset += 4 + name_len + unit_len;
+        }
+        return Result::Channels;
+    }
+
+    track(session, sequence);
+    return Result::Ignored;
+}
+
+void UdpTelemetryDecoder::track(std::uint32_t session, std::uint32_t sequence) {
+    if (!has_session_ || session != session_) {
+        // A restarted streamer numbers channels afresh.
+        has_session_ = true;
+        session_ = session;
+        for (std::size_t i = 0; i < channel_count_; ++i) {
+            names_[i].clear();
+            units_[i].clear();
+        }
+        channel_count_ = 0;
+        datagrams_ = 0;
+        lost_ = 0;
+        late_ = 0;
+        next_sequence_ = sequence;
+    }
+    ++datagrams_;
+    const auto ahead = static_cast<std::int32_t>(sequence - next_sequence_);
+    if (ahead >= 0) {
+        lost_ += static_cast<std::uint32_t>(ahead);
+        next_sequence_ = sequence + 1;
+    } else {
+        // Counted as lost when it was skipped; it turned up after all.
+        ++late_;
+        if (lost_ > 0) {
+            --lost_;
+        }
+    }
+}
+
+const std::string& UdpTelemetryDecoder::channelName(std::size_t channel) const {
+    return channel < channel_count_ ? names_[channel] : kUnknown;
+}
+
+const std::string& UdpTelemetryDecoder::channelUnit(std::size_t channel) const {
+    return channel < channel_count_ ? units_[channel] : kUnknown;
+}
+
+std::size_t UdpTelemetryDecoder::findChannel(const std::string& name) const {
+    for (std::size_t i = 0; i < channel_count_; ++i) {
+        if (names_[i] == name) {
+            return i;
+        }
+    }
+    return channel_count_;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file udp_telemetry_decoder.h
+ * @brief Client library for the UDP telemetry stream
+ */
+
+#ifndef IPC_UDP_TELEMETRY_DECODER_H
+#define IPC_UDP_TELEMETRY_DECODER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ipc/udp_telemetry_format.h"
+
+/**
+ * @class UdpTelemetryDecoder
+ * @brief Turns received datagrams back into channel names and samples
+ *
+ * Transport-agnostic: feed it every datagram from whatever socket (or
+ * capture file) the consumer reads. It learns channel names from the
+ * periodic channel tables, tracks the datagram sequence to report losses,
+ * and starts over when the streamer session changes.
+ *
+ * @code
+ * UdpTelemetryDecoder decoder;
+ * std::vector<UdpTelemetryDecoder::Sample> samples;
+ * const ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+ * decoder.decode(buffer, n, samples);
+ * // samples[i].channel indexes decoder.channelName(...)
+ * @endcode
+ */
+class UdpTelemetryDecoder {
+public:
+    struct Sample {
+        std::uint16_t channel;
+        double timestamp;   ///< Simulation time (s)
+        double value;
+    };
+
+    enum class Result {
+        Data,           ///< Samples appended
+        Channels,       ///< Channel table updated
+        Ignored,        ///< Well-formed, but a kind this decoder does not know
+        Invalid,        ///< Not a telemetry datagram, or truncated
+        Incompatible    ///< Another major format version
+    };
+
+    /**
+     * @brief Decode one datagram; Data appends to samples (nothing is cleared)
+     */
+    Result decode(const void* datagram, std::size_t size, std::vector<Sample>& samples);
+
+    /// One past the highest channel id named so far
+    std::size_t channelCount() const { return channel_count_; }
+    const std::string& channelName(std::size_t channel) const;
+    const std::string& channelUnit(std::size_t channel) const;
+    /// Channel id for a name, or channelCount() if unknown
+    std::size_t findChannel(const std::string& name) const;
+
+    std::uint32_t session() const { return session_; }
+    std::uint64_t datagrams() const { return datagrams_; }  ///< Accepted in this session
+    std::uint64_t lost() const { return lost_; }            ///< Sequence gaps in this session
+    std::uint64_t late() const { return late_; }            ///< Arrived after a later one
+
+private:
+    std::array<std::string, udp_telemetry::kMaxChannels> names_;
+    std::array<std::string, udp_telemetry::kMaxChannels> units_;
+    std::size_t channel_count_{0};
+    bool has_session_{false};
+    std::uint32_t session_{0};
+    std::uint32_t next_sequence_{0};
+    std::uint64_t datagrams_{0};
+    std::uint64_t lost_{0};
+    std::uint64_t late_{0};
+
+    void track(std::uint32_t session, std::uint32_t sequence);
+};
+
+#endif // IPC_UDP_TELEMETRY_DECODER_H
@@ -0,0 +1,120 @@
+/**
+ * @file udp_telemetry_format.h
+ * @brief Wire format of the UDP telemetry stream (shared by streamer and decoder)
+ */
+
+#ifndef IPC_UDP_TELEMETRY_FORMAT_H
+#define IPC_UDP_TELEMETRY_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Every datagram starts with a 16-byte header; all fields are little-endian:
+ *
+ *   u32 magic | u8 major | u8 minor | u8 kind | u8 flags | u32 session | u32 sequence
+ *
+ * `sequence` counts datagrams of the session, so a receiver sees losses and
+ * reordering; `session` changes whenever the streamer is restarted.
+ *
+ * Kind::Data carries a batch of samples sharing one time base:
+ *
+ *   f64 base_time_s | u16 count | count × (u16 channel | f32 dt_s | f32 value)
+ *
+ * with timestamp = base_time_s + dt_s (10 bytes per sample, so a 1200-byte
+ * datagram holds 117 samples). Values travel as float: plenty for plots,
+ * not for bit-exact logging (use the shared-memory ring for that).
+ *
+ * Kind::Channels maps channel ids to names, resent periodically so a
+ * receiver that joins late catches up:
+ *
+ *   u16 count | count × (u16 channel | u8 name_len | name | u8 unit_len | unit)
+ *
+ * Compatibility: decoders reject another major; minor only grows with
+ * additions a decoder may ignore (new kinds, trailing bytes).
+ */
+namespace udp_telemetry {
+
+constexpr std::uint32_t kMagic = 0x55544441;    ///< "ADTU" little-endian
+constexpr std::uint8_t kFormatMajor = 1;
+constexpr std::uint8_t kFormatMinor = 0;
+constexpr std::size_t kHeaderBytes = 16;
+constexpr std::size_t kDataPrefixBytes = 10;    ///< base time + count
+constexpr std::size_t kSampleBytes = 10;
+constexpr std::size_t kMaxDatagramBytes = 1472; ///< Ethernet MTU minus IPv4/UDP headers
+constexpr std::size_t kMaxChannels = 64;
+
+enum class Kind : std::uint8_t {
+    Data = 1,
+    Channels = 2
+};
+
+// Little-endian field access, byte by byte: independent of host byte order and alignment.
+
+inline void putU16(unsigned char* out, std::uint16_t value) {
+    out[0] = static_cast<unsigned char>(value);
+    out[1] = static_cast<unsigned char>(value >> 8);
+}
+
+inline void putU32(unsigned char* out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+inline void putU64(unsigned char* out, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+inline void putF32(unsigned char* out, float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32(out, bits);
+}
+
+inline void putF64(unsigned char* out, double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU64(out, bits);
+}
+
+inline std::uint16_t getU16(const unsigned char* in) {
+    return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+}
+
+inline std::uint32_t getU32(const unsigned char* in) {
+    std::uint32_t value = 0;
+    for (int i = 3; i >= 0; --i) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+inline std::uint64_t getU64(const unsigned char* in) {
+    std::uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+inline float getF32(const unsigned char* in) {
+    const std::uint32_t bits = getU32(in);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline double getF64(const unsigned char* in) {
+    const std::uint64_t bits = getU64(in);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+}  // namespace udp_telemetry
+
+#endif // IPC_UDP_TELEMETRY_FORMAT_H
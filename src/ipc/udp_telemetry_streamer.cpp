@@ -0,0 +1,252 @@
+#include "ipc/udp_telemetry_streamer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Sender poll period while the queue is empty
+constexpr auto kIdleSleep = std::chrono::milliseconds(1);
+/// Samples whose rate-limit slot is this close count as due (floating-point slack)
+constexpr double kIntervalSlackS = 1e-9;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+}  // namespace
+
+void UdpTelemetryStreamer::select(const char* name, double max_rate_hz) {
+    const double interval = max_rate_hz > 0.0 ? 1.0 / max_rate_hz : 0.0;
+    auto existing = std::find_if(selections_.begin(), selections_.end(),
+                                 [&](const Selection& selection) { return selection.name == name; });
+    if (existing != selections_.end()) {
+        existing->interval_s = interval;
+    } else {
+        selections_.push_back(Selection{name, interval});
+    }
+    const std::size_t count = channel_count_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; ++i) {
+        applySelection(channels_[i]);
+    }
+}
+
+void UdpTelemetryStreamer::applySelection(Channel& channel) const {
+    if (selections_.empty()) {
+        channel.selected = true;
+        channel.interval_s = 0.0;
+        return;
+    }
+    channel.selected = false;
+    for (const Selection& selection : selections_) {
+        if (selection.name == channel.name) {
+            channel.selected = true;
+            channel.interval_s = selection.interval_s;
+        }
+    }
+}
+
+bool UdpTelemetryStreamer::start(const char* host, std::uint16_t port, const Settings& settings) {
+    stop();
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (::inet_pton(AF_INET, host, &address.sin_addr) != 1) {
+        error_ = std::string("not an IPv4 address: ") + host;
+        return false;
+    }
+    socket_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (socket_ < 0) {
+        error_ = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+    if (::connect(socket_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        error_ = std::string("connect: ") + std::strerror(errno);
+        ::close(socket_);
+        socket_ = -1;
+        return false;
+    }
+
+    settings_ = settings;
+    settings_.max_datagram_bytes = std::clamp<std::size_t>(
+        settings.max_datagram_bytes,
+        udp_telemetry::kHeaderBytes + udp_telemetry::kDataPrefixBytes + udp_telemetry::kSampleBytes,
+        udp_telemetry::kMaxDatagramBytes);
+    queue_.reset(settings.queue_capacity);
+    session_ = static_cast<std::uint32_t>(Clock::now().time_since_epoch().count()) ^
+               static_cast<std::uint32_t>(::getpid());
+    sequence_ = 0;
+    stop_.store(false, std::memory_order_relaxed);
+    error_.clear();
+    sender_ = std::thread([this] { run(); });
+    return true;
+}
+
+void UdpTelemetryStreamer::stop() {
+    if (sender_.joinable()) {
+        stop_.store(true, std::memory_order_release);
+        sender_.join();
+    }
+    if (socket_ >= 0) {
+        ::close(socket_);
+        socket_ = -1;
+    }
+}
+
+void UdpTelemetryStreamer::onChannel(std::size_t id, const char* name, const char* unit) {
+    if (id >= udp_telemetry::kMaxChannels) {
+        return;
+    }
+    Channel& channel = channels_[id];
+    channel.name = name;
+    channel.unit = unit;
+    channel.sent_any = false;
+    applySelection(channel);
+    if (channel_count_.load(std::memory_order_relaxed) < id + 1) {
+        channel_count_.store(id + 1, std::memory_order_release);
+    }
+}
+
+void UdpTelemetryStreamer::onSample(std::size_t id, double timestamp, double value) {
+    if (id >= udp_telemetry::kMaxChannels || !running()) {
+        return;
+    }
+    Channel& channel = channels_[id];
+    if (!channel.selected) {
+        return;
+    }
+    // A rewind moves time backwards: restart the rate limit there.
+    if (channel.sent_any && timestamp >= channel.last_sent_s &&
+        timestamp - channel.last_sent_s < channel.interval_s - kIntervalSlackS) {
+        return;
+    }
+    if (!queue_.tryPush(Item{static_cast<std::uint32_t>(id), timestamp, value})) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    channel.last_sent_s = timestamp;
+    channel.sent_any = true;
+}
+
+void UdpTelemetryStreamer::writeHeader(unsigned char* out, udp_telemetry::Kind kind) {
+    udp_telemetry::putU32(out, udp_telemetry::kMagic);
+    out[4] = udp_telemetry::kFormatMajor;
+    out[5] = udp_telemetry::kFormatMinor;
+    out[6] = static_cast<unsigned char>(kind);
+    out[7] = 0;
+    udp_telemetry::putU32(out + 8, session_);
+    udp_telemetry::putU32(out + 12, sequence_++);
+}
+
+void UdpTelemetryStreamer::sendDatagram(const unsigned char* bytes, std::size_t size) {
+    // A refused or full socket only costs this datagram; the stream goes on.
+    if (::send(socket_, bytes, size, 0) == static_cast<ssize_t>(size)) {
+        datagrams_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        send_errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void UdpTelemetryStreamer::announceChannels() {
+    unsigned char datagram[udp_telemetry::kMaxDatagramBytes];
+    const std::size_t count = channel_count_.load(std::memory_order_acquire);
+    std::size_t next = 0;
+    while (next < count) {
+        // Header, count, then as many whole entries as fit.
+        std::size_t size = udp_telemetry::kHeaderBytes + 2;
+        std::uint16_t entries = 0;
+        for (; next < count; ++next) {
+            const Channel& channel = channels_[next];
+            if (!channel.name) {
+                continue;
+            }
+            const std::size_t name_len = std::min<std::size_t>(std::strlen(channel.name), 255);
+            const std::size_t unit_len = std::min<std::size_t>(std::strlen(channel.unit ? channel.unit : ""), 255);
+            const std::size_t entry = 2 + 1 + name_len + 1 + unit_len;
+            if (size + entry > settings_.max_datagram_bytes && entries > 0) {
+                break;
+            }
+            unsigned char* out = datagram + size;
+            udp_telemetry::putU16(out, static_cast<std::uint16_t>(next));
+            out[2] = static_cast<unsigned char>(name_len);
+            std::memcpy(out + 3, channel.name, name_len);
+            out[3 + name_len] = static_cast<unsigned char>(unit_len);
+            std::memcpy(out + 4 + name_len, channel.unit ? channel.unit : "", unit_len);
+            size += entry;
+            ++entries;
+        }
+        if (entries == 0) {
+            break;
+        }
+        writeHeader(datagram, udp_telemetry::Kind::Channels);
+        udp_telemetry::putU16(datagram + udp_telemetry::kHeaderBytes, entries);
+        sendDatagram(datagram, size);
+    }
+}
+
+void UdpTelemetryStreamer::run() {
+    using namespace udp_telemetry;
+    unsigned char datagram[kMaxDatagramBytes];
+    const std::size_t per_datagram =
+        (settings_.max_datagram_bytes - kHeaderBytes - kDataPrefixBytes) / kSampleBytes;
+    std::size_t batched = 0;
+    double base_time = 0.0;
+    Clock::time_point batch_start{};
+    std::size_t announced = 0;
+    Clock::time_point last_announce{};
+
+    auto flush = [&] {
+        writeHeader(datagram, Kind::Data);
+        putF64(datagram + kHeaderBytes, base_time);
+        putU16(datagram + kHeaderBytes + 8, static_cast<std::uint16_t>(batched));
+        sendDatagram(datagram, kHeaderBytes + kDataPrefixBytes + batched * kSampleBytes);
+        samples_.fetch_add(batched, std::memory_order_relaxed);
+        batched = 0;
+    };
+
+    for (;;) {
+        const bool stopping = stop_.load(std::memory_order_acquire);
+        // Announce new channels before any of their samples, and periodically for late joiners.
+        const std::size_t channels = channel_count_.load(std::memory_order_acquire);
+        if (channels != announced || secondsSince(last_announce) >= settings_.announce_interval_s) {
+            announceChannels();
+            announced = channels;
+            last_announce = Clock::now();
+        }
+
+        bool popped = false;
+        Item item;
+        while (queue_.tryPop(item)) {
+            popped = true;
+            if (batched == 0) {
+                base_time = item.timestamp;
+                batch_start = Clock::now();
+            }
+            unsigned char* out = datagram + kHeaderBytes + kDataPrefixBytes + batched * kSampleBytes;
+            putU16(out, static_cast<std::uint16_t>(item.channel));
+            putF32(out + 2, static_cast<float>(item.timestamp - base_time));
+            putF32(out + 6, static_cast<float>(item.value));
+            if (++batched == per_datagram) {
+                flush();
+            }
+        }
+        if (batched > 0 && (stopping || secondsSince(batch_start) >= settings_.flush_interval_s)) {
+            flush();
+        }
+        if (stopping) {
+            return;     // The producer stopped before asking us to: the queue is drained
+        }
+        if (!popped) {
+            std::this_thread::sleep_for(kIdleSleep);
+        }
+    }
+}
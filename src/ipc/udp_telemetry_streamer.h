@@ -0,0 +1,129 @@
+/**
+ * @file udp_telemetry_streamer.h
+ * @brief Batched, rate-limited telemetry stream over UDP for remote dashboards
+ */
+
+#ifndef IPC_UDP_TELEMETRY_STREAMER_H
+#define IPC_UDP_TELEMETRY_STREAMER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/spsc_queue.h"
+#include "core/telemetry_channels.h"
+#include "ipc/udp_telemetry_format.h"
+
+/**
+ * @class UdpTelemetryStreamer
+ * @brief Sends selected telemetry channels to one UDP endpoint
+ *
+ * Attach it to SimulationState::telemetry with TelemetryChannels::addSink().
+ * On the recording (simulation) thread onSample() only applies the
+ * channel's selection and rate limit and pushes the sample into a
+ * lock-free queue; if the queue is full the sample is counted as dropped.
+ * A sender thread packs queued samples into datagrams of up to
+ * Settings::max_datagram_bytes, sends each one when it is full or its
+ * oldest sample has waited flush_interval_s, and repeats the channel table
+ * every announce_interval_s (format: udp_telemetry_format.h; decode with
+ * UdpTelemetryDecoder).
+ *
+ * Rate limits are in simulation time, so a faster-than-real-time run
+ * streams proportionally more per wall second.
+ */
+class UdpTelemetryStreamer : public TelemetrySink {
+public:
+    struct Settings {
+        std::size_t max_datagram_bytes{1200};   ///< Datagram size cap (safe below common MTUs)
+        double flush_interval_s{0.02};          ///< Longest a sample waits for its batch (wall time)
+        double announce_interval_s{1.0};        ///< Channel table repeat period (wall time)
+        std::size_t queue_capacity{16384};      ///< Samples buffered between the two threads
+    };
+
+    UdpTelemetryStreamer() = default;
+    ~UdpTelemetryStreamer() override { stop(); }
+
+    UdpTelemetryStreamer(const UdpTelemetryStreamer&) = delete;
+    UdpTelemetryStreamer& operator=(const UdpTelemetryStreamer&) = delete;
+
+    /**
+     * @brief Stream a channel, at most max_rate_hz samples per simulated second (0 = every sample)
+     *
+     * Without any select() call every channel is streamed at full rate.
+     * Call on the recording thread.
+     */
+    void select(const char* name, double max_rate_hz = 0.0);
+
+    /**
+     * @brief Open the socket and start the sender thread
+     * @param host IPv4 address (dotted quad)
+     * @return false on failure; error() says why
+     */
+    bool start(const char* host, std::uint16_t port, const Settings& settings);
+    bool start(const char* host, std::uint16_t port) { return start(host, port, Settings{}); }
+
+    /// Send what is queued, then stop the thread and close the socket
+    void stop();
+
+    bool running() const { return sender_.joinable(); }
+    const std::string& error() const { return error_; }
+
+    std::uint64_t datagramsSent() const { return datagrams_.load(std::memory_order_relaxed); }
+    std::uint64_t samplesSent() const { return samples_.load(std::memory_order_relaxed); }
+    std::uint64_t samplesDropped() const { return dropped_.load(std::memory_order_relaxed); }  ///< Queue was full
+    std::uint64_t sendErrors() const { return send_errors_.load(std::memory_order_relaxed); }
+
+    void onChannel(std::size_t id, const char* name, const char* unit) override;
+    void onSample(std::size_t id, double timestamp, double value) override;
+
+private:
+    struct Item {
+        std::uint32_t channel;
+        double timestamp;
+        double value;
+    };
+
+    struct Selection {
+        std::string name;
+        double interval_s;
+    };
+
+    /// Written by the recording thread; name/unit are read by the sender below channel_count_
+    struct Channel {
+        const char* name{nullptr};
+        const char* unit{nullptr};
+        bool selected{false};
+        double interval_s{0.0};     ///< Minimum simulated time between streamed samples
+        double last_sent_s{0.0};
+        bool sent_any{false};
+    };
+
+    std::vector<Selection> selections_;
+    std::array<Channel, udp_telemetry::kMaxChannels> channels_{};
+    std::atomic<std::size_t> channel_count_{0};
+    SpscQueue<Item> queue_;
+    Settings settings_;
+    std::thread sender_;
+    std::atomic<bool> stop_{false};
+    int socket_{-1};
+    std::uint32_t session_{0};
+    std::uint32_t sequence_{0};
+    std::string error_;
+
+    std::atomic<std::uint64_t> datagrams_{0};
+    std::atomic<std::uint64_t> samples_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> send_errors_{0};
+
+    void applySelection(Channel& channel) const;
+    void run();
+    void writeHeader(unsigned char* out, udp_telemetry::Kind kind);
+    void sendDatagram(const unsigned char* bytes, std::size_t size);
+    void announceChannels();
+};
+
+#endif // IPC_UDP_TELEMETRY_STREAMER_H
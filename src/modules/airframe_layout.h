@@ -0,0 +1,123 @@
+/**
+ * @file airframe_layout.h
+ * @brief Compile-time rotor geometry tables for supported multirotor airframes
+ */
+
+#ifndef MODULES_AIRFRAME_LAYOUT_H
+#define MODULES_AIRFRAME_LAYOUT_H
+
+#include <array>
+#include <cstddef>
+
+#include "core/simulation_state.h"
+
+/**
+ * @struct RotorPlacement
+ * @brief One rotor of a layout: unit arm direction in the body XY plane and spin sense
+ *
+ * Body frame is FRD (x forward, y right, z down). Multiply the arm direction
+ * by VehicleConfig::arm_length to get the rotor hub position. direction = +1
+ * and -1 alternate around the frame so reaction torques cancel in hover.
+ */
+struct RotorPlacement {
+    double arm_x;      ///< Forward component of the unit arm vector
+    double arm_y;      ///< Right component of the unit arm vector
+    double direction;  ///< Spin sense (+1 CW, -1 CCW)
+};
+
+namespace airframe_detail {
+constexpr double kCos22 = 0.92387953251128674;  // cos(22.5 deg)
+constexpr double kSin22 = 0.38268343236508978;  // sin(22.5 deg)
+constexpr double kCos30 = 0.86602540378443865;  // cos(30 deg)
+constexpr double kSqrtHalf = 0.70710678118654752;
+}  // namespace airframe_detail
+
+/**
+ * @struct QuadXLayout
+ * @brief Quadcopter, arms at 45 deg to the body axes (front-right first, counter-clockwise)
+ */
+struct QuadXLayout {
+    static constexpr SimulationState::Airframe kAirframe = SimulationState::Airframe::QuadX;
+    static constexpr std::size_t kRotorCount = 4;
+    static constexpr const char* kName = "Quad X";
+    static constexpr std::array<RotorPlacement, kRotorCount> kRotors{{
+        {airframe_detail::kSqrtHalf, airframe_detail::kSqrtHalf, 1.0},    // Front-right
+        {airframe_detail::kSqrtHalf, -airframe_detail::kSqrtHalf, -1.0},  // Front-left
+        {-airframe_detail::kSqrtHalf, -airframe_detail::kSqrtHalf, 1.0},  // Back-left
+        {-airframe_detail::kSqrtHalf, airframe_detail::kSqrtHalf, -1.0},  // Back-right
+    }};
+};
+
+/**
+ * @struct QuadPlusLayout
+ * @brief Quadcopter, arms along the body axes (front first, counter-clockwise)
+ */
+struct QuadPlusLayout {
+    static constexpr SimulationState::Airframe kAirframe = SimulationState::Airframe::QuadPlus;
+    static constexpr std::size_t kRotorCount = 4;
+    static constexpr const char* kName = "Quad +";
+    static constexpr std::array<RotorPlacement, kRotorCount> kRotors{{
+        {1.0, 0.0, 1.0},    // Front
+        {0.0, -1.0, -1.0},  // Left
+        {-1.0, 0.0, 1.0},   // Back
+        {0.0, 1.0, -1.0},   // Right
+    }};
+};
+
+/**
+ * @struct HexXLayout
+ * @brief Hexacopter, arms every 60 deg starting at 30 deg (front-right first, counter-clockwise)
+ */
+struct HexXLayout {
+    static constexpr SimulationState::Airframe kAirframe = SimulationState::Airframe::HexX;
+    static constexpr std::size_t kRotorCount = 6;
+    static constexpr const char* kName = "Hex X";
+    static constexpr std::array<RotorPlacement, kRotorCount> kRotors{{
+        {airframe_detail::kCos30, 0.5, 1.0},     //  30 deg
+        {airframe_detail::kCos30, -0.5, -1.0},   // -30 deg
+        {0.0, -1.0, 1.0},                        // -90 deg
+        {-airframe_detail::kCos30, -0.5, -1.0},  // -150 deg
+        {-airframe_detail::kCos30, 0.5, 1.0},    // 150 deg
+        {0.0, 1.0, -1.0},                        //  90 deg
+    }};
+};
+
+/**
+ * @struct OctoXLayout
+ * @brief Octocopter, arms every 45 deg starting at 22.5 deg (front-right first, counter-clockwise)
+ */
+struct OctoXLayout {
+    static constexpr SimulationState::Airframe kAirframe = SimulationState::Airframe::OctoX;
+    static constexpr std::size_t kRotorCount = 8;
+    static constexpr const char* kName = "Octo X";
+    static constexpr std::array<RotorPlacement, kRotorCount> kRotors{{
+        {airframe_detail::kCos22, airframe_detail::kSin22, 1.0},     //  22.5 deg
+        {airframe_detail::kCos22, -airframe_detail::kSin22, -1.0},   // -22.5 deg
+        {airframe_detail::kSin22, -airframe_detail::kCos22, 1.0},    // -67.5 deg
+        {-airframe_detail::kSin22, -airframe_detail::kCos22, -1.0},  // -112.5 deg
+        {-airframe_detail::kCos22, -airframe_detail::kSin22, 1.0},   // -157.5 deg
+        {-airframe_detail::kCos22, airframe_detail::kSin22, -1.0},   // 157.5 deg
+        {-airframe_detail::kSin22, airframe_detail::kCos22, 1.0},    // 112.5 deg
+        {airframe_detail::kSin22, airframe_detail::kCos22, -1.0},    //  67.5 deg
+    }};
+};
+
+/**
+ * @brief Invoke f with a default-constructed layout tag for the given airframe
+ *
+ * Bridges the runtime airframe selection in SimulationState to the
+ * compile-time layout types, e.g. to instantiate the matching plant:
+ * `visitAirframe(airframe, [&](auto layout) { using L = decltype(layout); ... });`
+ */
+template <typename F>
+decltype(auto) visitAirframe(SimulationState::Airframe airframe, F&& f) {
+    switch (airframe) {
+        case SimulationState::Airframe::QuadPlus: return f(QuadPlusLayout{});
+        case SimulationState::Airframe::HexX:     return f(HexXLayout{});
+        case SimulationState::Airframe::OctoX:    return f(OctoXLayout{});
+        case SimulationState::Airframe::QuadX:
+        default:                                  return f(QuadXLayout{});
+    }
+}
+
+#endif // MODULES_AIRFRAME_LAYOUT_H
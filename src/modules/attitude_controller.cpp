@@ -0,0 +1,155 @@
+#include "modules/attitude_controller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/module_checkpoint.h"
+#include "core/quaternion_math.h"
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kMinTiltCosine = 0.5;  ///< Tilt compensation stops growing past 60 deg
+
+double sign(double value) {
+    return static_cast<double>((value > 0.0) - (value < 0.0));
+}
+
+}  // namespace
+
+template <typename Layout>
+void AttitudeControllerModule<Layout>::initialize(SimulationState& state) {
+    const double rate_hz = state.controller_config.rate_hz;
+    period_ = (std::isfinite(rate_hz) && rate_hz > 0.0) ? 1.0 / rate_hz : 0.0;
+    allocator_ready_ = false;
+    reset();
+    state.controller_state = SimulationState::ControllerState{};
+}
+
+template <typename Layout>
+void AttitudeControllerModule<Layout>::reset() {
+    integral_.fill(0.0);
+    derivative_.fill(0.0);
+    previous_rate_.fill(0.0);
+    last_output_.fill(0.0);
+    has_previous_ = false;
+}
+
+template <typename Layout>
+void AttitudeControllerModule<Layout>::configureAllocator(const SimulationState& state) {
+    allocator_ = ControlAllocator<kRotorCount>::template forVehicle<Layout>(state);
+    allocator_revision_ = state.vehicle_config.rotor_geometry_revision;
+    allocator_ready_ = true;
+}
+
+template <typename Layout>
+void AttitudeControllerModule<Layout>::update(double dt, SimulationState& state) {
+    const auto& config = state.controller_config;
+    auto& out = state.controller_state;
+    using Mode = SimulationState::ControllerConfig::Mode;
+
+    if ((config.mode != Mode::Rate && config.mode != Mode::Attitude) || !(dt > 0.0)) {
+        reset();
+        return;
+    }
+
+    if (!allocator_ready_ || allocator_revision_ != state.vehicle_config.rotor_geometry_revision) {
+        configureAllocator(state);
+    }
+    if (filter_dt_ != dt || filter_cutoff_hz_ != config.d_cutoff_hz) {
+        filter_weight_ = config.d_cutoff_hz > 0.0
+                             ? 1.0 - std::exp(-2.0 * kPi * config.d_cutoff_hz * dt)
+                             : 1.0;
+        filter_dt_ = dt;
+        filter_cutoff_hz_ = config.d_cutoff_hz;
+    }
+
+    const std::array<double, 4> q{state.quaternion[0], state.quaternion[1],
+                                  state.quaternion[2], state.quaternion[3]};
+    const std::array<double, 3> rate{state.angular_rate_rad_s.x,
+                                     state.angular_rate_rad_s.y,
+                                     state.angular_rate_rad_s.z};
+
+    // Outer loop: attitude error → body rate setpoint
+    std::array<double, 3> rate_sp{};
+    if (config.mode == Mode::Attitude) {
+        const auto& sp = state.controller_setpoint;
+        const std::array<double, 4> q_sp = quaternionFromEuler(sp.roll_rad, sp.pitch_rad, sp.yaw_rad);
+        const std::array<double, 4> q_err = quaternionMultiply({q[0], -q[1], -q[2], -q[3]}, q_sp);
+        const double shortest = q_err[0] < 0.0 ? -2.0 : 2.0;  // Rotate the short way round
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            rate_sp[axis] = config.attitude_kp[axis] * shortest * q_err[axis + 1];
+        }
+    } else {
+        const glm::dvec3& sp = state.controller_setpoint.rate_rad_s;
+        rate_sp = {sp.x, sp.y, sp.z};
+    }
+
+    // Inner loop: rate PID with D on measurement and conditional integration
+    const double inertia[3] = {state.vehicle_config.Ixx, state.vehicle_config.Iyy, state.vehicle_config.Izz};
+    std::array<double, 3> accel{};
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        rate_sp[axis] = std::clamp(rate_sp[axis], -config.max_rate_rad_s[axis], config.max_rate_rad_s[axis]);
+        const double error = rate_sp[axis] - rate[axis];
+
+        const double raw_derivative = has_previous_ ? -(rate[axis] - previous_rate_[axis]) / dt : 0.0;
+        derivative_[axis] += filter_weight_ * (raw_derivative - derivative_[axis]);
+        previous_rate_[axis] = rate[axis];
+
+        const double limit = config.max_accel_rad_s2[axis];
+        const double unclamped = config.rate_kp[axis] * error +
+                                 integral_[axis] +
+                                 config.rate_kd[axis] * derivative_[axis] +
+                                 config.rate_ff[axis] * rate_sp[axis];
+        accel[axis] = std::clamp(unclamped, -limit, limit);
+
+        const bool output_saturated = std::abs(unclamped) > limit && sign(error) == sign(unclamped);
+        const bool motors_saturated = out.saturated && sign(error) == sign(last_output_[axis]);
+        if (!output_saturated && !motors_saturated) {
+            const double bound = config.integral_limit_rad_s2[axis];
+            integral_[axis] = std::clamp(integral_[axis] + config.rate_ki[axis] * error * dt, -bound, bound);
+        }
+        last_output_[axis] = accel[axis];
+    }
+    has_previous_ = true;
+
+    const double torque[3] = {inertia[0] * accel[0], inertia[1] * accel[1], inertia[2] * accel[2]};
+
+    // Collective thrust, tilt-compensated so altitude holds while banked
+    double thrust = state.controller_setpoint.collective_thrust_newton;
+    if (!(thrust > 0.0)) {
+        const double tilt_cosine = 1.0 - 2.0 * (q[1] * q[1] + q[2] * q[2]);
+        thrust = state.vehicle_config.mass * state.vehicle_config.gravity /
+                 std::max(tilt_cosine, kMinTiltCosine);
+    }
+
+    // Allocation: wrench → rotor thrust within the motor limits → speed commands
+    const auto allocation = commandWrench(allocator_, {thrust, torque[0], torque[1], torque[2]}, state);
+
+    out.rate_setpoint_rad_s = glm::dvec3(rate_sp[0], rate_sp[1], rate_sp[2]);
+    out.rate_integral = glm::dvec3(integral_[0], integral_[1], integral_[2]);
+    out.accel_command_rad_s2 = glm::dvec3(accel[0], accel[1], accel[2]);
+    out.torque_command_nm = glm::dvec3(torque[0], torque[1], torque[2]);
+    out.thrust_command_newton = thrust;
+    out.saturated = allocation.saturated > 0;
+    ++out.updates;
+}
+
+template <typename Layout>
+void AttitudeControllerModule<Layout>::checkpoint(ModuleCheckpoint& archive) {
+    archive.io(integral_);
+    archive.io(derivative_);
+    archive.io(previous_rate_);
+    archive.io(last_output_);
+    archive.io(has_previous_);
+}
+
+template class AttitudeControllerModule<QuadXLayout>;
+template class AttitudeControllerModule<QuadPlusLayout>;
+template class AttitudeControllerModule<HexXLayout>;
+template class AttitudeControllerModule<OctoXLayout>;
+
+std::unique_ptr<Module> makeAttitudeControllerModule(SimulationState::Airframe airframe) {
+    return visitAirframe(airframe, [](auto layout) -> std::unique_ptr<Module> {
+        return std::make_unique<AttitudeControllerModule<decltype(layout)>>();
+    });
+}
@@ -0,0 +1,104 @@
+/**
+ * @file attitude_controller.h
+ * @brief Cascaded attitude/rate controller writing rotor speed commands
+ */
+
+#ifndef MODULES_ATTITUDE_CONTROLLER_H
+#define MODULES_ATTITUDE_CONTROLLER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "core/module.h"
+#include "core/simulation_state.h"
+#include "modules/airframe_layout.h"
+#include "modules/control_allocator.h"
+
+/**
+ * @class AttitudeControllerModule
+ * @brief Attitude P loop around a body-rate PID loop, followed by control allocation
+ *
+ * Structure (per axis, roll/pitch/yaw):
+ *
+ *   ω_sp = clamp(K_att · 2·vec(q⁻¹ ⊗ q_sp))                 (attitude mode)
+ *   α    = clamp(K_p e + K_i ∫e + K_d ḋ_f + K_ff ω_sp),     e = ω_sp - ω
+ *   τ    = I α
+ *
+ * - The derivative acts on the measured rate (no setpoint kick) and is
+ *   low-passed with an exactly discretized first-order filter.
+ * - Anti-windup: the integrator is clamped, and frozen whenever the rate
+ *   loop output or a motor is saturated in the direction the error pushes.
+ * - Collective thrust holds hover (m·g, tilt-compensated) unless a thrust
+ *   setpoint is given.
+ *
+ * A ControlAllocator maps [T, τx, τy, τz] to per-rotor thrust within the
+ * motor limits, using the rotor geometry the plant publishes in
+ * vehicle_config.rotors (its pseudo-inverse is rebuilt only when that
+ * geometry's revision changes); thrusts are then converted to speed
+ * commands. Everything is sized by the layout at compile time, so each
+ * update runs a bounded amount of work with no allocation.
+ *
+ * Runs at controller_config.rate_hz via period(); reads the true attitude
+ * and body rates from the state, writes motor_commands and controller_state.
+ *
+ * @tparam Layout Airframe geometry table (see airframe_layout.h)
+ */
+template <typename Layout>
+class AttitudeControllerModule : public Module {
+public:
+    static constexpr std::size_t kRotorCount = Layout::kRotorCount;
+    static_assert(kRotorCount <= SimulationState::kMaxRotors, "Layout exceeds SimulationState rotor arrays");
+
+    /**
+     * @brief Latch the loop rate and reset integrators and filters
+     * @param state Reference to simulation state
+     */
+    void initialize(SimulationState& state) override;
+
+    /**
+     * @brief Run one controller update
+     * @param dt Controller period (seconds)
+     * @param state Reference to simulation state (reads attitude, rates and
+     *              controller_config/setpoint, writes motor_commands and
+     *              controller_state)
+     */
+    void update(double dt, SimulationState& state) override;
+
+    const char* name() const override { return "Controller"; }
+
+    /// Saves the PID memories (integral, filtered derivative, previous rate)
+    void checkpoint(ModuleCheckpoint& archive) override;
+    double period() const override { return period_; }
+
+private:
+    double period_{0.002};                          ///< 1 / rate_hz latched at initialize
+    ControlAllocator<kRotorCount> allocator_;
+    bool allocator_ready_{false};
+    std::uint64_t allocator_revision_{0};           ///< Geometry revision the allocator was built from
+
+    std::array<double, 3> integral_{};              ///< K_i ∫e, clamped (rad/s²)
+    std::array<double, 3> derivative_{};            ///< Filtered -dω/dt (rad/s²)
+    std::array<double, 3> previous_rate_{};         ///< Measured rate at the last update
+    std::array<double, 3> last_output_{};           ///< Last rate loop output (anti-windup direction)
+    bool has_previous_{false};
+    double filter_dt_{-1.0};                        ///< dt and cutoff the filter weight was built for
+    double filter_cutoff_hz_{-1.0};
+    double filter_weight_{1.0};
+
+    void configureAllocator(const SimulationState& state);
+    void reset();
+};
+
+extern template class AttitudeControllerModule<QuadXLayout>;
+extern template class AttitudeControllerModule<QuadPlusLayout>;
+extern template class AttitudeControllerModule<HexXLayout>;
+extern template class AttitudeControllerModule<OctoXLayout>;
+
+/**
+ * @brief Create the controller instantiation matching a runtime airframe selection
+ */
+std::unique_ptr<Module> makeAttitudeControllerModule(SimulationState::Airframe airframe);
+
+#endif // MODULES_ATTITUDE_CONTROLLER_H
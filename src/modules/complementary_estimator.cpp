@@ -5,6 +5,7 @@
 #include "attitude/quaternion.h"
 #include "attitude/attitude_utils.h"
 #include "attitude/dcm.h"
+#include "core/module_checkpoint.h"
 #include "core/simulation_state.h"
 
 namespace {
@@ -22,6 +23,7 @@ void normalize_quaternion(std::array<double, 4>& q) {
 }
 
 void ComplementaryEstimatorModule::initialize(SimulationState& state) {
+    configure(state);
     q_est_ = state.quaternion;
     normalize_quaternion(q_est_);
     bias_ = glm::vec3(0.0f);
@@ -30,6 +32,11 @@ void ComplementaryEstimatorModule::initialize(SimulationState& state) {
     state.estimator.euler.order = EULER_ZYX;
 }
 
+void ComplementaryEstimatorModule::configure(SimulationState& state) {
+    kp_ = state.estimator_config.kp;
+    ki_ = state.estimator_config.ki;
+}
+
 void ComplementaryEstimatorModule::update(double dt, SimulationState& state) {
     if (dt <= 0.0f) {
         return;
@@ -97,3 +104,8 @@ void ComplementaryEstimatorModule::update(double dt, SimulationState& state) {
     quaternion_to_euler(q_est_.data(), &state.estimator.euler.roll, &state.estimator.euler.pitch, &state.estimator.euler.yaw);
     state.estimator.euler.order = EULER_ZYX;
 }
+
+void ComplementaryEstimatorModule::checkpoint(ModuleCheckpoint& archive) {
+    archive.io(q_est_);
+    archive.io(bias_);
+}
@@ -25,7 +25,7 @@
  * 2. Compute error quaternion from accelerometer-derived attitude
  * 3. Apply proportional-integral (PI) correction to quaternion and bias
  *
- * Tuning parameters:
+ * Tuning parameters (SimulationState::estimator_config):
  * - kp: Proportional gain (attitude correction speed)
  * - ki: Integral gain (bias estimation speed)
  *
@@ -50,21 +50,24 @@ public:
      */
     void update(double dt, SimulationState& state) override;
 
+    const char* name() const override { return "Estimator"; }
+
+    /// Saves the attitude estimate and gyro bias
+    void checkpoint(ModuleCheckpoint& archive) override;
+
+    /// Gains come from SimulationState::estimator_config
+    unsigned configSections() const override { return ConfigSection::kEstimator; }
+
     /**
-     * @brief Tune the complementary filter gains
-     * @param kp Proportional gain (higher = faster attitude correction)
-     * @param ki Integral gain (higher = faster bias estimation)
+     * @brief Take new gains from state.estimator_config, keeping the estimate and bias
      */
-    void setGains(float kp, float ki) {
-        kp_ = kp;
-        ki_ = ki;
-    }
+    void configure(SimulationState& state) override;
 
 private:
     std::array<double, 4> q_est_{1.0, 0.0, 0.0, 0.0}; ///< Estimated attitude quaternion [w, x, y, z]
     glm::vec3 bias_{0.0f};                            ///< Estimated gyroscope bias (rad/s)
-    float kp_{2.0f};                                  ///< Proportional gain
-    float ki_{0.05f};                                 ///< Integral gain
+    float kp_{2.0f};                                  ///< Proportional gain (latched from estimator_config)
+    float ki_{0.05f};                                 ///< Integral gain (latched from estimator_config)
 };
 
 #endif // COMPLEMENTARY_ESTIMATOR_H
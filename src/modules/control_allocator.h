@@ -0,0 +1,288 @@
+/**
+ * @file control_allocator.h
+ * @brief Maps a desired thrust/torque wrench onto per-rotor thrust
+ */
+
+#ifndef MODULES_CONTROL_ALLOCATOR_H
+#define MODULES_CONTROL_ALLOCATOR_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "core/simulation_state.h"
+#include "core/small_matrix.h"
+
+/**
+ * @class ControlAllocator
+ * @brief Pseudo-inverse control allocation with bounded saturation redistribution
+ *
+ * The effectiveness matrix B maps rotor thrusts F (N) to the wrench
+ * v = [T, τx, τy, τz] (collective thrust along body -Z, body torques):
+ *
+ *   v = B F,   column i = [-a_z, (r × a)_x + d c a_x, (r × a)_y + d c a_y, (r × a)_z + d c a_z]
+ *
+ * with rotor position r, thrust axis a, spin sense d and c = k_q / k_t.
+ * configure() caches the minimum-norm pseudo-inverse B⁺ = Bᵀ(BBᵀ)⁻¹, so the
+ * unsaturated case is one N×4 product.
+ *
+ * When rotors leave [lower, upper], allocate() redistributes: saturated
+ * rotors are pinned at their limit (worst first) and the remaining wrench is
+ * reallocated to the free rotors by weighted least squares. Each pass pins
+ * one rotor, so there are at most N passes of fixed-size work: the worst-case
+ * cost per control tick is constant. Axis weights decide what gives way
+ * when the wrench is infeasible (by default collective thrust and yaw yield
+ * before roll and pitch).
+ *
+ * All members are constexpr, so allocators for the standard airframes can
+ * be built at compile time with fromLayout().
+ *
+ * @tparam N Number of rotors
+ */
+template <std::size_t N>
+class ControlAllocator {
+public:
+    static constexpr std::size_t kAxes = 4;     ///< [T, τx, τy, τz]
+    using Wrench = SmallVector<kAxes>;
+    using RotorVector = SmallVector<N>;
+    using Effectiveness = SmallMatrix<kAxes, N>;
+    using Mixing = SmallMatrix<N, kAxes>;
+
+    /// Allocation outcome for diagnostics and anti-windup
+    struct Result {
+        std::size_t saturated{0};   ///< Rotors pinned at a limit
+        std::size_t passes{0};      ///< Redistribution passes used (0 = unsaturated)
+        double residual{0.0};       ///< Weighted wrench error ‖S(BF - v)‖² after allocation
+    };
+
+    constexpr ControlAllocator() = default;
+
+    /**
+     * @brief Effectiveness matrix from rotor geometry (first N entries used)
+     */
+    template <std::size_t M>
+    static constexpr Effectiveness effectiveness(const std::array<SimulationState::RotorGeometry, M>& rotors) {
+        static_assert(N <= M, "Geometry array shorter than rotor count");
+        Effectiveness b{};
+        for (std::size_t i = 0; i < N; ++i) {
+            const auto& rotor = rotors[i];
+            const auto& r = rotor.position_body_m;
+            const auto& a = rotor.axis_body;
+            const double c = rotor.thrust_coeff != 0.0 ? rotor.direction * rotor.torque_coeff / rotor.thrust_coeff : 0.0;
+            b.m[0][i] = -a[2];
+            b.m[1][i] = r[1] * a[2] - r[2] * a[1] + c * a[0];
+            b.m[2][i] = r[2] * a[0] - r[0] * a[2] + c * a[1];
+            b.m[3][i] = r[0] * a[1] - r[1] * a[0] + c * a[2];
+        }
+        return b;
+    }
+
+    /**
+     * @brief Allocator for a compile-time layout table (see airframe_layout.h)
+     *
+     * Rotors sit arm_length along each unit arm and thrust along body -Z.
+     */
+    template <typename Layout>
+    static constexpr ControlAllocator fromLayout(double arm_length, double thrust_coeff, double torque_coeff) {
+        static_assert(Layout::kRotorCount == N, "Layout rotor count does not match allocator size");
+        std::array<SimulationState::RotorGeometry, N> rotors{};
+        for (std::size_t i = 0; i < N; ++i) {
+            rotors[i].position_body_m = {arm_length * Layout::kRotors[i].arm_x,
+                                         arm_length * Layout::kRotors[i].arm_y, 0.0};
+            rotors[i].axis_body = {0.0, 0.0, -1.0};
+            rotors[i].direction = Layout::kRotors[i].direction;
+            rotors[i].thrust_coeff = thrust_coeff;
+            rotors[i].torque_coeff = torque_coeff;
+        }
+        ControlAllocator allocator;
+        allocator.configure(effectiveness(rotors));
+        return allocator;
+    }
+
+    /**
+     * @brief Allocator for the rotor geometry the plant published in the state
+     *
+     * Before the plant has published (revision 0) the nominal layout geometry
+     * is assumed, with the state's arm length and rotor coefficients.
+     */
+    template <typename Layout>
+    static ControlAllocator forVehicle(const SimulationState& state) {
+        const auto& vehicle = state.vehicle_config;
+        if (vehicle.rotor_geometry_revision == 0) {
+            return fromLayout<Layout>(vehicle.arm_length, state.rotor_config.thrust_coefficient,
+                                      state.rotor_config.torque_coefficient);
+        }
+        ControlAllocator allocator;
+        allocator.configure(effectiveness(vehicle.rotors));
+        return allocator;
+    }
+
+    /**
+     * @brief Cache B and its pseudo-inverse
+     * @return false if B does not have full row rank (some axis is uncontrollable)
+     */
+    constexpr bool configure(const Effectiveness& b) {
+        b_ = b;
+        SmallMatrix<kAxes, kAxes> gram_inverse{};
+        valid_ = invert(b * transpose(b), gram_inverse);
+        pinv_ = valid_ ? transpose(b) * gram_inverse : Mixing{};
+        return valid_;
+    }
+
+    /**
+     * @brief Relative importance of [T, τx, τy, τz] errors when saturated
+     *
+     * Weights are per unit of the axis (N or N·m); only their ratios matter.
+     */
+    constexpr void setAxisWeights(const Wrench& weights) { weights_ = weights; }
+
+    constexpr bool valid() const { return valid_; }
+    constexpr const Effectiveness& effectivenessMatrix() const { return b_; }
+    constexpr const Mixing& pseudoInverse() const { return pinv_; }
+
+    /**
+     * @brief Rotor thrusts realising (as closely as the limits allow) a wrench
+     * @param desired Wrench [T, τx, τy, τz] (N, N·m)
+     * @param lower Per-rotor minimum thrust (N)
+     * @param upper Per-rotor maximum thrust (N)
+     * @param thrust Output rotor thrusts, always within [lower, upper]
+     */
+    constexpr Result allocate(const Wrench& desired, const RotorVector& lower, const RotorVector& upper,
+                              RotorVector& thrust) const {
+        Result result;
+        thrust = pinv_ * desired;
+
+        std::array<bool, N> pinned{};
+        for (std::size_t pass = 0; pass < N; ++pass) {
+            // Pin the free rotor with the largest limit violation. Pinning one
+            // at a time lets the others move back inside once it is fixed.
+            std::size_t worst = N;
+            double worst_violation = 0.0;
+            for (std::size_t i = 0; i < N; ++i) {
+                if (pinned[i]) {
+                    continue;
+                }
+                const double violation = thrust[i] < lower[i] ? lower[i] - thrust[i]
+                                                              : thrust[i] - upper[i];
+                if (violation > worst_violation) {
+                    worst_violation = violation;
+                    worst = i;
+                }
+            }
+            if (worst == N) {
+                break;
+            }
+            thrust[worst] = thrust[worst] < lower[worst] ? lower[worst] : upper[worst];
+            pinned[worst] = true;
+            ++result.saturated;
+            result.passes = pass + 1;
+            if (result.saturated == N) {
+                break;
+            }
+
+            // Reallocate what the pinned rotors leave over to the free ones:
+            //   F_free = W Bsᵀ (Bs W Bsᵀ + λI)⁻¹ S (v - B F_pinned),   Bs = S B
+            Wrench remaining = desired;
+            for (std::size_t i = 0; i < N; ++i) {
+                if (pinned[i]) {
+                    for (std::size_t axis = 0; axis < kAxes; ++axis) {
+                        remaining[axis] -= b_.m[axis][i] * thrust[i];
+                    }
+                }
+            }
+            SmallMatrix<kAxes, kAxes> gram{};
+            double trace = 0.0;
+            for (std::size_t r = 0; r < kAxes; ++r) {
+                for (std::size_t c = 0; c < kAxes; ++c) {
+                    double sum = 0.0;
+                    for (std::size_t i = 0; i < N; ++i) {
+                        if (!pinned[i]) {
+                            sum += b_.m[r][i] * b_.m[c][i];
+                        }
+                    }
+                    gram.m[r][c] = weights_[r] * sum * weights_[c];
+                }
+                trace += gram.m[r][r];
+            }
+            // Fewer free rotors than axes leaves the Gram matrix singular; the
+            // small damping picks the least-squares solution instead.
+            const double damping = kRelativeDamping * (trace > 0.0 ? trace : 1.0);
+            for (std::size_t r = 0; r < kAxes; ++r) {
+                gram.m[r][r] += damping;
+            }
+            SmallMatrix<kAxes, kAxes> gram_inverse{};
+            if (!invert(gram, gram_inverse, 0.0)) {
+                break;
+            }
+            Wrench scaled{};
+            for (std::size_t axis = 0; axis < kAxes; ++axis) {
+                scaled[axis] = weights_[axis] * remaining[axis];
+            }
+            const Wrench multiplier = gram_inverse * scaled;
+            for (std::size_t i = 0; i < N; ++i) {
+                if (!pinned[i]) {
+                    double value = 0.0;
+                    for (std::size_t axis = 0; axis < kAxes; ++axis) {
+                        value += b_.m[axis][i] * weights_[axis] * multiplier[axis];
+                    }
+                    thrust[i] = value;
+                }
+            }
+        }
+
+        // Bounded passes: anything still outside after the last one is clipped.
+        for (std::size_t i = 0; i < N; ++i) {
+            thrust[i] = thrust[i] < lower[i] ? lower[i] : (thrust[i] > upper[i] ? upper[i] : thrust[i]);
+        }
+        const Wrench achieved = b_ * thrust;
+        for (std::size_t axis = 0; axis < kAxes; ++axis) {
+            const double error = weights_[axis] * (achieved[axis] - desired[axis]);
+            result.residual += error * error;
+        }
+        return result;
+    }
+
+private:
+    static constexpr double kRelativeDamping = 1e-9;
+
+    Effectiveness b_{};
+    Mixing pinv_{};
+    Wrench weights_{{1.0, 100.0, 100.0, 1.0}};
+    bool valid_{false};
+};
+
+/**
+ * @brief Allocate a wrench within the motor limits and write rotor speed commands
+ *
+ * Thrust bounds follow from motor_config's speed range and each rotor's
+ * thrust coefficient (the published geometry's, or
+ * rotor_config.thrust_coefficient before the plant has published); the
+ * resulting thrusts are converted to motor_commands speeds and throttles
+ * for the first N rotors.
+ */
+template <std::size_t N>
+typename ControlAllocator<N>::Result commandWrench(const ControlAllocator<N>& allocator,
+                                                   const typename ControlAllocator<N>::Wrench& wrench,
+                                                   SimulationState& state) {
+    const bool published = state.vehicle_config.rotor_geometry_revision != 0;
+    const double omega_min = state.motor_config.omega_min_rad_s;
+    const double omega_max = state.motor_config.omega_max_rad_s;
+    typename ControlAllocator<N>::RotorVector kt{};
+    typename ControlAllocator<N>::RotorVector lower{};
+    typename ControlAllocator<N>::RotorVector upper{};
+    for (std::size_t i = 0; i < N; ++i) {
+        kt[i] = published ? state.vehicle_config.rotors[i].thrust_coeff : state.rotor_config.thrust_coefficient;
+        lower[i] = kt[i] * omega_min * omega_min;
+        upper[i] = kt[i] * omega_max * omega_max;
+    }
+    typename ControlAllocator<N>::RotorVector rotor_thrust{};
+    const auto result = allocator.allocate(wrench, lower, upper, rotor_thrust);
+    for (std::size_t i = 0; i < N; ++i) {
+        const double omega = std::sqrt(rotor_thrust[i] / kt[i]);
+        state.motor_commands.omega_rad_s[i] = omega;
+        state.motor_commands.throttle_0_1[i] = omega_max > 0.0 ? omega / omega_max : 0.0;
+    }
+    return result;
+}
+
+#endif // MODULES_CONTROL_ALLOCATOR_H
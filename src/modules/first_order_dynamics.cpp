@@ -3,6 +3,8 @@
 #include <cmath>
 #include <algorithm>
 
+#include "core/excitation.h"
+#include "core/module_checkpoint.h"
 #include "core/simulation_state.h"
 
 namespace {
@@ -10,7 +12,7 @@ constexpr double kMinTimeConstant = 1e-3;
 }
 
 void FirstOrderDynamicsModule::initialize(SimulationState& state) {
-    internal_state_ = 0.0;
+    lag_.reset(0.0);
     state.dynamics_state.input = state.dynamics_config.input_target;
     state.dynamics_state.output = 0.0;
     state.dynamics_state.internal_state = 0.0;
@@ -21,19 +23,42 @@ void FirstOrderDynamicsModule::update(double dt, SimulationState& state) {
         return;
     }
 
-    time_constant_ = std::max(state.dynamics_config.time_constant, kMinTimeConstant);
-    gain_ = state.dynamics_config.gain;
+    const double gain = state.dynamics_config.gain;
+    lag_.setTimeConstant(0, std::max(state.dynamics_config.time_constant, kMinTimeConstant));
+    lag_.setGain(0, gain);
 
-    double command = state.dynamics_config.input_target;
-    if (state.dynamics_config.use_sine) {
-        command = gain_ * std::sin(2.0 * M_PI * state.dynamics_config.sine_frequency_hz * state.time_seconds);
+    const auto& config = state.dynamics_config;
+    const double t = state.time_seconds;
+    double command = config.input_target;
+    switch (config.input_mode) {
+    case SimulationState::DynamicsConfig::InputMode::Constant:
+        break;
+    case SimulationState::DynamicsConfig::InputMode::Sine:
+        command = config.excitation_amplitude * std::sin(2.0 * excitation::kPi * config.sine_frequency_hz * t);
+        break;
+    case SimulationState::DynamicsConfig::InputMode::Chirp:
+        command = excitation::logChirp(t, config.chirp_start_hz, config.chirp_end_hz,
+                                       config.chirp_duration_s, config.excitation_amplitude);
+        break;
+    case SimulationState::DynamicsConfig::InputMode::MultiSine:
+        command = excitation::schroederMultiSine(t, config.multisine_base_hz,
+                                                 static_cast<std::size_t>(std::max(config.multisine_tones, 0)),
+                                                 config.excitation_amplitude);
+        break;
     }
 
     state.dynamics_state.input = command;
 
-    double derivative = (-internal_state_ + gain_ * command) / time_constant_;
-    internal_state_ += derivative * dt;
+    lag_.step(dt, &command);
 
-    state.dynamics_state.internal_state = internal_state_;
-    state.dynamics_state.output = internal_state_;
+    state.dynamics_state.internal_state = lag_.output(0);
+    state.dynamics_state.output = lag_.output(0);
+}
+
+void FirstOrderDynamicsModule::checkpoint(ModuleCheckpoint& archive) {
+    auto output = lag_.outputs();
+    archive.io(output);
+    if (archive.loading()) {
+        lag_.load(output.data());
+    }
 }
@@ -6,6 +6,7 @@
 #ifndef FIRST_ORDER_DYNAMICS_H
 #define FIRST_ORDER_DYNAMICS_H
 
+#include "core/first_order_lag_bank.h"
 #include "core/module.h"
 
 /**
@@ -25,9 +26,17 @@
  *   dx/dt = (1/τ) * (K*u - x)
  *   y = x
  *
- * Input modes:
+ * Stepped as a single-channel FirstOrderLagBank (exact zero-order-hold
+ * discretization), the same kernel that drives the per-rotor motor lags.
+ *
+ * Input modes (DynamicsConfig::InputMode):
  * - Constant: Fixed target value
- * - Sinusoidal: Frequency-swept input for Bode analysis
+ * - Sine: Single tone of excitation_amplitude
+ * - Chirp: Repeating logarithmic sweep for watching the roll-off live
+ * - MultiSine: Schroeder-phased harmonics, all frequencies at once
+ *
+ * Gain and phase are measured by the headless frequency-response analyzer
+ * (analysis/frequency_response.h), which drives input_target directly.
  *
  * Useful for:
  * - Testing PID controllers
@@ -45,7 +54,7 @@ public:
     /**
      * @brief Update first-order dynamics state
      *
-     * Integrates the differential equation using Euler method.
+     * Advances the system with its exact discretization for the step.
      * Reads config from SimulationState::dynamics_config and writes
      * output to SimulationState::dynamics_state.
      *
@@ -55,10 +64,13 @@ public:
      */
     void update(double dt, SimulationState& state) override;
 
+    const char* name() const override { return "First-order"; }
+
+    /// Saves the lag output
+    void checkpoint(ModuleCheckpoint& archive) override;
+
 private:
-    double internal_state_{0.0}; ///< Current system state (output value)
-    double time_constant_{1.0};  ///< System time constant τ (seconds)
-    double gain_{1.0};           ///< System gain K (dimensionless)
+    FirstOrderLagBank<1> lag_;   ///< Single-channel lag holding τ, K and the state
 };
 
 #endif // FIRST_ORDER_DYNAMICS_H
@@ -0,0 +1,193 @@
+#include "modules/lqr_controller.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#include "control/config_hash.h"
+#include "control/trim.h"
+#include "core/unroll.h"
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+constexpr std::uint64_t kCacheFormat = 3;  ///< Bump when the error-state definition or synthesis changes
+
+/// Vehicle config with rotor geometry filled from the layout if the plant has not published it
+template <typename Layout>
+SimulationState::VehicleConfig effectiveVehicleConfig(const SimulationState& state) {
+    SimulationState::VehicleConfig vehicle = state.vehicle_config;
+    vehicle.rotor_count = Layout::kRotorCount;
+    if (vehicle.rotor_geometry_revision == 0) {
+        vehicle.rotors.fill(SimulationState::RotorGeometry{});
+        for (std::size_t i = 0; i < Layout::kRotorCount; ++i) {
+            auto& rotor = vehicle.rotors[i];
+            rotor.position_body_m = {vehicle.arm_length * Layout::kRotors[i].arm_x,
+                                     vehicle.arm_length * Layout::kRotors[i].arm_y, 0.0};
+            rotor.direction = Layout::kRotors[i].direction;
+            rotor.thrust_coeff = state.rotor_config.thrust_coefficient;
+            rotor.torque_coeff = state.rotor_config.torque_coefficient;
+        }
+    }
+    return vehicle;
+}
+
+}  // namespace
+
+template <typename Layout>
+void LqrControllerModule<Layout>::initialize(SimulationState& state) {
+    const double rate_hz = state.controller_config.rate_hz;
+    period_ = (std::isfinite(rate_hz) && rate_hz > 0.0) ? 1.0 / rate_hz : 0.0;
+    schedule_ready_ = false;
+    state.lqr_status = SimulationState::LqrStatus{};
+}
+
+template <typename Layout>
+std::uint64_t LqrControllerModule<Layout>::configurationKey(const SimulationState& state) {
+    ConfigHash hash;
+    hash.add(kCacheFormat).add(static_cast<std::uint64_t>(kRotorCount));
+    hashPlantConfig(hash, effectiveVehicleConfig<Layout>(state), state.rotor_config);
+    const auto& lqr = state.lqr_config;
+    for (double value : lqr.max_state_error) {
+        hash.add(value);
+    }
+    hash.add(lqr.max_rotor_speed_delta_rad_s);
+    for (double value : lqr.yaw_rate_points_rad_s) {
+        hash.add(value);
+    }
+    return hash.value();
+}
+
+template <typename Layout>
+std::string LqrControllerModule<Layout>::cachePath(const std::string& directory, std::uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "lqr_%016" PRIx64 ".bin", key);
+    return (std::filesystem::path(directory) / name).string();
+}
+
+template <typename Layout>
+void LqrControllerModule<Layout>::prepareSchedule(SimulationState& state) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto& lqr = state.lqr_config;
+    auto& status = state.lqr_status;
+    status = SimulationState::LqrStatus{};
+    status.config_hash = configurationKey(state);
+
+    const dm_vehicle_config_t model = vehicleModelConfig<kRotorCount>(effectiveVehicleConfig<Layout>(state));
+    const double drag_coefficient = state.vehicle_config.drag_coefficient;
+    TrimCondition hover;
+    hover.drag.coefficient = drag_coefficient;
+    const TrimSolution<kRotorCount> trim = solveTrim<kRotorCount>(model, hover);
+    if (trim.converged) {
+        trim_omega_rad_s_ = trim.rotor_omega_rad_s;
+    } else {
+        trim_omega_rad_s_.fill(hoverRotorSpeed<kRotorCount>(model));
+    }
+
+    const std::string path = lqr.use_disk_cache ? cachePath(lqr.cache_directory, status.config_hash) : std::string();
+    if (lqr.use_disk_cache && schedule_.load(path, status.config_hash)) {
+        status.ready = true;
+        status.from_cache = true;
+    } else {
+        const HoverLqrReport report = synthesizeHoverSchedule<kRotorCount>(
+            model, lqr.max_state_error, lqr.max_rotor_speed_delta_rad_s, lqr.yaw_rate_points_rad_s, schedule_,
+            drag_coefficient);
+        status.riccati_iterations = report.max_iterations;
+        status.ready = report.success && !schedule_.empty();
+        if (status.ready && lqr.use_disk_cache) {
+            // Failing to write the cache only costs a re-solve next run.
+            std::error_code error;
+            std::filesystem::create_directories(lqr.cache_directory, error);
+            schedule_.save(path, status.config_hash);
+        }
+    }
+
+    status.synthesis_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    schedule_revision_ = state.vehicle_config.rotor_geometry_revision;
+    schedule_ready_ = true;
+}
+
+template <typename Layout>
+void LqrControllerModule<Layout>::update(double dt, SimulationState& state) {
+    using Mode = SimulationState::ControllerConfig::Mode;
+    if (state.controller_config.mode != Mode::Lqr || !(dt > 0.0)) {
+        return;
+    }
+    if (!schedule_ready_ || schedule_revision_ != state.vehicle_config.rotor_geometry_revision) {
+        prepareSchedule(state);
+    }
+    if (!state.lqr_status.ready) {
+        return;
+    }
+
+    // The heading reference advances at the commanded yaw rate (the schedule variable).
+    auto& sp = state.controller_setpoint;
+    const double yaw_rate = sp.rate_rad_s.z;
+    sp.yaw_rad = std::remainder(sp.yaw_rad + yaw_rate * dt, 2.0 * kPi);
+    typename Schedule::Gain gain{};
+    schedule_.interpolate(yaw_rate, gain);
+
+    // Hover error in the heading frame
+    const double c = std::cos(sp.yaw_rad);
+    const double s = std::sin(sp.yaw_rad);
+    const glm::dvec3 dp = state.physics.position - sp.position_ned;
+    const glm::dvec3& v = state.physics.velocity;
+    SmallVector<kHoverErrorSize> x{};
+    x[kErrorPosition + 0] = c * dp.x + s * dp.y;
+    x[kErrorPosition + 1] = -s * dp.x + c * dp.y;
+    x[kErrorPosition + 2] = dp.z;
+    x[kErrorVelocity + 0] = c * v.x + s * v.y;
+    x[kErrorVelocity + 1] = -s * v.x + c * v.y;
+    x[kErrorVelocity + 2] = v.z;
+
+    // δq = q_ref⁻¹ ⊗ q with q_ref = yaw(ψ); conjugate yaw-only quaternion (a0, 0, 0, a3)
+    const double a0 = std::cos(0.5 * sp.yaw_rad);
+    const double a3 = -std::sin(0.5 * sp.yaw_rad);
+    const auto& q = state.quaternion;
+    const double dq[4] = {a0 * q[0] - a3 * q[3],
+                          a0 * q[1] - a3 * q[2],
+                          a0 * q[2] + a3 * q[1],
+                          a0 * q[3] + a3 * q[0]};
+    const double shortest = dq[0] < 0.0 ? -2.0 : 2.0;  // Rotate the short way round
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        x[kErrorAttitude + axis] = shortest * dq[axis + 1];
+    }
+    x[kErrorRate + 0] = state.angular_rate_rad_s.x;
+    x[kErrorRate + 1] = state.angular_rate_rad_s.y;
+    x[kErrorRate + 2] = state.angular_rate_rad_s.z - yaw_rate;
+
+    const SmallVector<kRotorCount> correction = gain * x;
+    const double omega_min = state.motor_config.omega_min_rad_s;
+    const double omega_max = state.motor_config.omega_max_rad_s;
+    bool saturated = false;
+    double thrust = 0.0;
+    unrollFor<kRotorCount>([&](auto i) {
+        const double wanted = trim_omega_rad_s_[i] - correction[i];
+        const double omega = std::clamp(wanted, omega_min, omega_max);
+        saturated = saturated || omega != wanted;
+        thrust += state.vehicle_config.rotors[i].thrust_coeff * omega * omega;
+        state.motor_commands.omega_rad_s[i] = omega;
+        state.motor_commands.throttle_0_1[i] = omega_max > 0.0 ? omega / omega_max : 0.0;
+    });
+
+    auto& out = state.controller_state;
+    out.rate_setpoint_rad_s = glm::dvec3(0.0, 0.0, yaw_rate);
+    out.thrust_command_newton = thrust;
+    out.saturated = saturated;
+    ++out.updates;
+}
+
+template class LqrControllerModule<QuadXLayout>;
+template class LqrControllerModule<QuadPlusLayout>;
+template class LqrControllerModule<HexXLayout>;
+template class LqrControllerModule<OctoXLayout>;
+
+std::unique_ptr<Module> makeLqrControllerModule(SimulationState::Airframe airframe) {
+    return visitAirframe(airframe, [](auto layout) -> std::unique_ptr<Module> {
+        return std::make_unique<LqrControllerModule<decltype(layout)>>();
+    });
+}
@@ -0,0 +1,98 @@
+/**
+ * @file lqr_controller.h
+ * @brief Gain-scheduled LQR position/attitude hold writing rotor speed commands
+ */
+
+#ifndef MODULES_LQR_CONTROLLER_H
+#define MODULES_LQR_CONTROLLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "control/gain_schedule.h"
+#include "control/hover_lqr.h"
+#include "core/module.h"
+#include "core/simulation_state.h"
+#include "modules/airframe_layout.h"
+
+/**
+ * @class LqrControllerModule
+ * @brief Full-state feedback u = ω_trim - K(r) δx around hover
+ *
+ * Gains are synthesized offline, not per tick: on the first update (and
+ * whenever the plant republishes its rotor geometry) the module linearizes
+ * the plant about hover at each yaw rate in LqrConfig, solves the continuous
+ * algebraic Riccati equation for each, and stores the gains in a
+ * GainSchedule. The schedule is cached on disk keyed by a hash of the
+ * vehicle/rotor configuration and the weights, so later runs with the same
+ * airframe just load it.
+ *
+ * Each update then builds the 12-state hover error (see HoverErrorIndex),
+ * interpolates K at the commanded yaw rate and writes clamped rotor speed
+ * commands: a fixed-size matrix-vector product with no allocation.
+ *
+ * Active only in ControllerConfig::Mode::Lqr; runs at controller_config.rate_hz.
+ *
+ * @tparam Layout Airframe geometry table (see airframe_layout.h)
+ */
+template <typename Layout>
+class LqrControllerModule : public Module {
+public:
+    static constexpr std::size_t kRotorCount = Layout::kRotorCount;
+    static_assert(kRotorCount <= SimulationState::kMaxRotors, "Layout exceeds SimulationState rotor arrays");
+
+    using Schedule = GainSchedule<kRotorCount, kHoverErrorSize>;
+
+    /**
+     * @brief Latch the loop rate; gains are (re)built lazily on the first LQR update
+     * @param state Reference to simulation state
+     */
+    void initialize(SimulationState& state) override;
+
+    /**
+     * @brief Run one LQR update
+     * @param dt Controller period (seconds)
+     * @param state Reference to simulation state (reads the vehicle state and
+     *              controller_setpoint, writes motor_commands, controller_state
+     *              and lqr_status)
+     */
+    void update(double dt, SimulationState& state) override;
+
+    const char* name() const override { return "LQR"; }
+    double period() const override { return period_; }
+
+    /**
+     * @brief Cache key for the current plant and LQR settings
+     */
+    static std::uint64_t configurationKey(const SimulationState& state);
+
+    /**
+     * @brief Cache file path for a key inside cache_directory
+     */
+    static std::string cachePath(const std::string& directory, std::uint64_t key);
+
+    const Schedule& schedule() const { return schedule_; }
+
+private:
+    double period_{0.002};                  ///< 1 / rate_hz latched at initialize
+    Schedule schedule_;
+    bool schedule_ready_{false};
+    std::uint64_t schedule_revision_{0};    ///< Geometry revision the schedule was built for
+    SmallVector<kRotorCount> trim_omega_rad_s_{};   ///< Hover trim from solveTrim()
+
+    void prepareSchedule(SimulationState& state);
+};
+
+extern template class LqrControllerModule<QuadXLayout>;
+extern template class LqrControllerModule<QuadPlusLayout>;
+extern template class LqrControllerModule<HexXLayout>;
+extern template class LqrControllerModule<OctoXLayout>;
+
+/**
+ * @brief Create the LQR instantiation matching a runtime airframe selection
+ */
+std::unique_ptr<Module> makeLqrControllerModule(SimulationState::Airframe airframe);
+
+#endif // MODULES_LQR_CONTROLLER_H
@@ -0,0 +1,56 @@
+#include "modules/motor_dynamics.h"
+
+#include <algorithm>
+
+#include "core/unroll.h"
+#include "modules/airframe_layout.h"
+
+template <std::size_t RotorCount>
+void MotorDynamicsModule<RotorCount>::initialize(SimulationState& state) {
+    const auto& config = state.motor_config;
+    lag_.setLimits(config.omega_min_rad_s, config.omega_max_rad_s);
+    for (std::size_t i = RotorCount; i < SimulationState::kMaxRotors; ++i) {
+        state.motor_state.omega_rad_s[i] = 0.0;
+    }
+}
+
+template <std::size_t RotorCount>
+void MotorDynamicsModule<RotorCount>::update(double dt, SimulationState& state) {
+    const auto& config = state.motor_config;
+    const auto& command = state.motor_commands.omega_rad_s;
+    auto& actual = state.motor_state.omega_rad_s;
+
+    if (!config.lag_enabled) {
+        // Same saturation as the lag bank, without the lag.
+        const double lower = config.omega_min_rad_s;
+        const double upper = std::max(lower, config.omega_max_rad_s);
+        unrollFor<RotorCount>([&](auto i) {
+            actual[i] = std::min(std::max(command[i], lower), upper);
+        });
+        return;
+    }
+
+    // Setters only invalidate the cached discretization when a value changes.
+    unrollFor<RotorCount>([&](auto i) {
+        lag_.setTimeConstant(i, config.time_constant_s[i]);
+    });
+    lag_.setLimits(config.omega_min_rad_s, config.omega_max_rad_s);
+
+    lag_.load(actual.data());
+    lag_.step(dt, command.data());
+
+    const auto& omega = lag_.outputs();
+    unrollFor<RotorCount>([&](auto i) {
+        actual[i] = omega[i];
+    });
+}
+
+template class MotorDynamicsModule<4>;
+template class MotorDynamicsModule<6>;
+template class MotorDynamicsModule<8>;
+
+std::unique_ptr<Module> makeMotorDynamicsModule(SimulationState::Airframe airframe) {
+    return visitAirframe(airframe, [](auto layout) -> std::unique_ptr<Module> {
+        return std::make_unique<MotorDynamicsModule<decltype(layout)::kRotorCount>>();
+    });
+}
@@ -0,0 +1,69 @@
+/**
+ * @file motor_dynamics.h
+ * @brief Per-rotor motor/ESC speed response (commanded to actual rotor speed)
+ */
+
+#ifndef MOTOR_DYNAMICS_H
+#define MOTOR_DYNAMICS_H
+
+#include <cstddef>
+#include <memory>
+
+#include "core/first_order_lag_bank.h"
+#include "core/module.h"
+#include "core/simulation_state.h"
+
+/**
+ * @class MotorDynamicsModule
+ * @brief Lags actual rotor speeds behind the commanded speeds
+ *
+ * Each rotor is modeled as
+ *
+ *   ω_actual(s) / ω_cmd(s) = 1 / (τ_i s + 1)
+ *
+ * saturated to the motor's achievable speed range. All rotors are stepped
+ * together by one FirstOrderLagBank, so the cost is a handful of vectorized
+ * multiply-adds per frame regardless of airframe.
+ *
+ * Runs before the plant each frame: reads SimulationState::motor_commands
+ * and SimulationState::motor_config, writes SimulationState::motor_state.
+ * The current actual speeds are reloaded from state every update, so resets
+ * and edits made elsewhere (e.g. plant re-initialization) are respected.
+ *
+ * @tparam RotorCount Number of active rotors (4, 6 or 8)
+ */
+template <std::size_t RotorCount>
+class MotorDynamicsModule : public Module {
+public:
+    static_assert(RotorCount <= SimulationState::kMaxRotors, "Rotor count exceeds SimulationState rotor arrays");
+
+    /**
+     * @brief Apply motor limits and clear unused rotor slots
+     * @param state Reference to simulation state
+     */
+    void initialize(SimulationState& state) override;
+
+    /**
+     * @brief Advance actual rotor speeds toward the commands
+     * @param dt Time step (seconds)
+     * @param state Reference to simulation state (reads motor_commands and
+     *              motor_config, writes motor_state)
+     */
+    void update(double dt, SimulationState& state) override;
+
+    const char* name() const override { return "Motors"; }
+
+private:
+    FirstOrderLagBank<RotorCount> lag_;   ///< One channel per rotor
+};
+
+extern template class MotorDynamicsModule<4>;
+extern template class MotorDynamicsModule<6>;
+extern template class MotorDynamicsModule<8>;
+
+/**
+ * @brief Create the motor dynamics instantiation matching a runtime airframe selection
+ */
+std::unique_ptr<Module> makeMotorDynamicsModule(SimulationState::Airframe airframe);
+
+#endif // MOTOR_DYNAMICS_H
@@ -0,0 +1,253 @@
+#include "modules/mpc_controller.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "core/module_checkpoint.h"
+#include "core/quaternion_math.h"
+
+namespace {
+constexpr double kMinTiltCosine = 0.5;  ///< Tilt compensation stops growing past 60 deg
+
+/// Settings that change H or the constraint matrix (bounds are per tick)
+bool sameModel(const SimulationState::MpcConfig& a, const SimulationState::MpcConfig& b) {
+    return a.step_s == b.step_s && a.attitude_weight == b.attitude_weight && a.rate_weight == b.rate_weight &&
+           a.accel_weight == b.accel_weight && a.terminal_factor == b.terminal_factor &&
+           a.max_iterations == b.max_iterations;
+}
+
+/// Move a horizon-long block forward by steps, repeating its last entry
+template <std::size_t N>
+void shiftBlock(double* block, std::size_t steps) {
+    for (std::size_t k = 0; k < N; ++k) {
+        block[k] = block[std::min(k + steps, N - 1)];
+    }
+}
+
+}  // namespace
+
+template <typename Layout>
+void MpcControllerModule<Layout>::initialize(SimulationState& state) {
+    const double rate_hz = state.controller_config.rate_hz;
+    period_ = (std::isfinite(rate_hz) && rate_hz > 0.0) ? 1.0 / rate_hz : 0.0;
+    model_ready_ = false;
+    allocator_ready_ = false;
+    active_ = false;
+    state.mpc_status = SimulationState::MpcStatus{};
+    solve_channel_ = state.telemetry.registerChannel("mpc.solve_us", "us");
+    iteration_channel_ = state.telemetry.registerChannel("mpc.iterations", "");
+}
+
+template <typename Layout>
+bool MpcControllerModule<Layout>::buildModel(const SimulationState::MpcConfig& config) {
+    const double ts = config.step_s;
+    if (!(ts > 0.0)) {
+        return false;
+    }
+
+    // Condensed prediction: row k-1 gives θ_k, ω_k from the accelerations α_0..α_{N-1}.
+    SmallMatrix<kHorizon, kHorizon> theta_input{};
+    SmallMatrix<kHorizon, kHorizon> rate_input{};
+    SmallMatrix<kHorizon, 2> theta_free{};
+    SmallMatrix<kHorizon, 2> rate_free{};
+    for (std::size_t k = 1; k <= kHorizon; ++k) {
+        for (std::size_t j = 0; j < k; ++j) {
+            theta_input.m[k - 1][j] = ts * ts * (static_cast<double>(k - j) - 0.5);
+            rate_input.m[k - 1][j] = ts;
+        }
+        theta_free.m[k - 1][0] = 1.0;
+        theta_free.m[k - 1][1] = static_cast<double>(k) * ts;
+        rate_free.m[k - 1][1] = 1.0;
+    }
+
+    constraints_ = SmallMatrix<kConstraints, kHorizon>{};
+    for (std::size_t k = 0; k < kHorizon; ++k) {
+        constraints_.m[k][k] = 1.0;
+        for (std::size_t j = 0; j < kHorizon; ++j) {
+            constraints_.m[kHorizon + k][j] = rate_input.m[k][j];
+        }
+    }
+
+    typename Qp::Settings settings;
+    settings.max_iterations = std::max<std::size_t>(config.max_iterations, 1);
+    for (std::size_t a = 0; a < 3; ++a) {
+        // Weighted copies W·S so that H = SᵀWS + rI and G = SᵀWΦ are plain products.
+        SmallMatrix<kHorizon, kHorizon> theta_weighted = theta_input;
+        SmallMatrix<kHorizon, kHorizon> rate_weighted = rate_input;
+        SmallMatrix<kHorizon, 2> theta_free_weighted = theta_free;
+        SmallMatrix<kHorizon, 2> rate_free_weighted = rate_free;
+        for (std::size_t k = 0; k < kHorizon; ++k) {
+            const double terminal = k + 1 == kHorizon ? config.terminal_factor : 1.0;
+            const double w_theta = config.attitude_weight[a] * terminal;
+            const double w_rate = config.rate_weight[a] * terminal;
+            for (std::size_t j = 0; j < kHorizon; ++j) {
+                theta_weighted.m[k][j] *= w_theta;
+                rate_weighted.m[k][j] *= w_rate;
+            }
+            for (std::size_t j = 0; j < 2; ++j) {
+                theta_free_weighted.m[k][j] *= w_theta;
+                rate_free_weighted.m[k][j] *= w_rate;
+            }
+        }
+        SmallMatrix<kHorizon, kHorizon> h = transpose(theta_input) * theta_weighted +
+                                            transpose(rate_input) * rate_weighted;
+        for (std::size_t k = 0; k < kHorizon; ++k) {
+            h.m[k][k] += config.accel_weight[a];
+        }
+        axes_[a].linear_cost = transpose(theta_input) * theta_free_weighted +
+                               transpose(rate_input) * rate_free_weighted;
+        if (!axes_[a].solver.configure(h, constraints_, settings)) {
+            return false;
+        }
+        axes_[a].solver.reset();
+    }
+    model_config_ = config;
+    shift_elapsed_s_ = 0.0;
+    return true;
+}
+
+template <typename Layout>
+void MpcControllerModule<Layout>::shiftWarmStart(std::size_t steps) {
+    for (Axis& axis : axes_) {
+        shiftBlock<kHorizon>(axis.solver.primal().data(), steps);
+        shiftBlock<kHorizon>(axis.solver.slack().data(), steps);
+        shiftBlock<kHorizon>(axis.solver.slack().data() + kHorizon, steps);
+        shiftBlock<kHorizon>(axis.solver.dual().data(), steps);
+        shiftBlock<kHorizon>(axis.solver.dual().data() + kHorizon, steps);
+    }
+}
+
+template <typename Layout>
+void MpcControllerModule<Layout>::update(double dt, SimulationState& state) {
+    using Mode = SimulationState::ControllerConfig::Mode;
+    const auto& controller = state.controller_config;
+    const auto& config = state.mpc_config;
+    if (controller.mode != Mode::Mpc || !(dt > 0.0)) {
+        active_ = false;
+        return;
+    }
+
+    if (!model_ready_ || !sameModel(model_config_, config)) {
+        model_ready_ = buildModel(config);
+        if (!model_ready_) {
+            return;
+        }
+    }
+    if (!active_) {
+        // Another controller was flying: its history says nothing about this QP.
+        for (Axis& axis : axes_) {
+            axis.solver.reset();
+        }
+        shift_elapsed_s_ = 0.0;
+        active_ = true;
+    }
+    if (!allocator_ready_ || allocator_revision_ != state.vehicle_config.rotor_geometry_revision) {
+        allocator_ = ControlAllocator<kRotorCount>::template forVehicle<Layout>(state);
+        allocator_revision_ = state.vehicle_config.rotor_geometry_revision;
+        allocator_ready_ = true;
+    }
+
+    // Keep the warm start aligned with the prediction grid.
+    shift_elapsed_s_ += dt;
+    const auto steps = static_cast<std::size_t>(shift_elapsed_s_ / model_config_.step_s);
+    if (steps > 0) {
+        shiftWarmStart(steps);
+        shift_elapsed_s_ -= static_cast<double>(steps) * model_config_.step_s;
+    }
+
+    // Attitude error θ = 2·vec(q_sp⁻¹ ⊗ q), short way round
+    const auto& sp = state.controller_setpoint;
+    const std::array<double, 4> q_sp = quaternionFromEuler(sp.roll_rad, sp.pitch_rad, sp.yaw_rad);
+    const std::array<double, 4> q{state.quaternion[0], state.quaternion[1],
+                                  state.quaternion[2], state.quaternion[3]};
+    const std::array<double, 4> q_err = quaternionMultiply({q_sp[0], -q_sp[1], -q_sp[2], -q_sp[3]}, q);
+    const double shortest = q_err[0] < 0.0 ? -2.0 : 2.0;
+    const double rate[3] = {state.angular_rate_rad_s.x, state.angular_rate_rad_s.y, state.angular_rate_rad_s.z};
+
+    const auto start = Qp::Clock::now();
+    const auto deadline = start + std::chrono::duration_cast<typename Qp::Clock::duration>(
+                                      std::chrono::duration<double, std::micro>(std::max(config.budget_us, 0.0)));
+    auto& status = state.mpc_status;
+    status.iterations = 0;
+    status.converged = true;
+    bool over_budget = false;
+    std::array<double, 3> accel{};
+    for (std::size_t a = 0; a < 3; ++a) {
+        Axis& axis = axes_[a];
+        const double theta0 = shortest * q_err[a + 1];
+        const double omega0 = rate[a];
+        SmallVector<kHorizon> f{};
+        for (std::size_t k = 0; k < kHorizon; ++k) {
+            f[k] = axis.linear_cost.m[k][0] * theta0 + axis.linear_cost.m[k][1] * omega0;
+        }
+
+        const double accel_limit = controller.max_accel_rad_s2[a];
+        const double rate_limit = controller.max_rate_rad_s[a];
+        SmallVector<kConstraints> lower{};
+        SmallVector<kConstraints> upper{};
+        for (std::size_t k = 0; k < kHorizon; ++k) {
+            lower[k] = -accel_limit;
+            upper[k] = accel_limit;
+            // Rate bound on ω_k - ω0, widened to what full deceleration can reach.
+            const double reachable = static_cast<double>(k + 1) * model_config_.step_s * accel_limit;
+            lower[kHorizon + k] = std::min(-rate_limit - omega0, reachable);
+            upper[kHorizon + k] = std::max(rate_limit - omega0, -reachable);
+        }
+
+        const auto result = axis.solver.solve(f, lower, upper, deadline);
+        status.iterations += result.iterations;
+        status.converged = status.converged && result.status == Qp::Status::Solved;
+        over_budget = over_budget || result.status == Qp::Status::TimeBudget;
+        // The acceleration slack is the constraint-feasible copy of the first move.
+        accel[a] = std::clamp(axis.solver.slack()[0], -accel_limit, accel_limit);
+    }
+    status.solve_us = std::chrono::duration<double, std::micro>(Qp::Clock::now() - start).count();
+    status.budget_overruns += over_budget ? 1 : 0;
+    ++status.solves;
+    state.telemetry.record(solve_channel_, state.time_seconds, status.solve_us);
+    state.telemetry.record(iteration_channel_, state.time_seconds, static_cast<double>(status.iterations));
+
+    const double torque[3] = {state.vehicle_config.Ixx * accel[0],
+                              state.vehicle_config.Iyy * accel[1],
+                              state.vehicle_config.Izz * accel[2]};
+    double thrust = sp.collective_thrust_newton;
+    if (!(thrust > 0.0)) {
+        const double tilt_cosine = 1.0 - 2.0 * (q[1] * q[1] + q[2] * q[2]);
+        thrust = state.vehicle_config.mass * state.vehicle_config.gravity /
+                 std::max(tilt_cosine, kMinTiltCosine);
+    }
+    const auto allocation = commandWrench(allocator_, {thrust, torque[0], torque[1], torque[2]}, state);
+
+    auto& out = state.controller_state;
+    out.rate_setpoint_rad_s = glm::dvec3(0.0);
+    out.rate_integral = glm::dvec3(0.0);
+    out.accel_command_rad_s2 = glm::dvec3(accel[0], accel[1], accel[2]);
+    out.torque_command_nm = glm::dvec3(torque[0], torque[1], torque[2]);
+    out.thrust_command_newton = thrust;
+    out.saturated = allocation.saturated > 0;
+    ++out.updates;
+}
+
+template <typename Layout>
+void MpcControllerModule<Layout>::checkpoint(ModuleCheckpoint& archive) {
+    // The QP matrices follow from the configuration; only the iterates carry history.
+    for (Axis& axis : axes_) {
+        archive.io(axis.solver.primal());
+        archive.io(axis.solver.slack());
+        archive.io(axis.solver.dual());
+    }
+    archive.io(active_);
+    archive.io(shift_elapsed_s_);
+}
+
+template class MpcControllerModule<QuadXLayout>;
+template class MpcControllerModule<QuadPlusLayout>;
+template class MpcControllerModule<HexXLayout>;
+template class MpcControllerModule<OctoXLayout>;
+
+std::unique_ptr<Module> makeMpcControllerModule(SimulationState::Airframe airframe) {
+    return visitAirframe(airframe, [](auto layout) -> std::unique_ptr<Module> {
+        return std::make_unique<MpcControllerModule<decltype(layout)>>();
+    });
+}
@@ -0,0 +1,114 @@
+/**
+ * @file mpc_controller.h
+ * @brief Receding-horizon attitude controller with a warm-started fixed-size QP
+ */
+
+#ifndef MODULES_MPC_CONTROLLER_H
+#define MODULES_MPC_CONTROLLER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "control/admm_qp.h"
+#include "core/module.h"
+#include "core/simulation_state.h"
+#include "core/small_matrix.h"
+#include "modules/airframe_layout.h"
+#include "modules/control_allocator.h"
+
+/**
+ * @class MpcControllerModule
+ * @brief Linear MPC on the per-axis rotational dynamics, followed by control allocation
+ *
+ * Each body axis is predicted as a double integrator θ̈ = α over kHorizon
+ * steps of MpcConfig::step_s (exact zero-order hold), with θ the attitude
+ * error 2·vec(q_sp⁻¹ ⊗ q). The condensed QP over the acceleration sequence
+ *
+ *   min Σ w_θ θ_k² + w_ω ω_k² + r α_k²
+ *   s.t. |α_k| ≤ max_accel,   |ω_k| ≤ max_rate (relaxed when unreachable)
+ *
+ * has fixed dimensions, so H, the constraint matrix and the ADMM
+ * factorization are built once per configuration and only the linear term
+ * and bounds change per tick. The solvers warm-start from the previous
+ * solution, shifted whenever a full model step has elapsed, and share a
+ * per-tick time budget; an unfinished solve still yields a feasible first
+ * move. The first acceleration of each axis is scaled by the inertia and
+ * allocated to the rotors like AttitudeControllerModule does.
+ *
+ * Solve time and iteration count are written to mpc_status and to the
+ * "mpc.solve_us" and "mpc.iterations" telemetry channels every update.
+ *
+ * Active only in ControllerConfig::Mode::Mpc; runs at controller_config.rate_hz.
+ *
+ * @tparam Layout Airframe geometry table (see airframe_layout.h)
+ */
+template <typename Layout>
+class MpcControllerModule : public Module {
+public:
+    static constexpr std::size_t kRotorCount = Layout::kRotorCount;
+    static constexpr std::size_t kHorizon = 15;                 ///< Prediction steps
+    static constexpr std::size_t kConstraints = 2 * kHorizon;   ///< Acceleration rows, then rate rows
+    static_assert(kRotorCount <= SimulationState::kMaxRotors, "Layout exceeds SimulationState rotor arrays");
+
+    using Qp = AdmmQp<kHorizon, kConstraints>;
+
+    /**
+     * @brief Latch the loop rate, drop the warm start and register telemetry channels
+     * @param state Reference to simulation state
+     */
+    void initialize(SimulationState& state) override;
+
+    /**
+     * @brief Solve the three axis QPs and write rotor commands
+     * @param dt Controller period (seconds)
+     * @param state Reference to simulation state (reads attitude, rates and
+     *              controller_setpoint, writes motor_commands,
+     *              controller_state, mpc_status and telemetry)
+     */
+    void update(double dt, SimulationState& state) override;
+
+    const char* name() const override { return "MPC"; }
+
+    /// Saves the ADMM warm starts and their alignment with the prediction grid
+    void checkpoint(ModuleCheckpoint& archive) override;
+    double period() const override { return period_; }
+
+private:
+    /// Per-axis QP data that depends only on the configuration
+    struct Axis {
+        Qp solver;
+        SmallMatrix<kHorizon, 2> linear_cost{};     ///< f = G [θ0, ω0]
+    };
+
+    double period_{0.002};                          ///< 1 / rate_hz latched at initialize
+    std::array<Axis, 3> axes_{};
+    SmallMatrix<kConstraints, kHorizon> constraints_{};
+    SimulationState::MpcConfig model_config_{};     ///< Settings the QPs were built for
+    bool model_ready_{false};
+    bool active_{false};                            ///< Flew the last update (warm start is current)
+    double shift_elapsed_s_{0.0};                   ///< Time since the warm start was last shifted
+
+    ControlAllocator<kRotorCount> allocator_;
+    bool allocator_ready_{false};
+    std::uint64_t allocator_revision_{0};
+
+    std::size_t solve_channel_{TelemetryChannels::kInvalid};
+    std::size_t iteration_channel_{TelemetryChannels::kInvalid};
+
+    bool buildModel(const SimulationState::MpcConfig& config);
+    void shiftWarmStart(std::size_t steps);
+};
+
+extern template class MpcControllerModule<QuadXLayout>;
+extern template class MpcControllerModule<QuadPlusLayout>;
+extern template class MpcControllerModule<HexXLayout>;
+extern template class MpcControllerModule<OctoXLayout>;
+
+/**
+ * @brief Create the MPC instantiation matching a runtime airframe selection
+ */
+std::unique_ptr<Module> makeMpcControllerModule(SimulationState::Airframe airframe);
+
+#endif // MODULES_MPC_CONTROLLER_H
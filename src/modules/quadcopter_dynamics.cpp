@@ -1,46 +1,26 @@
 #include "modules/quadcopter_dynamics.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
+#include <type_traits>
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
 
-#include "attitude/euler.h"
-#include "attitude/quaternion.h"
-#include "attitude/attitude_utils.h"
+#include "control/trim.h"
+#include "core/module_checkpoint.h"
 #include "core/simulation_state.h"
+#include "core/unroll.h"
+#include "modules/vehicle_derivative.h"
 
 namespace {
 constexpr double kPi = 3.14159265358979323846;
 constexpr double kMaxPhysicsStepS = 0.0025;
 constexpr double kMaxFrameStepS = 0.25;
 
-glm::mat4 renderFromNed()
-{
-    // NED (north, east, down) -> renderer (right/east, up, back/-north).
-    glm::mat4 transform(1.0f);
-    transform[0][0] = 0.0f;
-    transform[1][0] = 1.0f;
-    transform[2][0] = 0.0f;
-    transform[0][1] = 0.0f;
-    transform[1][1] = 0.0f;
-    transform[2][1] = -1.0f;
-    transform[0][2] = -1.0f;
-    transform[1][2] = 0.0f;
-    transform[2][2] = 0.0f;
-    return transform;
-}
-
-/**
- * @brief Compute hover throttle for a quadcopter
- * @param mass Vehicle mass (kg)
- * @param gravity Gravitational acceleration (m/s²)
- * @param num_rotors Number of rotors
- * @return Hover thrust per rotor (N)
- */
-double computeHoverThrust(double mass, double gravity, int num_rotors) {
-    return (mass * gravity) / num_rotors;
-}
+static_assert(std::is_same<decltype(SimulationState::PlantIntegration::trajectory),
+                           DenseTrajectory<kVehicleStateSize>>::value,
+              "Dense trajectory layout must match the packed vehicle state");
 
 /**
  * @brief Convert throttle [0, 1] to rotor angular velocity (rad/s)
@@ -59,40 +39,18 @@ double throttleToOmega(double throttle, double thrust_coeff) {
 
 }  // namespace
 
-void QuadcopterDynamicsModule::initialize(SimulationState& state) {
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::initialize(SimulationState& state) {
     // Initialize vehicle configuration from simulation state
-    vehicle_config_.rotor_count = 4;
-    vehicle_config_.mass = state.vehicle_config.mass;
-    vehicle_config_.gravity = state.vehicle_config.gravity;
-
-    // Inertia tensor (diagonal, assuming symmetry)
-    vehicle_config_.inertia[0][0] = state.vehicle_config.Ixx;
-    vehicle_config_.inertia[0][1] = 0.0;
-    vehicle_config_.inertia[0][2] = 0.0;
-
-    vehicle_config_.inertia[1][0] = 0.0;
-    vehicle_config_.inertia[1][1] = state.vehicle_config.Iyy;
-    vehicle_config_.inertia[1][2] = 0.0;
-
-    vehicle_config_.inertia[2][0] = 0.0;
-    vehicle_config_.inertia[2][1] = 0.0;
-    vehicle_config_.inertia[2][2] = state.vehicle_config.Izz;
-
-    // Inertia inverse (for diagonal matrix, just invert diagonal elements)
-    vehicle_config_.inertia_inv[0][0] = 1.0 / state.vehicle_config.Ixx;
-    vehicle_config_.inertia_inv[0][1] = 0.0;
-    vehicle_config_.inertia_inv[0][2] = 0.0;
+    vehicle_config_.rotor_count = static_cast<int>(kRotorCount);
+    state.vehicle_config.airframe = Layout::kAirframe;
+    state.vehicle_config.rotor_count = kRotorCount;
+    loadVehicleParameters(state);
 
-    vehicle_config_.inertia_inv[1][0] = 0.0;
-    vehicle_config_.inertia_inv[1][1] = 1.0 / state.vehicle_config.Iyy;
-    vehicle_config_.inertia_inv[1][2] = 0.0;
-
-    vehicle_config_.inertia_inv[2][0] = 0.0;
-    vehicle_config_.inertia_inv[2][1] = 0.0;
-    vehicle_config_.inertia_inv[2][2] = 1.0 / state.vehicle_config.Izz;
-
-    // Setup rotor configuration (X-frame quadcopter)
-    setupRotorConfiguration();
+    // Setup rotor geometry (layout table unless a config file gave one) and
+    // publish it so control allocation uses exactly the plant's rotors
+    setupRotorConfiguration(state);
+    publishRotorGeometry(state);
 
     // Initialize physics state
     std::memset(&physics_state_, 0, sizeof(physics_state_));
@@ -120,14 +78,21 @@ void QuadcopterDynamicsModule::initialize(SimulationState& state) {
     vehicle_model_.config = &vehicle_config_;
     vehicle_model_.state = physics_state_;
 
-    // Initialize motor commands to hover
-    double hover_thrust = computeHoverThrust(vehicle_config_.mass, vehicle_config_.gravity, 4);
-    double hover_omega = std::sqrt(hover_thrust / state.rotor_config.thrust_coefficient);
+    // Initialize motor commands to the hover trim of this configuration
+    trimHover(state);
 
-    for (int i = 0; i < 4; ++i) {
+    state.motor_commands.omega_rad_s.fill(0.0);
+    state.motor_commands.throttle_0_1.fill(0.0);
+    state.motor_state.omega_rad_s.fill(0.0);
+    unrollFor<kRotorCount>([&](auto i) {
+        const double hover_omega = state.trim.rotor_omega_rad_s[i];
         state.motor_commands.omega_rad_s[i] = hover_omega;
+        state.motor_state.omega_rad_s[i] = hover_omega;  // Motors start spun up
         state.motor_commands.throttle_0_1[i] = 0.5;  // 50% throttle for hover
-    }
+    });
+    state.rotor.rpm.fill(0.0);
+    state.rotor.thrust_newton.fill(0.0);
+    state.rotor.torque_newton_metre.fill(0.0);
 
     // Copy initial state to simulation
     copyStateToSim(physics_state_, state);
@@ -135,65 +100,114 @@ void QuadcopterDynamicsModule::initialize(SimulationState& state) {
     state.physics.last_result = static_cast<int>(DM_OK);
     state.physics.accepted_steps = 0;
     state.physics.rejected_steps = 0;
+
+    adaptive_.reset();
+    active_method_ = state.plant_integration.method;
+    state.plant_integration.derivative_evaluations = 0;
+    state.plant_integration.last_step_s = 0.0;
+    state.plant_integration.trajectory.clear();
+}
+
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::trimHover(SimulationState& state) const {
+    const auto start = std::chrono::steady_clock::now();
+    const TrimSolution<kRotorCount> solution = solveTrim<kRotorCount>(vehicle_config_, TrimCondition{});
+
+    auto& trim = state.trim;
+    trim = SimulationState::TrimStatus{};
+    trim.converged = solution.converged;
+    trim.iterations = solution.iterations;
+    trim.residual = solution.residual;
+    trim.roll_rad = solution.roll_rad;
+    trim.pitch_rad = solution.pitch_rad;
+    // Level hover at the closed-form speed if the rotors cannot balance the vehicle
+    const double fallback = hoverRotorSpeed<kRotorCount>(vehicle_config_);
+    unrollFor<kRotorCount>([&](auto i) {
+        trim.rotor_omega_rad_s[i] = solution.converged ? solution.rotor_omega_rad_s[i] : fallback;
+    });
+    trim.solve_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::configure(SimulationState& state) {
+    loadVehicleParameters(state);
+    setupRotorConfiguration(state);
+    publishRotorGeometry(state);
+    trimHover(state);
+}
+
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::loadVehicleParameters(const SimulationState& state) {
+    const auto& vehicle = state.vehicle_config;
+    vehicle_config_.mass = vehicle.mass;
+    vehicle_config_.gravity = vehicle.gravity;
+
+    // Inertia tensor (diagonal, assuming symmetry) and its inverse
+    const double diagonal[3] = {vehicle.Ixx, vehicle.Iyy, vehicle.Izz};
+    for (std::size_t row = 0; row < 3; ++row) {
+        for (std::size_t col = 0; col < 3; ++col) {
+            vehicle_config_.inertia[row][col] = row == col ? diagonal[row] : 0.0;
+            vehicle_config_.inertia_inv[row][col] = row == col ? 1.0 / diagonal[row] : 0.0;
+        }
+    }
 }
 
-void QuadcopterDynamicsModule::setupRotorConfiguration() {
-    // X-frame quadcopter configuration (45° from body axes)
-    // Front-right, front-left, back-left, back-right
-    // Rotor 0: Front-right (+X, +Y), CW
-    // Rotor 1: Front-left  (+X, -Y), CCW
-    // Rotor 2: Back-left   (-X, -Y), CW
-    // Rotor 3: Back-right  (-X, +Y), CCW
-
-    const double arm_length = 0.225;  // 225mm arms (450mm wheelbase)
-    const double diag = arm_length / std::sqrt(2.0);
-
-    // Rotor 0: Front-right
-    vehicle_config_.rotors[0].position_body[0] = diag;
-    vehicle_config_.rotors[0].position_body[1] = diag;
-    vehicle_config_.rotors[0].position_body[2] = 0.0;
-    vehicle_config_.rotors[0].axis_body[0] = 0.0;
-    vehicle_config_.rotors[0].axis_body[1] = 0.0;
-    vehicle_config_.rotors[0].axis_body[2] = -1.0;
-    vehicle_config_.rotors[0].direction = 1.0;  // CW
-    vehicle_config_.rotors[0].thrust_coeff = 1.2e-6;
-    vehicle_config_.rotors[0].torque_coeff = 2.5e-8;
-
-    // Rotor 1: Front-left
-    vehicle_config_.rotors[1].position_body[0] = diag;
-    vehicle_config_.rotors[1].position_body[1] = -diag;
-    vehicle_config_.rotors[1].position_body[2] = 0.0;
-    vehicle_config_.rotors[1].axis_body[0] = 0.0;
-    vehicle_config_.rotors[1].axis_body[1] = 0.0;
-    vehicle_config_.rotors[1].axis_body[2] = -1.0;
-    vehicle_config_.rotors[1].direction = -1.0;  // CCW
-    vehicle_config_.rotors[1].thrust_coeff = 1.2e-6;
-    vehicle_config_.rotors[1].torque_coeff = 2.5e-8;
-
-    // Rotor 2: Back-left
-    vehicle_config_.rotors[2].position_body[0] = -diag;
-    vehicle_config_.rotors[2].position_body[1] = -diag;
-    vehicle_config_.rotors[2].position_body[2] = 0.0;
-    vehicle_config_.rotors[2].axis_body[0] = 0.0;
-    vehicle_config_.rotors[2].axis_body[1] = 0.0;
-    vehicle_config_.rotors[2].axis_body[2] = -1.0;
-    vehicle_config_.rotors[2].direction = 1.0;  // CW
-    vehicle_config_.rotors[2].thrust_coeff = 1.2e-6;
-    vehicle_config_.rotors[2].torque_coeff = 2.5e-8;
-
-    // Rotor 3: Back-right
-    vehicle_config_.rotors[3].position_body[0] = -diag;
-    vehicle_config_.rotors[3].position_body[1] = diag;
-    vehicle_config_.rotors[3].position_body[2] = 0.0;
-    vehicle_config_.rotors[3].axis_body[0] = 0.0;
-    vehicle_config_.rotors[3].axis_body[1] = 0.0;
-    vehicle_config_.rotors[3].axis_body[2] = -1.0;
-    vehicle_config_.rotors[3].direction = -1.0;  // CCW
-    vehicle_config_.rotors[3].thrust_coeff = 1.2e-6;
-    vehicle_config_.rotors[3].torque_coeff = 2.5e-8;
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::setupRotorConfiguration(const SimulationState& state) {
+    const auto& vehicle = state.vehicle_config;
+    if (vehicle.rotor_table_set) {
+        unrollFor<kRotorCount>([&](auto i) {
+            const SimulationState::RotorGeometry& source = vehicle.rotor_table[i];
+            dm_rotor_config_t& rotor = vehicle_config_.rotors[i];
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                rotor.position_body[axis] = source.position_body_m[axis];
+                rotor.axis_body[axis] = source.axis_body[axis];
+            }
+            rotor.direction = source.direction;
+            rotor.thrust_coeff = source.thrust_coeff;
+            rotor.torque_coeff = source.torque_coeff;
+        });
+        return;
+    }
+
+    // Rotor hubs sit arm_length along each unit arm of the layout table,
+    // all thrusting along body -Z (up in FRD) with alternating spin sense.
+    const double arm_length = vehicle.arm_length;
+    unrollFor<kRotorCount>([&](auto i) {
+        constexpr RotorPlacement placement = Layout::kRotors[i];
+        dm_rotor_config_t& rotor = vehicle_config_.rotors[i];
+        rotor.position_body[0] = arm_length * placement.arm_x;
+        rotor.position_body[1] = arm_length * placement.arm_y;
+        rotor.position_body[2] = 0.0;
+        rotor.axis_body[0] = 0.0;
+        rotor.axis_body[1] = 0.0;
+        rotor.axis_body[2] = -1.0;
+        rotor.direction = placement.direction;
+        rotor.thrust_coeff = state.rotor_config.thrust_coefficient;
+        rotor.torque_coeff = state.rotor_config.torque_coefficient;
+    });
+}
+
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::publishRotorGeometry(SimulationState& state) const {
+    auto& published = state.vehicle_config.rotors;
+    published.fill(SimulationState::RotorGeometry{});
+    unrollFor<kRotorCount>([&](auto i) {
+        const dm_rotor_config_t& rotor = vehicle_config_.rotors[i];
+        auto& out = published[i];
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            out.position_body_m[axis] = rotor.position_body[axis];
+            out.axis_body[axis] = rotor.axis_body[axis];
+        }
+        out.direction = rotor.direction;
+        out.thrust_coeff = rotor.thrust_coeff;
+        out.torque_coeff = rotor.torque_coeff;
+    });
+    ++state.vehicle_config.rotor_geometry_revision;
 }
 
-void QuadcopterDynamicsModule::update(double dt, SimulationState& state) {
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::update(double dt, SimulationState& state) {
     if (!std::isfinite(dt) || dt <= 0.0 || dt > kMaxFrameStepS) {
         state.physics.last_result = static_cast<int>(DM_INVALID_ARGUMENT);
         state.physics.integration_valid = false;
@@ -205,29 +219,73 @@ void QuadcopterDynamicsModule::update(double dt, SimulationState& state) {
     // Copy simulation state to physics state
     copyStateFromSim(state, physics_state_);
 
-    // Prepare motor speeds array
+    // Prepare motor speeds array (actual speeds, after the motor lag). Thrust
+    // and drag torque go with omega², so a rotor at effectiveness e acts as
+    // one spinning sqrt(e) times as fast.
+    const auto& disturbance = state.disturbance;
     double rotor_omega[DM_MAX_ROTORS] = {0};
-    for (size_t i = 0; i < 4; ++i) {
-        rotor_omega[i] = state.motor_commands.omega_rad_s[i];
+    unrollFor<kRotorCount>([&](auto i) {
+        rotor_omega[i] = state.motor_state.omega_rad_s[i];
+        if (disturbance.rotor_effectiveness[i] != 1.0) {
+            rotor_omega[i] *= std::sqrt(std::max(disturbance.rotor_effectiveness[i], 0.0));
+        }
+    });
+
+    if (state.plant_integration.method != active_method_) {
+        // Step-size history from one scheme says nothing about the other.
+        adaptive_.reset();
+        state.plant_integration.trajectory.clear();
+        active_method_ = state.plant_integration.method;
+    }
+    const bool adaptive = active_method_ == SimulationState::PlantIntegration::Method::DormandPrince45;
+
+    // With a wind module in the pipeline the vehicle feels linear drag on its
+    // velocity relative to the air, the wind held over the frame.
+    AirRelativeDrag drag;
+    if (state.wind.active) {
+        drag.coefficient = state.vehicle_config.drag_coefficient;
+        drag.wind_ned = {state.wind_ned.x, state.wind_ned.y, state.wind_ned.z};
+        const glm::dvec3 air_relative(physics_state_.velocity[0] - state.wind_ned.x,
+                                      physics_state_.velocity[1] - state.wind_ned.y,
+                                      physics_state_.velocity[2] - state.wind_ned.z);
+        state.wind.drag_force_ned = -drag.coefficient * air_relative;
     }
 
-    const int substep_count = static_cast<int>(std::ceil(dt / kMaxPhysicsStepS));
-    const double substep_dt = dt / static_cast<double>(substep_count);
-    vehicle_model_.state = physics_state_;
-    for (int substep = 0; substep < substep_count; ++substep) {
-        const dm_result_t result =
-            dm_vehicle_step_rk4_checked(&vehicle_model_, rotor_omega, substep_dt);
-        state.physics.last_result = static_cast<int>(result);
-        state.physics.integration_valid = result == DM_OK;
-        if (result != DM_OK) {
-            ++state.physics.rejected_steps;
-            state.control.paused = true;
+    // External wrench as an impulse ahead of the rotor-driven integration.
+    // The dynamic_models RK4 step has no drag term, so there the drag at the
+    // start of the frame joins the impulse; DP45 integrates it in
+    // vehicleDerivative().
+    glm::dvec3 force_ned = disturbance.force_ned;
+    if (!adaptive) {
+        force_ned += state.wind.drag_force_ned;
+    }
+    if (force_ned != glm::dvec3(0.0) || disturbance.torque_body != glm::dvec3(0.0)) {
+        applyExternalImpulse(force_ned, disturbance.torque_body, dt);
+    }
+
+    if (adaptive) {
+        if (!stepAdaptive(dt, rotor_omega, drag, state)) {
             return;
         }
-        ++state.physics.accepted_steps;
-    }
+    } else {
+        const int substep_count = static_cast<int>(std::ceil(dt / kMaxPhysicsStepS));
+        const double substep_dt = dt / static_cast<double>(substep_count);
+        vehicle_model_.state = physics_state_;
+        for (int substep = 0; substep < substep_count; ++substep) {
+            const dm_result_t result =
+                dm_vehicle_step_rk4_checked(&vehicle_model_, rotor_omega, substep_dt);
+            state.physics.last_result = static_cast<int>(result);
+            state.physics.integration_valid = result == DM_OK;
+            if (result != DM_OK) {
+                ++state.physics.rejected_steps;
+                state.control.paused = true;
+                return;
+            }
+            ++state.physics.accepted_steps;
+        }
 
-    physics_state_ = vehicle_model_.state;
+        physics_state_ = vehicle_model_.state;
+    }
 
     // Copy physics state back to simulation
     copyStateToSim(physics_state_, state);
@@ -236,57 +294,114 @@ void QuadcopterDynamicsModule::update(double dt, SimulationState& state) {
     updateRotorTelemetry(state);
 }
 
-void QuadcopterDynamicsModule::copyStateToSim(const dm_state_t& dm_state, SimulationState& state) {
+template <typename Layout>
+bool MultirotorDynamicsModule<Layout>::stepAdaptive(double dt, const double* rotor_omega,
+                                                    const AirRelativeDrag& drag, SimulationState& state) {
+    SimulationState::PlantIntegration& integration = state.plant_integration;
+    adaptive_.settings.relative_tolerance = integration.relative_tolerance;
+    adaptive_.settings.absolute_tolerance = integration.absolute_tolerance;
+    adaptive_.settings.max_step = std::max(integration.max_step_s, integration.min_step_s);
+    adaptive_.settings.min_step = integration.min_step_s;
+    adaptive_.settings.initial_step = kMaxPhysicsStepS;
+
+    VehicleStateVector<double> x;
+    packVehicleState(physics_state_, x);
+
+    // Rotor speeds and wind are held constant over the frame (zero-order hold).
+    auto rhs = [this, rotor_omega, &drag](double, const VehicleStateVector<double>& y,
+                                          VehicleStateVector<double>& dydt) {
+        vehicleDerivative<kRotorCount>(vehicle_config_, rotor_omega, y, dydt, drag);
+    };
+
+    DormandPrince45<kVehicleStateSize>::Stats stats;
+    const double t1 = state.time_seconds;
+    DenseTrajectory<kVehicleStateSize>* dense = nullptr;
+    if (integration.record_trajectory) {
+        dense = &integration.trajectory;
+    } else {
+        integration.trajectory.clear();
+    }
+    const auto status = adaptive_.integrate(rhs, t1 - dt, t1, x, stats, dense);
+
+    state.physics.accepted_steps += stats.accepted_steps;
+    state.physics.rejected_steps += stats.rejected_steps;
+    integration.derivative_evaluations += stats.derivative_evaluations;
+    integration.last_step_s = adaptive_.suggestedStep();
+
+    if (status != DormandPrince45<kVehicleStateSize>::Status::Ok) {
+        // dynamic_models has no code for an error-control failure; report the
+        // frame as invalid input so the UI shows the same rejected-step path.
+        state.physics.last_result = static_cast<int>(DM_INVALID_ARGUMENT);
+        state.physics.integration_valid = false;
+        ++state.physics.rejected_steps;
+        state.control.paused = true;
+        integration.trajectory.clear();
+        return false;
+    }
+
+    // Project back onto the unit quaternion once per frame.
+    double norm_sq = 0.0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        norm_sq += x[kStateQuaternion + i] * x[kStateQuaternion + i];
+    }
+    const double inv_norm = 1.0 / std::sqrt(norm_sq);
+    for (std::size_t i = 0; i < 4; ++i) {
+        x[kStateQuaternion + i] *= inv_norm;
+    }
+
+    unpackVehicleState(x, physics_state_);
+    vehicle_model_.state = physics_state_;
+
+    // Keep the rotor cache in step with what the dm RK4 path would leave behind.
+    unrollFor<kRotorCount>([&](auto i) {
+        const double omega_sq = rotor_omega[i] * rotor_omega[i];
+        vehicle_model_.rotor_cache[i].omega = rotor_omega[i];
+        vehicle_model_.rotor_cache[i].thrust = vehicle_config_.rotors[i].thrust_coeff * omega_sq;
+        vehicle_model_.rotor_cache[i].torque = vehicle_config_.rotors[i].torque_coeff * omega_sq;
+    });
+
+    state.physics.last_result = static_cast<int>(DM_OK);
+    state.physics.integration_valid = true;
+    return true;
+}
+
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::applyExternalImpulse(const glm::dvec3& force_ned,
+                                                            const glm::dvec3& torque_body, double dt) {
+    const double inv_mass = 1.0 / vehicle_config_.mass;
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        physics_state_.velocity[axis] += force_ned[axis] * inv_mass * dt;
+    }
+    // Body torque: delta omega = I^-1 tau dt (the gyroscopic term is left to the integrator)
+    for (std::size_t row = 0; row < 3; ++row) {
+        double alpha = 0.0;
+        for (std::size_t col = 0; col < 3; ++col) {
+            alpha += vehicle_config_.inertia_inv[row][col] * torque_body[col];
+        }
+        physics_state_.angular_rate[row] += alpha * dt;
+    }
+}
+
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::copyStateToSim(const dm_state_t& dm_state, SimulationState& state) {
     // Position and velocity
     state.physics.position = glm::dvec3(dm_state.position[0], dm_state.position[1], dm_state.position[2]);
     state.physics.velocity = glm::dvec3(dm_state.velocity[0], dm_state.velocity[1], dm_state.velocity[2]);
 
-    // Quaternion
+    // Canonical attitude: quaternion and body rates stay in the plant's units.
+    // Euler/DCM/render views are derived lazily by SimulationState on demand.
     state.quaternion[0] = dm_state.quaternion[0];  // w
     state.quaternion[1] = dm_state.quaternion[1];  // x
     state.quaternion[2] = dm_state.quaternion[2];  // y
     state.quaternion[3] = dm_state.quaternion[3];  // z
+    state.markPoseDirty();
 
-    // Angular rates (body frame)
-    state.angular_rate_deg_per_sec = glm::dvec3(
-        rad2deg(dm_state.angular_rate[0]),
-        rad2deg(dm_state.angular_rate[1]),
-        rad2deg(dm_state.angular_rate[2])
-    );
-
-    // Convert quaternion to Euler angles
-    double q[4] = {dm_state.quaternion[0], dm_state.quaternion[1],
-                   dm_state.quaternion[2], dm_state.quaternion[3]};
-    double roll, pitch, yaw;
-    quaternion_to_euler(q, &roll, &pitch, &yaw);
-
-    state.euler.roll = roll;
-    state.euler.pitch = pitch;
-    state.euler.yaw = yaw;
-    state.euler.order = EULER_ZYX;
-
-    // Keep physics in NED and adapt only at the renderer boundary.
-    double dcm[3][3];
-    quaternion_to_dcm(q, dcm);
-
-    glm::mat4 ned_from_body(1.0f);
-    for (int row = 0; row < 3; ++row) {
-        for (int col = 0; col < 3; ++col) {
-            ned_from_body[col][row] = static_cast<float>(dcm[row][col]);
-        }
-    }
-    const glm::mat4 render_from_ned = renderFromNed();
-    const glm::vec4 position_ned(static_cast<float>(dm_state.position[0]),
-                                 static_cast<float>(dm_state.position[1]),
-                                 static_cast<float>(dm_state.position[2]),
-                                 1.0f);
-    const glm::vec3 position_render = glm::vec3(render_from_ned * position_ned);
-    const glm::mat4 translation = glm::translate(
-        glm::mat4(1.0f), position_render);
-    state.model_matrix = translation * render_from_ned * ned_from_body;
+    state.angular_rate_rad_s = glm::dvec3(
+        dm_state.angular_rate[0], dm_state.angular_rate[1], dm_state.angular_rate[2]);
 }
 
-void QuadcopterDynamicsModule::copyStateFromSim(const SimulationState& state, dm_state_t& dm_state) {
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::copyStateFromSim(const SimulationState& state, dm_state_t& dm_state) {
     // Position and velocity
     dm_state.position[0] = state.physics.position.x;
     dm_state.position[1] = state.physics.position.y;
@@ -303,17 +418,18 @@ void QuadcopterDynamicsModule::copyStateFromSim(const SimulationState& state, dm
     dm_state.quaternion[3] = state.quaternion[3];
 
     // Angular rates
-    dm_state.angular_rate[0] = deg2rad(state.angular_rate_deg_per_sec.x);
-    dm_state.angular_rate[1] = deg2rad(state.angular_rate_deg_per_sec.y);
-    dm_state.angular_rate[2] = deg2rad(state.angular_rate_deg_per_sec.z);
+    dm_state.angular_rate[0] = state.angular_rate_rad_s.x;
+    dm_state.angular_rate[1] = state.angular_rate_rad_s.y;
+    dm_state.angular_rate[2] = state.angular_rate_rad_s.z;
 }
 
-void QuadcopterDynamicsModule::updateRotorTelemetry(SimulationState& state) {
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::updateRotorTelemetry(SimulationState& state) {
     // Update rotor telemetry from cached values in vehicle_model
     double total_thrust = 0.0;
     double total_power = 0.0;
 
-    for (size_t i = 0; i < 4; ++i) {
+    unrollFor<kRotorCount>([&](auto i) {
         const auto& rotor = vehicle_model_.rotor_cache[i];
         double omega = rotor.omega;
 
@@ -328,8 +444,30 @@ void QuadcopterDynamicsModule::updateRotorTelemetry(SimulationState& state) {
 
         // Power = Torque * Omega
         total_power += rotor.torque * omega;
-    }
+    });
 
     state.rotor.total_thrust_newton = total_thrust;
     state.rotor.total_power_watt = total_power;
 }
+
+template <typename Layout>
+void MultirotorDynamicsModule<Layout>::checkpoint(ModuleCheckpoint& archive) {
+    // physics_state_ is reloaded from SimulationState at the start of every update.
+    double next_step = adaptive_.suggestedStep();
+    archive.io(next_step);
+    archive.io(active_method_);
+    if (archive.loading()) {
+        adaptive_.restoreStep(next_step);
+    }
+}
+
+template class MultirotorDynamicsModule<QuadXLayout>;
+template class MultirotorDynamicsModule<QuadPlusLayout>;
+template class MultirotorDynamicsModule<HexXLayout>;
+template class MultirotorDynamicsModule<OctoXLayout>;
+
+std::unique_ptr<Module> makeMultirotorDynamicsModule(SimulationState::Airframe airframe) {
+    return visitAirframe(airframe, [](auto layout) -> std::unique_ptr<Module> {
+        return std::make_unique<MultirotorDynamicsModule<decltype(layout)>>();
+    });
+}
@@ -1,71 +1,137 @@
 /**
  * @file quadcopter_dynamics.h
- * @brief Physics-based quadcopter dynamics simulation module
+ * @brief Physics-based multirotor dynamics simulation module
  *
  * Integrates the dynamic_models library to provide realistic 6-DOF rigid-body
  * dynamics with rotor aerodynamics, gravity, and drag. Replaces the simple
  * QuaternionDemoModule with full Newton-Euler equations of motion.
+ *
+ * The module is templated on an airframe layout (see airframe_layout.h) so
+ * the rotor count is a compile-time constant and every per-rotor loop is
+ * unrolled; quad-X, quad-+, hex and octo instantiations are provided.
  */
 
 #ifndef MODULES_QUADCOPTER_DYNAMICS_H
 #define MODULES_QUADCOPTER_DYNAMICS_H
 
+#include <cstddef>
+#include <memory>
+
+#include "core/dormand_prince.h"
 #include "core/module.h"
+#include "core/simulation_state.h"
 #include "drone/physics_model.h"
+#include "modules/airframe_layout.h"
+#include "modules/vehicle_derivative.h"
 
 /**
- * @class QuadcopterDynamicsModule
- * @brief Physics-based quadcopter simulation using dynamic_models library
+ * @class MultirotorDynamicsModule
+ * @brief Physics-based multirotor simulation using dynamic_models library
  *
  * Features:
  * - 6-DOF rigid-body dynamics (position, velocity, orientation, angular rates)
  * - Newton-Euler equations with quaternion kinematics
  * - Individual rotor thrust/torque modeling
- * - Gravity, drag, and gyroscopic effects
- * - RK4 numerical integration for accuracy
- * - Configurable vehicle parameters (mass, inertia, rotor layout)
+ * - Gravity, air-relative drag (with WindFieldModule), and gyroscopic effects;
+ *   drag is part of vehicleDerivative() under DP45 and an impulse under RK4
+ * - Fixed-step RK4 (dynamic_models) or adaptive Dormand-Prince RK45 with
+ *   dense output, selected via state.plant_integration.method
+ * - Configurable vehicle parameters (mass, inertia, rotor geometry), also
+ *   in flight through configure(); rotor count fixed at compile time by
+ *   the Layout parameter
  *
  * Usage:
  *   - Call initialize() to set up vehicle configuration
  *   - Call update(dt, state) each frame to propagate physics
- *   - Motor commands from state.motor_commands are used as control inputs
- *   - Physics state is written to state.physics and state.quaternion
+ *   - Actual rotor speeds from state.motor_state are used as control inputs
+ *     (MotorDynamicsModule lags them behind state.motor_commands)
+ *   - Physics state is written to state.physics, state.quaternion and
+ *     state.angular_rate_rad_s; derived attitude views are left dirty
+ *
+ * @tparam Layout Airframe geometry table (QuadXLayout, QuadPlusLayout, HexXLayout, OctoXLayout)
  */
-class QuadcopterDynamicsModule : public Module {
+template <typename Layout>
+class MultirotorDynamicsModule : public Module {
 public:
-    QuadcopterDynamicsModule() = default;
-    ~QuadcopterDynamicsModule() override = default;
+    static constexpr std::size_t kRotorCount = Layout::kRotorCount;
+    static_assert(kRotorCount <= DM_MAX_ROTORS, "Layout exceeds dynamic_models rotor capacity");
+    static_assert(kRotorCount <= SimulationState::kMaxRotors, "Layout exceeds SimulationState rotor arrays");
+
+    MultirotorDynamicsModule() = default;
+    ~MultirotorDynamicsModule() override = default;
 
     /**
      * @brief Initialize vehicle configuration and physics model
      *
      * Sets up:
-     * - Quadcopter mass and inertia tensor
-     * - Rotor positions in body frame (X configuration)
+     * - Vehicle mass and inertia tensor
+     * - Rotor positions in body frame from Layout::kRotors
+     * - state.vehicle_config.airframe / rotor_count
      * - Thrust/torque coefficients
-     * - Initial hover state (motors spun up to hover thrust)
+     * - Initial hover state (motors spun up to the solveTrim() hover
+     *   speeds, published in state.trim)
      */
     void initialize(SimulationState& state) override;
 
     /**
      * @brief Update physics simulation by dt seconds
      *
-     * Integrates equations of motion using RK4:
-     * - Reads motor commands from state.motor_commands
+     * Integrates equations of motion with the selected scheme:
+     * - Reads actual rotor speeds from state.motor_state
      * - Computes forces/torques from rotors + gravity + drag
      * - Integrates state derivatives (ṗ, v̇, q̇, ω̇)
-     * - Updates state.physics, state.quaternion, state.euler
+     * - Updates state.physics, state.quaternion, state.angular_rate_rad_s
      * - Updates state.rotor telemetry
      *
      * @param dt Time step in seconds
-     * @param state Simulation state (read motor_commands, write physics)
+     * @param state Simulation state (read motor_state, write physics)
      */
     void update(double dt, SimulationState& state) override;
 
+    const char* name() const override { return "Plant"; }
+
+    /// Saves the integrator choice and the adaptive step-size history
+    void checkpoint(ModuleCheckpoint& archive) override;
+
+    unsigned configSections() const override { return ConfigSection::kVehicle | ConfigSection::kRotors; }
+
+    /**
+     * @brief Take new mass, inertia and rotor geometry from the state in flight
+     *
+     * Rebuilds the physical parameters and rotor table, republishes the
+     * geometry (controllers rebuild their allocators on the revision bump)
+     * and re-solves state.trim. Position, velocity, attitude and rotor
+     * speeds carry on unchanged.
+     */
+    void configure(SimulationState& state) override;
+
 private:
     dm_vehicle_config_t vehicle_config_;    ///< Vehicle physical parameters
     dm_vehicle_model_t vehicle_model_;      ///< Runtime physics model
     dm_state_t physics_state_;              ///< Current vehicle state for dm library
+    DormandPrince45<kVehicleStateSize> adaptive_; ///< Adaptive stepper (keeps step-size history)
+    SimulationState::PlantIntegration::Method active_method_{
+        SimulationState::PlantIntegration::Method::FixedRk4}; ///< Scheme used on the last frame
+
+    /**
+     * @brief Advance physics_state_ by dt with adaptive Dormand-Prince steps
+     *
+     * Fills state.plant_integration.trajectory with the dense output of the
+     * frame when record_trajectory is set, and updates the accepted/rejected
+     * counters. Drag is integrated
+     * with the rest of the derivative, so error control covers it.
+     *
+     * @return false if error control could not be satisfied (state not committed)
+     */
+    bool stepAdaptive(double dt, const double* rotor_omega, const AirRelativeDrag& drag, SimulationState& state);
+
+    /**
+     * @brief Add dt worth of an external wrench to physics_state_'s velocity and body rates
+     *
+     * Called before the frame is integrated, so the impulse leads the
+     * rotor-driven step rather than following it.
+     */
+    void applyExternalImpulse(const glm::dvec3& force_ned, const glm::dvec3& torque_body, double dt);
 
     /**
      * @brief Copy dm_state to SimulationState
@@ -78,9 +144,29 @@ private:
     void copyStateFromSim(const SimulationState& state, dm_state_t& dm_state);
 
     /**
-     * @brief Configure standard X-frame quadcopter rotor layout
+     * @brief Copy mass, gravity and inertia from state.vehicle_config into vehicle_config_
+     */
+    void loadVehicleParameters(const SimulationState& state);
+
+    /**
+     * @brief Fill vehicle_config_.rotors from the configured rotor table, or the layout table
+     *
+     * Layout rotors sit vehicle_config.arm_length along each arm with the
+     * RotorConfig coefficients; a rotor_table set by a config file replaces them.
+     */
+    void setupRotorConfiguration(const SimulationState& state);
+
+    /**
+     * @brief Copy vehicle_config_.rotors into state.vehicle_config.rotors and bump its revision
      */
-    void setupRotorConfiguration();
+    void publishRotorGeometry(SimulationState& state) const;
+
+    /**
+     * @brief Solve the hover equilibrium of vehicle_config_ into state.trim
+     *
+     * Falls back to the closed-form equal-speed hover if Newton fails.
+     */
+    void trimHover(SimulationState& state) const;
 
     /**
      * @brief Update rotor telemetry from physics model
@@ -88,4 +174,19 @@ private:
     void updateRotorTelemetry(SimulationState& state);
 };
 
+extern template class MultirotorDynamicsModule<QuadXLayout>;
+extern template class MultirotorDynamicsModule<QuadPlusLayout>;
+extern template class MultirotorDynamicsModule<HexXLayout>;
+extern template class MultirotorDynamicsModule<OctoXLayout>;
+
+/// The default airframe: X-frame quadcopter
+using QuadcopterDynamicsModule = MultirotorDynamicsModule<QuadXLayout>;
+using HexacopterDynamicsModule = MultirotorDynamicsModule<HexXLayout>;
+using OctocopterDynamicsModule = MultirotorDynamicsModule<OctoXLayout>;
+
+/**
+ * @brief Create the plant instantiation matching a runtime airframe selection
+ */
+std::unique_ptr<Module> makeMultirotorDynamicsModule(SimulationState::Airframe airframe);
+
 #endif // MODULES_QUADCOPTER_DYNAMICS_H
@@ -5,9 +5,8 @@
 #include <glm/glm.hpp>
 
 #include "attitude/euler.h"
-#include "attitude/dcm.h"
-#include "attitude/quaternion.h"
 #include "attitude/attitude_utils.h"
+#include "core/attitude_history.h"
 #include "core/simulation_state.h"
 
 namespace {
@@ -25,13 +24,8 @@ void normalize_angle(double& angle) {
 }  // namespace
 
 void QuaternionDemoModule::initialize(SimulationState& state) {
-    state.euler.roll = 0.0;
-    state.euler.pitch = 0.0;
-    state.euler.yaw = 0.0;
-    state.euler.order = EULER_ZYX;
-    state.quaternion = {1.0, 0.0, 0.0, 0.0};
-    state.model_matrix = glm::mat4(1.0f);
-    state.angular_rate_deg_per_sec = glm::dvec3(0.0, 0.0, 30.0);
+    state.setAttitude({1.0, 0.0, 0.0, 0.0});
+    state.angular_rate_rad_s = glm::dvec3(0.0, 0.0, deg2rad(30.0));
 }
 
 void QuaternionDemoModule::update(double dt, SimulationState& state) {
@@ -41,60 +35,21 @@ void QuaternionDemoModule::update(double dt, SimulationState& state) {
 
     state.time_seconds += dt;
 
-    glm::dvec3 rates = state.angular_rate_deg_per_sec;
+    const glm::dvec3& rates = state.angular_rate_rad_s;
 
-    const double roll_increment = deg2rad(rates.x) * dt;
-    const double pitch_increment = deg2rad(rates.y) * dt;
-    const double yaw_increment = deg2rad(rates.z) * dt;
+    EulerAngles euler = state.euler();
+    euler.roll += rates.x * dt;
+    euler.pitch += rates.y * dt;
+    euler.yaw += rates.z * dt;
 
-    state.euler.roll += roll_increment;
-    state.euler.pitch += pitch_increment;
-    state.euler.yaw += yaw_increment;
-
-    normalize_angle(state.euler.roll);
-    normalize_angle(state.euler.pitch);
-    normalize_angle(state.euler.yaw);
-
-    double dcm[3][3];
-    euler_to_dcm(&state.euler, dcm);
-
-    glm::mat4 model(1.0f);
-    for (int row = 0; row < 3; ++row) {
-        for (int col = 0; col < 3; ++col) {
-            model[col][row] = static_cast<float>(dcm[row][col]);
-        }
-    }
-    state.model_matrix = model;
+    normalize_angle(euler.roll);
+    normalize_angle(euler.pitch);
+    normalize_angle(euler.yaw);
 
     double q[4];
-    euler_to_quaternion(&state.euler, q);
-    state.quaternion = {q[0], q[1], q[2], q[3]};
+    euler_to_quaternion(&euler, q);
+    state.setAttitude({q[0], q[1], q[2], q[3]});
 
     // Capture attitude history for plotting
-    if (state.time_seconds - state.attitude_history.last_sample_time >= state.attitude_history.sample_interval) {
-        SimulationState::AttitudeSample sample;
-        sample.timestamp = state.time_seconds;
-        sample.quaternion = state.quaternion;
-        sample.roll = state.euler.roll;
-        sample.pitch = state.euler.pitch;
-        sample.yaw = state.euler.yaw;
-        sample.angular_rate = glm::dvec3(
-            deg2rad(state.angular_rate_deg_per_sec.x),
-            deg2rad(state.angular_rate_deg_per_sec.y),
-            deg2rad(state.angular_rate_deg_per_sec.z)
-        );
-
-        state.attitude_history.samples.push_back(sample);
-        state.attitude_history.last_sample_time = state.time_seconds;
-
-        // Prune old samples
-        while (!state.attitude_history.samples.empty()) {
-            double age = state.time_seconds - state.attitude_history.samples.front().timestamp;
-            if (age > state.attitude_history.window_seconds) {
-                state.attitude_history.samples.pop_front();
-            } else {
-                break;
-            }
-        }
-    }
+    captureAttitudeSample(state);
 }
@@ -14,9 +14,8 @@
  *
  * This module updates the vehicle's attitude quaternion based on the angular
  * velocity specified in SimulationState. It demonstrates quaternion-based
- * rotational kinematics and converts the quaternion to:
- * - Euler angles (for display)
- * - Rotation matrix (for 3D rendering)
+ * rotational kinematics; Euler angles and the render matrix are derived
+ * lazily by SimulationState from the quaternion it writes.
  *
  * The integration uses a simple Euler method with quaternion normalization
  * to prevent numerical drift.
@@ -36,13 +35,15 @@ public:
      * q_dot = 0.5 * omega * q
      *
      * Where omega is the angular velocity quaternion [0, wx, wy, wz].
-     * The result is normalized and converted to Euler angles and rotation matrix.
+     * The result is normalized and written back through setAttitude().
      *
      * @param dt Time step (seconds)
-     * @param state Reference to simulation state (reads angular_rate_deg_per_sec,
-     *              writes quaternion, euler, model_matrix)
+     * @param state Reference to simulation state (reads angular_rate_rad_s,
+     *              writes quaternion)
      */
     void update(double dt, SimulationState& state) override;
+
+    const char* name() const override { return "Quaternion demo"; }
 };
 
 #endif // QUATERNION_DEMO_H
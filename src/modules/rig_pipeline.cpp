@@ -0,0 +1,31 @@
+#include "modules/rig_pipeline.h"
+
+#include <memory>
+
+#include "modules/attitude_controller.h"
+#include "modules/complementary_estimator.h"
+#include "modules/first_order_dynamics.h"
+#include "modules/lqr_controller.h"
+#include "modules/motor_dynamics.h"
+#include "modules/mpc_controller.h"
+#include "modules/quadcopter_dynamics.h"
+#include "modules/rotor_telemetry.h"
+#include "modules/sensor_simulator.h"
+#include "modules/sitl_bridge.h"
+#include "modules/wind_field.h"
+
+void addRigModules(ModuleScheduler& modules, SimulationState::Airframe airframe) {
+    // Controllers and motor lag run before the plant so it integrates this
+    // step's actual rotor speeds
+    modules.add(makeAttitudeControllerModule(airframe));
+    modules.add(makeLqrControllerModule(airframe));
+    modules.add(makeMpcControllerModule(airframe));
+    modules.add(std::make_unique<SitlBridgeModule>());     // External mode: commands from firmware
+    modules.add(std::make_unique<WindFieldModule>());      // Air velocity for the plant's drag
+    modules.add(makeMotorDynamicsModule(airframe));
+    modules.add(makeMultirotorDynamicsModule(airframe));
+    modules.add(std::make_unique<FirstOrderDynamicsModule>());
+    modules.add(std::make_unique<SensorSimulatorModule>());
+    modules.add(std::make_unique<ComplementaryEstimatorModule>());
+    modules.add(makeRotorTelemetryModule(airframe));
+}
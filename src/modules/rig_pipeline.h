@@ -0,0 +1,23 @@
+/**
+ * @file rig_pipeline.h
+ * @brief The rig's standard module pipeline, shared by the GUI and headless runs
+ */
+
+#ifndef MODULES_RIG_PIPELINE_H
+#define MODULES_RIG_PIPELINE_H
+
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+
+/**
+ * @brief Append the full vehicle pipeline for an airframe, in the rig's order
+ *
+ * Controllers (each at its own fixed rate; the active mode picks which one
+ * writes the commands), the SITL bridge, wind, motor lag, plant, first-order
+ * test system, sensors, estimator and rotor telemetry. Anything that must
+ * act before the controllers (a ScenarioPlayerModule) is added first.
+ * The caller initializes the scheduler.
+ */
+void addRigModules(ModuleScheduler& modules, SimulationState::Airframe airframe);
+
+#endif // MODULES_RIG_PIPELINE_H
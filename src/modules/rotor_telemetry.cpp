@@ -3,44 +3,29 @@
 #include <cmath>
 #include <limits>
 
-#include "core/simulation_state.h"
+#include "core/memory_accounting.h"
+#include "core/unroll.h"
+#include "modules/airframe_layout.h"
 
-void RotorTelemetryModule::initialize(SimulationState& state) {
+template <std::size_t RotorCount>
+void MultirotorTelemetryModule<RotorCount>::initialize(SimulationState& state) {
     // Initialize history buffers
-    for (int i = 0; i < 4; ++i) {
-        state.rotor_history.window_seconds = 60.0;
-        state.rotor_history.sample_interval = 0.1; // 10 Hz sampling
-        state.rotor_history.last_sample_time = -std::numeric_limits<double>::infinity();
+    state.rotor_history.window_seconds = 60.0;
+    state.rotor_history.sample_interval = 0.1; // 10 Hz sampling
+    state.rotor_history.last_sample_time = -std::numeric_limits<double>::infinity();
+    for (auto& samples : state.rotor_history.rotors) {
+        samples.clear();
     }
 }
 
-void RotorTelemetryModule::update(double dt, SimulationState& state) {
-    // Capture rotor telemetry to history buffers (data comes from QuadcopterDynamicsModule)
-    if (state.time_seconds - state.rotor_history.last_sample_time >= state.rotor_history.sample_interval) {
-        // Sample each rotor
-        for (int i = 0; i < 4; ++i) {
-            SimulationState::RotorSample sample;
-            sample.timestamp = state.time_seconds;
-            sample.rpm = state.rotor.rpm[i];
-            sample.thrust = state.rotor.thrust_newton[i];
-            sample.power = state.rotor.total_power_watt / 4.0; // Divide total by 4 for now
-            sample.temperature = 25.0 + (sample.power * 0.1); // Simple thermal model
-            sample.voltage = state.power.bus_voltage;
-            sample.current = (sample.power > 0) ? (sample.power / sample.voltage) : 0.0;
-
-            // Add to appropriate rotor history
-            switch (i) {
-                case 0: state.rotor_history.rotor1_samples.push_back(sample); break;
-                case 1: state.rotor_history.rotor2_samples.push_back(sample); break;
-                case 2: state.rotor_history.rotor3_samples.push_back(sample); break;
-                case 3: state.rotor_history.rotor4_samples.push_back(sample); break;
-            }
-        }
+template <std::size_t RotorCount>
+void MultirotorTelemetryModule<RotorCount>::update(double dt, SimulationState& state) {
+    // Capture rotor telemetry to history buffers (data comes from the multirotor plant)
+    auto& history = state.rotor_history;
+    if (state.time_seconds - history.last_sample_time >= history.sample_interval * history.decimation) {
+        const double power_per_rotor = state.rotor.total_power_watt / static_cast<double>(RotorCount);
 
-        state.rotor_history.last_sample_time = state.time_seconds;
-
-        // Prune old samples for all rotors
-        auto prune_samples = [&](std::deque<SimulationState::RotorSample>& samples) {
+        auto prune_samples = [&](SimulationState::RotorHistory::Samples& samples) {
             while (!samples.empty()) {
                 double age = state.time_seconds - samples.front().timestamp;
                 if (age > state.rotor_history.window_seconds) {
@@ -51,13 +36,42 @@ void RotorTelemetryModule::update(double dt, SimulationState& state) {
             }
         };
 
-        prune_samples(state.rotor_history.rotor1_samples);
-        prune_samples(state.rotor_history.rotor2_samples);
-        prune_samples(state.rotor_history.rotor3_samples);
-        prune_samples(state.rotor_history.rotor4_samples);
+        // Sample each rotor, then prune old samples from its history
+        unrollFor<RotorCount>([&](auto i) {
+            SimulationState::RotorSample sample;
+            sample.timestamp = state.time_seconds;
+            sample.rpm = state.rotor.rpm[i];
+            sample.thrust = state.rotor.thrust_newton[i];
+            sample.power = power_per_rotor; // Even split of the total for now
+            sample.temperature = 25.0 + (sample.power * 0.1); // Simple thermal model
+            sample.voltage = state.power.bus_voltage;
+            sample.current = (sample.power > 0) ? (sample.power / sample.voltage) : 0.0;
+
+            auto& samples = state.rotor_history.rotors[i];
+            samples.push_back(sample);
+            prune_samples(samples);
+        });
+
+        history.last_sample_time = state.time_seconds;
+
+        // All rotors share one sampling rate, so they shed samples together.
+        const MemoryCapAction action = memoryCapAction(MemoryTag::History, history.decimation);
+        unrollFor<RotorCount>([&](auto i) {
+            applyMemoryCapAction(action, history.rotors[i]);
+        });
     }
 
     // Update power consumption metrics
     state.power.bus_current = state.rotor.total_power_watt / state.power.bus_voltage;
     state.power.energy_joule += state.rotor.total_power_watt * dt;
 }
+
+template class MultirotorTelemetryModule<4>;
+template class MultirotorTelemetryModule<6>;
+template class MultirotorTelemetryModule<8>;
+
+std::unique_ptr<Module> makeRotorTelemetryModule(SimulationState::Airframe airframe) {
+    return visitAirframe(airframe, [](auto layout) -> std::unique_ptr<Module> {
+        return std::make_unique<MultirotorTelemetryModule<decltype(layout)::kRotorCount>>();
+    });
+}
@@ -6,10 +6,14 @@
 #ifndef ROTOR_TELEMETRY_H
 #define ROTOR_TELEMETRY_H
 
+#include <cstddef>
+#include <memory>
+
 #include "core/module.h"
+#include "core/simulation_state.h"
 
 /**
- * @class RotorTelemetryModule
+ * @class MultirotorTelemetryModule
  * @brief Computes rotor thrust, torque, and power from RPM measurements
  *
  * This module calculates performance metrics for a quadcopter's rotors
@@ -30,11 +34,19 @@
  * - Add rotor dynamics (lag between command and actual RPM)
  * - Include motor voltage/current modeling
  *
+ * The rotor count is a template parameter so sampling into the per-rotor
+ * history is unrolled for each supported airframe.
+ *
+ * @tparam RotorCount Number of active rotors (4, 6 or 8)
+ *
  * @see SimulationState::RotorConfig
  * @see SimulationState::RotorTelemetry
  */
-class RotorTelemetryModule : public Module {
+template <std::size_t RotorCount>
+class MultirotorTelemetryModule : public Module {
 public:
+    static_assert(RotorCount <= SimulationState::kMaxRotors, "Rotor count exceeds SimulationState rotor arrays");
+
     /**
      * @brief Initialize rotor parameters
      * @param state Reference to simulation state
@@ -53,9 +65,23 @@ public:
      */
     void update(double dt, SimulationState& state) override;
 
+    const char* name() const override { return "Telemetry"; }
+
 private:
     double base_rpm_{1500.0}; ///< Baseline RPM for synthetic data generation
     double phase_{0.0};       ///< Phase accumulator for sinusoidal RPM variation
 };
 
+extern template class MultirotorTelemetryModule<4>;
+extern template class MultirotorTelemetryModule<6>;
+extern template class MultirotorTelemetryModule<8>;
+
+/// Telemetry for the default quadcopter airframe
+using RotorTelemetryModule = MultirotorTelemetryModule<4>;
+
+/**
+ * @brief Create the telemetry instantiation matching a runtime airframe selection
+ */
+std::unique_ptr<Module> makeRotorTelemetryModule(SimulationState::Airframe airframe);
+
 #endif // ROTOR_TELEMETRY_H
@@ -0,0 +1,487 @@
+#include "modules/scenario_player.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "core/module_checkpoint.h"
+
+namespace {
+
+constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+constexpr std::size_t kRotors = SimulationState::kMaxRotors;
+constexpr std::size_t kModeCount = 6;
+
+using Group = ScenarioVariable::Group;
+using Mode = SimulationState::ControllerConfig::Mode;
+
+/// Names of ControllerConfig::Mode, in enum order
+const char* const kModeNames[kModeCount] = {"off", "rate", "attitude", "lqr", "mpc", "external"};
+
+const ScenarioVariable kVariables[] = {
+    // Setpoints
+    {"roll_deg", Group::Setpoint, 1, kDegToRad,
+     [](const SimulationState& s, std::size_t) { return s.controller_setpoint.roll_rad; },
+     [](SimulationState& s, std::size_t, double v) { s.controller_setpoint.roll_rad = v; }},
+    {"pitch_deg", Group::Setpoint, 1, kDegToRad,
+     [](const SimulationState& s, std::size_t) { return s.controller_setpoint.pitch_rad; },
+     [](SimulationState& s, std::size_t, double v) { s.controller_setpoint.pitch_rad = v; }},
+    {"yaw_deg", Group::Setpoint, 1, kDegToRad,
+     [](const SimulationState& s, std::size_t) { return s.controller_setpoint.yaw_rad; },
+     [](SimulationState& s, std::size_t, double v) { s.controller_setpoint.yaw_rad = v; }},
+    {"rate_deg_s", Group::Setpoint, 3, kDegToRad,
+     [](const SimulationState& s, std::size_t i) { return s.controller_setpoint.rate_rad_s[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.controller_setpoint.rate_rad_s[i] = v; }},
+    {"position_ned", Group::Setpoint, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.controller_setpoint.position_ned[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.controller_setpoint.position_ned[i] = v; }},
+    {"thrust_n", Group::Setpoint, 1, 1.0,
+     [](const SimulationState& s, std::size_t) { return s.controller_setpoint.collective_thrust_newton; },
+     [](SimulationState& s, std::size_t, double v) { s.controller_setpoint.collective_thrust_newton = v; }},
+
+    // Disturbances and faults
+    {"force_ned", Group::Disturbance, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.disturbance.force_ned[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.disturbance.force_ned[i] = v; }},
+    {"torque_body", Group::Disturbance, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.disturbance.torque_body[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.disturbance.torque_body[i] = v; }},
+    {"rotor_effectiveness", Group::Fault, kRotors, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.disturbance.rotor_effectiveness[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.disturbance.rotor_effectiveness[i] = v; }},
+
+    // Parameters (only those the modules read on every update)
+    {"controller.mode", Group::Parameter, 1, 1.0,
+     [](const SimulationState& s, std::size_t) { return static_cast<double>(s.controller_config.mode); },
+     [](SimulationState& s, std::size_t, double v) { s.controller_config.mode = static_cast<Mode>(static_cast<int>(v)); }},
+    {"controller.attitude_kp", Group::Parameter, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.controller_config.attitude_kp[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.controller_config.attitude_kp[i] = v; }},
+    {"controller.rate_kp", Group::Parameter, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.controller_config.rate_kp[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.controller_config.rate_kp[i] = v; }},
+    {"controller.rate_ki", Group::Parameter, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.controller_config.rate_ki[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.controller_config.rate_ki[i] = v; }},
+    {"controller.rate_kd", Group::Parameter, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.controller_config.rate_kd[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.controller_config.rate_kd[i] = v; }},
+    {"controller.rate_ff", Group::Parameter, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.controller_config.rate_ff[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.controller_config.rate_ff[i] = v; }},
+    {"controller.d_cutoff_hz", Group::Parameter, 1, 1.0,
+     [](const SimulationState& s, std::size_t) { return s.controller_config.d_cutoff_hz; },
+     [](SimulationState& s, std::size_t, double v) { s.controller_config.d_cutoff_hz = v; }},
+    {"controller.max_rate_deg_s", Group::Parameter, 3, kDegToRad,
+     [](const SimulationState& s, std::size_t i) { return s.controller_config.max_rate_rad_s[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.controller_config.max_rate_rad_s[i] = v; }},
+    {"controller.max_accel_rad_s2", Group::Parameter, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.controller_config.max_accel_rad_s2[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.controller_config.max_accel_rad_s2[i] = v; }},
+    {"motor.time_constant_s", Group::Parameter, kRotors, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.motor_config.time_constant_s[i]; },
+     [](SimulationState& s, std::size_t i, double v) { s.motor_config.time_constant_s[i] = v; }},
+    {"motor.omega_min_rad_s", Group::Parameter, 1, 1.0,
+     [](const SimulationState& s, std::size_t) { return s.motor_config.omega_min_rad_s; },
+     [](SimulationState& s, std::size_t, double v) { s.motor_config.omega_min_rad_s = v; }},
+    {"motor.omega_max_rad_s", Group::Parameter, 1, 1.0,
+     [](const SimulationState& s, std::size_t) { return s.motor_config.omega_max_rad_s; },
+     [](SimulationState& s, std::size_t, double v) { s.motor_config.omega_max_rad_s = v; }},
+    {"dynamics.input_target", Group::Parameter, 1, 1.0,
+     [](const SimulationState& s, std::size_t) { return s.dynamics_config.input_target; },
+     [](SimulationState& s, std::size_t, double v) { s.dynamics_config.input_target = v; }},
+    {"dynamics.gain", Group::Parameter, 1, 1.0,
+     [](const SimulationState& s, std::size_t) { return s.dynamics_config.gain; },
+     [](SimulationState& s, std::size_t, double v) { s.dynamics_config.gain = v; }},
+    {"dynamics.time_constant", Group::Parameter, 1, 1.0,
+     [](const SimulationState& s, std::size_t) { return s.dynamics_config.time_constant; },
+     [](SimulationState& s, std::size_t, double v) { s.dynamics_config.time_constant = v; }},
+
+    // Signals
+    {"roll_deg", Group::Signal, 1, kDegToRad,
+     [](const SimulationState& s, std::size_t) { return s.euler().roll; }, nullptr},
+    {"pitch_deg", Group::Signal, 1, kDegToRad,
+     [](const SimulationState& s, std::size_t) { return s.euler().pitch; }, nullptr},
+    {"yaw_deg", Group::Signal, 1, kDegToRad,
+     [](const SimulationState& s, std::size_t) { return s.euler().yaw; }, nullptr},
+    {"rate_deg_s", Group::Signal, 3, kDegToRad,
+     [](const SimulationState& s, std::size_t i) { return s.angular_rate_rad_s[i]; }, nullptr},
+    {"position_ned", Group::Signal, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.physics.position[i]; }, nullptr},
+    {"velocity_ned", Group::Signal, 3, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.physics.velocity[i]; }, nullptr},
+    {"altitude_m", Group::Signal, 1, 1.0,
+     [](const SimulationState& s, std::size_t) { return -s.physics.position.z; }, nullptr},
+    {"rotor_omega_rad_s", Group::Signal, kRotors, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.motor_state.omega_rad_s[i]; }, nullptr},
+    {"rotor_thrust_n", Group::Signal, kRotors, 1.0,
+     [](const SimulationState& s, std::size_t i) { return s.rotor.thrust_newton[i]; }, nullptr},
+    {"estimator_roll_deg", Group::Signal, 1, kDegToRad,
+     [](const SimulationState& s, std::size_t) { return s.estimator.euler.roll; }, nullptr},
+    {"estimator_pitch_deg", Group::Signal, 1, kDegToRad,
+     [](const SimulationState& s, std::size_t) { return s.estimator.euler.pitch; }, nullptr},
+};
+
+constexpr std::size_t kVariableCount = sizeof(kVariables) / sizeof(kVariables[0]);
+
+std::size_t findVariable(const std::string& name, Group group) {
+    for (std::size_t i = 0; i < kVariableCount; ++i) {
+        if (kVariables[i].group == group && name == kVariables[i].name) {
+            return i;
+        }
+    }
+    return kVariableCount;
+}
+
+/// Setpoints are in rewind keyframes; everything else a script writes is rebuilt after a load
+bool rebuiltAfterLoad(const ScenarioEvent& event) {
+    const Group group = kVariables[event.variable].group;
+    return event.kind == ScenarioEvent::Kind::Set &&
+           (group == Group::Parameter || group == Group::Disturbance || group == Group::Fault);
+}
+
+/// Assertions read signals by bare name and anything else by its verb prefix
+std::size_t findAssertVariable(const std::string& name) {
+    static const std::pair<const char*, Group> kPrefixes[] = {
+        {"setpoint.", Group::Setpoint}, {"disturbance.", Group::Disturbance}, {"fault.", Group::Fault}};
+    for (const auto& prefix : kPrefixes) {
+        const std::size_t length = std::strlen(prefix.first);
+        if (name.compare(0, length, prefix.first) == 0) {
+            return findVariable(name.substr(length), prefix.second);
+        }
+    }
+    const std::size_t signal = findVariable(name, Group::Signal);
+    return signal != kVariableCount ? signal : findVariable(name, Group::Parameter);
+}
+
+bool parseNumber(const std::string& token, double& value) {
+    char* end = nullptr;
+    value = std::strtod(token.c_str(), &end);
+    return !token.empty() && end == token.c_str() + token.size() && std::isfinite(value);
+}
+
+/// Split "name[i]" into name and index; a bare name leaves has_index false
+bool parseTarget(const std::string& token, std::string& name, std::size_t& index, bool& has_index) {
+    const std::size_t open = token.find('[');
+    has_index = open != std::string::npos;
+    if (!has_index) {
+        name = token;
+        return !name.empty();
+    }
+    if (open == 0 || token.back() != ']' || token.size() < open + 3) {
+        return false;
+    }
+    name = token.substr(0, open);
+    char* end = nullptr;
+    const std::string digits = token.substr(open + 1, token.size() - open - 2);
+    const unsigned long parsed = std::strtoul(digits.c_str(), &end, 10);
+    index = static_cast<std::size_t>(parsed);
+    return end == digits.c_str() + digits.size() && digits.find('-') == std::string::npos;
+}
+
+}  // namespace
+
+std::size_t scenarioVariableCount() {
+    return kVariableCount;
+}
+
+const ScenarioVariable& scenarioVariable(std::size_t index) {
+    return kVariables[index];
+}
+
+bool ScenarioScript::parse(const std::string& text) {
+    std::vector<ScenarioEvent> events;
+    double frame_dt = 1.0 / 60.0;
+    double duration = 0.0;
+    std::istringstream lines(text);
+    std::string line;
+    std::uint32_t line_number = 0;
+
+    auto fail = [&](const std::string& message) {
+        error_ = "line " + std::to_string(line_number) + ": " + message;
+        return false;
+    };
+
+    while (std::getline(lines, line)) {
+        ++line_number;
+        const std::size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream words(line);
+        std::vector<std::string> tokens;
+        for (std::string token; words >> token;) {
+            tokens.push_back(token);
+        }
+        if (tokens.empty()) {
+            continue;
+        }
+
+        // Directives
+        if (tokens[0] == "dt" || tokens[0] == "duration") {
+            double value = 0.0;
+            if (tokens.size() != 2 || !parseNumber(tokens[1], value) || value < 0.0 ||
+                (tokens[0] == "dt" && value <= 0.0)) {
+                return fail(tokens[0] + " needs one " + (tokens[0] == "dt" ? "positive" : "non-negative") +
+                            " number of seconds");
+            }
+            (tokens[0] == "dt" ? frame_dt : duration) = value;
+            continue;
+        }
+
+        ScenarioEvent event;
+        event.line = line_number;
+        if (!parseNumber(tokens[0], event.time_s) || event.time_s < 0.0) {
+            return fail("expected a directive or a non-negative event time, got '" + tokens[0] + "'");
+        }
+        if (tokens.size() < 2) {
+            return fail("event without a verb");
+        }
+        const std::string& verb = tokens[1];
+
+        if (verb == "mode") {
+            const char* const* mode = std::find_if(std::begin(kModeNames), std::end(kModeNames),
+                                                   [&](const char* name) { return tokens.size() == 3 && tokens[2] == name; });
+            if (mode == std::end(kModeNames)) {
+                return fail("mode needs one of off, rate, attitude, lqr, mpc, external");
+            }
+            event.variable = static_cast<std::uint16_t>(findVariable("controller.mode", Group::Parameter));
+            event.values[0] = static_cast<double>(mode - std::begin(kModeNames));
+            events.push_back(event);
+            continue;
+        }
+
+        Group group;
+        if (verb == "setpoint") {
+            group = Group::Setpoint;
+        } else if (verb == "disturbance") {
+            group = Group::Disturbance;
+        } else if (verb == "fault") {
+            group = Group::Fault;
+        } else if (verb == "param") {
+            group = Group::Parameter;
+        } else if (verb == "assert") {
+            group = Group::Signal;
+        } else {
+            return fail("unknown verb '" + verb + "'");
+        }
+
+        std::string name;
+        std::size_t index = 0;
+        bool has_index = false;
+        if (tokens.size() < 3 || !parseTarget(tokens[2], name, index, has_index)) {
+            return fail(verb + " needs a name or name[index]");
+        }
+        const std::size_t variable =
+            group == Group::Signal ? findAssertVariable(name) : findVariable(name, group);
+        if (variable == kVariableCount) {
+            return fail("unknown " + verb + " name '" + name + "'");
+        }
+        const ScenarioVariable& target = kVariables[variable];
+        if (has_index && index >= target.components) {
+            return fail(name + " has " + std::to_string(target.components) + " component(s)");
+        }
+        event.variable = static_cast<std::uint16_t>(variable);
+        event.first = static_cast<std::uint8_t>(index);
+
+        if (group == Group::Signal) {
+            event.kind = ScenarioEvent::Kind::Assert;
+            if (!has_index && target.components != 1) {
+                return fail("assert " + name + " needs an index");
+            }
+            const std::string op = tokens.size() > 3 ? tokens[3] : std::string();
+            const std::size_t operands = op == "~" ? 2 : 1;
+            if ((op != "<" && op != ">" && op != "~") || tokens.size() != 4 + operands ||
+                !parseNumber(tokens[4], event.values[0]) ||
+                (operands == 2 && (!parseNumber(tokens[5], event.tolerance) || event.tolerance < 0.0))) {
+                return fail("assert needs '< value', '> value' or '~ value tolerance'");
+            }
+            event.compare = op == "<" ? ScenarioEvent::Compare::Less
+                            : op == ">" ? ScenarioEvent::Compare::Greater
+                                        : ScenarioEvent::Compare::Near;
+            event.values[0] *= target.scale;
+            event.tolerance *= target.scale;
+            events.push_back(event);
+            continue;
+        }
+
+        const std::size_t count = has_index ? 1 : target.components;
+        if (count > event.values.size()) {
+            return fail(name + " needs an index");
+        }
+        if (tokens.size() != 3 + count) {
+            return fail(name + (has_index ? "[i]" : "") + " takes " + std::to_string(count) + " value(s)");
+        }
+        event.count = static_cast<std::uint8_t>(count);
+        for (std::size_t k = 0; k < count; ++k) {
+            if (!parseNumber(tokens[3 + k], event.values[k])) {
+                return fail("'" + tokens[3 + k] + "' is not a number");
+            }
+            event.values[k] *= target.scale;
+        }
+        if (std::strcmp(target.name, "controller.mode") == 0 &&
+            (event.values[0] != std::floor(event.values[0]) || event.values[0] < 0.0 ||
+             event.values[0] >= static_cast<double>(kModeCount))) {
+            return fail("controller.mode is 0..5 (or use the mode verb)");
+        }
+        events.push_back(event);
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](const ScenarioEvent& a, const ScenarioEvent& b) { return a.time_s < b.time_s; });
+    events_ = std::move(events);
+    frame_dt_ = frame_dt;
+    duration_ = duration;
+    error_.clear();
+    return true;
+}
+
+bool ScenarioScript::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        error_ = "cannot read " + path;
+        return false;
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    if (!parse(text.str())) {
+        error_ = path + ": " + error_;
+        return false;
+    }
+    return true;
+}
+
+double ScenarioScript::duration() const {
+    // One frame past the last event, so a run dispatches all of them.
+    const double last = events_.empty() ? 0.0 : events_.back().time_s + frame_dt_;
+    return std::max(duration_, last);
+}
+
+std::size_t ScenarioScript::frames() const {
+    return static_cast<std::size_t>(std::ceil(duration() / frame_dt_ - 1e-9));
+}
+
+void ScenarioPlayerModule::initialize(SimulationState& state) {
+    cursor_ = 0;
+    passed_ = 0;
+    failed_ = 0;
+    reapply_ = false;
+    baselines_.clear();
+    captured_ = false;
+    state.scenario_status = SimulationState::ScenarioStatus{};
+    state.scenario_status.active = true;
+    state.scenario_status.events = script_.events().size();
+}
+
+void ScenarioPlayerModule::update(double dt, SimulationState& state) {
+    if (!captured_) {
+        // After every module has initialized, before the script writes anything
+        for (const ScenarioEvent& event : script_.events()) {
+            if (!rebuiltAfterLoad(event)) {
+                continue;
+            }
+            for (std::uint8_t k = 0; k < event.count; ++k) {
+                const auto component = static_cast<std::uint8_t>(event.first + k);
+                const bool known = std::any_of(baselines_.begin(), baselines_.end(), [&](const Baseline& b) {
+                    return b.variable == event.variable && b.component == component;
+                });
+                if (!known) {
+                    baselines_.push_back(
+                        Baseline{event.variable, component, kVariables[event.variable].get(state, component)});
+                }
+            }
+        }
+        captured_ = true;
+    }
+    if (reapply_) {
+        reapply(state);
+        reapply_ = false;
+    }
+
+    const auto& events = script_.events();
+    const double step_start = state.time_seconds - dt;
+    while (cursor_ < events.size() && events[cursor_].time_s <= step_start + kTimeSlackS) {
+        const ScenarioEvent& event = events[cursor_++];
+        if (event.kind == ScenarioEvent::Kind::Set) {
+            apply(event, state);
+        } else {
+            evaluate(event, state);
+        }
+    }
+    publish(state);
+}
+
+void ScenarioPlayerModule::apply(const ScenarioEvent& event, SimulationState& state) const {
+    const ScenarioVariable& target = kVariables[event.variable];
+    for (std::uint8_t k = 0; k < event.count; ++k) {
+        target.set(state, event.first + k, event.values[k]);
+    }
+}
+
+void ScenarioPlayerModule::evaluate(const ScenarioEvent& event, SimulationState& state) {
+    const ScenarioVariable& target = kVariables[event.variable];
+    const double value = target.get(state, event.first);
+    bool pass = false;
+    const char* op = "";
+    switch (event.compare) {
+        case ScenarioEvent::Compare::Less:    pass = value < event.values[0]; op = "<"; break;
+        case ScenarioEvent::Compare::Greater: pass = value > event.values[0]; op = ">"; break;
+        case ScenarioEvent::Compare::Near:
+            pass = std::abs(value - event.values[0]) <= event.tolerance;
+            op = "~";
+            break;
+    }
+    if (pass) {
+        ++passed_;
+        return;
+    }
+    ++failed_;
+    auto& status = state.scenario_status;
+    if (status.first_failure.empty()) {
+        char component[8] = "";
+        if (target.components > 1) {
+            std::snprintf(component, sizeof(component), "[%u]", static_cast<unsigned>(event.first));
+        }
+        char report[160];
+        std::snprintf(report, sizeof(report), "t=%.4g s, line %u: %s%s = %.6g, expected %s %.6g",
+                      event.time_s, event.line, target.name, component,
+                      value / target.scale, op, event.values[0] / target.scale);
+        status.first_failure = report;
+    }
+}
+
+void ScenarioPlayerModule::reapply(SimulationState& state) {
+    for (const Baseline& baseline : baselines_) {
+        kVariables[baseline.variable].set(state, baseline.component, baseline.value);
+    }
+    const auto& events = script_.events();
+    for (std::size_t i = 0; i < cursor_; ++i) {
+        if (rebuiltAfterLoad(events[i])) {
+            apply(events[i], state);
+        }
+    }
+    if (failed_ == 0) {
+        state.scenario_status.first_failure.clear();
+    }
+}
+
+void ScenarioPlayerModule::publish(SimulationState& state) const {
+    auto& status = state.scenario_status;
+    status.dispatched = cursor_;
+    status.assertions_passed = passed_;
+    status.assertions_failed = failed_;
+}
+
+void ScenarioPlayerModule::checkpoint(ModuleCheckpoint& archive) {
+    archive.io(cursor_);
+    archive.io(passed_);
+    archive.io(failed_);
+    if (archive.loading()) {
+        reapply_ = true;
+    }
+}
@@ -0,0 +1,191 @@
+/**
+ * @file scenario_player.h
+ * @brief Time-tagged scenario scripts and the module that plays them inside the pipeline
+ */
+
+#ifndef MODULES_SCENARIO_PLAYER_H
+#define MODULES_SCENARIO_PLAYER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/module.h"
+#include "core/simulation_state.h"
+
+/**
+ * @struct ScenarioEvent
+ * @brief One parsed script line, with its target resolved and values in state units
+ */
+struct ScenarioEvent {
+    enum class Kind : std::uint8_t {
+        Set,        ///< Write values[0..count) to components first.. of the variable
+        Assert      ///< Compare component first of the variable against values[0]
+    };
+    enum class Compare : std::uint8_t {
+        Less,       ///< value < values[0]
+        Greater,    ///< value > values[0]
+        Near        ///< |value - values[0]| <= tolerance
+    };
+
+    double time_s{0.0};
+    Kind kind{Kind::Set};
+    Compare compare{Compare::Less};
+    std::uint16_t variable{0};      ///< Index into the variable table (scenarioVariable())
+    std::uint8_t first{0};          ///< First component addressed
+    std::uint8_t count{1};          ///< Components written (Set)
+    std::array<double, 3> values{};
+    double tolerance{0.0};          ///< Near only
+    std::uint32_t line{0};          ///< Source line, for reports
+};
+
+/**
+ * @struct ScenarioVariable
+ * @brief A SimulationState field scripts can set or assert on
+ *
+ * Scripts use file units (degrees, deg/s); scale converts them to the
+ * state's units when the script is parsed.
+ */
+struct ScenarioVariable {
+    enum class Group : std::uint8_t {
+        Setpoint,       ///< controller_setpoint ("setpoint <name>")
+        Disturbance,    ///< disturbance wrench ("disturbance <name>"), an impulse ahead of each plant step
+        Fault,          ///< disturbance.rotor_effectiveness ("fault <name>")
+        Parameter,      ///< Configuration read on every update ("param <name>", "mode")
+        Signal          ///< Read-only vehicle state ("assert" only)
+    };
+
+    const char* name;                                       ///< Name within its group's verb
+    Group group;
+    std::size_t components;                                 ///< 1 for scalars
+    double scale;                                           ///< File unit → state unit
+    double (*get)(const SimulationState&, std::size_t);     ///< State units
+    void (*set)(SimulationState&, std::size_t, double);     ///< nullptr for signals
+};
+
+/// Entries of the variable table, in a fixed order
+std::size_t scenarioVariableCount();
+const ScenarioVariable& scenarioVariable(std::size_t index);
+
+/**
+ * @class ScenarioScript
+ * @brief A parsed scenario: frame length, duration and events sorted by time
+ *
+ * One statement per line; '#' starts a comment. Directives set up the run,
+ * every other line is an event tagged with its simulation time (s):
+ *
+ * @code
+ * dt 0.002                          # frame length of GUI and headless runs (s)
+ * duration 6                        # run length (default: one frame past the last event)
+ * 0.0  mode attitude                # off | rate | attitude | lqr | mpc | external
+ * 0.5  setpoint roll_deg 10
+ * 1.0  setpoint rate_deg_s 0 0 30   # vector: all three components
+ * 2.0  disturbance force_ned 0 1.5 0
+ * 2.5  fault rotor_effectiveness[2] 0.7
+ * 3.0  param controller.rate_kp[0] 25
+ * 4.0  assert roll_deg ~ 10 0.5     # < value | > value | ~ value tolerance
+ * 4.0  assert position_ned[2] > -0.2
+ * @endcode
+ *
+ * Names are those of the variable table (scenarioVariable()); `name[i]`
+ * addresses one component, a bare name takes one value per component.
+ * Events with equal times keep their file order. Everything is checked
+ * here, so a script that parses plays without errors.
+ */
+class ScenarioScript {
+public:
+    /**
+     * @brief Replace the script with one parsed from text
+     * @return false (script unchanged) on the first bad line; error() says where and why
+     */
+    bool parse(const std::string& text);
+
+    /**
+     * @brief Parse a script file
+     * @return false if the file cannot be read or does not parse
+     */
+    bool load(const std::string& path);
+
+    const std::vector<ScenarioEvent>& events() const { return events_; }
+    double frameDt() const { return frame_dt_; }
+    /// Simulated time the script covers: the duration directive, or one frame past its last event
+    double duration() const;
+    /// Frames of frameDt() a run needs to cover duration()
+    std::size_t frames() const;
+    const std::string& error() const { return error_; }
+
+private:
+    std::vector<ScenarioEvent> events_;
+    double frame_dt_{1.0 / 60.0};
+    double duration_{0.0};
+    std::string error_;
+};
+
+/**
+ * @class ScenarioPlayerModule
+ * @brief Applies a script's events at their times and evaluates its assertions
+ *
+ * Register it first, so every event takes effect before the modules of the
+ * step it falls in. An event at time t applies at the start of the first
+ * step beginning at or after t; with a fixed frame (ScenarioScript::frameDt)
+ * that is the same step in the GUI and in headless runs, which is what
+ * makes the two bit-identical. Dispatch walks a cursor over the pre-sorted
+ * events: a step with nothing due costs one comparison.
+ *
+ * Assertions compare the state at the start of their step (the end of the
+ * previous one); results go to SimulationState::scenario_status.
+ *
+ * Configuration, disturbances and faults are not in rewind keyframes, so
+ * after a checkpoint load the player puts every such variable the script
+ * writes back to its value before the first event and re-applies those
+ * events before the cursor. Setpoints are keyframed and journaled, so they
+ * are left as restored: later edits by the pilot or other modules survive.
+ */
+class ScenarioPlayerModule : public Module {
+public:
+    explicit ScenarioPlayerModule(ScenarioScript script) : script_(std::move(script)) {}
+
+    /**
+     * @brief Rewind to the first event and reset scenario_status
+     */
+    void initialize(SimulationState& state) override;
+
+    /**
+     * @brief Apply and evaluate every event due by the start of this step
+     */
+    void update(double dt, SimulationState& state) override;
+
+    const char* name() const override { return "Scenario"; }
+
+    void checkpoint(ModuleCheckpoint& archive) override;
+
+    const ScenarioScript& script() const { return script_; }
+
+private:
+    /// Events within this of a step start count as due (floating-point slack of summed frames)
+    static constexpr double kTimeSlackS = 1e-9;
+
+    struct Baseline {
+        std::uint16_t variable;
+        std::uint8_t component;
+        double value;
+    };
+
+    ScenarioScript script_;
+    std::vector<Baseline> baselines_;
+    std::size_t cursor_{0};             ///< First event not yet dispatched
+    std::uint64_t passed_{0};
+    std::uint64_t failed_{0};
+    bool captured_{false};              ///< baselines_ hold the pre-script values
+    bool reapply_{false};               ///< A checkpoint was loaded: rebuild the written variables
+
+    void apply(const ScenarioEvent& event, SimulationState& state) const;
+    void evaluate(const ScenarioEvent& event, SimulationState& state);
+    void reapply(SimulationState& state);
+    void publish(SimulationState& state) const;
+};
+
+#endif // MODULES_SCENARIO_PLAYER_H
@@ -2,9 +2,6 @@
 
 #include <cmath>
 
-#include "attitude/quaternion.h"
-#include "attitude/dcm.h"
-#include "attitude/attitude_utils.h"
 #include "core/simulation_state.h"
 
 void SensorSimulatorModule::initialize(SimulationState& state) {
@@ -15,14 +12,10 @@ void SensorSimulatorModule::initialize(SimulationState& state) {
 void SensorSimulatorModule::update(double dt, SimulationState& state) {
     (void)dt;
 
-    glm::vec3 gyro_body(
-        static_cast<float>(deg2rad(state.angular_rate_deg_per_sec.x)),
-        static_cast<float>(deg2rad(state.angular_rate_deg_per_sec.y)),
-        static_cast<float>(deg2rad(state.angular_rate_deg_per_sec.z)));
-    state.sensor.gyro_rad_s = gyro_body;
+    state.sensor.gyro_rad_s = glm::vec3(state.angular_rate_rad_s);
 
-    double dcm[3][3];
-    euler_to_dcm(&state.euler, dcm);
+    // Shared body-to-NED DCM from the state's lazy attitude cache.
+    const SimulationState::Dcm& dcm = state.dcm();
 
     double gravity_world[3] = {0.0, 0.0, -gravity_};
     double gravity_body[3] = {
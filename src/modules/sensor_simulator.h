@@ -15,8 +15,8 @@
  * This module generates synthetic sensor data by transforming true vehicle
  * state into body-frame measurements:
  *
- * **Gyroscope**: Reads angular velocity directly from state (with unit conversion)
- * **Accelerometer**: Transforms gravity vector into body frame using current attitude
+ * **Gyroscope**: Reads angular velocity directly from state (rad/s)
+ * **Accelerometer**: Transforms gravity vector into body frame using the shared DCM view
  *
  * Future enhancements:
  * - Add sensor noise (white noise, bias drift)
@@ -39,11 +39,13 @@ public:
      * - accel_mps2: Specific force in body frame (m/s²), including gravity
      *
      * @param dt Time step (seconds)
-     * @param state Reference to simulation state (reads quaternion/angular_rate,
+     * @param state Reference to simulation state (reads quaternion/angular_rate_rad_s,
      *              writes sensor.gyro_rad_s and sensor.accel_mps2)
      */
     void update(double dt, SimulationState& state) override;
 
+    const char* name() const override { return "Sensors"; }
+
 private:
     double gravity_{9.80665}; ///< Gravitational acceleration magnitude (m/s²)
 };
@@ -0,0 +1,81 @@
+#include "modules/sitl_bridge.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+void SitlBridgeModule::initialize(SimulationState& state) {
+    const double rate_hz = state.controller_config.rate_hz;
+    period_ = (std::isfinite(rate_hz) && rate_hz > 0.0) ? 1.0 / rate_hz : 0.0;
+    state.sitl_status = SimulationState::SitlStatus{};
+    if (!link_.isOpen() && !link_.create(state.sitl_config.link_name)) {
+        std::cerr << "SITL link " << state.sitl_config.link_name << " unavailable: " << link_.error() << std::endl;
+    }
+    state.sitl_status.link_open = link_.isOpen();
+    exchange_channel_ = state.telemetry.registerChannel("sitl.exchange_us", "us");
+}
+
+void SitlBridgeModule::update(double dt, SimulationState& state) {
+    using Mode = SimulationState::ControllerConfig::Mode;
+    if (state.controller_config.mode != Mode::External || !link_.isOpen() || !(dt > 0.0)) {
+        return;
+    }
+    if (state.control.paused) {
+        return;     // A missed exchange paused us; wait for the user (or runner) to resume
+    }
+
+    sitl::SensorFrame sensors{};
+    sensors.time_s = state.time_seconds;
+    sensors.dt_s = dt;
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        sensors.gyro_rad_s[axis] = state.sensor.gyro_rad_s[axis];
+        sensors.accel_mps2[axis] = state.sensor.accel_mps2[axis];
+        sensors.angular_rate_rad_s[axis] = state.angular_rate_rad_s[axis];
+        sensors.position_ned_m[axis] = state.physics.position[axis];
+        sensors.velocity_ned_mps[axis] = state.physics.velocity[axis];
+    }
+    std::copy(state.quaternion.begin(), state.quaternion.end(), sensors.quaternion);
+    const std::size_t rotor_count = std::min<std::size_t>(state.vehicle_config.rotor_count, sitl::kMaxRotors);
+    sensors.rotor_count = static_cast<std::uint32_t>(rotor_count);
+    std::copy_n(state.trim.rotor_omega_rad_s.begin(), rotor_count, sensors.trim_omega_rad_s);
+
+    auto& status = state.sitl_status;
+    sitl::MotorCommand commands{};
+    const auto start = std::chrono::steady_clock::now();
+    const SitlLink::Wait result = link_.exchange(sensors, commands, state.sitl_config.timeout_s);
+    const double round_trip_us =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    if (result != SitlLink::Wait::Ready) {
+        // Hold the previous commands for this frame and stop before the next.
+        status.connected = false;
+        ++status.timeouts;
+        state.control.paused = true;
+        return;
+    }
+
+    const double omega_min = state.motor_config.omega_min_rad_s;
+    const double omega_max = state.motor_config.omega_max_rad_s;
+    bool saturated = false;
+    for (std::size_t i = 0; i < rotor_count; ++i) {
+        const double wanted = commands.omega_rad_s[i];
+        if (!std::isfinite(wanted)) {
+            saturated = true;   // Keep the last usable command
+            continue;
+        }
+        const double omega = std::clamp(wanted, omega_min, omega_max);
+        saturated = saturated || omega != wanted;
+        state.motor_commands.omega_rad_s[i] = omega;
+        state.motor_commands.throttle_0_1[i] = omega_max > 0.0 ? omega / omega_max : 0.0;
+    }
+    state.controller_state.saturated = saturated;
+    ++state.controller_state.updates;
+
+    status.connected = true;
+    status.last_us = round_trip_us;
+    status.mean_us = status.exchanges == 0 ? round_trip_us
+                                           : status.mean_us + kMeanWeight * (round_trip_us - status.mean_us);
+    status.max_us = std::max(status.max_us, round_trip_us);
+    ++status.exchanges;
+    state.telemetry.record(exchange_channel_, state.time_seconds, round_trip_us);
+}
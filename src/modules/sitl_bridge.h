@@ -0,0 +1,65 @@
+/**
+ * @file sitl_bridge.h
+ * @brief Lockstep software-in-the-loop bridge to an external flight-controller process
+ */
+
+#ifndef MODULES_SITL_BRIDGE_H
+#define MODULES_SITL_BRIDGE_H
+
+#include <cstddef>
+
+#include "core/module.h"
+#include "core/simulation_state.h"
+#include "ipc/sitl_link.h"
+
+/**
+ * @class SitlBridgeModule
+ * @brief Trades one sensor frame for one set of rotor commands per controller period
+ *
+ * Active in ControllerConfig::Mode::External. Register it where the
+ * built-in controllers go (before the motor lag and the plant): update()
+ * publishes the IMU frame and the true state, then blocks until the
+ * controller answers, so the plant integrates a step only once that
+ * step's commands have arrived. Nothing paces the exchange but the two
+ * processes, so a headless loop runs the firmware as fast as both can go.
+ *
+ * If the controller misses sitl_config.timeout_s the frame finishes with
+ * the previous commands and the simulation pauses (like a rejected plant
+ * step); no further exchange is tried until it is resumed. A non-positive
+ * timeout never gives up. The external process is not part of module
+ * checkpoints: rewinding replays against it live.
+ *
+ * The link segment is created at initialize(); see SitlLink and
+ * tools/sitl_mock_controller.cpp for the controller side.
+ */
+class SitlBridgeModule : public Module {
+public:
+    /**
+     * @brief Latch the controller rate and create the link segment
+     */
+    void initialize(SimulationState& state) override;
+
+    /**
+     * @brief Exchange sensors for commands
+     * @param dt Controller period (seconds)
+     * @param state Reads sensor, attitude, physics and trim; writes
+     *              motor_commands and sitl_status
+     */
+    void update(double dt, SimulationState& state) override;
+
+    const char* name() const override { return "SITL bridge"; }
+    double period() const override { return period_; }
+
+    /// The link, e.g. to tune spinning or close it early
+    SitlLink& link() { return link_; }
+
+private:
+    /// Weight of the newest round trip in the moving average
+    static constexpr double kMeanWeight = 0.05;
+
+    double period_{0.002};          ///< 1 / controller_config.rate_hz latched at initialize
+    SitlLink link_;
+    std::size_t exchange_channel_{0};
+};
+
+#endif // MODULES_SITL_BRIDGE_H
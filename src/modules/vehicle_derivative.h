@@ -0,0 +1,190 @@
+/**
+ * @file vehicle_derivative.h
+ * @brief Continuous-time multirotor rigid-body equations of motion
+ *
+ * Mirrors the rotor and rigid-body model that dynamic_models integrates with
+ * fixed-step RK4, but exposes the state derivative itself so other
+ * integrators (adaptive RK45, linearization) can drive the same physics.
+ */
+
+#ifndef MODULES_VEHICLE_DERIVATIVE_H
+#define MODULES_VEHICLE_DERIVATIVE_H
+
+#include <array>
+#include <cstddef>
+
+#include "core/unroll.h"
+#include "drone/physics_model.h"
+
+/**
+ * @brief Layout of the packed 13-element plant state vector
+ *
+ * [p_n p_e p_d | v_n v_e v_d | q_w q_x q_y q_z | p q r]
+ * Position/velocity in NED (m, m/s), body-to-NED quaternion, body rates (rad/s).
+ */
+enum VehicleStateIndex : std::size_t {
+    kStatePosition = 0,
+    kStateVelocity = 3,
+    kStateQuaternion = 6,
+    kStateAngularRate = 10,
+    kVehicleStateSize = 13
+};
+
+template <typename Scalar>
+using VehicleStateVector = std::array<Scalar, kVehicleStateSize>;
+
+/**
+ * @brief Pack a dm_state_t into the flat state vector
+ */
+inline void packVehicleState(const dm_state_t& in, VehicleStateVector<double>& out) {
+    for (std::size_t i = 0; i < 3; ++i) {
+        out[kStatePosition + i] = in.position[i];
+        out[kStateVelocity + i] = in.velocity[i];
+        out[kStateAngularRate + i] = in.angular_rate[i];
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        out[kStateQuaternion + i] = in.quaternion[i];
+    }
+}
+
+/**
+ * @brief Unpack the flat state vector into a dm_state_t
+ */
+inline void unpackVehicleState(const VehicleStateVector<double>& in, dm_state_t& out) {
+    for (std::size_t i = 0; i < 3; ++i) {
+        out.position[i] = in[kStatePosition + i];
+        out.velocity[i] = in[kStateVelocity + i];
+        out.angular_rate[i] = in[kStateAngularRate + i];
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        out.quaternion[i] = in[kStateQuaternion + i];
+    }
+}
+
+/**
+ * @brief Linear drag on the velocity relative to the surrounding air
+ *
+ * The force is -coefficient (v - wind_ned). The wind is an input held over
+ * the evaluation like the rotor speeds; the default is no drag.
+ */
+struct AirRelativeDrag {
+    double coefficient{0.0};                ///< N per m/s
+    std::array<double, 3> wind_ned{};       ///< Air velocity (m/s)
+};
+
+/**
+ * @brief Evaluate the multirotor state derivative
+ *
+ * Each rotor produces thrust k_t·ω² along its axis and a reaction torque
+ * direction·k_q·ω² about the same axis; gravity acts along +down (NED) and
+ * the air-relative drag along -(v - wind).
+ *
+ * Templated on the scalar type so the same equations can be evaluated with
+ * plain doubles or with differentiable number types, and on the rotor count
+ * so the per-rotor force/torque accumulation is fully unrolled.
+ *
+ * @tparam RotorCount Number of rotors (must equal config.rotor_count)
+ * @param config Vehicle mass, inertia and rotor layout
+ * @param rotor_omega Rotor speeds (rad/s), RotorCount entries
+ * @param x Packed state (see VehicleStateIndex)
+ * @param dxdt Packed state derivative
+ * @param drag Air-relative drag and the wind it acts against
+ */
+template <std::size_t RotorCount, typename Scalar>
+void vehicleDerivative(const dm_vehicle_config_t& config,
+                       const Scalar* rotor_omega,
+                       const VehicleStateVector<Scalar>& x,
+                       VehicleStateVector<Scalar>& dxdt,
+                       const AirRelativeDrag& drag = AirRelativeDrag{}) {
+    // Body-frame force and torque from the rotors. Every contribution of a
+    // rotor is a fixed geometric coefficient times ω², so only ω² depends on
+    // the scalar type; with dual numbers this keeps the per-rotor work to one
+    // product plus six scaled accumulations.
+    Scalar force[3] = {Scalar(0.0), Scalar(0.0), Scalar(0.0)};
+    Scalar torque[3] = {Scalar(0.0), Scalar(0.0), Scalar(0.0)};
+    unrollFor<RotorCount>([&](auto i) {
+        const dm_rotor_config_t& rotor = config.rotors[i];
+        const Scalar omega_sq = rotor_omega[i] * rotor_omega[i];
+        const double* a = rotor.axis_body;
+        const double* r = rotor.position_body;
+        const double k_t = rotor.thrust_coeff;
+        const double k_q = rotor.direction * rotor.torque_coeff;
+        const double moment[3] = {k_t * (r[1] * a[2] - r[2] * a[1]) + k_q * a[0],
+                                  k_t * (r[2] * a[0] - r[0] * a[2]) + k_q * a[1],
+                                  k_t * (r[0] * a[1] - r[1] * a[0]) + k_q * a[2]};
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            force[axis] += (k_t * a[axis]) * omega_sq;
+            torque[axis] += moment[axis] * omega_sq;
+        }
+    });
+
+    const Scalar& qw = x[kStateQuaternion + 0];
+    const Scalar& qx = x[kStateQuaternion + 1];
+    const Scalar& qy = x[kStateQuaternion + 2];
+    const Scalar& qz = x[kStateQuaternion + 3];
+
+    // Body-to-NED rotation of the specific force.
+    const Scalar xx = qx * qx;
+    const Scalar yy = qy * qy;
+    const Scalar zz = qz * qz;
+    const Scalar xy = qx * qy;
+    const Scalar xz = qx * qz;
+    const Scalar yz = qy * qz;
+    const Scalar wx = qw * qx;
+    const Scalar wy = qw * qy;
+    const Scalar wz = qw * qz;
+    const Scalar r00 = 1.0 - 2.0 * (yy + zz);
+    const Scalar r01 = 2.0 * (xy - wz);
+    const Scalar r02 = 2.0 * (xz + wy);
+    const Scalar r10 = 2.0 * (xy + wz);
+    const Scalar r11 = 1.0 - 2.0 * (xx + zz);
+    const Scalar r12 = 2.0 * (yz - wx);
+    const Scalar r20 = 2.0 * (xz - wy);
+    const Scalar r21 = 2.0 * (yz + wx);
+    const Scalar r22 = 1.0 - 2.0 * (xx + yy);
+
+    const double inv_mass = 1.0 / config.mass;
+    for (std::size_t i = 0; i < 3; ++i) {
+        dxdt[kStatePosition + i] = x[kStateVelocity + i];
+    }
+    dxdt[kStateVelocity + 0] = (r00 * force[0] + r01 * force[1] + r02 * force[2]) * inv_mass;
+    dxdt[kStateVelocity + 1] = (r10 * force[0] + r11 * force[1] + r12 * force[2]) * inv_mass;
+    dxdt[kStateVelocity + 2] = (r20 * force[0] + r21 * force[1] + r22 * force[2]) * inv_mass
+                               + config.gravity;
+    if (drag.coefficient != 0.0) {
+        const double damping = drag.coefficient * inv_mass;
+        for (std::size_t i = 0; i < 3; ++i) {
+            dxdt[kStateVelocity + i] -= damping * (x[kStateVelocity + i] - drag.wind_ned[i]);
+        }
+    }
+
+    // Quaternion kinematics: q_dot = 0.5 * q ⊗ [0, ω].
+    const Scalar& p = x[kStateAngularRate + 0];
+    const Scalar& q = x[kStateAngularRate + 1];
+    const Scalar& r = x[kStateAngularRate + 2];
+    dxdt[kStateQuaternion + 0] = 0.5 * (-qx * p - qy * q - qz * r);
+    dxdt[kStateQuaternion + 1] = 0.5 * (qw * p + qy * r - qz * q);
+    dxdt[kStateQuaternion + 2] = 0.5 * (qw * q - qx * r + qz * p);
+    dxdt[kStateQuaternion + 3] = 0.5 * (qw * r + qx * q - qy * p);
+
+    // Euler's rotation equation: ω_dot = I⁻¹ (τ - ω × Iω).
+    const Scalar omega[3] = {p, q, r};
+    Scalar inertia_omega[3];
+    for (int row = 0; row < 3; ++row) {
+        inertia_omega[row] = config.inertia[row][0] * omega[0] +
+                             config.inertia[row][1] * omega[1] +
+                             config.inertia[row][2] * omega[2];
+    }
+    const Scalar net[3] = {
+        torque[0] - (omega[1] * inertia_omega[2] - omega[2] * inertia_omega[1]),
+        torque[1] - (omega[2] * inertia_omega[0] - omega[0] * inertia_omega[2]),
+        torque[2] - (omega[0] * inertia_omega[1] - omega[1] * inertia_omega[0])
+    };
+    for (int row = 0; row < 3; ++row) {
+        dxdt[kStateAngularRate + row] = config.inertia_inv[row][0] * net[0] +
+                                        config.inertia_inv[row][1] * net[1] +
+                                        config.inertia_inv[row][2] * net[2];
+    }
+}
+
+#endif // MODULES_VEHICLE_DERIVATIVE_H
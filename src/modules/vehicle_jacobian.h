@@ -0,0 +1,71 @@
+/**
+ * @file vehicle_jacobian.h
+ * @brief Exact linearization of the multirotor equations of motion
+ */
+
+#ifndef MODULES_VEHICLE_JACOBIAN_H
+#define MODULES_VEHICLE_JACOBIAN_H
+
+#include <cstddef>
+
+#include "core/jacobian.h"
+#include "core/small_matrix.h"
+#include "modules/vehicle_derivative.h"
+
+/**
+ * @brief ẋ = f(x, ω) and its Jacobians at one operating point
+ */
+template <std::size_t RotorCount>
+struct VehicleJacobian {
+    SmallVector<kVehicleStateSize> derivative{};                ///< f(x, ω)
+    SmallMatrix<kVehicleStateSize, kVehicleStateSize> a{};      ///< ∂f/∂x
+    SmallMatrix<kVehicleStateSize, RotorCount> b{};             ///< ∂f/∂ω (per rad/s)
+};
+
+/**
+ * @brief Differentiate vehicleDerivative() with forward-mode AD
+ *
+ * One evaluation with Dual<13 + RotorCount> scalars gives the state and
+ * rotor-speed Jacobians exactly (to round-off), for linearization, trim
+ * solvers and filter covariance propagation. The quaternion entries are
+ * differentiated as four free states; callers that need the error-state
+ * form project the columns themselves. The wind is held fixed, so drag
+ * only shows in ∂v̇/∂v.
+ */
+template <std::size_t RotorCount>
+VehicleJacobian<RotorCount> vehicleJacobian(const dm_vehicle_config_t& config,
+                                            const SmallVector<RotorCount>& rotor_omega,
+                                            const VehicleStateVector<double>& x,
+                                            const AirRelativeDrag& drag = AirRelativeDrag{}) {
+    VehicleJacobian<RotorCount> out;
+    forwardJacobian<kVehicleStateSize, RotorCount>(
+        [&config, &drag](const auto& state, const auto* omega, auto& dxdt) {
+            vehicleDerivative<RotorCount>(config, omega, state, dxdt, drag);
+        },
+        x, rotor_omega, out.derivative, out.a, out.b);
+    return out;
+}
+
+/**
+ * @brief Same Jacobians by central differences (27+ derivative evaluations for a quad)
+ *
+ * Kept as the validation and benchmark reference for vehicleJacobian().
+ */
+template <std::size_t RotorCount>
+VehicleJacobian<RotorCount> vehicleJacobianCentralDifference(const dm_vehicle_config_t& config,
+                                                             const SmallVector<RotorCount>& rotor_omega,
+                                                             const VehicleStateVector<double>& x,
+                                                             const AirRelativeDrag& drag = AirRelativeDrag{},
+                                                             double state_step = 1e-6,
+                                                             double input_step = 1e-6) {
+    VehicleJacobian<RotorCount> out;
+    centralDifferenceJacobian<kVehicleStateSize, RotorCount>(
+        [&config, &drag](const VehicleStateVector<double>& state, const double* omega,
+                         VehicleStateVector<double>& dxdt) {
+            vehicleDerivative<RotorCount, double>(config, omega, state, dxdt, drag);
+        },
+        x, rotor_omega, out.derivative, out.a, out.b, state_step, input_step);
+    return out;
+}
+
+#endif // MODULES_VEHICLE_JACOBIAN_H
@@ -0,0 +1,81 @@
+#include "modules/wind_field.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "core/module_checkpoint.h"
+#include "core/simulation_state.h"
+
+namespace {
+constexpr double kMinFrozenAirspeed = 1.0;  ///< Taylor speed floor in calm air (m/s)
+}
+
+void WindFieldModule::initialize(SimulationState& state) {
+    turbulence_.resize(1, state.wind_config.seed);
+    configure(state);
+    state.wind_ned = state.wind_config.steady_ned;
+    state.wind = SimulationState::WindStatus{};
+    state.wind.active = true;
+}
+
+void WindFieldModule::configure(SimulationState& state) {
+    const auto& config = state.wind_config;
+    const glm::dvec3& steady = config.steady_ned;
+    const double horizontal = std::hypot(steady.x, steady.y);
+    along_north_ = horizontal > 0.0 ? steady.x / horizontal : 1.0;
+    along_east_ = horizontal > 0.0 ? steady.y / horizontal : 0.0;
+
+    if (turbulence_.seed() != config.seed) {
+        turbulence_.reseed(config.seed);
+    }
+    turbulent_ = config.turbulence != SimulationState::WindConfig::Turbulence::Off;
+    if (!turbulent_) {
+        return;
+    }
+    const double airspeed = config.airspeed_m_s > 0.0 ? config.airspeed_m_s
+                                                      : std::max(glm::length(steady), kMinFrozenAirspeed);
+    TurbulenceScales scales;
+    scales.sigma_horizontal_m_s = config.sigma_horizontal_m_s;
+    scales.sigma_vertical_m_s = config.sigma_vertical_m_s;
+    scales.length_horizontal_m = config.length_horizontal_m;
+    scales.length_vertical_m = config.length_vertical_m;
+    turbulence_.configure(config.turbulence == SimulationState::WindConfig::Turbulence::Dryden
+                              ? TurbulenceSpectrum::Dryden
+                              : TurbulenceSpectrum::VonKarman,
+                          scales, airspeed, kSamplePeriodS);
+}
+
+void WindFieldModule::update(double dt, SimulationState& state) {
+    (void)dt;
+    const auto& config = state.wind_config;
+
+    glm::dvec3 gust(0.0);
+    const double into_gust = state.time_seconds - config.gust_start_s;
+    if (config.gust_duration_s > 0.0 && into_gust >= 0.0 && into_gust <= config.gust_duration_s) {
+        constexpr double kTwoPi = 6.283185307179586;
+        gust = config.gust_ned * (0.5 * (1.0 - std::cos(kTwoPi * into_gust / config.gust_duration_s)));
+    }
+
+    glm::dvec3 turbulence(0.0);
+    if (turbulent_) {
+        turbulence_.step();
+        const double u = turbulence_.output(TurbulenceField::kAlong, 0);
+        const double v = turbulence_.output(TurbulenceField::kAcross, 0);
+        turbulence = glm::dvec3(along_north_ * u - along_east_ * v, along_east_ * u + along_north_ * v,
+                                turbulence_.output(TurbulenceField::kVertical, 0));
+    }
+
+    state.wind_ned = config.steady_ned + gust + turbulence;
+    state.wind.gust_ned = gust;
+    state.wind.turbulence_ned = turbulence;
+    ++state.wind.samples;
+}
+
+void WindFieldModule::checkpoint(ModuleCheckpoint& archive) {
+    std::vector<double>& filters = turbulence_.stateData();
+    std::vector<double>& outputs = turbulence_.outputData();
+    archive.bytes(filters.data(), filters.size() * sizeof(double));
+    archive.bytes(outputs.data(), outputs.size() * sizeof(double));
+    archive.io(turbulence_.sampleCounter());
+}
@@ -0,0 +1,57 @@
+/**
+ * @file wind_field.h
+ * @brief Wind at the vehicle: steady wind, a 1-cosine gust and Dryden / von Kármán turbulence
+ */
+
+#ifndef WIND_FIELD_H
+#define WIND_FIELD_H
+
+#include "core/module.h"
+#include "core/turbulence_field.h"
+
+/**
+ * @class WindFieldModule
+ * @brief Writes SimulationState::wind_ned for the plant's air-relative drag
+ *
+ * Sampled at a fixed 100 Hz, which is what lets the turbulence shaping
+ * filters be designed once (configure()) instead of per frame; the plant
+ * holds the last sample in between. Each sample is
+ *
+ *   wind_ned = steady_ned + gust(t) + R(ψ_wind) [u v w]
+ *
+ * with gust(t) = gust_ned (1 - cos(2π (t - t0) / T)) / 2 over the gust
+ * duration T and u, v, w from a one-vehicle TurbulenceField. Its presence
+ * in the pipeline (WindStatus::active) is what turns on the plant's
+ * drag, -drag_coefficient (velocity - wind_ned).
+ *
+ * Configuration is SimulationState::wind_config; a live change keeps the
+ * turbulence history when only intensities or the seed change.
+ */
+class WindFieldModule : public Module {
+public:
+    static constexpr double kSamplePeriodS = 0.01;
+
+    void initialize(SimulationState& state) override;
+    void update(double dt, SimulationState& state) override;
+
+    const char* name() const override { return "Wind"; }
+    double period() const override { return kSamplePeriodS; }
+
+    /// Saves the turbulence filter states and sample count
+    void checkpoint(ModuleCheckpoint& archive) override;
+
+    unsigned configSections() const override { return ConfigSection::kWind; }
+
+    /**
+     * @brief Redesign the filters from state.wind_config and re-aim the turbulence axes
+     */
+    void configure(SimulationState& state) override;
+
+private:
+    TurbulenceField turbulence_;
+    bool turbulent_{false};         ///< wind_config.turbulence != Off
+    double along_north_{1.0};       ///< cos ψ of the steady wind heading
+    double along_east_{0.0};        ///< sin ψ
+};
+
+#endif // WIND_FIELD_H
@@ -1,4 +1,5 @@
 #include "renderer.h"
+#include "core/memory_accounting.h"
 #include <iostream>
 #include <GL/glew.h>
 // If using Glad: #include <glad/glad.h>
@@ -17,6 +18,7 @@ Renderer::Renderer() {
     cubeVao = cubeVbo = cubeEbo = 0;
     backgroundVao = backgroundVbo = 0;
     cubeIndexCount = 0;
+    bufferBytes = 0;
     modelLoc = viewLoc = projLoc = -1;
     lightDirLoc = ambientColorLoc = lightColorLoc = -1;
     // Initialize model matrix or leave as is
@@ -130,6 +132,8 @@ void Renderer::shutdown() {
         glDeleteBuffers(1, &backgroundVbo);
         backgroundVbo = 0;
     }
+    MemoryAccounting::refund(MemoryTag::Gpu, bufferBytes);
+    bufferBytes = 0;
 
     if (shaderProgram) {
         glDeleteProgram(shaderProgram);
@@ -328,6 +332,8 @@ void Renderer::setupCubeGeometry3D() {
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, cubeEbo);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    bufferBytes += sizeof(vertices) + sizeof(indices);
+    MemoryAccounting::charge(MemoryTag::Gpu, sizeof(vertices) + sizeof(indices));
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -359,6 +365,8 @@ void Renderer::setupBackgroundQuad() {
     glBindVertexArray(backgroundVao);
     glBindBuffer(GL_ARRAY_BUFFER, backgroundVbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    bufferBytes += sizeof(vertices);
+    MemoryAccounting::charge(MemoryTag::Gpu, sizeof(vertices));
 
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -9,6 +9,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cstddef>
 #include <string>
 #include "core/transform.h"
 
@@ -96,6 +97,7 @@ private:
     unsigned int backgroundVbo;             ///< Background quad VBO
 
     unsigned int cubeIndexCount;            ///< Index count for cube
+    std::size_t bufferBytes;                ///< Vertex/index bytes charged to MemoryTag::Gpu
 
     // === Shader Uniform Locations ===
     int modelLoc;                  ///< Location of model matrix uniform
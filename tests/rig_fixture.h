@@ -0,0 +1,59 @@
+/**
+ * @file rig_fixture.h
+ * @brief Closed-loop rig pipeline fixture shared by the tests that drive it from a RigConfig
+ */
+
+#ifndef TESTS_RIG_FIXTURE_H
+#define TESTS_RIG_FIXTURE_H
+
+#include "config/rig_config.h"
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+#include "modules/rig_pipeline.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+
+/// Fixed step the fixture advances the pipeline by (one 500 Hz controller period)
+constexpr double kRigStepS = 0.002;
+
+/// Parse a rig configuration, reporting a parse error as a test failure
+inline RigConfig parseRigConfig(const std::string& text, int& failures)
+{
+    RigConfig config;
+    if (!config.parse(text)) {
+        std::fprintf(stderr, "FAIL parse: %s\n", config.error().c_str());
+        ++failures;
+    }
+    return config;
+}
+
+/// Closed-loop rig pipeline configured from a RigConfig, with its own SITL segment
+struct RigFixture {
+    SimulationState state;
+    ModuleScheduler modules;
+    std::string link;
+
+    /// test_name keeps concurrently running tests on separate shared-memory segments
+    RigFixture(const RigConfig& config, const char* test_name)
+        : link(std::string("/aerodyn_sitl_") + test_name + "_test_" + std::to_string(::getpid())) {
+        config.apply(state);
+        state.sitl_config.link_name = link.c_str();
+        addRigModules(modules, state.vehicle_config.airframe);
+        modules.initialize(state);
+    }
+
+    RigFixture(const RigFixture&) = delete;
+    RigFixture& operator=(const RigFixture&) = delete;
+
+    void run(double seconds) {
+        for (long i = 0; i < std::lround(seconds / kRigStepS); ++i) {
+            modules.advance(kRigStepS, state);
+        }
+    }
+};
+
+#endif // TESTS_RIG_FIXTURE_H
@@ -0,0 +1,116 @@
+#include "modules/airframe_layout.h"
+#include "modules/control_allocator.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+constexpr double kArm = 0.225;
+constexpr double kThrustCoeff = 1.2e-6;
+constexpr double kTorqueCoeff = 2.5e-8;
+
+constexpr bool closeTo(double a, double b) { return (a - b) < 1e-12 && (b - a) < 1e-12; }
+
+// Standard frames are fully evaluated at compile time.
+constexpr auto kQuadX = ControlAllocator<4>::fromLayout<QuadXLayout>(kArm, kThrustCoeff, kTorqueCoeff);
+static_assert(kQuadX.valid(), "Quad X allocation must have full rank");
+static_assert(closeTo(kQuadX.pseudoInverse()(0, 0), 0.25), "Collective thrust splits evenly");
+constexpr auto kOctoX = ControlAllocator<8>::fromLayout<OctoXLayout>(kArm, kThrustCoeff, kTorqueCoeff);
+static_assert(kOctoX.valid(), "Octo X allocation must have full rank");
+static_assert(closeTo(kOctoX.pseudoInverse()(3, 0), 0.125), "Collective thrust splits evenly");
+
+template <std::size_t N>
+void checkRightInverse(const char* name, const ControlAllocator<N>& allocator)
+{
+    const auto identity = allocator.effectivenessMatrix() * allocator.pseudoInverse();
+    double worst = 0.0;
+    for (std::size_t r = 0; r < 4; ++r) {
+        for (std::size_t c = 0; c < 4; ++c) {
+            worst = std::max(worst, std::abs(identity(r, c) - (r == c ? 1.0 : 0.0)));
+        }
+    }
+    expectNear(name, worst, 0.0, 1e-9);
+}
+
+}  // namespace
+
+int main()
+{
+    checkRightInverse("quad X B B+ = I", kQuadX);
+    checkRightInverse("quad + B B+ = I",
+                      ControlAllocator<4>::fromLayout<QuadPlusLayout>(kArm, kThrustCoeff, kTorqueCoeff));
+    checkRightInverse("hex X B B+ = I",
+                      ControlAllocator<6>::fromLayout<HexXLayout>(kArm, kThrustCoeff, kTorqueCoeff));
+    checkRightInverse("octo X B B+ = I", kOctoX);
+
+    const double omega_max = 2000.0;
+    ControlAllocator<4>::RotorVector lower{};
+    ControlAllocator<4>::RotorVector upper{};
+    upper.fill(kThrustCoeff * omega_max * omega_max);
+
+    // Unsaturated: the wrench is reproduced exactly in a single product.
+    ControlAllocator<4>::RotorVector thrust{};
+    const ControlAllocator<4>::Wrench hover{{4.905, 0.05, -0.03, 0.005}};
+    auto result = kQuadX.allocate(hover, lower, upper, thrust);
+    expectTrue("hover unsaturated", result.saturated == 0 && result.passes == 0);
+    const auto achieved = kQuadX.effectivenessMatrix() * thrust;
+    for (std::size_t axis = 0; axis < 4; ++axis) {
+        expectNear("hover wrench reproduced", achieved[axis], hover[axis], 1e-12);
+    }
+
+    // Infeasible: roll demand plus a large yaw demand near the thrust ceiling.
+    // Limits hold, passes stay bounded, and roll is kept ahead of yaw.
+    const ControlAllocator<4>::Wrench aggressive{{17.0, 0.8, 0.0, 0.2}};
+    result = kQuadX.allocate(aggressive, lower, upper, thrust);
+    expectTrue("saturation detected", result.saturated > 0);
+    expectTrue("passes bounded by rotor count", result.passes <= 4);
+    bool within = true;
+    for (std::size_t i = 0; i < 4; ++i) {
+        within = within && thrust[i] >= lower[i] && thrust[i] <= upper[i];
+    }
+    expectTrue("thrust within limits", within);
+    const auto saturated = kQuadX.effectivenessMatrix() * thrust;
+    const double roll_error = std::abs(saturated[1] - aggressive[1]) / aggressive[1];
+    const double yaw_error = std::abs(saturated[3] - aggressive[3]) / aggressive[3];
+    expectTrue("roll prioritised over yaw", roll_error < yaw_error);
+    expectNear("roll nearly achieved", saturated[1], aggressive[1], 0.05 * aggressive[1]);
+
+    // Rotors at the centre of mass cannot produce roll or pitch torque.
+    std::array<SimulationState::RotorGeometry, 4> degenerate{};
+    for (auto& rotor : degenerate) {
+        rotor.thrust_coeff = kThrustCoeff;
+        rotor.torque_coeff = kTorqueCoeff;
+    }
+    ControlAllocator<4> broken;
+    expectTrue("rank-deficient geometry rejected",
+               !broken.configure(ControlAllocator<4>::effectiveness(degenerate)));
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d control allocation check(s) failed\n", failures);
+        return 1;
+    }
+
+    std::puts("Control allocation: all tests passed");
+    return 0;
+}
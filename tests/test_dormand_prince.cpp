@@ -0,0 +1,97 @@
+#include "core/dormand_prince.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    // Harmonic oscillator x'' = -w^2 x: smooth, with a known closed form.
+    const double w = 2.0;
+    auto oscillator = [w](double, const std::array<double, 2>& y, std::array<double, 2>& dydt) {
+        dydt[0] = y[1];
+        dydt[1] = -w * w * y[0];
+    };
+
+    DormandPrince45<2> stepper;
+    stepper.settings.relative_tolerance = 1e-9;
+    stepper.settings.absolute_tolerance = 1e-12;
+    stepper.settings.max_step = 1.0;
+
+    DormandPrince45<2>::Stats stats;
+    DenseTrajectory<2> dense;
+    std::array<double, 2> y{1.0, 0.0};
+    const auto status = stepper.integrate(oscillator, 0.0, 3.0, y, stats, &dense);
+
+    expectTrue("oscillator integrates", status == DormandPrince45<2>::Status::Ok);
+    expectNear("oscillator position", y[0], std::cos(w * 3.0), 1e-7);
+    expectNear("oscillator velocity", y[1], -w * std::sin(w * 3.0), 1e-7);
+    expectTrue("accepted steps counted", stats.accepted_steps == dense.size());
+    // FSAL: one start evaluation plus six per trial step.
+    expectTrue("fsal evaluation count",
+               stats.derivative_evaluations == 1 + 6 * (stats.accepted_steps + stats.rejected_steps));
+
+    expectNear("dense covers start", dense.startTime(), 0.0, 0.0);
+    expectNear("dense covers end", dense.endTime(), 3.0, 1e-12);
+    std::array<double, 2> mid{};
+    for (double t : {0.37, 1.234, 2.9}) {
+        expectTrue("dense sample inside", dense.sample(t, mid));
+        expectNear("dense position", mid[0], std::cos(w * t), 1e-6);
+        expectNear("dense velocity", mid[1], -w * std::sin(w * t), 1e-6);
+    }
+    expectTrue("dense rejects outside", !dense.sample(3.5, mid));
+
+    // Smooth decay needs far fewer evaluations than a fixed 2.5 ms RK4 grid.
+    auto decay = [](double, const std::array<double, 1>& y, std::array<double, 1>& dydt) {
+        dydt[0] = -0.5 * y[0];
+    };
+    DormandPrince45<1> slow;
+    DormandPrince45<1>::Stats slow_stats;
+    std::array<double, 1> z{1.0};
+    slow.integrate(decay, 0.0, 2.0, z, slow_stats);
+    expectNear("decay value", z[0], std::exp(-1.0), 1e-6);
+    expectTrue("decay is cheaper than fixed rk4", slow_stats.derivative_evaluations < 4 * 800);
+
+    // A fast transient forces rejections and short steps, but stays accurate.
+    auto stiff = [](double, const std::array<double, 1>& y, std::array<double, 1>& dydt) {
+        dydt[0] = -200.0 * (y[0] - 1.0);
+    };
+    DormandPrince45<1> fast;
+    fast.settings.initial_step = 0.05;
+    DormandPrince45<1>::Stats fast_stats;
+    std::array<double, 1> s{0.0};
+    fast.integrate(stiff, 0.0, 0.1, s, fast_stats);
+    expectNear("transient value", s[0], 1.0 - std::exp(-20.0), 1e-6);
+    expectTrue("transient rejected a step", fast_stats.rejected_steps > 0U);
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d Dormand-Prince check(s) failed\n", failures);
+        return 1;
+    }
+
+    std::puts("Dormand-Prince integrator: all tests passed");
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include "core/attitude_history.h"
+#include "core/frame_arena.h"
+#include "core/simulation_state.h"
+#include "gui/widgets/plot_series.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// Allocation-counting hook: every global operator new (and so every
+// new[], std::allocator and container growth) bumps this counter.
+static std::size_t g_heap_allocations = 0;
+
+void* operator new(std::size_t bytes)
+{
+    ++g_heap_allocations;
+    if (void* p = std::malloc(bytes == 0 ? 1 : bytes)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+int failures = 0;
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+struct Point {
+    float x;
+    float y;
+};
+
+/**
+ * @brief The UI temporaries of one dashboard frame, headless
+ *
+ * Same allocation pattern as the panels: plot-line copies of the attitude
+ * and rotor histories (ui::PlotLine), a float copy plus polyline of a
+ * panel history (PowerPanel), and formatted labels (EstimatorPanel,
+ * RotorPanel, scene buttons).
+ */
+double drawFrame(FrameArena& arena, const SimulationState& state, const TrackedDeque<float, MemoryTag::Plot>& power)
+{
+    arena.reset();
+    double checksum = 0.0;
+
+    const auto& attitude = state.attitude_history.samples;
+    for (int axis = 0; axis < 3; ++axis) {
+        ArenaVector<double> x_data(arena), y_data(arena);
+        ui::ExtractSeries(attitude,
+                          [axis](const SimulationState::AttitudeSample& s) {
+                              return axis == 0 ? s.roll : axis == 1 ? s.pitch : s.yaw;
+                          },
+                          x_data, y_data);
+        checksum += x_data.back() + y_data.front();
+    }
+    for (std::size_t rotor = 0; rotor < 4; ++rotor) {
+        ArenaVector<double> x_data(arena), y_data(arena);
+        ui::ExtractSeries(state.rotor_history.rotors[rotor],
+                          [](const SimulationState::RotorSample& s) { return static_cast<double>(s.rpm); },
+                          x_data, y_data);
+        checksum += static_cast<double>(x_data.size());
+    }
+
+    const ArenaVector<float> samples(power.begin(), power.end(), arena);
+    ArenaVector<Point> points(arena);
+    points.reserve(samples.size() + 2);
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        points.push_back(Point{static_cast<float>(i), samples[i]});
+    }
+    points.push_back(Point{0.0f, 0.0f});
+    checksum += points[samples.size() / 2].y;
+
+    for (std::size_t i = 0; i < 8; ++i) {
+        checksum += static_cast<double>(std::strlen(arena.format("R%zu", i + 1)));
+    }
+    checksum += static_cast<double>(std::strlen(arena.format("%.1f deg, %.1f deg, %.1f deg", 1.0, 2.0, 3.0)));
+    return checksum;
+}
+
+}  // namespace
+
+int main()
+{
+    // Bump allocation: alignment, formatting, and reuse after reset.
+    {
+        FrameArena arena(1024);
+        const std::size_t blocks = arena.heapBlocks();
+        char* byte = arena.allocateArray<char>(3);
+        double* value = arena.allocateArray<double>(4);
+        expectTrue("double aligned", reinterpret_cast<std::uintptr_t>(value) % alignof(double) == 0);
+        expectTrue("bump is contiguous", reinterpret_cast<char*>(value) > byte);
+        const char* text = arena.format("%s-%d", "rotor", 7);
+        expectTrue("format", std::strcmp(text, "rotor-7") == 0);
+        expectTrue("no growth inside the block", arena.heapBlocks() == blocks);
+        arena.reset();
+        expectTrue("reset rewinds", arena.used() == 0 && arena.allocateArray<char>(3) == byte);
+    }
+
+    // A frame larger than the block spills into overflow for that frame; the
+    // next reset leaves one block big enough for it.
+    {
+        FrameArena arena(1024);
+        const std::size_t blocks = arena.heapBlocks();
+        char long_text[3000];
+        std::memset(long_text, 'x', sizeof(long_text) - 1);
+        long_text[sizeof(long_text) - 1] = '\0';
+        for (int i = 0; i < 4; ++i) {
+            arena.allocate(700);
+        }
+        const char* copy = arena.format("%s", long_text);
+        expectTrue("overflow format", std::strlen(copy) == sizeof(long_text) - 1);
+        expectTrue("overflow taken", arena.heapBlocks() > blocks);
+        arena.reset();
+        expectTrue("coalesced to the peak", arena.capacity() >= arena.highWater());
+        const std::size_t grown = arena.heapBlocks();
+        for (int i = 0; i < 4; ++i) {
+            arena.allocate(700);
+        }
+        arena.format("%s", long_text);
+        expectTrue("same frame fits after coalescing", arena.heapBlocks() == grown);
+    }
+
+    // Steady-state frames do no global heap allocation at all.
+    {
+        SimulationState state;
+        for (int i = 0; i < 2000; ++i) {
+            state.time_seconds += state.attitude_history.sample_interval;
+            state.markPoseDirty();
+            captureAttitudeSample(state);
+        }
+        for (std::size_t rotor = 0; rotor < 4; ++rotor) {
+            for (int i = 0; i < 600; ++i) {
+                SimulationState::RotorSample sample{};
+                sample.timestamp = 0.1 * i;
+                sample.rpm = 1000.0f + static_cast<float>(i);
+                state.rotor_history.rotors[rotor].push_back(sample);
+            }
+        }
+        TrackedDeque<float, MemoryTag::Plot> power(3000, 120.0f);
+
+        FrameArena arena(4096);
+        double checksum = 0.0;
+        for (int frame = 0; frame < 3; ++frame) {
+            checksum += drawFrame(arena, state, power);
+        }
+        const std::size_t before = g_heap_allocations;
+        for (int frame = 0; frame < 200; ++frame) {
+            checksum += drawFrame(arena, state, power);
+        }
+        const std::size_t during = g_heap_allocations - before;
+        if (during != 0) {
+            std::fprintf(stderr, "steady-state frames allocated %zu times\n", during);
+        }
+        expectTrue("steady-state frames are heap-free", during == 0);
+        expectTrue("frame did work", std::isfinite(checksum) && checksum > 0.0);
+
+        // The same frame with std::vector temporaries is what the arena replaced.
+        const std::size_t vector_before = g_heap_allocations;
+        std::vector<double> x_data, y_data;
+        ui::ExtractSeries(state.attitude_history.samples,
+                          [](const SimulationState::AttitudeSample& s) { return s.roll; }, x_data, y_data);
+        expectTrue("hook counts heap allocations", g_heap_allocations > vector_before);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d frame-arena check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("Frame arena checks passed");
+    return 0;
+}
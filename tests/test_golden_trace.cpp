@@ -0,0 +1,242 @@
+// Golden-trace regression harness.
+//
+//   aerodyn_golden_trace_test [--bless] [--tolerance <rel>] <golden-dir>
+//
+// Records every scenario below through the headless module pipeline and
+// compares it against <golden-dir>/<scenario>.trace: bitwise by default,
+// or within a relative tolerance when a change is expected to reassociate
+// floating point. --bless (re)writes the golden traces from this build.
+// A scenario without a golden trace fails the comparison. CTest compares
+// the references committed in tests/golden within a relative tolerance
+// (bitwise traces are only valid for the compiler and flags that recorded
+// them), and separately checks determinism by blessing a build-tree copy
+// and comparing a fresh recording against it bit for bit.
+
+#include "analysis/golden_trace.h"
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+#include "modules/attitude_controller.h"
+#include "modules/complementary_estimator.h"
+#include "modules/first_order_dynamics.h"
+#include "modules/motor_dynamics.h"
+#include "modules/quadcopter_dynamics.h"
+#include "modules/rotor_telemetry.h"
+#include "modules/sensor_simulator.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+void buildClosedLoop(ModuleScheduler& scheduler, SimulationState& state, SimulationState::Airframe airframe)
+{
+    state.vehicle_config.airframe = airframe;
+    scheduler.add(makeAttitudeControllerModule(airframe));
+    scheduler.add(makeMotorDynamicsModule(airframe));
+    scheduler.add(makeMultirotorDynamicsModule(airframe));
+}
+
+/// Roll, pitch and yaw setpoint steps at fixed frames
+void attitudeScript(std::size_t step, SimulationState& state)
+{
+    auto& setpoint = state.controller_setpoint;
+    switch (step) {
+    case 30:  setpoint.roll_rad = 0.25; break;
+    case 150: setpoint.pitch_rad = -0.2; break;
+    case 270: setpoint.yaw_rad = 0.8; break;
+    case 390: setpoint.roll_rad = 0.0; setpoint.pitch_rad = 0.0; break;
+    default: break;
+    }
+}
+
+std::vector<TraceScenario> scenarios()
+{
+    std::vector<TraceScenario> list;
+
+    // Open-loop plant with the fixed RK4 grid: hover, then a body-rate kick.
+    {
+        TraceScenario scenario;
+        scenario.name = "plant_rk4_kick";
+        scenario.dt = 0.0025;
+        scenario.steps = 400;
+        scenario.build = [](ModuleScheduler& scheduler, SimulationState& state) {
+            scheduler.add(makeMultirotorDynamicsModule(state.vehicle_config.airframe));
+            scheduler.initialize(state);
+        };
+        scenario.script = [](std::size_t step, SimulationState& state) {
+            if (step == 100) {
+                state.angular_rate_rad_s = glm::dvec3(0.5, -0.3, 1.0);
+            }
+        };
+        list.push_back(scenario);
+    }
+
+    // Adaptive Dormand-Prince plant spun up in yaw.
+    {
+        TraceScenario scenario;
+        scenario.name = "plant_dp45_spin";
+        scenario.dt = 0.02;
+        scenario.steps = 200;
+        scenario.build = [](ModuleScheduler& scheduler, SimulationState& state) {
+            state.plant_integration.method = SimulationState::PlantIntegration::Method::DormandPrince45;
+            scheduler.add(makeMultirotorDynamicsModule(state.vehicle_config.airframe));
+            scheduler.initialize(state);
+        };
+        scenario.script = [](std::size_t step, SimulationState& state) {
+            if (step == 50) {
+                state.angular_rate_rad_s = glm::dvec3(0.0, 0.0, 3.0);
+            }
+        };
+        list.push_back(scenario);
+    }
+
+    // Closed attitude loop on two airframes.
+    for (const auto airframe : {SimulationState::Airframe::QuadX, SimulationState::Airframe::HexX}) {
+        TraceScenario scenario;
+        scenario.name = airframe == SimulationState::Airframe::QuadX ? "attitude_quad_x" : "attitude_hex_x";
+        scenario.build = [airframe](ModuleScheduler& scheduler, SimulationState& state) {
+            buildClosedLoop(scheduler, state, airframe);
+            scheduler.initialize(state);
+        };
+        scenario.script = attitudeScript;
+        list.push_back(scenario);
+    }
+
+    // Full pipeline: closed loop plus IMU, complementary estimator and rotor history.
+    {
+        TraceScenario scenario;
+        scenario.name = "estimator_pipeline";
+        scenario.build = [](ModuleScheduler& scheduler, SimulationState& state) {
+            const auto airframe = SimulationState::Airframe::QuadX;
+            buildClosedLoop(scheduler, state, airframe);
+            scheduler.add(std::make_unique<SensorSimulatorModule>());
+            scheduler.add(std::make_unique<ComplementaryEstimatorModule>());
+            scheduler.add(makeRotorTelemetryModule(airframe));
+            scheduler.initialize(state);
+        };
+        scenario.script = attitudeScript;
+        list.push_back(scenario);
+    }
+
+    // First-order module driven by its chirp input.
+    {
+        TraceScenario scenario;
+        scenario.name = "first_order_chirp";
+        scenario.dt = 0.005;
+        scenario.steps = 2000;
+        scenario.build = [](ModuleScheduler& scheduler, SimulationState& state) {
+            state.dynamics_config.input_mode = SimulationState::DynamicsConfig::InputMode::Chirp;
+            state.dynamics_config.chirp_duration_s = 10.0;
+            scheduler.add(std::make_unique<FirstOrderDynamicsModule>());
+            scheduler.initialize(state);
+        };
+        list.push_back(scenario);
+    }
+
+    return list;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    bool bless = false;
+    double tolerance = 0.0;
+    std::string golden_dir;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bless") == 0) {
+            bless = true;
+        } else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = std::atof(argv[++i]);
+        } else {
+            golden_dir = argv[i];
+        }
+    }
+    if (golden_dir.empty()) {
+        std::fprintf(stderr, "usage: %s [--bless] [--tolerance <rel>] <golden-dir>\n", argv[0]);
+        return 2;
+    }
+    if (bless) {
+        std::filesystem::create_directories(golden_dir);
+    }
+
+    int failures = 0;
+
+    // The differ itself: a one-ulp change is found at its step and field,
+    // and passes once a tolerance is allowed.
+    {
+        GoldenTrace golden("self", {"a", "b"}, 0.1);
+        GoldenTrace perturbed("self", {"a", "b"}, 0.1);
+        for (int step = 0; step < 10; ++step) {
+            double row[2] = {0.1 * step, std::sin(0.1 * step)};
+            golden.append(row);
+            if (step == 7) {
+                row[1] = std::nextafter(row[1], 2.0);
+            }
+            perturbed.append(row);
+        }
+        const TraceDiff diff = compareTraces(golden, perturbed);
+        if (diff.match || diff.step != 7 || diff.field != "b" || golden.stepHash(6) != perturbed.stepHash(6)) {
+            std::fprintf(stderr, "FAIL differ missed a one-ulp change: %s\n", diff.describe().c_str());
+            ++failures;
+        }
+        if (!compareTraces(golden, perturbed, 1e-12).match) {
+            std::fprintf(stderr, "FAIL tolerance comparison rejected a one-ulp change\n");
+            ++failures;
+        }
+    }
+
+    for (const TraceScenario& scenario : scenarios()) {
+        // The pipeline must be deterministic before a golden copy means anything.
+        const GoldenTrace trace = recordTrace(scenario);
+        const TraceDiff rerun = compareTraces(trace, recordTrace(scenario));
+        if (!rerun.match) {
+            std::fprintf(stderr, "FAIL %s is not deterministic: %s\n", scenario.name.c_str(), rerun.describe().c_str());
+            ++failures;
+            continue;
+        }
+
+        const std::string path = golden_dir + "/" + scenario.name + ".trace";
+        if (bless) {
+            if (!trace.save(path)) {
+                std::fprintf(stderr, "FAIL could not write %s\n", path.c_str());
+                ++failures;
+            } else {
+                std::printf("blessed %s: %zu steps x %zu fields, hash %016llx\n", scenario.name.c_str(),
+                            trace.steps(), trace.width(), static_cast<unsigned long long>(trace.finalHash()));
+            }
+            continue;
+        }
+
+        GoldenTrace golden;
+        if (!std::filesystem::exists(path)) {
+            std::fprintf(stderr, "FAIL no golden trace for %s (run with --bless)\n", scenario.name.c_str());
+            ++failures;
+            continue;
+        }
+        if (!golden.load(path)) {
+            std::fprintf(stderr, "FAIL %s is corrupt or from another trace format\n", path.c_str());
+            ++failures;
+            continue;
+        }
+        const TraceDiff diff = compareTraces(golden, trace, tolerance);
+        if (!diff.match) {
+            std::fprintf(stderr, "FAIL %s: %s (t = %.6f s)\n", scenario.name.c_str(), diff.describe().c_str(),
+                         diff.step < golden.steps() ? golden.value(diff.step, 0) : 0.0);
+            ++failures;
+        }
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d golden-trace check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts(bless ? "Golden traces blessed" : "Golden-trace checks passed");
+    return 0;
+}
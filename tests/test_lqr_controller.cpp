@@ -0,0 +1,198 @@
+#include "control/gain_schedule.h"
+#include "control/hover_lqr.h"
+#include "control/riccati.h"
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+#include "modules/lqr_controller.h"
+#include "modules/motor_dynamics.h"
+#include "modules/quadcopter_dynamics.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+constexpr double kFrameDt = 1.0 / 60.0;
+
+template <std::size_t N>
+double maxAbs(const SmallMatrix<N, N>& a)
+{
+    double worst = 0.0;
+    for (const auto& row : a.m) {
+        for (double value : row) {
+            worst = std::max(worst, std::abs(value));
+        }
+    }
+    return worst;
+}
+
+void buildClosedLoop(ModuleScheduler& scheduler, SimulationState& state)
+{
+    const auto airframe = state.vehicle_config.airframe;
+    scheduler.add(makeLqrControllerModule(airframe));
+    scheduler.add(makeMotorDynamicsModule(airframe));
+    scheduler.add(makeMultirotorDynamicsModule(airframe));
+    scheduler.initialize(state);
+}
+
+void run(ModuleScheduler& scheduler, SimulationState& state, double seconds)
+{
+    const int frames = static_cast<int>(std::lround(seconds / kFrameDt));
+    for (int i = 0; i < frames; ++i) {
+        scheduler.advance(kFrameDt, state);
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    // Double integrator with Q = I, R = 1 has the closed-form gain K = [1, √3].
+    {
+        SmallMatrix<2, 2> a{};
+        a.m[0][1] = 1.0;
+        SmallMatrix<2, 1> b{};
+        b.m[1][0] = 1.0;
+        const auto solution = solveCare(a, b, SmallMatrix<2, 2>::identity(), SmallMatrix<1, 1>::identity());
+        expectTrue("double integrator converged", solution.converged);
+        expectNear("double integrator k1", solution.gain.m[0][0], 1.0, 1e-9);
+        expectNear("double integrator k2", solution.gain.m[0][1], std::sqrt(3.0), 1e-9);
+    }
+
+    // Hover model of the quad X: trim is exact, and the Riccati solution
+    // satisfies the CARE to round-off.
+    {
+        SimulationState state;
+        ModuleScheduler scheduler;
+        buildClosedLoop(scheduler, state);
+        const dm_vehicle_config_t model = vehicleModelConfig<4>(state.vehicle_config);
+        const auto linear = linearizeHover<4>(model, 1.0);
+        expectNear("hover trim residual", linear.trim_residual, 0.0, 1e-9);
+        expectNear("gravity coupling", linear.a.m[kErrorVelocity][kErrorAttitude + 1], -model.gravity, 1e-6);
+
+        SmallMatrix<kHoverErrorSize, kHoverErrorSize> q{};
+        for (std::size_t i = 0; i < kHoverErrorSize; ++i) {
+            q.m[i][i] = 1.0 / (state.lqr_config.max_state_error[i] * state.lqr_config.max_state_error[i]);
+        }
+        SmallMatrix<4, 4> r = SmallMatrix<4, 4>::identity();
+        for (std::size_t i = 0; i < 4; ++i) {
+            r.m[i][i] = 1.0 / (150.0 * 150.0);
+        }
+        const auto solution = solveCare(linear.a, linear.b, q, r);
+        expectTrue("hover CARE converged", solution.converged);
+        expectTrue("Newton-Kleinman iterations bounded", solution.iterations < 30);
+        const auto& p = solution.cost;
+        const auto residual = transpose(linear.a) * p + p * linear.a + q -
+                              p * linear.b * solution.gain;
+        expectNear("CARE residual", maxAbs(residual) / maxAbs(p), 0.0, 1e-8);
+    }
+
+    const std::string cache = (std::filesystem::temp_directory_path() / "aerodyn_lqr_test_cache").string();
+    std::filesystem::remove_all(cache);
+
+    // Closed loop: synthesize on first use, hold a displaced position setpoint.
+    std::uint64_t key = 0;
+    {
+        SimulationState state;
+        state.controller_config.mode = SimulationState::ControllerConfig::Mode::Lqr;
+        state.lqr_config.cache_directory = cache;
+        ModuleScheduler scheduler;
+        buildClosedLoop(scheduler, state);
+
+        state.controller_setpoint.position_ned = glm::dvec3(1.0, -0.5, -1.0);
+        run(scheduler, state, 8.0);
+        expectTrue("schedule ready", state.lqr_status.ready);
+        expectTrue("first run solved", !state.lqr_status.from_cache);
+        expectNear("north held", state.physics.position.x, 1.0, 0.02);
+        expectNear("east held", state.physics.position.y, -0.5, 0.02);
+        expectNear("down held", state.physics.position.z, -1.0, 0.02);
+        expectNear("settled", glm::length(state.physics.velocity), 0.0, 0.02);
+        key = state.lqr_status.config_hash;
+        expectTrue("cache written",
+                   std::filesystem::exists(LqrControllerModule<QuadXLayout>::cachePath(cache, key)));
+
+        // Pirouette: the heading reference follows the commanded yaw rate.
+        state.controller_setpoint.rate_rad_s.z = 1.5;
+        run(scheduler, state, 4.0);
+        expectNear("pirouette rate", state.angular_rate_rad_s.z, 1.5, 0.05);
+        expectNear("position held while spinning", state.physics.position.x, 1.0, 0.1);
+    }
+
+    // Same plant and weights: the second run loads the cached schedule.
+    {
+        SimulationState state;
+        state.controller_config.mode = SimulationState::ControllerConfig::Mode::Lqr;
+        state.lqr_config.cache_directory = cache;
+        ModuleScheduler scheduler;
+        buildClosedLoop(scheduler, state);
+        run(scheduler, state, 0.1);
+        expectTrue("second run loaded cache", state.lqr_status.ready && state.lqr_status.from_cache);
+        expectTrue("same key", state.lqr_status.config_hash == key);
+    }
+
+    // Any plant change alters the key; a mismatched key is rejected on load.
+    {
+        SimulationState state;
+        state.vehicle_config.mass = 0.6;
+        expectTrue("mass changes key", LqrControllerModule<QuadXLayout>::configurationKey(state) != key);
+
+        GainSchedule<4, kHoverErrorSize> schedule;
+        expectTrue("wrong key rejected",
+                   !schedule.load(LqrControllerModule<QuadXLayout>::cachePath(cache, key), key + 1));
+        expectTrue("right key accepted",
+                   schedule.load(LqrControllerModule<QuadXLayout>::cachePath(cache, key), key));
+        expectTrue("all points stored", schedule.size() == state.lqr_config.yaw_rate_points_rad_s.size());
+
+        GainSchedule<4, kHoverErrorSize>::Gain blended{};
+        schedule.interpolate(0.5, blended);
+        const double expected = 0.5 * (schedule.gain(2).m[0][0] + schedule.gain(3).m[0][0]);
+        expectNear("linear interpolation", blended.m[0][0], expected, 1e-12);
+        schedule.interpolate(10.0, blended);
+        expectNear("clamped above table", blended.m[0][0], schedule.gain(4).m[0][0], 0.0);
+    }
+
+    // Octocopter: eight inputs through the same synthesis path.
+    {
+        SimulationState state;
+        state.vehicle_config.airframe = SimulationState::Airframe::OctoX;
+        state.controller_config.mode = SimulationState::ControllerConfig::Mode::Lqr;
+        state.lqr_config.use_disk_cache = false;
+        ModuleScheduler scheduler;
+        buildClosedLoop(scheduler, state);
+        state.controller_setpoint.position_ned = glm::dvec3(0.0, 1.0, 0.0);
+        run(scheduler, state, 8.0);
+        expectTrue("octo schedule ready", state.lqr_status.ready);
+        expectNear("octo east held", state.physics.position.y, 1.0, 0.02);
+    }
+
+    std::filesystem::remove_all(cache);
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d LQR controller check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("LQR controller checks passed");
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "core/attitude_history.h"
+#include "core/memory_accounting.h"
+#include "core/simulation_state.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+std::int64_t live(MemoryTag tag)
+{
+    return MemoryAccounting::usage(tag).live_bytes;
+}
+
+/// Slack for deque bookkeeping (node map, one partially used block)
+constexpr std::int64_t kSlackBytes = 8 * 1024;
+
+}  // namespace
+
+int main()
+{
+    // Tracked containers charge their tag and give every byte back.
+    {
+        const std::int64_t before = live(MemoryTag::Plot);
+        const std::uint64_t allocations = MemoryAccounting::usage(MemoryTag::Plot).allocations;
+        {
+            TrackedVector<double, MemoryTag::Plot> values(1000);
+            expectTrue("vector charged", live(MemoryTag::Plot) >= before + 8000);
+            expectTrue("other tags untouched", live(MemoryTag::Log) == 0);
+        }
+        expectTrue("bytes returned", live(MemoryTag::Plot) == before);
+        expectTrue("allocation counted", MemoryAccounting::usage(MemoryTag::Plot).allocations > allocations);
+        expectTrue("peak kept", MemoryAccounting::usage(MemoryTag::Plot).peak_bytes >= before + 8000);
+        MemoryAccounting::resetPeaks();
+        expectTrue("peak reset", MemoryAccounting::usage(MemoryTag::Plot).peak_bytes == before);
+
+        MemoryAccounting::charge(MemoryTag::Gpu, 4096);
+        expectTrue("manual charge", live(MemoryTag::Gpu) == 4096);
+        MemoryAccounting::refund(MemoryTag::Gpu, 4096);
+        expectTrue("manual refund", live(MemoryTag::Gpu) == 0);
+    }
+
+    // Evict: the buffer keeps its rate, the tag stays near its cap and the
+    // newest samples survive.
+    {
+        constexpr std::size_t kCap = 64 * 1024;
+        MemoryAccounting::setCap(MemoryTag::Plot, kCap, MemoryAccounting::Policy::Evict);
+        TrackedDeque<double, MemoryTag::Plot> samples;
+        int decimation = 1;
+        std::int64_t worst = 0;
+        for (int i = 0; i < 100000; ++i) {
+            samples.push_back(static_cast<double>(i));
+            enforceMemoryCap(MemoryTag::Plot, samples, decimation);
+            worst = std::max(worst, live(MemoryTag::Plot));
+        }
+        expectTrue("evict bounds live bytes", worst <= static_cast<std::int64_t>(kCap) + kSlackBytes);
+        expectTrue("evict keeps the rate", decimation == 1);
+        expectNear("evict keeps the newest", samples.back(), 99999.0, 0.0);
+        expectTrue("evict drops the oldest", samples.front() > 90000.0);
+        expectTrue("evictions counted", MemoryAccounting::usage(MemoryTag::Plot).enforcements > 0);
+        MemoryAccounting::setCap(MemoryTag::Plot, 0, MemoryAccounting::Policy::Evict);
+    }
+
+    // Decimate: the owner samples every decimation-th value, so the window
+    // is kept at a coarser rate; decimation relaxes once the cap is lifted.
+    {
+        constexpr std::size_t kCap = 64 * 1024;
+        MemoryAccounting::setCap(MemoryTag::History, kCap, MemoryAccounting::Policy::Decimate);
+        TrackedDeque<double, MemoryTag::History> samples;
+        int decimation = 1;
+        std::int64_t worst = 0;
+        int since_sample = 0;
+        for (int i = 0; i < 40000; ++i) {
+            if (++since_sample < decimation) {
+                continue;
+            }
+            since_sample = 0;
+            samples.push_back(static_cast<double>(i));
+            enforceMemoryCap(MemoryTag::History, samples, decimation);
+            worst = std::max(worst, live(MemoryTag::History));
+        }
+        expectTrue("decimate bounds live bytes", worst <= static_cast<std::int64_t>(kCap) + kSlackBytes);
+        expectTrue("decimation raised", decimation > 1);
+        expectTrue("decimate keeps the window", samples.front() < 1000.0);
+        expectTrue("decimate keeps the newest", samples.back() > 40000.0 - 2.0 * decimation);
+
+        MemoryAccounting::setCap(MemoryTag::History, 64 * kCap, MemoryAccounting::Policy::Decimate);
+        for (int i = 0; i < 8; ++i) {
+            memoryCapAction(MemoryTag::History, decimation);
+        }
+        expectTrue("decimation relaxes under the cap", decimation == 1);
+        MemoryAccounting::setCap(MemoryTag::History, 0, MemoryAccounting::Policy::Evict);
+    }
+
+    // The attitude history under a small cap samples coarser instead of
+    // growing, and still spans the run.
+    {
+        constexpr std::size_t kCap = 128 * 1024;
+        MemoryAccounting::setCap(MemoryTag::History, kCap, MemoryAccounting::Policy::Decimate);
+        SimulationState state;
+        state.attitude_history.sample_interval = 0.001;
+        state.attitude_history.window_seconds = 600.0;
+        std::int64_t worst = 0;
+        for (int i = 0; i < 60000; ++i) {
+            state.time_seconds += 0.001;
+            state.markPoseDirty();
+            captureAttitudeSample(state);
+            worst = std::max(worst, live(MemoryTag::History));
+        }
+        const auto& history = state.attitude_history;
+        expectTrue("history bounded", worst <= static_cast<std::int64_t>(kCap) + kSlackBytes);
+        expectTrue("history decimated", history.decimation > 1);
+        expectTrue("history spans the run", history.samples.front().timestamp < 5.0);
+        expectNear("history newest", history.samples.back().timestamp, state.time_seconds,
+                   0.001 * history.decimation);
+        MemoryAccounting::setCap(MemoryTag::History, 0, MemoryAccounting::Policy::Evict);
+    }
+
+    // A capped log refuses new channels instead of growing.
+    {
+        MemoryAccounting::setCap(MemoryTag::Log, 1, MemoryAccounting::Policy::Evict);
+        TelemetryChannels channels;
+        const std::size_t first = channels.registerChannel("first", "x");
+        expectTrue("first channel fits", first != TelemetryChannels::kInvalid);
+        expectTrue("over-cap log refuses channels",
+                   channels.registerChannel("second", "x") == TelemetryChannels::kInvalid);
+        MemoryAccounting::setCap(MemoryTag::Log, 0, MemoryAccounting::Policy::Evict);
+        expectTrue("uncapped log accepts channels",
+                   channels.registerChannel("second", "x") != TelemetryChannels::kInvalid);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d memory-accounting check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("Memory accounting checks passed");
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "core/module.h"
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+/// Fixed-rate module that takes cost_ms of wall time per update
+class SlowModule : public Module {
+public:
+    SlowModule(double period_s, double cost_ms) : period_s_(period_s), cost_ms_(cost_ms) {}
+
+    void update(double, SimulationState&) override {
+        if (cost_ms_ > 0.0) {
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(cost_ms_));
+        }
+        ++updates;
+    }
+    const char* name() const override { return "Slow"; }
+    double period() const override { return period_s_; }
+
+    int updates{0};
+
+private:
+    double period_s_;
+    double cost_ms_;
+};
+
+/// Per-tick module that only counts
+class CountingModule : public Module {
+public:
+    void update(double, SimulationState&) override { ++updates; }
+    const char* name() const override { return "Counting"; }
+
+    int updates{0};
+};
+
+std::size_t channelSamples(const SimulationState& state, const char* name)
+{
+    const std::size_t id = state.telemetry.find(name);
+    return id == TelemetryChannels::kInvalid ? 0 : state.telemetry.channel(id).size;
+}
+
+}  // namespace
+
+int main()
+{
+    // Multi-rate splitting: a 100 Hz module inside 25 ms ticks runs at
+    // exactly its rate and the per-tick module once per sub-step.
+    {
+        SimulationState state;
+        ModuleScheduler scheduler;
+        auto fixed = std::make_unique<SlowModule>(0.01, 0.0);
+        auto counting = std::make_unique<CountingModule>();
+        SlowModule* fixed_view = fixed.get();
+        CountingModule* counting_view = counting.get();
+        scheduler.add(std::move(fixed));
+        scheduler.add(std::move(counting));
+        scheduler.initialize(state);
+        for (int tick = 0; tick < 8; ++tick) {
+            scheduler.advance(0.025, state);
+        }
+        expectNear("time advanced", state.time_seconds, 0.2, 1e-12);
+        expectTrue("fixed-rate updates", fixed_view->updates == 20);
+        expectTrue("per-tick module runs every sub-step", counting_view->updates == 24);
+        expectTrue("profile slots", state.profile.count == 2 && state.profile.slots[0].calls == 20);
+    }
+
+    // Cheap modules at real time: no misses, and the factor is sim time over
+    // the wall time the caller reports.
+    {
+        SimulationState state;
+        state.realtime.target_factor = 1.0;
+        ModuleScheduler scheduler;
+        scheduler.add(std::make_unique<SlowModule>(0.002, 0.0));
+        scheduler.add(std::make_unique<CountingModule>());
+        scheduler.initialize(state);
+        expectTrue("initialize keeps the target", state.realtime.target_factor == 1.0);
+        for (int tick = 0; tick < 60; ++tick) {
+            state.realtime.wall_interval_s = 0.02;   // Frames arrive at 50 Hz, sim runs 60 Hz steps
+            scheduler.advance(1.0 / 60.0, state);
+        }
+        expectTrue("no misses when cheap", state.realtime.deadline_misses == 0);
+        expectNear("worst lateness when cheap", state.realtime.worst_lateness_us, 0.0, 0.0);
+        expectNear("tick factor", state.realtime.tick_factor, (1.0 / 60.0) / 0.02, 1e-12);
+        expectNear("window factor", state.realtime.factor, (1.0 / 60.0) / 0.02, 1e-12);
+        expectTrue("rtf channel", channelSamples(state, "sim.rtf") == 60);
+        expectTrue("lateness channel", channelSamples(state, "sim.lateness_us") == 60);
+    }
+
+    // A 100 Hz module costing 2 ms cannot keep up with 10x real time
+    // (1 ms of wall time per period): every update misses and lateness grows.
+    {
+        SimulationState state;
+        state.realtime.target_factor = 10.0;
+        ModuleScheduler scheduler;
+        scheduler.add(std::make_unique<SlowModule>(0.01, 2.0));
+        scheduler.initialize(state);
+        scheduler.advance(0.05, state);
+        const auto& slot = state.profile.slots[0];
+        expectTrue("slow module calls", slot.calls == 5);
+        expectTrue("every slow update misses", slot.deadline_misses == 5);
+        expectTrue("misses add up", state.realtime.deadline_misses == 5);
+        // The fifth update finishes after >= 10 ms against a 5 ms deadline.
+        expectTrue("slot lateness", slot.worst_lateness_us >= 4000.0);
+        expectTrue("overall lateness", state.realtime.worst_lateness_us == slot.worst_lateness_us);
+        expectTrue("no factor without wall interval", state.realtime.factor == 0.0 &&
+                                                      channelSamples(state, "sim.rtf") == 0);
+
+        // The same module meets real time, and initialize restarts the counts.
+        state.realtime.target_factor = 1.0;
+        scheduler.initialize(state);
+        expectTrue("initialize clears misses", state.realtime.deadline_misses == 0 &&
+                                               state.profile.slots[0].deadline_misses == 0);
+        scheduler.advance(0.05, state);
+        expectTrue("slow module meets real time", state.realtime.deadline_misses == 0);
+
+        // Without a target there are no deadlines at all.
+        state.realtime.target_factor = 0.0;
+        scheduler.initialize(state);
+        const std::size_t lateness_samples = channelSamples(state, "sim.lateness_us");
+        scheduler.advance(0.05, state);
+        expectTrue("no deadlines without a target", state.realtime.deadline_misses == 0);
+        expectTrue("no lateness samples without a target",
+                   channelSamples(state, "sim.lateness_us") == lateness_samples);
+    }
+
+    // Variable ticks at real time with frames (rendering included) taking
+    // 100 ms against a 1/30 s cap: the modules meet every deadline, but the
+    // factor shows the simulation falling behind by the time the cap cuts.
+    {
+        SimulationState state;
+        state.realtime.target_factor = 1.0;
+        state.realtime.max_tick_s = 1.0 / 30.0;
+        ModuleScheduler scheduler;
+        scheduler.add(std::make_unique<SlowModule>(0.01, 0.0));
+        scheduler.initialize(state);
+        expectTrue("initialize keeps the cap", state.realtime.max_tick_s == 1.0 / 30.0);
+        expectNear("short frame uncapped", ModuleScheduler::capTick(0.02, state), 0.02, 0.0);
+        for (int frame = 0; frame < 10; ++frame) {
+            state.realtime.wall_interval_s = 0.1;
+            scheduler.advance(ModuleScheduler::capTick(0.1, state), state);
+        }
+        expectTrue("modules keep up", state.realtime.deadline_misses == 0);
+        expectNear("capped time", state.time_seconds, 10.0 / 30.0, 1e-12);
+        expectNear("dropped time", state.realtime.dropped_s, 1.0 - 10.0 / 30.0, 1e-12);
+        expectNear("tick factor below target", state.realtime.tick_factor, 1.0 / 3.0, 1e-12);
+        expectNear("window factor below target", state.realtime.factor, 1.0 / 3.0, 1e-12);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d module-scheduler check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("Module scheduler checks passed");
+    return 0;
+}
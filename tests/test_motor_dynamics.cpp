@@ -0,0 +1,115 @@
+#include "core/first_order_lag_bank.h"
+#include "core/simulation_state.h"
+#include "modules/motor_dynamics.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    // Step response of K/(τs+1) matches the closed form at every sample.
+    FirstOrderLagBank<3> bank;
+    bank.setTimeConstant(0, 0.02);
+    bank.setTimeConstant(1, 0.05);
+    bank.setTimeConstant(2, 0.5);
+    bank.setGain(2, 2.0);
+    const double input[3] = {1.0, 1.0, 1.0};
+    const double dt = 0.004;
+    for (int k = 1; k <= 50; ++k) {
+        bank.step(dt, input);
+    }
+    const double t = 50 * dt;
+    expectNear("fast channel", bank.output(0), 1.0 - std::exp(-t / 0.02), 1e-12);
+    expectNear("slow channel", bank.output(1), 1.0 - std::exp(-t / 0.05), 1e-12);
+    expectNear("gain channel", bank.output(2), 2.0 * (1.0 - std::exp(-t / 0.5)), 1e-12);
+
+    // Exact discretization: one long step equals many short ones.
+    FirstOrderLagBank<1> coarse;
+    FirstOrderLagBank<1> fine;
+    coarse.setTimeConstant(0, 0.03);
+    fine.setTimeConstant(0, 0.03);
+    const double target = 900.0;
+    coarse.step(0.1, &target);
+    for (int k = 0; k < 100; ++k) {
+        fine.step(0.001, &target);
+    }
+    expectNear("step split invariance", coarse.output(0), fine.output(0), 1e-9);
+
+    // Steps far longer than τ stay stable and land on the target.
+    FirstOrderLagBank<1> stiff;
+    stiff.setTimeConstant(0, 1e-3);
+    stiff.step(1.0, &target);
+    expectNear("long step settles", stiff.output(0), target, 1e-9);
+
+    // Output saturation.
+    FirstOrderLagBank<2> limited;
+    limited.setLimits(0.0, 500.0);
+    limited.setTimeConstants(0.01);
+    const double beyond[2] = {900.0, -100.0};
+    limited.step(1.0, beyond);
+    expectNear("upper limit", limited.output(0), 500.0, 0.0);
+    expectNear("lower limit", limited.output(1), 0.0, 0.0);
+
+    // Motor module: actual speeds lag commands per rotor and respect limits.
+    SimulationState state;
+    state.motor_config.time_constant_s[0] = 0.02;
+    state.motor_config.time_constant_s[3] = 0.08;
+    state.motor_config.omega_max_rad_s = 1200.0;
+    MotorDynamicsModule<4> motors;
+    motors.initialize(state);
+    state.motor_state.omega_rad_s.fill(800.0);
+    state.motor_commands.omega_rad_s = {1000.0, 1000.0, 1500.0, 1000.0};
+    for (int k = 0; k < 10; ++k) {
+        motors.update(0.005, state);
+    }
+    expectNear("rotor 0 lag", state.motor_state.omega_rad_s[0],
+               1000.0 - 200.0 * std::exp(-0.05 / 0.02), 1e-9);
+    expectNear("rotor 3 lag", state.motor_state.omega_rad_s[3],
+               1000.0 - 200.0 * std::exp(-0.05 / 0.08), 1e-9);
+    expectTrue("rotor 2 saturates", state.motor_state.omega_rad_s[2] <= 1200.0);
+    expectNear("unused rotor untouched", state.motor_state.omega_rad_s[4], 800.0, 0.0);
+
+    state.motor_config.lag_enabled = false;
+    motors.update(0.005, state);
+    expectNear("bypass tracks command", state.motor_state.omega_rad_s[3], 1000.0, 0.0);
+    expectNear("bypass saturates high", state.motor_state.omega_rad_s[2], 1200.0, 0.0);
+    state.motor_config.omega_min_rad_s = 100.0;
+    state.motor_commands.omega_rad_s[1] = -50.0;
+    motors.update(0.005, state);
+    expectNear("bypass saturates low", state.motor_state.omega_rad_s[1], 100.0, 0.0);
+
+    auto hex = makeMotorDynamicsModule(SimulationState::Airframe::HexX);
+    expectTrue("factory builds hex motors", hex != nullptr);
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d motor dynamics check(s) failed\n", failures);
+        return 1;
+    }
+
+    std::puts("Motor dynamics: all tests passed");
+    return 0;
+}
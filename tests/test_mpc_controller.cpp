@@ -0,0 +1,157 @@
+#include "control/admm_qp.h"
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+#include "modules/motor_dynamics.h"
+#include "modules/mpc_controller.h"
+#include "modules/quadcopter_dynamics.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kFrameDt = 1.0 / 60.0;
+constexpr double kUnlimitedBudgetUs = 1e9;   ///< Keeps the wall clock out of the functional checks
+constexpr double kDeadlineUs = 2000.0;       ///< One 500 Hz period
+
+double deg2rad(double deg) { return deg * kPi / 180.0; }
+
+double rollOf(const SimulationState& state)
+{
+    const auto& q = state.quaternion;
+    return std::atan2(2.0 * (q[0] * q[1] + q[2] * q[3]), 1.0 - 2.0 * (q[1] * q[1] + q[2] * q[2]));
+}
+
+double yawOf(const SimulationState& state)
+{
+    const auto& q = state.quaternion;
+    return std::atan2(2.0 * (q[0] * q[3] + q[1] * q[2]), 1.0 - 2.0 * (q[2] * q[2] + q[3] * q[3]));
+}
+
+void run(ModuleScheduler& scheduler, SimulationState& state, double seconds)
+{
+    const int frames = static_cast<int>(std::lround(seconds / kFrameDt));
+    for (int i = 0; i < frames; ++i) {
+        scheduler.advance(kFrameDt, state);
+    }
+}
+
+}  // namespace
+
+// With --perf (the perf-labelled CTest entry) the closed loop runs on the
+// configured solver budget and must meet the 500 Hz deadline; otherwise the
+// budget is lifted so every check is independent of machine speed.
+int main(int argc, char** argv)
+{
+    const bool perf = argc > 1 && std::strcmp(argv[1], "--perf") == 0;
+    using Qp = AdmmQp<2, 2>;
+    const auto no_deadline = Qp::Clock::now() + std::chrono::hours(1);
+
+    // Box-constrained QP with a known solution: min ½‖x‖² + fᵀx, -1 ≤ x ≤ 1.
+    {
+        Qp qp;
+        expectTrue("configure", qp.configure(SmallMatrix<2, 2>::identity(), SmallMatrix<2, 2>::identity(), {}));
+        const auto result = qp.solve({-3.0, 0.5}, {-1.0, -1.0}, {1.0, 1.0}, no_deadline);
+        expectTrue("box QP solved", result.status == Qp::Status::Solved);
+        expectNear("active bound", qp.solution()[0], 1.0, 1e-3);
+        expectNear("inactive bound", qp.solution()[1], -0.5, 1e-3);
+
+        // Warm start: the same problem again converges at the first check.
+        const auto warm = qp.solve({-3.0, 0.5}, {-1.0, -1.0}, {1.0, 1.0}, no_deadline);
+        expectTrue("warm start converges immediately", warm.iterations <= result.iterations &&
+                                                      warm.iterations <= 5);
+
+        // A deadline already passed stops at the first check with a usable iterate.
+        qp.reset();
+        const auto late = qp.solve({-3.0, 0.5}, {-1.0, -1.0}, {1.0, 1.0}, Qp::Clock::now());
+        expectTrue("budget stop reported", late.status == Qp::Status::TimeBudget ||
+                                           late.status == Qp::Status::Solved);
+        expectTrue("budget stop is prompt", late.iterations <= 5);
+        expectTrue("slack within bounds", std::abs(qp.slack()[0]) <= 1.0 && std::abs(qp.slack()[1]) <= 1.0);
+    }
+
+    // Closed loop on the quad X: aggressive roll step, then a yaw step.
+    {
+        SimulationState state;
+        state.controller_config.mode = SimulationState::ControllerConfig::Mode::Mpc;
+        if (!perf) {
+            state.mpc_config.budget_us = kUnlimitedBudgetUs;
+        }
+        ModuleScheduler scheduler;
+        const auto airframe = state.vehicle_config.airframe;
+        scheduler.add(makeMpcControllerModule(airframe));
+        scheduler.add(makeMotorDynamicsModule(airframe));
+        scheduler.add(makeMultirotorDynamicsModule(airframe));
+        scheduler.initialize(state);
+        expectTrue("MPC slot named", std::strcmp(state.profile.slots[0].name, "MPC") == 0);
+
+        state.controller_setpoint.roll_rad = deg2rad(30.0);
+        run(scheduler, state, 2.0);
+        expectNear("roll tracks setpoint", rollOf(state), deg2rad(30.0), deg2rad(0.5));
+        expectNear("roll rate settles", state.angular_rate_rad_s.x, 0.0, 0.02);
+        expectTrue("rate limit respected",
+                   std::abs(state.angular_rate_rad_s.x) <= state.controller_config.max_rate_rad_s[0] + 0.1);
+
+        state.controller_setpoint.roll_rad = 0.0;
+        state.controller_setpoint.yaw_rad = deg2rad(30.0);
+        run(scheduler, state, 5.0);
+        expectNear("yaw tracks setpoint", yawOf(state), deg2rad(30.0), deg2rad(1.0));
+        expectNear("roll back to level", rollOf(state), 0.0, deg2rad(0.5));
+
+        // One telemetry sample per 500 Hz update; warm-started solves converge
+        // in a fraction of the iteration cap.
+        const auto& telemetry = state.telemetry;
+        const std::size_t solve = telemetry.find("mpc.solve_us");
+        const std::size_t iterations = telemetry.find("mpc.iterations");
+        expectTrue("solve channel registered", solve != TelemetryChannels::kInvalid);
+        expectTrue("iteration channel registered", iterations != TelemetryChannels::kInvalid);
+        expectNear("sample per update", static_cast<double>(telemetry.channel(solve).count), 3500.0, 1.0);
+        expectTrue("iterations recorded", telemetry.channel(iterations).mean() > 0.0);
+        const auto& status = state.mpc_status;
+        const double iteration_cap = 3.0 * static_cast<double>(state.mpc_config.max_iterations);
+        expectTrue("every update solved", status.solves == 3500);
+        expectTrue("no budget stop without a budget", perf || status.budget_overruns == 0);
+        if (status.budget_overruns == 0) {
+            expectTrue("warm-started solves converge", status.converged);
+        }
+        expectTrue("iterations within the cap", telemetry.channel(iterations).max < iteration_cap);
+        expectTrue("warm starts keep iterations low", telemetry.channel(iterations).mean() < 0.1 * iteration_cap);
+        if (perf) {
+            expectTrue("solve meets 500 Hz deadline", telemetry.channel(solve).max < kDeadlineUs);
+        }
+        std::printf("MPC solve: mean %.1f us, worst %.1f us, %llu of %llu ticks over the %.0f us budget\n",
+                    telemetry.channel(solve).mean(), telemetry.channel(solve).max,
+                    static_cast<unsigned long long>(status.budget_overruns),
+                    static_cast<unsigned long long>(status.solves), state.mpc_config.budget_us);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d MPC check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("MPC controller: all tests passed");
+    return 0;
+}
@@ -35,9 +35,19 @@ int main()
     plant.initialize(state);
 
     // Identity body attitude in NED maps to right/east, up/-down, back/-north.
-    expectNear("render row0 col1", state.model_matrix[1][0], 1.0, 1e-7);
-    expectNear("render row1 col2", state.model_matrix[2][1], -1.0, 1e-7);
-    expectNear("render row2 col0", state.model_matrix[0][2], -1.0, 1e-7);
+    expectNear("render row0 col1", state.modelMatrix()[1][0], 1.0, 1e-7);
+    expectNear("render row1 col2", state.modelMatrix()[2][1], -1.0, 1e-7);
+    expectNear("render row2 col0", state.modelMatrix()[0][2], -1.0, 1e-7);
+
+    // Derived views follow the canonical quaternion after every write.
+    SimulationState yawed;
+    const double half_yaw = 0.25;
+    yawed.setAttitude({std::cos(half_yaw), 0.0, 0.0, std::sin(half_yaw)});
+    expectNear("lazy euler yaw", yawed.euler().yaw, 2.0 * half_yaw, 1e-12);
+    expectNear("lazy dcm north-east", yawed.dcm()[1][0], std::sin(2.0 * half_yaw), 1e-12);
+    yawed.setAttitude({1.0, 0.0, 0.0, 0.0});
+    expectNear("lazy euler refreshed", yawed.euler().yaw, 0.0, 1e-12);
+    expectNear("lazy dcm refreshed", yawed.dcm()[1][0], 0.0, 1e-12);
 
     for (int i = 0; i < 400; ++i) {
         plant.update(0.0025, state);
@@ -63,6 +73,77 @@ int main()
     expectNear("rejected down unchanged", state.physics.position.z,
                position_before_rejection.z, 0.0);
 
+    // Adaptive Dormand-Prince mode: hover stays put with far fewer evaluations
+    // than the fixed 2.5 ms RK4 grid, and dense output spans the last frame.
+    SimulationState adaptive;
+    adaptive.plant_integration.method = SimulationState::PlantIntegration::Method::DormandPrince45;
+    adaptive.plant_integration.record_trajectory = true;
+    QuadcopterDynamicsModule adaptive_plant;
+    adaptive_plant.initialize(adaptive);
+    for (int i = 0; i < 50; ++i) {
+        adaptive.time_seconds += 0.02;
+        adaptive_plant.update(0.02, adaptive);
+    }
+    expectTrue("adaptive integration valid", adaptive.physics.integration_valid);
+    expectTrue("adaptive accepted steps", adaptive.physics.accepted_steps > 0U);
+    expectTrue("adaptive cheaper than fixed rk4",
+               adaptive.plant_integration.derivative_evaluations < 4U * 400U);
+    expectNear("adaptive hover down", adaptive.physics.position.z, 0.0, 1e-8);
+    expectNear("dense output start", adaptive.plant_integration.trajectory.startTime(),
+               adaptive.time_seconds - 0.02, 1e-12);
+    std::array<double, 13> mid{};
+    expectTrue("dense output samples inside frame",
+               adaptive.plant_integration.trajectory.sample(adaptive.time_seconds - 0.01, mid));
+    expectNear("dense output quaternion w", mid[6], 1.0, 1e-9);
+    adaptive.plant_integration.record_trajectory = false;
+    adaptive.time_seconds += 0.02;
+    adaptive_plant.update(0.02, adaptive);
+    expectTrue("dense output only on request", adaptive.plant_integration.trajectory.empty());
+    adaptive.plant_integration.record_trajectory = true;
+
+    // A yaw-rate spin-up is still tracked accurately by the adaptive scheme.
+    adaptive.angular_rate_rad_s = glm::dvec3(0.0, 0.0, 3.0);
+    adaptive_plant.update(0.02, adaptive);
+    expectNear("adaptive yaw after spin", adaptive.euler().yaw, 0.06, 1e-6);
+
+    // Every airframe instantiation trims to a level hover with its own rotor count.
+    auto check_hover = [](auto layout, const char* name) {
+        using Layout = decltype(layout);
+        double arm_x = 0.0;
+        double arm_y = 0.0;
+        double spin = 0.0;
+        for (const RotorPlacement& rotor : Layout::kRotors) {
+            arm_x += rotor.arm_x;
+            arm_y += rotor.arm_y;
+            spin += rotor.direction;
+        }
+        expectNear(name, arm_x, 0.0, 1e-12);
+        expectNear(name, arm_y, 0.0, 1e-12);
+        expectNear(name, spin, 0.0, 0.0);
+
+        SimulationState layout_state;
+        layout_state.plant_integration.method =
+            SimulationState::PlantIntegration::Method::DormandPrince45;
+        MultirotorDynamicsModule<Layout> layout_plant;
+        layout_plant.initialize(layout_state);
+        expectTrue(name, layout_state.vehicle_config.rotor_count == Layout::kRotorCount);
+        for (int i = 0; i < 50; ++i) {
+            layout_state.time_seconds += 0.02;
+            layout_plant.update(0.02, layout_state);
+        }
+        expectTrue(name, layout_state.physics.integration_valid);
+        expectNear(name, layout_state.physics.position.z, 0.0, 1e-8);
+        expectNear(name, layout_state.angular_rate_rad_s.z, 0.0, 1e-12);
+        expectNear(name, layout_state.rotor.total_thrust_newton,
+                   layout_state.vehicle_config.mass * layout_state.vehicle_config.gravity, 1e-9);
+        expectNear(name, layout_state.rotor.thrust_newton[Layout::kRotorCount - 1],
+                   layout_state.rotor.total_thrust_newton / Layout::kRotorCount, 1e-12);
+    };
+    check_hover(QuadXLayout{}, "quad x hover");
+    check_hover(QuadPlusLayout{}, "quad plus hover");
+    check_hover(HexXLayout{}, "hex hover");
+    check_hover(OctoXLayout{}, "octo hover");
+
     if (failures != 0) {
         std::fprintf(stderr, "%d AeroDyn plant check(s) failed\n", failures);
         return 1;
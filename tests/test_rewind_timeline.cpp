@@ -0,0 +1,210 @@
+#include "core/attitude_history.h"
+#include "core/module_scheduler.h"
+#include "core/rewind_timeline.h"
+#include "core/simulation_state.h"
+#include "modules/attitude_controller.h"
+#include "modules/complementary_estimator.h"
+#include "modules/motor_dynamics.h"
+#include "modules/quadcopter_dynamics.h"
+#include "modules/rotor_telemetry.h"
+#include "modules/sensor_simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+constexpr double kDt = 1.0 / 60.0;
+
+/// Per-tick module that totals the simulated time it has run, so tests can
+/// measure how much a seek replays independently of the machine
+class StepTotalModule : public Module {
+public:
+    void update(double dt, SimulationState&) override { simulated_s += dt; }
+    const char* name() const override { return "StepTotal"; }
+
+    double simulated_s{0.0};
+};
+
+/// Closed loop with estimator: every module that carries private state
+struct Rig {
+    SimulationState state;
+    ModuleScheduler scheduler;
+    RewindTimeline timeline;
+    StepTotalModule* stepped{nullptr};
+
+    explicit Rig(const RewindTimeline::Settings& settings)
+    {
+        const auto airframe = SimulationState::Airframe::QuadX;
+        state.vehicle_config.airframe = airframe;
+        scheduler.add(makeAttitudeControllerModule(airframe));
+        scheduler.add(makeMotorDynamicsModule(airframe));
+        scheduler.add(makeMultirotorDynamicsModule(airframe));
+        scheduler.add(std::make_unique<SensorSimulatorModule>());
+        scheduler.add(std::make_unique<ComplementaryEstimatorModule>());
+        scheduler.add(makeRotorTelemetryModule(airframe));
+        auto total = std::make_unique<StepTotalModule>();
+        stepped = total.get();
+        scheduler.add(std::move(total));
+        scheduler.initialize(state);
+        timeline.reset(scheduler, state, settings);
+    }
+
+    /// Pilot stick: a new attitude setpoint every few seconds
+    void fly(int frames)
+    {
+        for (int i = 0; i < frames; ++i) {
+            const int frame = static_cast<int>(std::lround(state.time_seconds / kDt));
+            if (frame % 150 == 0) {
+                auto& setpoint = state.controller_setpoint;
+                setpoint.roll_rad = 0.2 * std::sin(0.37 * frame);
+                setpoint.pitch_rad = 0.15 * std::cos(0.23 * frame);
+                setpoint.yaw_rad += 0.1;
+            }
+            timeline.step(kDt, scheduler, state);
+            captureAttitudeSample(state);
+        }
+    }
+};
+
+bool sameHot(const SimulationHotState& a, const SimulationState& b)
+{
+    return std::memcmp(&a, static_cast<const SimulationHotState*>(&b), sizeof(SimulationHotState)) == 0;
+}
+
+}  // namespace
+
+int main()
+{
+    // Seeking anywhere lands on the recorded state bit for bit, with the
+    // journal replaying setpoint changes and keyframes only once a second.
+    {
+        Rig rig(RewindTimeline::Settings{1.0, 600});
+        std::vector<SimulationHotState> recorded;
+        for (int i = 0; i < 3600; ++i) {
+            rig.fly(1);
+            recorded.push_back(rig.state.snapshot());
+        }
+        expectTrue("inputs journaled", rig.timeline.inputCount() > 10);
+        expectTrue("one keyframe per interval", rig.timeline.keyframeCount() <= 62);
+
+        const int targets[] = {1800, 100, 2999, 3000, 3599, 0, 777, 778, 2500};
+        for (int frame : targets) {
+            const double time = rig.timeline.seek(recorded[frame].time_seconds, rig.scheduler, rig.state);
+            expectNear("seek time", time, recorded[frame].time_seconds, 0.0);
+            expectTrue("seek is bitwise identical", sameHot(recorded[frame], rig.state));
+        }
+        expectTrue("history rebuilt", rig.state.attitude_history.samples.back().timestamp <= rig.state.time_seconds);
+
+        // Edits made while rewound are discarded by the next seek.
+        rig.timeline.seek(recorded[1000].time_seconds, rig.scheduler, rig.state);
+        rig.state.setAttitude({0.0, 1.0, 0.0, 0.0});
+        rig.timeline.seek(recorded[1010].time_seconds, rig.scheduler, rig.state);
+        expectTrue("stray edit dropped", sameHot(recorded[1010], rig.state));
+    }
+
+    // Branch from here: the recording after the playhead is replaced by the
+    // what-if run, which is itself seekable.
+    {
+        Rig rig(RewindTimeline::Settings{0.5, 600});
+        rig.fly(1200);
+        const double end = rig.timeline.endTime();
+        rig.timeline.seek(10.0, rig.scheduler, rig.state);
+        expectTrue("rewound", !rig.timeline.atEnd());
+        rig.timeline.branch();
+        expectTrue("branch truncates", rig.timeline.atEnd() && rig.timeline.endTime() < end);
+
+        rig.state.controller_setpoint.roll_rad = -0.3;
+        std::vector<SimulationHotState> branched;
+        for (int i = 0; i < 300; ++i) {
+            rig.fly(1);
+            branched.push_back(rig.state.snapshot());
+        }
+        // An attitude reset cannot be journaled; it forces a keyframe.
+        const std::size_t keyframes = rig.timeline.keyframeCount();
+        rig.state.setAttitude({1.0, 0.0, 0.0, 0.0});
+        rig.fly(1);
+        branched.push_back(rig.state.snapshot());
+        expectTrue("edit keyframed", rig.timeline.keyframeCount() == keyframes + 1);
+        rig.fly(60);
+
+        rig.timeline.seek(2.0, rig.scheduler, rig.state);
+        rig.timeline.seek(branched[150].time_seconds, rig.scheduler, rig.state);
+        expectTrue("branch replays", sameHot(branched[150], rig.state));
+        rig.timeline.seek(branched[300].time_seconds, rig.scheduler, rig.state);
+        expectTrue("edit replays", sameHot(branched[300], rig.state));
+
+        // Resetting time starts a new recording.
+        rig.timeline.seek(rig.timeline.endTime(), rig.scheduler, rig.state);
+        rig.state.time_seconds = 0.0;
+        rig.fly(10);
+        expectNear("new recording", rig.timeline.startTime(), 0.0, 0.0);
+        expectTrue("old recording dropped", rig.timeline.keyframeCount() == 1);
+    }
+
+    // The ring is bounded: a 10-minute session keeps max_keyframes, and
+    // scrubbing it costs at most one keyframe interval of replay.
+    {
+        Rig rig(RewindTimeline::Settings{1.0, 120});
+        rig.fly(36000);
+        expectTrue("ring bounded", rig.timeline.keyframeCount() == 120);
+        expectNear("oldest reachable", rig.timeline.startTime(), rig.timeline.endTime() - 119.0, 3.0);
+        expectTrue("journal trimmed", rig.timeline.tickCount() <= 121 * 60);
+        expectNear("clamped to the ring", rig.timeline.seek(0.0, rig.scheduler, rig.state),
+                   rig.timeline.startTime(), 0.0);
+
+        // Wall time depends on the machine, so it is only reported; the
+        // replay work per seek is what keeps scrubbing interactive.
+        double worst_ms = 0.0;
+        double worst_replay_s = 0.0;
+        bool landed = true;
+        double time = rig.timeline.endTime();
+        for (int i = 0; i < 50; ++i) {
+            time = rig.timeline.startTime() + std::fmod(time * 7.31 + 13.0, rig.timeline.endTime() - rig.timeline.startTime());
+            const double stepped_s = rig.stepped->simulated_s;
+            const auto start = std::chrono::steady_clock::now();
+            const double reached = rig.timeline.seek(time, rig.scheduler, rig.state);
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            worst_ms = std::max(worst_ms, ms);
+            worst_replay_s = std::max(worst_replay_s, rig.stepped->simulated_s - stepped_s);
+            landed = landed && reached <= time + 1e-9 && reached > time - kDt - 1e-9;
+        }
+        std::printf("keyframe %zu bytes, worst seek replays %.3f s in %.2f ms\n", rig.timeline.keyframeBytes(),
+                    worst_replay_s, worst_ms);
+        expectTrue("scrubbing lands on the tick at or before the target", landed);
+        expectTrue("seek replays at most one keyframe interval",
+                   worst_replay_s <= rig.timeline.settings().keyframe_interval_s + kDt + 1e-9);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d rewind-timeline check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("Rewind timeline checks passed");
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include "config/config_watcher.h"
+#include "config/rig_config.h"
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+#include "rig_fixture.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+RigConfig parsed(const std::string& text)
+{
+    return parseRigConfig(text, failures);
+}
+
+void writeFile(const std::string& path, const std::string& text)
+{
+    std::ofstream file(path);
+    file << text;
+}
+
+}  // namespace
+
+int main()
+{
+    // Defaults: an empty file changes nothing.
+    {
+        SimulationState state;
+        const RigConfig empty = parsed("# nothing but a comment\n\n");
+        expectTrue("empty file matches the built-in defaults", empty.apply(state) == 0);
+        expectTrue("quad X by default", empty.airframe() == SimulationState::Airframe::QuadX && empty.rotorCount() == 4);
+        expectTrue("layout table by default", !empty.vehicle().rotor_table_set);
+    }
+
+    // Syntax and range errors name their line; a failed parse keeps the old values.
+    {
+        const char* const bad[] = {"vehicle.mas 1", "vehicle.mass", "vehicle.mass -1", "vehicle.mass 1 2",
+                                   "vehicle.inertia 1 1", "vehicle.mass[0] 1", "rotor.position 0 0 0",
+                                   "rotor[9].direction 1", "rotor[x].direction 1", "rotor[0].direction 0.5",
+                                   "rotor[0].axis 0 0 0", "motor.lag maybe", "airframe tri", "estimator.kp nan",
+                                   "wind.turbulence gusty", "wind.length 0 10", "wind.seed 1.5", "wind.steady 1 2"};
+        for (const char* text : bad) {
+            RigConfig config = parsed("vehicle.mass 0.7");
+            const std::string with_line = std::string("# header\n") + text;
+            const bool ok = config.parse(with_line);
+            expectTrue(text, !ok && config.error().compare(0, 7, "line 2:") == 0 && config.vehicle().mass == 0.7);
+        }
+        RigConfig config;
+        expectTrue("duplicate names the first line",
+                   !config.parse("vehicle.mass 0.5\n\nvehicle.mass 0.6") &&
+                       config.error().find("already set on line 1") != std::string::npos);
+        expectTrue("rotor index checked against the airframe",
+                   !config.parse("rotor[5].direction 1\nairframe quadx") && config.error().compare(0, 7, "line 1:") == 0);
+        expectTrue("hex has a sixth rotor", config.parse("airframe hex\nrotor[5].direction 1") && config.rotorCount() == 6);
+        expectTrue("unrealizable inertia", !config.parse("vehicle.inertia 0.01 0.01 0.05"));
+        expectTrue("speed range", !config.parse("motor.omega_min 900\nmotor.omega_max 800"));
+        expectTrue("too heavy to fly", !config.parse("vehicle.mass 3") &&
+                                           config.error().find("cannot lift") != std::string::npos);
+        expectTrue("a bigger motor lifts it", config.parse("vehicle.mass 3\nmotor.omega_max 3000"));
+        expectTrue("missing file", !config.load("/nonexistent/rig.cfg"));
+    }
+
+    // Rotor table: per-rotor keys edit the layout entry at the configured arm and coefficients.
+    {
+        const RigConfig config = parsed("vehicle.arm_length 0.25\nrotor.thrust_coefficient 1.3e-6\n"
+                                        "rotor[1].thrust_coefficient 1.1e-6\nrotor[2].axis 0 3 -4\n"
+                                        "motor.time_constant 0.04\nmotor.time_constant[3] 0.05\n");
+        const auto& table = config.vehicle().rotor_table;
+        expectTrue("table handed to the plant", config.vehicle().rotor_table_set);
+        expectNear("layout position at the arm length", table[0].position_body_m[0], 0.25 * 0.70710678118654752, 1e-15);
+        expectNear("shared coefficient", table[0].thrust_coeff, 1.3e-6, 0.0);
+        expectNear("per-rotor coefficient", table[1].thrust_coeff, 1.1e-6, 0.0);
+        expectNear("axis normalized", table[2].axis_body[1], 0.6, 1e-15);
+        expectNear("layout spin sense kept", table[1].direction, -1.0, 0.0);
+        expectNear("every motor", config.motor().time_constant_s[2], 0.04, 0.0);
+        expectNear("one motor", config.motor().time_constant_s[3], 0.05, 0.0);
+    }
+
+    // apply() reports exactly the sections that changed.
+    {
+        SimulationState state;
+        expectTrue("vehicle", parsed("vehicle.mass 0.6").apply(state) == ConfigSection::kVehicle);
+        expectTrue("same again", parsed("vehicle.mass 0.6").apply(state) == 0);
+        expectTrue("back to defaults", parsed("").apply(state) == ConfigSection::kVehicle);
+        expectTrue("rotors", parsed("vehicle.arm_length 0.3").apply(state) == ConfigSection::kRotors);
+        expectTrue("motors", parsed("vehicle.arm_length 0.3\nmotor.lag off").apply(state) == ConfigSection::kMotors);
+        expectTrue("estimator and airframe",
+                   parsed("vehicle.arm_length 0.3\nmotor.lag off\nestimator.ki 0.1\nairframe hex").apply(state) ==
+                       (ConfigSection::kEstimator | ConfigSection::kAirframe));
+        expectTrue("estimator gains written", state.estimator_config.ki == 0.1f);
+    }
+
+    // In flight: only the plant and estimator are reconfigured, the vehicle
+    // carries on from where it is, and the controllers pick up the new plant.
+    {
+        RigFixture live(parsed(""), "config");
+        RigFixture stale(parsed(""), "config");
+        live.run(1.0);
+        stale.run(1.0);
+        const glm::dvec3 position = live.state.physics.position;
+        const double hover_before = live.state.trim.rotor_omega_rad_s[0];
+        const std::uint64_t revision = live.state.vehicle_config.rotor_geometry_revision;
+
+        const RigConfig heavier = parsed("vehicle.mass 0.6\nrotor[0].thrust_coefficient 1.1e-6\nestimator.kp 1");
+        const unsigned changed = heavier.apply(live.state);
+        expectTrue("sections", changed == (ConfigSection::kVehicle | ConfigSection::kRotors | ConfigSection::kEstimator));
+        expectTrue("plant and estimator only", live.modules.reconfigure(changed, live.state) == 2);
+        expectTrue("no reset", live.state.physics.position == position && live.state.time_seconds > 0.99);
+        expectTrue("geometry republished", live.state.vehicle_config.rotor_geometry_revision == revision + 1 &&
+                                               live.state.vehicle_config.rotors[0].thrust_coeff == 1.1e-6);
+        expectTrue("trim re-solved", live.state.trim.rotor_omega_rad_s[1] > hover_before);
+
+        // The same values without reconfigure: the controller flies a 0.6 kg
+        // model on a 0.5 kg plant and climbs away.
+        heavier.apply(stale.state);
+        live.run(3.0);
+        stale.run(3.0);
+        expectNear("thrust balances the new mass", live.state.physics.velocity.z, 0.0, 0.2);
+        expectNear("weak rotor compensated", live.state.euler().roll, 0.0, 0.02);
+        expectTrue("stale plant climbs", stale.state.physics.velocity.z < -0.5);
+    }
+
+    // The watcher reports finished writes and rename-overs of its file only.
+    {
+        char directory[] = "/tmp/aerodyn_config_XXXXXX";
+        expectTrue("temp dir", ::mkdtemp(directory) != nullptr);
+        const std::string path = std::string(directory) + "/rig.cfg";
+        writeFile(path, "vehicle.mass 0.5\n");
+        ConfigWatcher watcher;
+        expectTrue("watching", watcher.watch(path) && watcher.active());
+        expectTrue("quiet at start", !watcher.poll());
+        writeFile(path, "vehicle.mass 0.55\n");
+        expectTrue("write seen", watcher.poll());
+        expectTrue("reported once", !watcher.poll());
+        writeFile(std::string(directory) + "/other.cfg", "x");
+        expectTrue("other files ignored", !watcher.poll());
+        writeFile(path + ".tmp", "vehicle.mass 0.6\n");
+        std::rename((path + ".tmp").c_str(), path.c_str());
+        expectTrue("rename over the file seen", watcher.poll());
+        RigConfig config;
+        expectTrue("reads the new file", config.load(path) && config.vehicle().mass == 0.6);
+        watcher.close();
+        std::remove(path.c_str());
+        std::remove((std::string(directory) + "/other.cfg").c_str());
+        ::rmdir(directory);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d rig config check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("Rig config checks passed");
+    return 0;
+}
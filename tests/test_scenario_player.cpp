@@ -0,0 +1,222 @@
+#include "analysis/golden_trace.h"
+#include "analysis/scenario_runner.h"
+#include "core/module_scheduler.h"
+#include "core/rewind_timeline.h"
+#include "core/simulation_state.h"
+#include "modules/rig_pipeline.h"
+#include "modules/scenario_player.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+
+/// Step, hold against a disturbance torque, lose some of a rotor; the last assertion fails on purpose
+const char* const kScript = R"(
+# roll step and recovery
+dt 0.01
+duration 6
+0.0  mode attitude
+0.5  setpoint roll_deg 10
+2.0  assert roll_deg ~ 10 1
+2.0  assert setpoint.roll_deg ~ 10 0
+2.0  setpoint roll_deg 0
+3.5  assert roll_deg ~ 0 1
+3.5  param controller.rate_kp[0] 25
+3.5  disturbance torque_body 0.02 0 0
+5.0  assert roll_deg ~ 0 1.5
+5.0  fault rotor_effectiveness[0] 0.8
+5.9  assert roll_deg < 10
+5.9  assert altitude_m > 100          # fails
+)";
+
+std::string linkName()
+{
+    return "/aerodyn_sitl_scenario_test_" + std::to_string(::getpid());
+}
+
+bool sameHot(const SimulationHotState& a, const SimulationState& b)
+{
+    return std::memcmp(&a, static_cast<const SimulationHotState*>(&b), sizeof(SimulationHotState)) == 0;
+}
+
+/// No-op stand-in so the dispatch benchmark measures the player alone
+struct Idle : Module {
+    void update(double, SimulationState&) override {}
+};
+
+}  // namespace
+
+int main()
+{
+    // Parsing: units, ordering and line-numbered errors.
+    {
+        ScenarioScript script;
+        expectTrue("parses", script.parse("dt 0.005\n2 setpoint roll_deg 1\n1 setpoint roll_deg 2 # later\n"
+                                          "1 setpoint pitch_deg 3\n1 mode lqr\n"));
+        const auto& events = script.events();
+        expectTrue("four events", events.size() == 4);
+        if (events.size() == 4) {
+            expectTrue("sorted, ties in file order", events[0].time_s == 1.0 && events[0].values[0] == 2.0 * kDegToRad &&
+                                                         events[1].values[0] == 3.0 * kDegToRad &&
+                                                         events[2].values[0] == 3.0 && events[3].time_s == 2.0);
+        }
+        expectNear("frame length", script.frameDt(), 0.005, 0.0);
+        expectNear("duration covers the last event", script.duration(), 2.005, 1e-12);
+        expectTrue("frames", script.frames() == 401);
+
+        const char* const bad[] = {"1 setpoint rol_deg 2", "1 jump 2", "x setpoint roll_deg 1",
+                                   "1 fault rotor_effectiveness[9] 0.5", "1 setpoint rate_deg_s 1 2",
+                                   "1 assert roll_deg ~ 3", "1 assert position_ned > 1", "dt 0",
+                                   "1 param controller.mode 2.5", "1 fault rotor_effectiveness 0.5"};
+        for (const char* line : bad) {
+            ScenarioScript rejected;
+            const bool parsed = rejected.parse(std::string("0 mode rate\n") + line);
+            expectTrue(line, !parsed && rejected.error().compare(0, 7, "line 2:") == 0);
+        }
+        expectTrue("failed parse keeps the script", !script.parse("1 nope") && script.events().size() == 4);
+    }
+
+    ScenarioScript script;
+    expectTrue("scenario parses", script.parse(kScript));
+
+    // Headless: events land, assertions are evaluated and reported.
+    const ScenarioOutcome headless = runScenario("roll_step", script, RigConfig{}, linkName());
+    const auto& status = headless.status;
+    expectTrue("every event dispatched", status.active && status.dispatched == status.events && status.events == 12);
+    expectTrue("assertions pass", status.assertions_passed == 5);
+    expectTrue("one failure", status.assertions_failed == 1);
+    expectTrue("failure names its line", status.first_failure.find("line 16: altitude_m") != std::string::npos);
+    expectTrue("whole run recorded", headless.trace.steps() == 600);
+
+    // The GUI path (rewind timeline, same pipeline, same fixed frame) is bit-identical.
+    {
+        SimulationState state;
+        const std::string link = linkName();
+        state.sitl_config.link_name = link.c_str();
+        ModuleScheduler modules;
+        modules.add(std::make_unique<ScenarioPlayerModule>(script));
+        addRigModules(modules, state.vehicle_config.airframe);
+        modules.initialize(state);
+        RewindTimeline timeline;
+        timeline.reset(modules, state, RewindTimeline::Settings{1.0, 600});
+
+        GoldenTrace gui("roll_step", traceFields(state.vehicle_config.rotor_count), script.frameDt());
+        std::vector<double> row(gui.width());
+        for (std::size_t frame = 0; frame < script.frames(); ++frame) {
+            timeline.step(script.frameDt(), modules, state);
+            sampleTraceRow(state, state.vehicle_config.rotor_count, row.data());
+            gui.append(row.data());
+        }
+        const TraceDiff diff = compareTraces(headless.trace, gui);
+        expectTrue("GUI run matches headless bit for bit", diff.match);
+        if (!diff.match) {
+            std::fprintf(stderr, "  %s\n", diff.describe().c_str());
+        }
+        expectTrue("same verdicts", state.scenario_status.assertions_failed == 1 &&
+                                        state.scenario_status.assertions_passed == 5);
+
+        // Rewinding before a parameter change puts the parameter back; playing
+        // on re-applies it and lands on the same final state.
+        timeline.seek(3.2, modules, state);
+        expectNear("gain restored on rewind", state.controller_config.rate_kp[0], 20.0, 0.0);
+        expectNear("disturbance restored on rewind", state.disturbance.torque_body.x, 0.0, 0.0);
+        expectTrue("assertion count rewound", state.scenario_status.assertions_passed == 2);
+        timeline.seek(timeline.endTime(), modules, state);
+        expectNear("gain re-applied", state.controller_config.rate_kp[0], 25.0, 0.0);
+        expectNear("fault re-applied", state.disturbance.rotor_effectiveness[0], 0.8, 0.0);
+        expectTrue("replay reaches the headless final state", sameHot(headless.final_state, state));
+    }
+
+    // Setpoints come back from the keyframe and journal, not from the script:
+    // a seek across a scripted setpoint change keeps the pilot's later edit.
+    {
+        ScenarioScript stick;
+        expectTrue("setpoint script parses", stick.parse("dt 0.01\nduration 3\n0.5 setpoint roll_deg 10\n"));
+        SimulationState state;
+        const std::string link = linkName();
+        state.sitl_config.link_name = link.c_str();
+        ModuleScheduler modules;
+        modules.add(std::make_unique<ScenarioPlayerModule>(stick));
+        addRigModules(modules, state.vehicle_config.airframe);
+        modules.initialize(state);
+        RewindTimeline timeline;
+        timeline.reset(modules, state, RewindTimeline::Settings{1.0, 600});
+
+        std::vector<SimulationHotState> recorded;
+        for (std::size_t frame = 0; frame < stick.frames(); ++frame) {
+            if (frame == 150) {
+                state.controller_setpoint.roll_rad = -5.0 * kDegToRad;
+            }
+            timeline.step(stick.frameDt(), modules, state);
+            recorded.push_back(state.snapshot());
+        }
+
+        timeline.seek(recorded[80].time_seconds, modules, state);
+        expectNear("scripted setpoint replayed", state.controller_setpoint.roll_rad, 10.0 * kDegToRad, 0.0);
+        timeline.seek(recorded[250].time_seconds, modules, state);
+        expectNear("pilot edit survives the seek", state.controller_setpoint.roll_rad, -5.0 * kDegToRad, 0.0);
+        expectTrue("seek past the edit is bitwise identical", sameHot(recorded[250], state));
+    }
+
+    // Dispatch is a cursor compare: 200k pending events cost nothing per step.
+    {
+        std::string text = "dt 0.001\n";
+        for (int i = 0; i < 200000; ++i) {
+            text += "1000 setpoint roll_deg 1\n";
+        }
+        ScenarioScript crowded;
+        expectTrue("large script parses", crowded.parse(text));
+        SimulationState state;
+        ModuleScheduler modules;
+        modules.add(std::make_unique<ScenarioPlayerModule>(crowded));
+        modules.add(std::make_unique<Idle>());
+        modules.initialize(state);
+        const int steps = 20000;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < steps; ++i) {
+            modules.advance(0.001, state);
+        }
+        const double per_step_ns =
+            std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / steps;
+        expectTrue("nothing dispatched early", state.scenario_status.dispatched == 0);
+        expectTrue("constant-time dispatch", per_step_ns < 5000.0);
+        std::printf("scenario step with 200k pending events: %.0f ns (whole scheduler tick)\n", per_step_ns);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d scenario player check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("Scenario player checks passed");
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "core/telemetry_channels.h"
+#include "ipc/shm_telemetry_publisher.h"
+#include "ipc/shm_telemetry_reader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+/// Sample i carries value i and timestamp i / 1000, so a torn record is detectable
+double stamp(double value)
+{
+    return value / 1000.0;
+}
+
+/**
+ * @brief Consumer process body: follow the ring until `last` arrives
+ * @return 0 if every sample was whole and in order
+ */
+int consume(const char* name, double last)
+{
+    ShmTelemetryReader reader;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (!reader.attach(name)) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return 3;
+        }
+    }
+    ShmTelemetryReader::Sample batch[256];
+    double previous = -1.0;
+    while (previous < last) {
+        const std::size_t count = reader.read(batch, 256);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (batch[i].timestamp != stamp(batch[i].value) || batch[i].value <= previous) {
+                return 1;   // Torn or out of order
+            }
+            previous = batch[i].value;
+        }
+        if (count == 0 && std::chrono::steady_clock::now() > deadline) {
+            return 2;
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main()
+{
+    const std::string name = "/aerodyn_test_" + std::to_string(::getpid());
+
+    // Channels and samples arrive in order; each reader has its own cursor.
+    {
+        ShmTelemetryPublisher publisher;
+        expectTrue("publisher opens", publisher.open(name.c_str(), 1000));
+        TelemetryChannels channels;
+        const std::size_t first = channels.registerChannel("sim.rtf", "x");
+        expectTrue("sink attached", channels.addSink(&publisher));
+        const std::size_t second = channels.registerChannel("mpc.solve_us", "us");
+
+        ShmTelemetryReader reader;
+        expectTrue("reader attaches", reader.attach(name.c_str()));
+        expectTrue("channel table", reader.channelCount() == 2 &&
+                                        std::strcmp(reader.channelName(first), "sim.rtf") == 0 &&
+                                        std::strcmp(reader.channelUnit(second), "us") == 0);
+        expectTrue("find channel", reader.findChannel("mpc.solve_us") == second);
+
+        for (int i = 0; i < 500; ++i) {
+            channels.record(i % 2 == 0 ? first : second, stamp(i), static_cast<double>(i));
+        }
+        ShmTelemetryReader late;
+        late.attach(name.c_str());
+
+        std::vector<ShmTelemetryReader::Sample> samples(600);
+        const std::size_t count = reader.read(samples.data(), samples.size());
+        expectTrue("all samples", count == 500);
+        bool ordered = true;
+        for (std::size_t i = 0; i < count; ++i) {
+            ordered = ordered && samples[i].value == static_cast<double>(i) &&
+                      samples[i].timestamp == stamp(static_cast<double>(i)) &&
+                      samples[i].channel == (i % 2 == 0 ? first : second);
+        }
+        expectTrue("samples in order", ordered);
+        expectTrue("caught up", reader.read(samples.data(), samples.size()) == 0);
+        expectTrue("independent cursor", late.available() == 500);
+
+        // The late reader is lapped: it skips ahead and never sees a stale slot.
+        for (int i = 500; i < 5000; ++i) {
+            channels.record(first, stamp(i), static_cast<double>(i));
+        }
+        std::vector<ShmTelemetryReader::Sample> rest(4096);
+        const std::size_t kept = late.read(rest.data(), rest.size());
+        expectTrue("lapped reader drops", late.dropped() > 0);
+        expectTrue("lapped reader resumes", kept > 0 && rest[kept - 1].value == 4999.0);
+        bool increasing = true;
+        for (std::size_t i = 1; i < kept; ++i) {
+            increasing = increasing && rest[i].value == rest[i - 1].value + 1.0;
+        }
+        expectTrue("no stale samples after a lap", increasing);
+
+        channels.removeSink(&publisher);
+        channels.record(first, 10.0, -1.0);
+        expectTrue("removed sink sees nothing", publisher.published() == 5000);
+
+        publisher.close();
+        expectTrue("close is visible", reader.publisherClosed());
+        ShmTelemetryReader after;
+        expectTrue("closed segment is unlinked", !after.attach(name.c_str()));
+    }
+
+    // A consumer process follows a fast producer without torn reads.
+    {
+        constexpr int kSamples = 400000;
+        ShmTelemetryPublisher publisher;
+        expectTrue("publisher reopens", publisher.open(name.c_str(), 4096));
+        TelemetryChannels channels;
+        channels.addSink(&publisher);
+        const std::size_t id = channels.registerChannel("bench.counter", "");
+
+        const pid_t child = ::fork();
+        if (child == 0) {
+            _exit(consume(name.c_str(), kSamples - 1));
+        }
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kSamples; ++i) {
+            channels.record(id, stamp(i), static_cast<double>(i));
+        }
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        // The segment stays open (last sample retained) until the consumer has it.
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        expectTrue("consumer saw whole, ordered samples", WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        std::printf("publish: %.1f ns/sample\n", ns / kSamples);
+    }
+
+    // Readers refuse a segment with another major layout version.
+    {
+        const std::string bogus = name + "_v2";
+        const int fd = ::shm_open(bogus.c_str(), O_CREAT | O_RDWR, 0600);
+        const std::size_t bytes = shm_telemetry::segmentBytes(16);
+        expectTrue("bogus segment", fd >= 0 && ::ftruncate(fd, static_cast<off_t>(bytes)) == 0);
+        void* memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        auto* header = new (memory) shm_telemetry::Header;
+        header->magic = shm_telemetry::kMagic;
+        header->layout_major = shm_telemetry::kLayoutMajor + 1;
+        header->header_bytes = sizeof(shm_telemetry::Header);
+        header->record_bytes = sizeof(shm_telemetry::Record);
+        header->record_capacity = 16;
+        header->ready.store(1);
+        ShmTelemetryReader reader;
+        expectTrue("major version checked", !reader.attach(bogus.c_str()) &&
+                                                reader.error().find("version") != std::string::npos);
+        ::munmap(memory, bytes);
+        ::shm_unlink(bogus.c_str());
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d shared-memory telemetry check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("Shared-memory telemetry checks passed");
+    return 0;
+}
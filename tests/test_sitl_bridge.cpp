@@ -0,0 +1,156 @@
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+#include "modules/motor_dynamics.h"
+#include "modules/quadcopter_dynamics.h"
+#include "modules/sensor_simulator.h"
+#include "modules/sitl_bridge.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+constexpr double kTick = 0.01;
+constexpr int kTicks = 200;         ///< 2 s of flight
+constexpr int kFrames = 1000;       ///< Exchanges in 2 s at 500 Hz
+constexpr double kExchangeBudgetUs = 20.0;   ///< Median round trip the lockstep link is built for
+
+/// Start the mock controller process; it answers `frames` exchanges, then exits
+pid_t spawnController(const char* program, const std::string& link, int frames)
+{
+    const pid_t child = ::fork();
+    if (child == 0) {
+        const std::string count = std::to_string(frames);
+        ::execl(program, program, "--name", link.c_str(), "--frames", count.c_str(), "--timeout", "20",
+                static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    return child;
+}
+
+struct Flight {
+    SimulationHotState final_state;
+    SimulationState::SitlStatus status;
+    std::uint64_t plant_calls;
+    std::vector<double> round_trips_us;
+    double wall_s;
+    bool paused_while_linked;
+    bool controller_ok;
+};
+
+Flight fly(const char* program, const std::string& link)
+{
+    SimulationState state;
+    state.controller_config.mode = SimulationState::ControllerConfig::Mode::External;
+    state.controller_config.rate_hz = 500.0;
+    state.sitl_config.link_name = link.c_str();
+    state.sitl_config.timeout_s = 5.0;
+    ModuleScheduler scheduler;
+    scheduler.add(std::make_unique<SitlBridgeModule>());
+    scheduler.add(makeMotorDynamicsModule(SimulationState::Airframe::QuadX));
+    scheduler.add(makeMultirotorDynamicsModule(SimulationState::Airframe::QuadX));
+    scheduler.add(std::make_unique<SensorSimulatorModule>());
+    scheduler.initialize(state);
+
+    Flight flight{};
+    const pid_t controller = spawnController(program, link, kFrames);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTicks; ++i) {
+        scheduler.advance(kTick, state);
+    }
+    flight.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    flight.final_state = state.snapshot();
+    flight.paused_while_linked = state.control.paused;
+    flight.plant_calls = state.profile.slots[2].calls;
+    state.telemetry.forEachSample(state.telemetry.find("sitl.exchange_us"),
+                                  [&](const TelemetryChannels::Sample& sample) {
+                                      flight.round_trips_us.push_back(sample.value);
+                                  });
+
+    // The controller has answered its quota and exited: the next exchange times out.
+    int status = 0;
+    ::waitpid(controller, &status, 0);
+    flight.controller_ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    state.sitl_config.timeout_s = 0.05;
+    scheduler.advance(kTick, state);
+    flight.status = state.sitl_status;
+    flight.paused_while_linked = flight.paused_while_linked || !state.control.paused;
+    return flight;
+}
+
+}  // namespace
+
+// With --perf (the perf-labelled CTest entry) the exchange must also meet
+// its 20 µs median budget and the flight must run faster than real time.
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <path to aerodyn_sitl_mock> [--perf]\n", argv[0]);
+        return 2;
+    }
+    const bool perf = argc > 2 && std::strcmp(argv[2], "--perf") == 0;
+    const std::string link = "/aerodyn_sitl_test_" + std::to_string(::getpid());
+
+    const Flight first = fly(argv[1], link);
+    expectTrue("controller process exits cleanly", first.controller_ok);
+    expectTrue("one exchange per controller period", first.status.exchanges == kFrames);
+    expectTrue("plant steps only with fresh commands", first.plant_calls == kFrames);
+    expectTrue("missed exchange is counted", first.status.timeouts == 1 && !first.status.connected);
+    expectTrue("pauses only when the controller is gone", !first.paused_while_linked);
+    expectNear("mock controller holds altitude", first.final_state.physics.position.z, 0.0, 0.05);
+
+    // Lockstep makes the run independent of process timing.
+    const Flight second = fly(argv[1], link);
+    expectTrue("second run completes", second.controller_ok && second.status.exchanges == kFrames);
+    expectTrue("lockstep runs are bitwise identical",
+               std::memcmp(&first.final_state, &second.final_state, sizeof(SimulationHotState)) == 0);
+
+    std::vector<double> round_trips = first.round_trips_us;
+    round_trips.insert(round_trips.end(), second.round_trips_us.begin(), second.round_trips_us.end());
+    std::sort(round_trips.begin(), round_trips.end());
+    const double median_us = round_trips.empty() ? 0.0 : round_trips[round_trips.size() / 2];
+    const double p99_us = round_trips.empty() ? 0.0 : round_trips[round_trips.size() * 99 / 100];
+    expectTrue("round trips recorded", round_trips.size() == 2 * kFrames);
+    if (perf) {
+        expectTrue("median exchange within the 20 us budget", median_us < kExchangeBudgetUs);
+        expectTrue("faster than real time", first.wall_s < kTicks * kTick);
+    }
+    std::printf("exchange: median %.1f us, p99 %.1f us, max %.1f us; %.0fx real time\n", median_us, p99_us,
+                std::max(first.status.max_us, second.status.max_us), kTicks * kTick / first.wall_s);
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d SITL bridge check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("SITL bridge checks passed");
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "core/attitude_history.h"
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+#include "modules/motor_dynamics.h"
+#include "modules/quadcopter_dynamics.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+constexpr double kDt = 0.005;
+
+/// Position and attitude after every step
+std::vector<double> fly(ModuleScheduler& scheduler, SimulationState& state, int steps)
+{
+    std::vector<double> trace;
+    for (int i = 0; i < steps; ++i) {
+        scheduler.advance(kDt, state);
+        trace.push_back(state.physics.position.z);
+        trace.push_back(state.quaternion[1]);
+        trace.push_back(state.angular_rate_rad_s.x);
+    }
+    return trace;
+}
+
+}  // namespace
+
+int main()
+{
+    expectTrue("hot block is compact", sizeof(SimulationHotState) <= 1024);
+
+    // Restoring a snapshot replays the same trajectory bit for bit.
+    {
+        SimulationState state;
+        ModuleScheduler scheduler;
+        scheduler.add(makeMotorDynamicsModule(SimulationState::Airframe::QuadX));
+        scheduler.add(makeMultirotorDynamicsModule(SimulationState::Airframe::QuadX));
+        scheduler.initialize(state);
+        // Uneven rotor commands so the vehicle tumbles and climbs.
+        for (std::size_t i = 0; i < 4; ++i) {
+            state.motor_commands.omega_rad_s[i] = 1100.0 + 40.0 * static_cast<double>(i);
+        }
+        fly(scheduler, state, 100);
+
+        const SimulationHotState snapshot = state.snapshot();
+        const std::vector<double> first = fly(scheduler, state, 200);
+        expectTrue("vehicle moved", first.back() != first.front());
+
+        state.restore(snapshot);
+        expectNear("time restored", state.time_seconds, snapshot.time_seconds, 0.0);
+        const std::vector<double> second = fly(scheduler, state, 200);
+        bool identical = first.size() == second.size();
+        for (std::size_t i = 0; identical && i < first.size(); ++i) {
+            identical = first[i] == second[i];
+        }
+        expectTrue("replay is bitwise identical", identical);
+    }
+
+    // Restore invalidates the cached views and leaves the cold state alone.
+    {
+        SimulationState state;
+        state.setAttitude({0.9238795325112867, 0.3826834323650898, 0.0, 0.0});   // 45 deg roll
+        const SimulationHotState rolled = state.snapshot();
+        state.setAttitude({1.0, 0.0, 0.0, 0.0});
+        expectNear("level before restore", state.euler().roll, 0.0, 1e-12);
+
+        state.time_seconds = 1.0;
+        captureAttitudeSample(state);
+        state.controller_config.rate_hz = 250.0;
+        state.restore(rolled);
+        expectNear("euler recomputed", state.euler().roll, 0.7853981633974483, 1e-9);
+        expectTrue("history kept", state.attitude_history.samples.size() == 1);
+        expectNear("configuration kept", state.controller_config.rate_hz, 250.0, 0.0);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d state-snapshot check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("State snapshot checks passed");
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "analysis/headless_target.h"
+#include "analysis/step_metrics.h"
+#include "core/simulation_state.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+constexpr double kPi = 3.14159265358979323846;
+
+}  // namespace
+
+int main()
+{
+    // Hand-fed second-order underdamped step: overshoot exp(-πζ/√(1-ζ²)),
+    // peak at π/ωd, all without storing the trace.
+    {
+        const double zeta = 0.3;
+        const double wn = 4.0;
+        const double wd = wn * std::sqrt(1.0 - zeta * zeta);
+        StepMetricsAccumulator accumulator;
+        accumulator.reset(1.0, 0.0, 2.0);
+        const double dt = 1e-4;
+        for (int n = 1; n <= 100000; ++n) {
+            const double t = n * dt;
+            const double y = 2.0 * (1.0 - std::exp(-zeta * wn * t) *
+                                              (std::cos(wd * t) + zeta / std::sqrt(1.0 - zeta * zeta) * std::sin(wd * t)));
+            accumulator.add(1.0 + t, 2.0, y);
+        }
+        const StepMetrics& m = accumulator.metrics();
+        const double overshoot = 100.0 * std::exp(-kPi * zeta / std::sqrt(1.0 - zeta * zeta));
+        expectNear("second-order overshoot", m.overshoot_pct, overshoot, 1e-3);
+        expectNear("second-order peak time", m.peak_time_s, kPi / wd, 2e-4);
+        expectTrue("second-order settles", m.settling_time_s > 0.0 && m.settling_time_s < 4.0 / (zeta * wn));
+        expectNear("second-order final error", m.steady_state_error, 0.0, 1e-4);
+        expectTrue("sample count", m.samples == 100000);
+    }
+
+    // First-order grid, run in parallel: rise τ·ln 9, 2 % settling τ·ln 50,
+    // no overshoot, IAE = K·A·τ and ITAE = K·A·τ².
+    {
+        const std::vector<double> taus = {0.1, 0.5, 1.0, 2.0};
+        const std::vector<double> gains = {0.5, 1.0, 3.0};
+        const std::vector<HeadlessTarget> grid = firstOrderGrid(SimulationState::DynamicsConfig{}, taus, gains);
+        expectTrue("grid size", grid.size() == taus.size() * gains.size());
+
+        StepTestSettings settings;
+        settings.amplitude = 0.8;
+        settings.duration_s = 30.0;
+        std::atomic<std::size_t> completed{0};
+        const std::vector<StepMetrics> results = runStepTests(grid, settings, &completed);
+        expectTrue("grid results", results.size() == grid.size());
+        expectTrue("grid progress", completed.load() == grid.size());
+        for (std::size_t i = 0; i < taus.size(); ++i) {
+            for (std::size_t j = 0; j < gains.size(); ++j) {
+                const StepMetrics& m = results[i * gains.size() + j];
+                const double tau = taus[i];
+                const double scale = gains[j] * settings.amplitude;
+                expectNear("first-order rise", m.rise_time_s, tau * std::log(9.0), 1e-6);
+                expectNear("first-order settling", m.settling_time_s, tau * std::log(50.0), 1e-3 * tau);
+                expectNear("first-order overshoot", m.overshoot_pct, 0.0, 1e-12);
+                expectNear("first-order iae", m.iae, scale * tau, 1e-5 * scale);
+                // The 30 s run truncates the ITAE tail of the slowest lag by about 2e-5.
+                expectNear("first-order itae", m.itae, scale * tau * tau, 1e-4 * scale * tau * tau);
+                expectNear("first-order final error", m.steady_state_error, 0.0, 1e-6 * scale);
+            }
+        }
+
+        // Serial and parallel batches agree exactly.
+        settings.threads = 1;
+        const std::vector<StepMetrics> serial = runStepTests(grid, settings);
+        bool identical = serial.size() == results.size();
+        for (std::size_t i = 0; identical && i < serial.size(); ++i) {
+            identical = serial[i].iae == results[i].iae && serial[i].rise_time_s == results[i].rise_time_s;
+        }
+        expectTrue("serial matches parallel", identical);
+    }
+
+    // Ramp: a first-order lag trails a ramp of slope a by K·a·τ.
+    {
+        SimulationState::DynamicsConfig config;
+        config.time_constant = 0.4;
+        StepTestSettings ramp;
+        ramp.kind = StepTestSettings::Kind::Ramp;
+        ramp.amplitude = 0.5;
+        ramp.duration_s = 10.0;
+        const StepMetrics m = runStepTest(firstOrderTarget(config), ramp);
+        expectNear("ramp lag", m.steady_state_error, 0.5 * 0.4, 1e-6);
+        expectTrue("ramp has no rise time", std::isnan(m.rise_time_s));
+    }
+
+    // Regression gate for the attitude controller: a 0.2 rad step on every
+    // airframe and both tilt axes must stay fast, well damped and unbiased.
+    {
+        SimulationState defaults;
+        std::vector<HeadlessTarget> loops;
+        for (const auto airframe : {SimulationState::Airframe::QuadX, SimulationState::Airframe::QuadPlus,
+                                    SimulationState::Airframe::HexX, SimulationState::Airframe::OctoX}) {
+            loops.push_back(attitudeLoopTarget(airframe, defaults.controller_config, 0));
+            loops.push_back(attitudeLoopTarget(airframe, defaults.controller_config, 1));
+        }
+        StepTestSettings step;
+        step.amplitude = 0.2;
+        step.duration_s = 3.0;
+        step.dt = 0.002;
+        const std::vector<StepMetrics> results = runStepTests(loops, step);
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const StepMetrics& m = results[i];
+            char name[96];
+            std::snprintf(name, sizeof(name), "%s %zu rise", loops[i].name.c_str(), i / 2);
+            expectTrue(name, m.rise_time_s < 0.3);
+            std::snprintf(name, sizeof(name), "%s %zu settling", loops[i].name.c_str(), i / 2);
+            expectTrue(name, m.settling_time_s < 0.7);
+            std::snprintf(name, sizeof(name), "%s %zu overshoot", loops[i].name.c_str(), i / 2);
+            expectTrue(name, m.overshoot_pct < 5.0);
+            std::snprintf(name, sizeof(name), "%s %zu steady-state error", loops[i].name.c_str(), i / 2);
+            expectNear(name, m.steady_state_error, 0.0, 1e-3);
+            std::snprintf(name, sizeof(name), "%s %zu iae", loops[i].name.c_str(), i / 2);
+            expectTrue(name, m.iae < 0.045);
+        }
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d step-metrics check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("Step metrics checks passed");
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "control/hover_lqr.h"
+#include "control/trim.h"
+#include "core/simulation_state.h"
+#include "modules/quadcopter_dynamics.h"
+#include "modules/vehicle_derivative.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+/// Vehicle description of a freshly initialized plant for the given airframe
+template <std::size_t RotorCount>
+dm_vehicle_config_t plantModel(SimulationState::Airframe airframe, SimulationState& state)
+{
+    state.vehicle_config.airframe = airframe;
+    makeMultirotorDynamicsModule(airframe)->initialize(state);
+    return vehicleModelConfig<RotorCount>(state.vehicle_config);
+}
+
+/// Largest state-derivative error of the vehicle flying the trim (velocity
+/// derivative against the turn's centripetal term, angular acceleration against zero)
+template <std::size_t RotorCount>
+double equilibriumError(const dm_vehicle_config_t& config, const TrimCondition& condition,
+                        const TrimSolution<RotorCount>& trim)
+{
+    VehicleStateVector<double> x{};
+    for (std::size_t i = 0; i < 3; ++i) {
+        x[kStateVelocity + i] = condition.velocity_ned_m_s[i];
+        x[kStateAngularRate + i] = trim.body_rate_rad_s[i];
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        x[kStateQuaternion + i] = trim.quaternion[i];
+    }
+    VehicleStateVector<double> dxdt{};
+    vehicleDerivative<RotorCount, double>(config, trim.rotor_omega_rad_s.data(), x, dxdt, condition.drag);
+    const double r = condition.turn_rate_rad_s;
+    const double* v = condition.velocity_ned_m_s.data();
+    const double expected[3] = {-r * v[1], r * v[0], 0.0};
+    double worst = 0.0;
+    for (std::size_t i = 0; i < 3; ++i) {
+        worst = std::max(worst, std::abs(dxdt[kStateVelocity + i] - expected[i]));
+        worst = std::max(worst, std::abs(dxdt[kStateAngularRate + i]));
+    }
+    return worst;
+}
+
+}  // namespace
+
+int main()
+{
+    // Quad X hover: the closed-form equal speeds, level, in a few Newton steps;
+    // the plant starts its motors there and reports the solve.
+    {
+        SimulationState state;
+        const dm_vehicle_config_t model = plantModel<4>(SimulationState::Airframe::QuadX, state);
+        const TrimSolution<4> trim = solveTrim<4>(model, TrimCondition{});
+        const double hover = hoverRotorSpeed<4>(model);
+        expectTrue("quad hover converged", trim.converged);
+        expectTrue("quad hover iterations", trim.iterations <= 4);
+        expectNear("quad hover roll", trim.roll_rad, 0.0, 1e-12);
+        expectNear("quad hover pitch", trim.pitch_rad, 0.0, 1e-12);
+        for (std::size_t i = 0; i < 4; ++i) {
+            expectNear("quad hover speed", trim.rotor_omega_rad_s[i], hover, 1e-9 * hover);
+        }
+        expectTrue("plant published trim", state.trim.converged);
+        expectNear("plant starts at trim", state.motor_state.omega_rad_s[0], hover, 1e-9 * hover);
+    }
+
+    // Climb and straight cruise need no tilt without drag; the vehicle stays in equilibrium.
+    {
+        SimulationState state;
+        const dm_vehicle_config_t model = plantModel<4>(SimulationState::Airframe::QuadX, state);
+        TrimCondition climb;
+        climb.velocity_ned_m_s = {3.0, 0.0, -2.0};
+        const TrimSolution<4> trim = solveTrim<4>(model, climb);
+        expectTrue("climb converged", trim.converged);
+        expectNear("climb roll", trim.roll_rad, 0.0, 1e-12);
+        expectNear("climb equilibrium", equilibriumError(model, climb, trim), 0.0, 1e-9);
+    }
+
+    // Forward flight with drag: the thrust tilts nose-down until its horizontal
+    // part cancels the drag, tan θ = -c V_air / (m g); drifting with the wind is level.
+    {
+        SimulationState state;
+        const dm_vehicle_config_t model = plantModel<4>(SimulationState::Airframe::QuadX, state);
+        TrimCondition cruise;
+        cruise.velocity_ned_m_s = {10.0, 0.0, 0.0};
+        cruise.drag.coefficient = 0.1;
+        cruise.drag.wind_ned = {-2.0, 0.0, 0.0};
+        const TrimSolution<4> trim = solveTrim<4>(model, cruise);
+        expectTrue("drag cruise converged", trim.converged);
+        expectNear("drag cruise pitch", trim.pitch_rad, -std::atan(0.1 * 12.0 / (model.mass * model.gravity)), 1e-9);
+        expectNear("drag cruise roll", trim.roll_rad, 0.0, 1e-9);
+        expectNear("drag cruise equilibrium", equilibriumError(model, cruise, trim), 0.0, 1e-9);
+        const double hover = hoverRotorSpeed<4>(model);
+        expectTrue("drag costs thrust", trim.rotor_omega_rad_s[0] > hover);
+
+        TrimCondition drift = cruise;
+        drift.velocity_ned_m_s = {-2.0, 0.0, 0.0};
+        const TrimSolution<4> level = solveTrim<4>(model, drift);
+        expectNear("drifting with the wind is level", level.pitch_rad, 0.0, 1e-12);
+    }
+
+    // Coordinated turn: bank angle tan φ = V ψ̇ / g, and the rotors supply
+    // the gyroscopic torque of the turning body.
+    {
+        SimulationState state;
+        const dm_vehicle_config_t model = plantModel<4>(SimulationState::Airframe::QuadX, state);
+        TrimCondition turn;
+        turn.velocity_ned_m_s = {10.0, 0.0, 0.0};
+        turn.turn_rate_rad_s = 0.5;
+        const TrimSolution<4> trim = solveTrim<4>(model, turn);
+        expectTrue("turn converged", trim.converged);
+        expectNear("turn bank", trim.roll_rad, std::atan(10.0 * 0.5 / model.gravity), 1e-9);
+        expectNear("turn pitch", trim.pitch_rad, 0.0, 1e-9);
+        expectNear("turn equilibrium", equilibriumError(model, turn, trim), 0.0, 1e-9);
+
+        // Sweep the turn rate warm-starting each point from the previous one.
+        TrimSolution<4> previous = trim;
+        bool all_converged = true;
+        std::size_t worst_iterations = 0;
+        for (int step = 1; step <= 20; ++step) {
+            turn.turn_rate_rad_s = 0.5 + 0.05 * step;
+            previous = solveTrim<4>(model, turn, TrimSettings{}, &previous);
+            all_converged = all_converged && previous.converged;
+            worst_iterations = std::max(worst_iterations, previous.iterations);
+        }
+        expectTrue("warm-started sweep converged", all_converged);
+        expectTrue("warm-started sweep iterations", worst_iterations <= 4);
+        expectNear("sweep end bank", previous.roll_rad, std::atan(10.0 * 1.5 / model.gravity), 1e-9);
+    }
+
+    // Hexacopter with one weak rotor: six equations, eight unknowns. The
+    // minimum-norm steps still find a level equilibrium by redistributing speed.
+    {
+        SimulationState state;
+        dm_vehicle_config_t model = plantModel<6>(SimulationState::Airframe::HexX, state);
+        model.rotors[0].thrust_coeff *= 0.8;
+        const TrimSolution<6> trim = solveTrim<6>(model, TrimCondition{});
+        expectTrue("hex converged", trim.converged);
+        expectNear("hex level roll", trim.roll_rad, 0.0, 1e-9);
+        expectNear("hex level pitch", trim.pitch_rad, 0.0, 1e-9);
+        expectNear("hex equilibrium", equilibriumError(model, TrimCondition{}, trim), 0.0, 1e-9);
+        expectTrue("weak rotor spins faster", trim.rotor_omega_rad_s[0] > hoverRotorSpeed<6>(model));
+    }
+
+    // Octo hover is unchanged by the generalization.
+    {
+        SimulationState state;
+        const dm_vehicle_config_t model = plantModel<8>(SimulationState::Airframe::OctoX, state);
+        const TrimSolution<8> trim = solveTrim<8>(model, TrimCondition{});
+        expectTrue("octo converged", trim.converged);
+        expectNear("octo speed", trim.rotor_omega_rad_s[3], hoverRotorSpeed<8>(model), 1e-6);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d trim check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("Trim solver checks passed");
+    return 0;
+}
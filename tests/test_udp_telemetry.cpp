@@ -0,0 +1,218 @@
+#include "core/telemetry_channels.h"
+#include "ipc/udp_telemetry_decoder.h"
+#include "ipc/udp_telemetry_streamer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+/// UDP socket on 127.0.0.1 with an ephemeral port
+int openReceiver(std::uint16_t& port)
+{
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    const int buffer_bytes = 8 << 20;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_bytes, sizeof(buffer_bytes));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    socklen_t length = sizeof(address);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+    port = ntohs(address.sin_port);
+    return fd;
+}
+
+/// Every datagram that arrives until the socket stays quiet for 200 ms
+std::vector<std::vector<unsigned char>> drain(int fd)
+{
+    std::vector<std::vector<unsigned char>> datagrams;
+    pollfd watch{fd, POLLIN, 0};
+    while (::poll(&watch, 1, 200) > 0) {
+        std::vector<unsigned char> datagram(udp_telemetry::kMaxDatagramBytes);
+        const ssize_t size = ::recv(fd, datagram.data(), datagram.size(), 0);
+        if (size > 0) {
+            datagram.resize(static_cast<std::size_t>(size));
+            datagrams.push_back(std::move(datagram));
+        }
+    }
+    return datagrams;
+}
+
+}  // namespace
+
+int main()
+{
+    std::uint16_t port = 0;
+    const int receiver = openReceiver(port);
+
+    // Selected channels arrive batched, rate-limited and in order over loopback.
+    {
+        UdpTelemetryStreamer streamer;
+        streamer.select("sim.rtf");
+        streamer.select("mpc.solve_us", 100.0);
+        TelemetryChannels channels;
+        const std::size_t rtf = channels.registerChannel("sim.rtf", "x");
+        channels.addSink(&streamer);
+        const std::size_t solve = channels.registerChannel("mpc.solve_us", "us");
+        const std::size_t hidden = channels.registerChannel("mpc.iterations", "");
+        expectTrue("streamer starts", streamer.start("127.0.0.1", port));
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 10000; ++i) {
+            const double t = i * 1e-3;
+            channels.record(rtf, t, 0.5 * i);
+            channels.record(solve, t, 100.0 + i);
+            channels.record(hidden, t, 1.0);
+        }
+        const double record_ns =
+            std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / 30000.0;
+        channels.removeSink(&streamer);
+        streamer.stop();
+        expectTrue("nothing dropped", streamer.samplesDropped() == 0 && streamer.sendErrors() == 0);
+        expectTrue("samples sent", streamer.samplesSent() == 11000);
+
+        UdpTelemetryDecoder decoder;
+        std::vector<UdpTelemetryDecoder::Sample> samples;
+        std::size_t data_datagrams = 0;
+        std::size_t largest = 0;
+        for (const auto& datagram : drain(receiver)) {
+            largest = std::max(largest, datagram.size());
+            if (decoder.decode(datagram.data(), datagram.size(), samples) == UdpTelemetryDecoder::Result::Data) {
+                ++data_datagrams;
+            }
+        }
+        expectTrue("datagrams fit the budget", largest <= 1200);
+        expectTrue("samples are batched", data_datagrams > 0 && data_datagrams <= 11000 / 117 + 2);
+        expectTrue("no datagram lost on loopback", decoder.lost() == 0 && decoder.late() == 0);
+        expectTrue("channel names", decoder.findChannel("sim.rtf") == rtf &&
+                                        decoder.channelUnit(solve) == "us" &&
+                                        decoder.channelName(hidden) == "mpc.iterations");
+
+        std::vector<UdpTelemetryDecoder::Sample> full;
+        std::vector<UdpTelemetryDecoder::Sample> limited;
+        bool unselected = false;
+        for (const auto& sample : samples) {
+            if (sample.channel == rtf) {
+                full.push_back(sample);
+            } else if (sample.channel == solve) {
+                limited.push_back(sample);
+            } else {
+                unselected = true;
+            }
+        }
+        expectTrue("unselected channel stays local", !unselected);
+        expectTrue("full-rate channel complete", full.size() == 10000);
+        bool exact = true;
+        for (std::size_t i = 0; i < full.size(); ++i) {
+            exact = exact && full[i].value == 0.5 * static_cast<double>(i) &&
+                    std::abs(full[i].timestamp - static_cast<double>(i) * 1e-3) < 1e-6;
+        }
+        expectTrue("samples in order with their timestamps", exact);
+        expectTrue("rate limit keeps 100 Hz", limited.size() == 1000);
+        if (limited.size() > 2) {
+            expectNear("rate-limited spacing", limited[2].timestamp - limited[1].timestamp, 0.01, 1e-6);
+        }
+        std::printf("record with streaming: %.1f ns/sample, %zu data datagrams\n", record_ns, data_datagrams);
+    }
+
+    // A full queue drops on the recording thread instead of blocking it.
+    {
+        UdpTelemetryStreamer streamer;
+        UdpTelemetryStreamer::Settings settings;
+        settings.queue_capacity = 64;
+        TelemetryChannels channels;
+        channels.addSink(&streamer);
+        const std::size_t id = channels.registerChannel("burst", "");
+        expectTrue("small queue starts", streamer.start("127.0.0.1", port, settings));
+        for (int i = 0; i < 20000; ++i) {
+            channels.record(id, i * 1e-4, i);
+        }
+        channels.removeSink(&streamer);
+        streamer.stop();
+        expectTrue("overflow counted", streamer.samplesDropped() > 0);
+        expectTrue("every sample sent or dropped", streamer.samplesSent() + streamer.samplesDropped() == 20000);
+        drain(receiver);
+    }
+
+    // Decoder: version gate, truncation, loss accounting and session restarts.
+    {
+        UdpTelemetryStreamer streamer;
+        TelemetryChannels channels;
+        channels.addSink(&streamer);
+        const std::size_t id = channels.registerChannel("x", "");
+        UdpTelemetryStreamer::Settings settings;
+        settings.flush_interval_s = 0.0;    // One datagram per sample
+        streamer.start("127.0.0.1", port, settings);
+        for (int i = 0; i < 4; ++i) {
+            channels.record(id, i, i);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        streamer.stop();
+        const auto datagrams = drain(receiver);
+        expectTrue("one datagram per sample plus the table", datagrams.size() >= 5);
+
+        if (datagrams.size() >= 5) {
+            UdpTelemetryDecoder decoder;
+            std::vector<UdpTelemetryDecoder::Sample> samples;
+            std::vector<unsigned char> newer = datagrams[0];
+            newer[4] = udp_telemetry::kFormatMajor + 1;
+            expectTrue("other major rejected", decoder.decode(newer.data(), newer.size(), samples) ==
+                                                   UdpTelemetryDecoder::Result::Incompatible);
+            const auto& data = datagrams[1];
+            expectTrue("truncated rejected", decoder.decode(data.data(), data.size() - 3, samples) ==
+                                                 UdpTelemetryDecoder::Result::Invalid);
+            for (std::size_t i = 0; i < datagrams.size(); ++i) {
+                if (i != 2) {
+                    decoder.decode(datagrams[i].data(), datagrams[i].size(), samples);
+                }
+            }
+            expectTrue("gap counted as lost", decoder.lost() == 1);
+            decoder.decode(datagrams[2].data(), datagrams[2].size(), samples);
+            expectTrue("late arrival reclassified", decoder.lost() == 0 && decoder.late() == 1);
+
+            std::vector<unsigned char> restarted = datagrams[1];
+            restarted[8] ^= 0xFF;   // Another session
+            decoder.decode(restarted.data(), restarted.size(), samples);
+            expectTrue("new session starts over", decoder.datagrams() == 1 && decoder.channelCount() == 0);
+        }
+    }
+
+    ::close(receiver);
+    if (failures != 0) {
+        std::fprintf(stderr, "%d UDP telemetry check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("UDP telemetry checks passed");
+    return 0;
+}
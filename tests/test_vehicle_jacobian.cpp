@@ -0,0 +1,186 @@
+#include "control/hover_lqr.h"
+#include "core/dual.h"
+#include "modules/vehicle_derivative.h"
+#include "modules/vehicle_jacobian.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+constexpr double kMass = 1.2;
+constexpr double kGravity = 9.81;
+constexpr double kThrustCoeff = 1.2e-6;
+
+/// Quad X with the arm length and coefficients of the default plant
+dm_vehicle_config_t quadConfig()
+{
+    dm_vehicle_config_t config{};
+    config.rotor_count = 4;
+    config.mass = kMass;
+    config.gravity = kGravity;
+    const double inertia[3] = {0.029, 0.029, 0.055};
+    for (int i = 0; i < 3; ++i) {
+        config.inertia[i][i] = inertia[i];
+        config.inertia_inv[i][i] = 1.0 / inertia[i];
+    }
+    const double arm = 0.25 / std::sqrt(2.0);
+    const double positions[4][2] = {{arm, arm}, {-arm, arm}, {-arm, -arm}, {arm, -arm}};
+    const double directions[4] = {1.0, -1.0, 1.0, -1.0};
+    for (int i = 0; i < 4; ++i) {
+        dm_rotor_config_t& rotor = config.rotors[i];
+        rotor.position_body[0] = positions[i][0];
+        rotor.position_body[1] = positions[i][1];
+        rotor.axis_body[2] = -1.0;
+        rotor.direction = directions[i];
+        rotor.thrust_coeff = kThrustCoeff;
+        rotor.torque_coeff = 2.5e-8;
+    }
+    return config;
+}
+
+template <std::size_t R, std::size_t C>
+double maxDifference(const SmallMatrix<R, C>& a, const SmallMatrix<R, C>& b, double& largest)
+{
+    double worst = 0.0;
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) {
+            worst = std::max(worst, std::abs(a.m[i][j] - b.m[i][j]));
+            largest = std::max(largest, std::abs(a.m[i][j]));
+        }
+    }
+    return worst;
+}
+
+}  // namespace
+
+int main()
+{
+    // Dual-number rules against closed-form derivatives.
+    {
+        using D = Dual<2>;
+        const D x = D::variable(0.7, 0);
+        const D y = D::variable(-1.3, 1);
+        const D f = x * y + sin(x) / y - sqrt(x) * 3.0 + 2.0 / x;
+        expectNear("dual value", f.value,
+                   0.7 * -1.3 + std::sin(0.7) / -1.3 - 3.0 * std::sqrt(0.7) + 2.0 / 0.7, 1e-14);
+        expectNear("dual d/dx", f.grad[0],
+                   -1.3 + std::cos(0.7) / -1.3 - 1.5 / std::sqrt(0.7) - 2.0 / (0.7 * 0.7), 1e-13);
+        expectNear("dual d/dy", f.grad[1], 0.7 - std::sin(0.7) / (1.3 * 1.3), 1e-13);
+    }
+
+    const dm_vehicle_config_t config = quadConfig();
+
+    // Tilted, rotating, unevenly driven vehicle: AD matches central
+    // differences, and the value matches the plain double evaluation.
+    {
+        VehicleStateVector<double> x{};
+        x[kStateVelocity + 0] = 3.0;
+        x[kStateVelocity + 2] = -0.5;
+        const double norm = std::sqrt(0.95 * 0.95 + 0.1 * 0.1 + 0.2 * 0.2 + 0.15 * 0.15);
+        x[kStateQuaternion + 0] = 0.95 / norm;
+        x[kStateQuaternion + 1] = 0.1 / norm;
+        x[kStateQuaternion + 2] = -0.2 / norm;
+        x[kStateQuaternion + 3] = 0.15 / norm;
+        x[kStateAngularRate + 0] = 0.8;
+        x[kStateAngularRate + 1] = -0.4;
+        x[kStateAngularRate + 2] = 1.5;
+        const SmallVector<4> omega = {1100.0, 1250.0, 1180.0, 1020.0};
+
+        const VehicleJacobian<4> exact = vehicleJacobian<4>(config, omega, x);
+        const VehicleJacobian<4> reference = vehicleJacobianCentralDifference<4>(config, omega, x);
+
+        VehicleStateVector<double> plain{};
+        vehicleDerivative<4, double>(config, omega.data(), x, plain);
+        double value_error = 0.0;
+        for (std::size_t i = 0; i < kVehicleStateSize; ++i) {
+            value_error = std::max(value_error, std::abs(exact.derivative[i] - plain[i]));
+        }
+        expectNear("derivative value matches double evaluation", value_error, 0.0, 1e-12);
+
+        double scale_a = 0.0;
+        double scale_b = 0.0;
+        expectNear("A matches central differences", maxDifference(exact.a, reference.a, scale_a), 0.0,
+                   1e-7 * std::max(1.0, scale_a));
+        expectNear("B matches central differences", maxDifference(exact.b, reference.b, scale_b), 0.0,
+                   1e-7 * std::max(1e-3, scale_b));
+
+        // Closed-form entries: ∂ṗ/∂v = I, ∂q̇_w/∂p = -q_x/2, and ∂ṙ/∂ω_0 = -2 k_q ω_0 / I_zz.
+        expectNear("dp/dv", exact.a.m[kStatePosition + 1][kStateVelocity + 1], 1.0, 0.0);
+        expectNear("dqw/dp", exact.a.m[kStateQuaternion][kStateAngularRate],
+                   -0.5 * x[kStateQuaternion + 1], 1e-15);
+        expectNear("dr_dot/domega0", exact.b.m[kStateAngularRate + 2][0],
+                   -2.0 * 2.5e-8 * omega[0] / 0.055, 1e-12);
+
+        // Drag in a crosswind: only ∂v̇/∂v changes, by -c/m on the diagonal.
+        AirRelativeDrag drag;
+        drag.coefficient = 0.2;
+        drag.wind_ned = {1.0, -4.0, 0.5};
+        const VehicleJacobian<4> dragged = vehicleJacobian<4>(config, omega, x, drag);
+        const VehicleJacobian<4> dragged_reference = vehicleJacobianCentralDifference<4>(config, omega, x, drag);
+        double scale_drag = 0.0;
+        expectNear("A with drag matches central differences",
+                   maxDifference(dragged.a, dragged_reference.a, scale_drag), 0.0, 1e-7 * std::max(1.0, scale_drag));
+        expectNear("drag damping", dragged.a.m[kStateVelocity + 1][kStateVelocity + 1], -0.2 / kMass, 1e-15);
+        expectNear("drag force", dragged.derivative[kStateVelocity + 1] - exact.derivative[kStateVelocity + 1],
+                   -0.2 * (x[kStateVelocity + 1] - drag.wind_ned[1]) / kMass, 1e-12);
+    }
+
+    // Level vehicle: each rotor's vertical-acceleration sensitivity is -2 k_t ω / m.
+    {
+        VehicleStateVector<double> x{};
+        x[kStateQuaternion] = 1.0;
+        const SmallVector<4> omega = {1000.0, 1000.0, 1000.0, 1000.0};
+        const VehicleJacobian<4> jacobian = vehicleJacobian<4>(config, omega, x);
+        for (std::size_t i = 0; i < 4; ++i) {
+            expectNear("dvd/domega", jacobian.b.m[kStateVelocity + 2][i], -2.0 * kThrustCoeff * 1000.0 / kMass,
+                       1e-15);
+        }
+    }
+
+    // Hover linearization: exact gravity coupling between tilt and horizontal
+    // acceleration, and trim holds.
+    {
+        const HoverLinearization<4> model = linearizeHover<4>(config, 0.0);
+        expectNear("hover trim residual", model.trim_residual, 0.0, 1e-12);
+        expectNear("pitch to north acceleration", model.a.m[kErrorVelocity + 0][kErrorAttitude + 1], -kGravity,
+                   1e-12);
+        expectNear("roll to east acceleration", model.a.m[kErrorVelocity + 1][kErrorAttitude + 0], kGravity,
+                   1e-12);
+        expectNear("attitude kinematics", model.a.m[kErrorAttitude + 2][kErrorRate + 2], 1.0, 1e-15);
+        expectTrue("rotors drive yaw", model.b.m[kErrorRate + 2][0] != 0.0);
+
+        const HoverLinearization<4> damped = linearizeHover<4>(config, 0.5, 0.2);
+        expectNear("damped pirouette trim residual", damped.trim_residual, 0.0, 1e-9);
+        expectNear("drag damps the heading-frame velocity", damped.a.m[kErrorVelocity + 0][kErrorVelocity + 0],
+                   -0.2 / kMass, 1e-12);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d vehicle Jacobian check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("vehicle Jacobian checks passed");
+    return 0;
+}
@@ -0,0 +1,236 @@
+#include "config/rig_config.h"
+#include "core/module_checkpoint.h"
+#include "core/module_scheduler.h"
+#include "core/simulation_state.h"
+#include "core/turbulence_field.h"
+#include "modules/wind_field.h"
+#include "rig_fixture.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expectNear(const char* name, double actual, double expected, double tolerance)
+{
+    if (!std::isfinite(actual) || std::abs(actual - expected) > tolerance) {
+        std::fprintf(stderr,
+                     "FAIL %s: actual=%.12g expected=%.12g tolerance=%.3g\n",
+                     name, actual, expected, tolerance);
+        ++failures;
+    }
+}
+
+void expectTrue(const char* name, bool condition)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+struct AxisStatistics {
+    double variance[TurbulenceField::kAxes]{};
+    double along_correlation{0.0};   ///< Normalized autocorrelation of u at a lag of one time constant
+};
+
+/// Ensemble statistics of a 1000-vehicle field with τ = L/V = 1 s, sampled at 100 Hz
+AxisStatistics swarmStatistics(TurbulenceSpectrum spectrum, const TurbulenceScales& scales)
+{
+    constexpr std::size_t kVehicles = 1000;
+    constexpr int kLag = 100;
+    TurbulenceField field;
+    field.resize(kVehicles, 42);
+    field.configure(spectrum, scales, 5.0, 0.01);
+
+    AxisStatistics stats;
+    double sum_sq[TurbulenceField::kAxes] = {};
+    double products = 0.0, early_sq = 0.0, late_sq = 0.0;
+    std::size_t count = 0;
+    std::vector<double> held(kVehicles);
+    for (int sample = 1; sample <= 2000; ++sample) {
+        field.step();
+        if (sample <= 500) {
+            continue;   // Five time constants out of calm air
+        }
+        for (std::size_t axis = 0; axis < TurbulenceField::kAxes; ++axis) {
+            const double* y = field.output(axis);
+            for (std::size_t i = 0; i < kVehicles; ++i) {
+                sum_sq[axis] += y[i] * y[i];
+            }
+        }
+        ++count;
+        const double* u = field.output(TurbulenceField::kAlong);
+        if (sample % 200 == 0) {
+            held.assign(u, u + kVehicles);
+        } else if (sample % 200 == kLag) {
+            for (std::size_t i = 0; i < kVehicles; ++i) {
+                products += held[i] * u[i];
+                early_sq += held[i] * held[i];
+                late_sq += u[i] * u[i];
+            }
+        }
+    }
+    for (std::size_t axis = 0; axis < TurbulenceField::kAxes; ++axis) {
+        stats.variance[axis] = sum_sq[axis] / static_cast<double>(count * kVehicles);
+    }
+    stats.along_correlation = products / std::sqrt(early_sq * late_sq);
+    return stats;
+}
+
+RigConfig parsed(const std::string& text)
+{
+    return parseRigConfig(text, failures);
+}
+
+}  // namespace
+
+int main()
+{
+    // The configuration defaults are MIL-F-8785C light turbulence at 10 m.
+    {
+        const TurbulenceScales light = lowAltitudeTurbulence(7.7, 10.0);
+        const SimulationState::WindConfig defaults{};
+        expectNear("sigma horizontal", light.sigma_horizontal_m_s, defaults.sigma_horizontal_m_s, 0.01);
+        expectNear("sigma vertical", light.sigma_vertical_m_s, defaults.sigma_vertical_m_s, 0.01);
+        expectNear("length horizontal", light.length_horizontal_m, defaults.length_horizontal_m, 0.1);
+        expectNear("length vertical", light.length_vertical_m, defaults.length_vertical_m, 0.01);
+    }
+
+    // Filters: configured intensity, and the Dryden u component decorrelates as exp(-t/τ).
+    {
+        TurbulenceScales scales;
+        scales.sigma_horizontal_m_s = 1.2;
+        scales.sigma_vertical_m_s = 0.6;
+        scales.length_horizontal_m = 5.0;
+        scales.length_vertical_m = 5.0;
+
+        const AxisStatistics dryden = swarmStatistics(TurbulenceSpectrum::Dryden, scales);
+        expectNear("dryden u variance", dryden.variance[0], 1.44, 0.07);
+        expectNear("dryden v variance", dryden.variance[1], 1.44, 0.07);
+        expectNear("dryden w variance", dryden.variance[2], 0.36, 0.02);
+        expectNear("dryden u correlation at tau", dryden.along_correlation, std::exp(-1.0), 0.04);
+
+        const AxisStatistics karman = swarmStatistics(TurbulenceSpectrum::VonKarman, scales);
+        expectNear("von karman u variance", karman.variance[0], 1.44, 0.07);
+        expectNear("von karman w variance", karman.variance[2], 0.36, 0.02);
+
+        TurbulenceField field;
+        field.resize(1, 1);
+        field.configure(TurbulenceSpectrum::VonKarman, scales, 5.0, 0.01);
+        expectTrue("von karman filter orders", field.filter(0).order == 2 && field.filter(2).order == 3);
+    }
+
+    // Seeding: a vehicle's turbulence depends on the seed and its index, not the swarm size.
+    {
+        TurbulenceField swarm, pair, other;
+        swarm.resize(1000, 7);
+        pair.resize(8, 7);
+        other.resize(8, 8);
+        for (TurbulenceField* field : {&swarm, &pair, &other}) {
+            field->configure(TurbulenceSpectrum::Dryden, lowAltitudeTurbulence(7.7, 10.0), 5.0, 0.01);
+        }
+        bool same = true, differs = false;
+        for (int sample = 0; sample < 50; ++sample) {
+            swarm.step();
+            pair.step();
+            other.step();
+            for (std::size_t axis = 0; axis < TurbulenceField::kAxes; ++axis) {
+                same = same && swarm.output(axis, 5) == pair.output(axis, 5);
+                differs = differs || other.output(axis, 5) != pair.output(axis, 5);
+            }
+        }
+        expectTrue("same seed, same turbulence in any swarm", same);
+        expectTrue("another seed, other turbulence", differs);
+    }
+
+    // Steady wind pushes the vehicle downwind through the plant's drag; the gust rises and decays.
+    {
+        const std::string windy_config = "vehicle.drag_coefficient 0.1\nwind.steady 0 4 0\nwind.gust 2 0 0\n"
+                                         "wind.gust_start 1\nwind.gust_duration 0.5";
+        RigFixture calm(parsed("vehicle.drag_coefficient 0.1"), "wind");
+        RigFixture windy(parsed(windy_config), "wind");
+        RigFixture adaptive(parsed(windy_config), "wind");
+        adaptive.state.plant_integration.method = SimulationState::PlantIntegration::Method::DormandPrince45;
+        expectTrue("wind module active", windy.state.wind.active);
+        double peak_gust = 0.0;
+        for (int i = 0; i < 100; ++i) {
+            windy.run(0.02);
+            peak_gust = std::max(peak_gust, windy.state.wind.gust_ned.x);
+        }
+        calm.run(2.0);
+        adaptive.run(2.0);
+        expectNear("gust peak", peak_gust, 2.0, 1e-3);
+        expectNear("gust over", windy.state.wind.gust_ned.x, 0.0, 0.0);
+        expectNear("steady wind", windy.state.wind_ned.y, 4.0, 0.0);
+        expectTrue("carried downwind", windy.state.physics.velocity.y > 0.5 && windy.state.physics.position.y > 0.5);
+        expectNear("drag on the relative air",
+                   windy.state.wind.drag_force_ned.y, -0.1 * (windy.state.physics.velocity.y - 4.0), 0.02);
+        expectNear("calm air stays put", calm.state.physics.position.y, 0.0, 1e-6);
+        // DP45 integrates the drag inside the derivative; the RK4 impulse agrees closely.
+        expectNear("integrated drag", adaptive.state.physics.velocity.y, windy.state.physics.velocity.y,
+                   0.02 * windy.state.physics.velocity.y);
+    }
+
+    // Turbulence in the pipeline: same seed, same flight; a checkpoint replays the wind exactly.
+    {
+        const std::string config = "wind.turbulence vonkarman\nwind.steady 3 0 0\nwind.seed 11";
+        RigFixture first(parsed(config), "wind");
+        RigFixture second(parsed(config), "wind");
+        RigFixture reseeded(parsed("wind.turbulence vonkarman\nwind.steady 3 0 0\nwind.seed 12"), "wind");
+        first.run(1.0);
+        second.run(1.0);
+        reseeded.run(1.0);
+        expectTrue("turbulent", first.state.wind.turbulence_ned != glm::dvec3(0.0));
+        expectTrue("reproducible flight",
+                   std::memcmp(static_cast<const SimulationHotState*>(&first.state),
+                               static_cast<const SimulationHotState*>(&second.state), sizeof(SimulationHotState)) == 0);
+        expectTrue("seeded flight", first.state.wind_ned != reseeded.state.wind_ned);
+
+        SimulationState state = first.state;
+        WindFieldModule wind;
+        wind.initialize(state);
+        for (int i = 0; i < 20; ++i) {
+            wind.update(WindFieldModule::kSamplePeriodS, state);
+        }
+        ModuleCheckpoint measure;
+        wind.checkpoint(measure);
+        std::vector<unsigned char> buffer(measure.size());
+        ModuleCheckpoint save(ModuleCheckpoint::Mode::Save, buffer.data(), buffer.size());
+        wind.checkpoint(save);
+        std::vector<glm::dvec3> before;
+        for (int i = 0; i < 20; ++i) {
+            wind.update(WindFieldModule::kSamplePeriodS, state);
+            before.push_back(state.wind_ned);
+        }
+        ModuleCheckpoint load(ModuleCheckpoint::Mode::Load, buffer.data(), buffer.size());
+        wind.checkpoint(load);
+        bool replayed = !load.overflowed();
+        for (int i = 0; i < 20; ++i) {
+            wind.update(WindFieldModule::kSamplePeriodS, state);
+            replayed = replayed && state.wind_ned == before[static_cast<std::size_t>(i)];
+        }
+        expectTrue("checkpoint replays the turbulence", replayed);
+
+        // A live intensity change reconfigures the wind module only.
+        RigConfig stronger;
+        stronger.parse(config + "\nwind.sigma 3 1.5");
+        const unsigned changed = stronger.apply(first.state);
+        expectTrue("wind section", changed == ConfigSection::kWind);
+        expectTrue("wind module reconfigured", first.modules.reconfigure(changed, first.state) == 1);
+        first.run(0.5);
+        expectTrue("still flying", first.state.physics.integration_valid);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d wind field check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("Wind field checks passed");
+    return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file run_scenario.cpp
+ * @brief Headless scenario runner: plays a script through the rig pipeline and checks its assertions
+ *
+ * Usage: aerodyn_run_scenario SCRIPT [--config FILE | --airframe quadx|quadplus|hex|octo]
+ *                              [--trace FILE] [--golden FILE]
+ *
+ * Runs as fast as the machine allows and prints the assertion summary.
+ * --config loads a vehicle configuration (RigConfig; the GUI reads the
+ * same file from AERODYN_CONFIG), so a sweep is one config file per run.
+ * --trace saves the per-frame trace (GoldenTrace format); --golden diffs
+ * the run bitwise against a saved one, e.g. one recorded from the same
+ * script before a change. Exit status: 0 all assertions passed (and the
+ * trace matched), 1 otherwise, 2 on usage or script errors.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "analysis/golden_trace.h"
+#include "analysis/scenario_runner.h"
+
+namespace {
+
+void usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s SCRIPT [--config FILE | --airframe quadx|quadplus|hex|octo] [--trace FILE] [--golden FILE]\n",
+                 program);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    const char* trace_path = nullptr;
+    const char* golden_path = nullptr;
+    const char* config_path = nullptr;
+    const char* airframe = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--airframe") == 0 && i + 1 < argc) {
+            airframe = argv[++i];
+        } else if (std::strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+            config_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            golden_path = argv[++i];
+        } else if (!path && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!path || (config_path && airframe)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    RigConfig config;
+    if ((config_path && !config.load(config_path)) ||
+        (airframe && !config.parse(std::string("airframe ") + airframe))) {
+        std::fprintf(stderr, "%s\n", config.error().c_str());
+        return 2;
+    }
+
+    ScenarioScript script;
+    if (!script.load(path)) {
+        std::fprintf(stderr, "%s\n", script.error().c_str());
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const ScenarioOutcome outcome = runScenario(path, script, config);
+    const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto& status = outcome.status;
+    std::printf("%s: %zu events, %zu frames of %g s (%.2f s simulated in %.3f s wall)\n", path,
+                status.events, outcome.trace.steps(), script.frameDt(),
+                outcome.trace.steps() * script.frameDt(), wall_s);
+    std::printf("assertions: %llu passed, %llu failed\n", static_cast<unsigned long long>(status.assertions_passed),
+                static_cast<unsigned long long>(status.assertions_failed));
+    if (!status.first_failure.empty()) {
+        std::printf("first failure: %s\n", status.first_failure.c_str());
+    }
+
+    bool ok = status.assertions_failed == 0;
+    if (trace_path && !outcome.trace.save(trace_path)) {
+        std::fprintf(stderr, "could not write %s\n", trace_path);
+        ok = false;
+    }
+    if (golden_path) {
+        GoldenTrace golden;
+        if (!golden.load(golden_path)) {
+            std::fprintf(stderr, "could not read trace %s\n", golden_path);
+            return 2;
+        }
+        const TraceDiff diff = compareTraces(golden, outcome.trace);
+        std::printf("trace: %s\n", diff.describe().c_str());
+        ok = ok && diff.match;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file shm_telemetry_dump.cpp
+ * @brief Sample consumer: prints the live shared-memory telemetry stream
+ *
+ * Usage: aerodyn_shm_dump [--name /aerodyn_telemetry] [--channel sim.rtf] [--count N] [--from-start]
+ *
+ * Waits for the simulator to publish, lists the channels, then prints one
+ * "time channel value unit" line per sample until N samples were printed
+ * or the publisher shuts down.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "ipc/shm_telemetry_reader.h"
+
+namespace {
+
+void usage(const char* program) {
+    std::fprintf(stderr, "usage: %s [--name SHM_NAME] [--channel NAME] [--count N] [--from-start]\n", program);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* name = shm_telemetry::kDefaultName;
+    const char* only = nullptr;
+    unsigned long long limit = 0;
+    bool from_start = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (std::strcmp(argv[i], "--channel") == 0 && i + 1 < argc) {
+            only = argv[++i];
+        } else if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            limit = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--from-start") == 0) {
+            from_start = true;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    ShmTelemetryReader reader;
+    while (!reader.attach(name)) {
+        std::fprintf(stderr, "waiting for %s (%s)\n", name, reader.error().c_str());
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    if (!from_start) {
+        reader.skipToLatest();
+    }
+    std::printf("# %s: %zu channels\n", name, reader.channelCount());
+    for (std::size_t i = 0; i < reader.channelCount(); ++i) {
+        std::printf("#   %2zu %s [%s]\n", i, reader.channelName(i), reader.channelUnit(i));
+    }
+
+    ShmTelemetryReader::Sample batch[512];
+    unsigned long long printed = 0;
+    std::uint64_t reported_drops = 0;
+    while (limit == 0 || printed < limit) {
+        const std::size_t count = reader.read(batch, 512);
+        if (count == 0) {
+            if (reader.publisherClosed()) {
+                std::printf("# publisher closed\n");
+                break;
+            }
+            // Polling is the only syscall: nothing per sample.
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+        if (reader.dropped() != reported_drops) {
+            std::printf("# dropped %llu samples (reader too slow)\n",
+                        static_cast<unsigned long long>(reader.dropped() - reported_drops));
+            reported_drops = reader.dropped();
+        }
+        // Resolve the filter per batch: channels can appear while the simulator runs.
+        const std::size_t wanted = only ? reader.findChannel(only) : reader.channelCount();
+        for (std::size_t i = 0; i < count && (limit == 0 || printed < limit); ++i) {
+            const auto& sample = batch[i];
+            if (only && sample.channel != wanted) {
+                continue;
+            }
+            std::printf("%.6f %s %.9g %s\n", sample.timestamp, reader.channelName(sample.channel), sample.value,
+                        reader.channelUnit(sample.channel));
+            ++printed;
+        }
+    }
+    return 0;
+}
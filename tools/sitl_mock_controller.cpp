@@ -0,0 +1,95 @@
+/**
+ * @file sitl_mock_controller.cpp
+ * @brief Stand-in flight controller for the lockstep SITL bridge
+ *
+ * Usage: aerodyn_sitl_mock [--name /aerodyn_sitl] [--frames N] [--timeout S]
+ *
+ * Attaches to the simulator's SITL segment and answers every sensor frame
+ * with the plant's hover trim, scaled to hold the altitude of the first
+ * frame. It exists to exercise the link (tests, latency checks, a first
+ * smoke test of a new setup), not to fly well: attitude is left alone.
+ *
+ * Exits after N frames, when the simulator closes the link, or when no
+ * frame arrives within the timeout (default: wait for ever).
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "ipc/sitl_link.h"
+
+namespace {
+
+constexpr double kAltitudeGain = 0.5;   ///< Thrust fraction per metre below the start altitude
+constexpr double kClimbGain = 0.8;      ///< Thrust fraction per m/s of descent
+
+void usage(const char* program) {
+    std::fprintf(stderr, "usage: %s [--name SHM_NAME] [--frames N] [--timeout SECONDS]\n", program);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* name = sitl::kDefaultName;
+    unsigned long long limit = 0;
+    double timeout_s = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            limit = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--timeout") == 0 && i + 1 < argc) {
+            timeout_s = std::strtod(argv[++i], nullptr);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    SitlLink link;
+    const auto give_up = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout_s);
+    while (!link.attach(name)) {
+        if (timeout_s > 0.0 && std::chrono::steady_clock::now() > give_up) {
+            std::fprintf(stderr, "no simulator at %s: %s\n", name, link.error().c_str());
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    sitl::SensorFrame sensors{};
+    sitl::MotorCommand commands{};
+    bool have_reference = false;
+    double reference_down_m = 0.0;
+    unsigned long long handled = 0;
+    while (limit == 0 || handled < limit) {
+        const SitlLink::Wait result = link.waitSensors(sensors, timeout_s);
+        if (result == SitlLink::Wait::Closed) {
+            break;
+        }
+        if (result == SitlLink::Wait::Timeout) {
+            std::fprintf(stderr, "no sensor frame for %.3f s\n", timeout_s);
+            return 1;
+        }
+        if (!have_reference) {
+            reference_down_m = sensors.position_ned_m[2];
+            have_reference = true;
+        }
+        // NED: positive down error or down velocity means more thrust.
+        const double scale = 1.0 + kAltitudeGain * (sensors.position_ned_m[2] - reference_down_m) +
+                             kClimbGain * sensors.velocity_ned_mps[2];
+        const double speed_scale = std::sqrt(std::max(scale, 0.0));
+        const std::size_t rotors = std::min<std::size_t>(sensors.rotor_count, sitl::kMaxRotors);
+        for (std::size_t i = 0; i < sitl::kMaxRotors; ++i) {
+            commands.omega_rad_s[i] = i < rotors ? sensors.trim_omega_rad_s[i] * speed_scale : 0.0;
+        }
+        link.sendCommands(commands);
+        ++handled;
+    }
+    std::fprintf(stderr, "answered %llu frames\n", handled);
+    return 0;
+}